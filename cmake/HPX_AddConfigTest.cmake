@@ -201,6 +201,20 @@ macro(hpx_check_for_unistd_h)
     FILE ${ARGN})
 endmacro()
 
+###############################################################################
+macro(hpx_check_for_io_uring)
+  add_hpx_config_test(HPX_WITH_IO_URING
+    SOURCE cmake/tests/io_uring.cpp
+    FILE ${ARGN})
+endmacro()
+
+###############################################################################
+macro(hpx_check_for_perf_event)
+  add_hpx_config_test(HPX_WITH_PERF_EVENT
+    SOURCE cmake/tests/perf_event.cpp
+    FILE ${ARGN})
+endmacro()
+
 ###############################################################################
 macro(hpx_check_for_cxx11_alias_templates)
   add_hpx_config_test(HPX_WITH_CXX11_ALIAS_TEMPLATES
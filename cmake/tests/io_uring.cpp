@@ -0,0 +1,18 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+
+int main()
+{
+    io_uring_params p = {};
+    int opcodes[] = { IORING_OP_READV, IORING_OP_WRITE_FIXED, IORING_OP_FSYNC };
+    long calls[] = {
+        __NR_io_uring_setup, __NR_io_uring_enter, __NR_io_uring_register };
+    (void) p; (void) opcodes; (void) calls;
+}
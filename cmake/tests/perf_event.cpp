@@ -0,0 +1,19 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+
+int main()
+{
+    perf_event_attr attr = {};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.read_format = PERF_FORMAT_GROUP;
+    long call = __NR_perf_event_open;
+    (void) attr; (void) call;
+}
@@ -117,7 +117,7 @@ namespace hpx { namespace detail
             if (hpx::detail::has_async_policy(policy))
             {
                 threads::thread_id_type tid = p.apply(policy, policy.priority());
-                if (policy == launch::fork)
+                if (policy == launch::fork && tid)
                 {
                     // make sure this thread is executed last
                     hpx::this_thread::yield_to(thread::id(std::move(tid)));
@@ -197,7 +197,8 @@ namespace hpx { namespace detail
 
             // make sure this thread is executed last
             threads::thread_id_type tid = p.apply(policy, policy.priority());
-            hpx::this_thread::yield_to(thread::id(std::move(tid)));
+            if (tid)
+                hpx::this_thread::yield_to(thread::id(std::move(tid)));
             return p.get_future();
         }
 
@@ -17,6 +17,8 @@
 #include <hpx/components/component_storage/server/component_storage.hpp>
 
 #include <cstddef>
+#include <cstdint>
+#include <string>
 #include <vector>
 
 namespace hpx { namespace components
@@ -32,6 +34,14 @@ namespace hpx { namespace components
         component_storage(hpx::id_type target_locality);
         component_storage(hpx::future<naming::id_type> && f);
 
+        // Create a storage on the given locality which keeps the data in
+        // memory mapped segment files inside the directory \a path. Data
+        // stored in this directory by a previous storage instance is
+        // available again.
+        component_storage(hpx::id_type target_locality,
+            std::string const& path,
+            std::size_t segment_size = std::size_t(64 * 1024 * 1024));
+
         hpx::future<naming::id_type> migrate_to_here(std::vector<char> const&,
             naming::id_type const&, naming::address const&);
         naming::id_type migrate_to_here(launch::sync_policy,
@@ -46,6 +56,35 @@ namespace hpx { namespace components
         future<std::size_t> size() const;
         std::size_t size(launch::sync_policy) const;
 
+        // Reclaim the space of segments which are filled with less than
+        // the given fraction of live data, returns the number of bytes
+        // reclaimed. This does nothing for storage kept in memory.
+        future<std::uint64_t> compact(double max_live_ratio = 0.5);
+        std::uint64_t compact(launch::sync_policy,
+            double max_live_ratio = 0.5);
+
+        // Access to snapshots of all components of a locality, these are
+        // used by hpx::components::snapshot and restore_snapshot.
+        future<void> store_snapshot(std::vector<naming::gid_type> const& ids,
+            std::vector<std::vector<char> > const& data) const;
+        void store_snapshot(launch::sync_policy,
+            std::vector<naming::gid_type> const& ids,
+            std::vector<std::vector<char> > const& data) const;
+
+        future<void> commit_snapshot(
+            std::vector<naming::gid_type> const& erased) const;
+        void commit_snapshot(launch::sync_policy,
+            std::vector<naming::gid_type> const& erased) const;
+
+        // the (unmanaged) ids of all components stored by snapshots
+        future<std::vector<naming::id_type> > snapshot_keys() const;
+        std::vector<naming::id_type> snapshot_keys(launch::sync_policy) const;
+
+        future<std::vector<std::vector<char> > > load_snapshot(
+            std::vector<naming::gid_type> const& ids) const;
+        std::vector<std::vector<char> > load_snapshot(launch::sync_policy,
+            std::vector<naming::gid_type> const& ids) const;
+
 #if defined(HPX_HAVE_ASYNC_FUNCTION_COMPATIBILITY)
         HPX_DEPRECATED(HPX_DEPRECATED_MSG)
         naming::id_type migrate_to_here_sync(std::vector<char> const& v,
@@ -10,14 +10,18 @@
 
 #include <hpx/config.hpp>
 #include <hpx/lcos/future.hpp>
+#include <hpx/lcos/when_all.hpp>
 #include <hpx/runtime/components/client_base.hpp>
 #include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/traits/is_client.hpp>
 #include <hpx/traits/is_component.hpp>
 
 #include <hpx/components/component_storage/component_storage.hpp>
 #include <hpx/components/component_storage/server/migrate_to_storage.hpp>
 
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace hpx { namespace components
 {
@@ -80,6 +84,97 @@ namespace hpx { namespace components
         return Derived(migrate_to_storage<component_type>(
             to_migrate.get_id(), target_storage.get_id()));
     }
+
+    /// Migrate the components with the given ids to the specified target
+    /// storage
+    ///
+    /// The function \a migrate_to_storage<Component> will migrate all
+    /// components referenced by \a to_migrate to the storage facility
+    /// specified with \a target_storage. All migrations are performed
+    /// concurrently.
+    ///
+    /// \param to_migrate      [in] The global ids of the components to
+    ///                        migrate.
+    /// \param target_storage  [in] The id of the storage facility to migrate
+    ///                        the objects to.
+    ///
+    /// \tparam  The only template argument specifies the component type of the
+    ///          components to migrate to the given storage facility.
+    ///
+    /// \returns A future representing the global ids of the migrated
+    ///          component instances (in the same order as \a to_migrate).
+    ///          The future becomes ready once all components are migrated.
+    ///
+    template <typename Component>
+#if defined(DOXYGEN)
+    future<std::vector<naming::id_type> >
+#else
+    inline typename std::enable_if<
+        traits::is_component<Component>::value,
+        future<std::vector<naming::id_type> >
+    >::type
+#endif
+    migrate_to_storage(std::vector<naming::id_type> const& to_migrate,
+        naming::id_type const& target_storage)
+    {
+        std::vector<future<naming::id_type> > migrated;
+        migrated.reserve(to_migrate.size());
+        for (naming::id_type const& id : to_migrate)
+        {
+            migrated.push_back(
+                migrate_to_storage<Component>(id, target_storage));
+        }
+
+        return when_all(migrated).then(
+            [](future<std::vector<future<naming::id_type> > > && f)
+            ->  std::vector<naming::id_type>
+            {
+                std::vector<future<naming::id_type> > migrated = f.get();
+
+                std::vector<naming::id_type> result;
+                result.reserve(migrated.size());
+                for (future<naming::id_type>& id : migrated)
+                    result.push_back(id.get());     // rethrow errors
+                return result;
+            });
+    }
+
+    /// Migrate the given components to the specified target storage
+    ///
+    /// The function \a migrate_to_storage will migrate all components
+    /// referenced by \a to_migrate to the storage facility specified with
+    /// \a target_storage. All migrations are performed concurrently.
+    ///
+    /// \param to_migrate      [in] The client side representations of the
+    ///                        components to migrate.
+    /// \param target_storage  [in] The id of the storage facility to migrate
+    ///                        the objects to.
+    ///
+    /// \returns The client side representations of the migrated component
+    ///          instances (in the same order as \a to_migrate).
+    ///
+    template <typename Client>
+#if defined(DOXYGEN)
+    std::vector<Client>
+#else
+    inline typename std::enable_if<
+        traits::is_client<Client>::value, std::vector<Client>
+    >::type
+#endif
+    migrate_to_storage(std::vector<Client> const& to_migrate,
+        hpx::components::component_storage const& target_storage)
+    {
+        typedef typename Client::server_component_type component_type;
+
+        std::vector<Client> result;
+        result.reserve(to_migrate.size());
+        for (Client const& c : to_migrate)
+        {
+            result.push_back(Client(migrate_to_storage<component_type>(
+                c.get_id(), target_storage.get_id())));
+        }
+        return result;
+    }
 }}
 
 #endif
@@ -17,8 +17,13 @@
 #include <hpx/components/containers/unordered/unordered_map.hpp>
 
 #include <hpx/components/component_storage/export_definitions.hpp>
+#include <hpx/components/component_storage/server/segment_log.hpp>
 
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
 #include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -33,17 +38,53 @@ namespace hpx { namespace components { namespace server
     public:
         component_storage();
 
+        // store the data in the segment files inside the given directory
+        // (see segment_log), the data stored there before is available
+        explicit component_storage(std::string const& path,
+            std::size_t segment_size = std::size_t(64 * 1024 * 1024));
+
+        ~component_storage();
+
         naming::gid_type migrate_to_here(std::vector<char> const&,
             naming::id_type, naming::address const&);
         std::vector<char> migrate_from_here(naming::gid_type const&);
-        std::size_t size() const { return data_.size(); }
+        std::size_t size() const;
+
+        // reclaim the space of removed components, returns the number of
+        // bytes reclaimed
+        std::uint64_t compact(double max_live_ratio);
+
+        // Snapshots of all components of a locality (see snapshot.hpp). The
+        // components are not rebound to this storage.
+        void store_snapshot(std::vector<naming::gid_type> const& ids,
+            std::vector<std::vector<char> > const& data);
+        void commit_snapshot(std::vector<naming::gid_type> const& erased);
+        std::vector<naming::gid_type> snapshot_keys() const;
+        std::vector<std::vector<char> > load_snapshot(
+            std::vector<naming::gid_type> const& ids) const;
 
         HPX_DEFINE_COMPONENT_ACTION(component_storage, migrate_to_here);
         HPX_DEFINE_COMPONENT_ACTION(component_storage, migrate_from_here);
         HPX_DEFINE_COMPONENT_ACTION(component_storage, size);
+        HPX_DEFINE_COMPONENT_ACTION(component_storage, compact);
+        HPX_DEFINE_COMPONENT_ACTION(component_storage, store_snapshot);
+        HPX_DEFINE_COMPONENT_ACTION(component_storage, commit_snapshot);
+        HPX_DEFINE_COMPONENT_ACTION(component_storage, snapshot_keys);
+        HPX_DEFINE_COMPONENT_ACTION(component_storage, load_snapshot);
 
     private:
-        hpx::unordered_map<naming::gid_type, std::vector<char> > data_;
+        typedef hpx::unordered_map<naming::gid_type, std::vector<char> >
+            data_type;
+
+        // the data is kept in memory only if there is no segment log
+        std::unique_ptr<data_type> data_;
+
+        // components stored in data_ by snapshots
+        mutable mutex_type mtx_;
+        std::set<naming::gid_type> snapshot_keys_;
+#if !defined(HPX_WINDOWS)
+        std::unique_ptr<segment_log> log_;
+#endif
     };
 }}}
 
@@ -56,6 +97,21 @@ HPX_REGISTER_ACTION_DECLARATION(
 HPX_REGISTER_ACTION_DECLARATION(
     hpx::components::server::component_storage::size_action,
     component_storage_size_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::components::server::component_storage::compact_action,
+    component_storage_compact_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::components::server::component_storage::store_snapshot_action,
+    component_storage_store_snapshot_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::components::server::component_storage::commit_snapshot_action,
+    component_storage_commit_snapshot_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::components::server::component_storage::snapshot_keys_action,
+    component_storage_snapshot_keys_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::components::server::component_storage::load_snapshot_action,
+    component_storage_load_snapshot_action);
 
 typedef std::vector<char> hpx_component_storage_data_type;
 HPX_REGISTER_UNORDERED_MAP_DECLARATION(
@@ -0,0 +1,138 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_COMPONENT_STORAGE_SERVER_SEGMENT_LOG_APR_10_2017_0918AM)
+#define HPX_COMPONENT_STORAGE_SERVER_SEGMENT_LOG_APR_10_2017_0918AM
+
+#include <hpx/config.hpp>
+
+#if !defined(HPX_WINDOWS)
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/naming/name.hpp>
+
+#include <hpx/components/component_storage/export_definitions.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hpx { namespace components { namespace server
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Persistent storage for the serialized state of migrated components.
+    //
+    // The data is kept in an append-only log of memory mapped segment files
+    // inside a directory. Every record consists of a header (identifying the
+    // component and the size of the data) followed by the data itself. The
+    // index maps the global id of every stored component to the location of
+    // its most recent record; the data is read from the mapped segment only
+    // when it is retrieved. Erasing a component appends a tombstone record.
+    // Records written by snapshots (see snapshot.hpp) are marked as such, a
+    // snapshot never includes components which were migrated to the storage.
+    //
+    // Records are appended concurrently: the space for a record is reserved
+    // under a lock, the data is copied without holding any lock.
+    //
+    // Opening an existing directory rebuilds the index by scanning the
+    // record headers of all segments in the order they were created.
+    class HPX_MIGRATE_TO_STORAGE_EXPORT segment_log
+    {
+    public:
+        HPX_NON_COPYABLE(segment_log);
+
+    private:
+        typedef lcos::local::spinlock mutex_type;
+
+        struct segment;
+        typedef std::shared_ptr<segment> segment_ptr;
+
+        struct location
+        {
+            segment_ptr segment_;
+            std::size_t offset_;        // offset of the record header
+            std::size_t size_;          // size of the data
+            bool snapshot_;             // the data belongs to a snapshot
+        };
+
+        typedef std::unordered_map<naming::gid_type, location> index_type;
+
+    public:
+        static constexpr std::size_t default_segment_size = 64 * 1024 * 1024;
+
+        // Open the log stored in the given directory, creating the directory
+        // if it does not exist yet.
+        explicit segment_log(std::string const& path,
+            std::size_t segment_size = default_segment_size);
+        ~segment_log();
+
+        // Append the data for the given component, replacing any data stored
+        // for it before.
+        void store(naming::gid_type const& gid, std::vector<char> const& data,
+            bool snapshot = false);
+
+        // Retrieve (and optionally erase) the data stored for the given
+        // component. Throws if there is no data for it.
+        std::vector<char> load(naming::gid_type const& gid, bool erase);
+
+        // Erase the data stored for the given component, returns false if
+        // there is no data for it (or if it was not stored by a snapshot and
+        // snapshot is true).
+        bool erase(naming::gid_type const& gid, bool snapshot = false);
+
+        // number of components stored
+        std::size_t size() const;
+
+        // global ids of all components stored (only of those stored by a
+        // snapshot if snapshot is true)
+        std::vector<naming::gid_type> keys(bool snapshot = false) const;
+
+        // Rewrite all live records of the segments which are filled with
+        // less than the given fraction of live data and remove those
+        // segments afterwards. Returns the number of bytes reclaimed.
+        std::uint64_t compact(double max_live_ratio = 0.5);
+
+        // Write all modified data back to the segment files.
+        void flush();
+
+        std::string const& path() const { return path_; }
+
+    private:
+        void recover();
+        segment_ptr create_segment(std::size_t min_size);
+
+        // reserve space for a record in the active segment, returns the
+        // offset of the record
+        std::size_t reserve(std::size_t size, segment_ptr& seg);
+        void append(std::uint32_t state, naming::gid_type const& gid,
+            char const* data, std::size_t size, location* loc);
+        void append_tombstone(naming::gid_type const& gid,
+            location const& loc);
+
+        void retire(segment_ptr const& seg, std::size_t record_size,
+            std::unique_lock<mutex_type>& l);
+        void remove_segment(segment_ptr const& seg);
+
+    private:
+        std::string path_;
+        std::size_t segment_size_;
+
+        mutable mutex_type mtx_;
+        index_type index_;
+        std::map<std::uint64_t, segment_ptr> segments_;
+        segment_ptr active_;
+        std::uint64_t next_segment_;
+
+        mutex_type compaction_mtx_;
+    };
+}}}
+
+#endif
+#endif
@@ -0,0 +1,65 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file snapshot.hpp
+
+#if !defined(HPX_COMPONENT_STORAGE_SNAPSHOT_APR_17_2017_0217PM)
+#define HPX_COMPONENT_STORAGE_SNAPSHOT_APR_17_2017_0217PM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+
+#include <hpx/components/component_storage/component_storage.hpp>
+#include <hpx/components/component_storage/export_definitions.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hpx { namespace components
+{
+    /// Save the state of all migratable components living on this locality
+    ///
+    /// The function \a snapshot serializes all instances of components
+    /// supporting migration (see \a migration_support) which are living on
+    /// the calling locality and streams the data to \a storage in batches.
+    /// The instances are serialized in parallel while no action is executing
+    /// on any of them: the snapshot waits for all actions in flight on
+    /// migratable components of the locality to finish, actions invoked
+    /// afterwards are delayed until all instances have been serialized.
+    ///
+    /// \param storage      [in] The storage facility receiving the data. This
+    ///                     should be used for the snapshots of a single
+    ///                     locality only.
+    /// \param incremental  [in] Save only the instances which were modified
+    ///                     since the previous snapshot. In any case the data
+    ///                     of instances destroyed since then is removed from
+    ///                     the storage.
+    ///
+    /// \returns A future holding the number of bytes written to the storage.
+    ///
+    /// \note This function must not be invoked from inside an action
+    ///       executed on a migratable component. Actions on migratable
+    ///       components waiting for other actions on migratable components
+    ///       of the same locality to finish must not be in flight while a
+    ///       snapshot is taken.
+    HPX_MIGRATE_TO_STORAGE_EXPORT future<std::uint64_t> snapshot(
+        component_storage const& storage, bool incremental = true);
+
+    /// Recreate all components saved by \a snapshot
+    ///
+    /// The function \a restore_snapshot recreates all component instances
+    /// stored in \a storage on the calling locality and binds them to their
+    /// original global ids. This has to be invoked before any of these
+    /// global ids is in use again, usually right after the application has
+    /// been restarted.
+    ///
+    /// \param storage      [in] The storage facility holding the snapshot.
+    ///
+    /// \returns A future holding the number of restored components.
+    HPX_MIGRATE_TO_STORAGE_EXPORT future<std::size_t> restore_snapshot(
+        component_storage const& storage);
+}}
+
+#endif
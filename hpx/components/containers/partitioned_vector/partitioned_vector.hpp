@@ -414,6 +414,28 @@ namespace hpx
             return indices;
         }
 
+        // Sort the given global indices into one block of local indices per
+        // partition. For each block this also returns the offsets of the
+        // indices in the original sequence.
+        void gather_indices(std::vector<size_type> const& indices,
+            std::vector<std::vector<size_type> >& part_indices,
+            std::vector<std::vector<std::size_t> >& part_offsets) const
+        {
+            part_indices.clear();
+            part_indices.resize(partitions_.size());
+            part_offsets.clear();
+            part_offsets.resize(partitions_.size());
+
+            for (std::size_t i = 0; i != indices.size(); ++i)
+            {
+                size_type part = get_partition(indices[i]);
+                HPX_ASSERT(part < partitions_.size());
+
+                part_indices[part].push_back(get_local_index(indices[i]));
+                part_offsets[part].push_back(i);
+            }
+        }
+
         // Return the global index corresponding to the local index inside the
         // given segment.
         template <typename SegmentIter>
@@ -988,6 +1010,10 @@ namespace hpx
         /// \return Returns the value of the element at position represented by
         ///         \a pos.
         ///
+        /// \note The positions are grouped by the partition they belong to,
+        ///       exactly one request is sent to each of the partitions
+        ///       involved, independently of the order of the positions.
+        ///
         future<std::vector<T> >
         get_values(std::vector<size_type> const & pos_vec) const
         {
@@ -996,69 +1022,55 @@ namespace hpx
             if (pos_vec.empty())
                 return make_ready_future(std::vector<T>());
 
-            // current partition index of the block
-            size_type part_cur = get_partition(pos_vec[0]);
-
-            // iterator to the begin of current block
-            typename std::vector<size_type>::const_iterator part_begin =
-                pos_vec.begin();
+            // sort the local indices into one block per partition, remember
+            // where each of the values has to go in the overall result
+            std::vector<std::vector<size_type> > part_indices;
+            std::vector<std::vector<std::size_t> > part_offsets;
+            gather_indices(pos_vec, part_indices, part_offsets);
 
             // vector holding futures of the values for all blocks
             std::vector<future<std::vector<T> > > part_values_future;
-            for (typename std::vector<size_type>::const_iterator it =
-                    pos_vec.begin(); it != pos_vec.end(); ++it)
-            {
-                // get the partition of the current position
-                size_type part = get_partition(*it);
+            std::vector<std::vector<std::size_t> > offsets;
 
-                // if the partition of the current position is the same
-                // as the rest of the current block go to next position
-                if (part == part_cur)
+            part_values_future.reserve(part_indices.size());
+            offsets.reserve(part_indices.size());
+
+            for (std::size_t part = 0; part != part_indices.size(); ++part)
+            {
+                if (part_indices[part].empty())
                     continue;
 
-                // if the partition of the current position is NOT the same
-                // as the positions before the block ends here
-                else
-                {
-                    // this is the end of a block containing indexes ('pos')
-                    // of the same partition ('part').
-                    // get async values for this block
-                    part_values_future.push_back(get_values(part_cur,
-                        get_local_indices(std::vector<size_type>(part_begin, it))));
-
-                    // reset block variables to start a new one from here
-                    part_cur = part;
-                    part_begin = it;
-                }
+                part_values_future.push_back(
+                    get_values(part, part_indices[part]));
+                offsets.push_back(std::move(part_offsets[part]));
             }
 
-            // the end of the vector is also an end of a block
-            // get async values for this block
-            part_values_future.push_back(get_values(part_cur,
-                get_local_indices(std::vector<size_type>(
-                    part_begin, pos_vec.end()))));
-
             // This helper function unwraps the vectors from each partition
-            // and merge them to one vector
+            // and scatters the values back into the requested order
+            std::size_t size = pos_vec.size();
             auto merge_func =
-                [&pos_vec](std::vector<future<std::vector<T> > > && part_values_f)
-                    -> std::vector<T>
+                [size, offsets](
+                    std::vector<future<std::vector<T> > > && part_values_f)
+                ->  std::vector<T>
                 {
-                    std::vector<T> values;
-                    values.reserve(pos_vec.size());
+                    std::vector<T> values(size);
 
-                    for (future<std::vector<T> >& part_f: part_values_f)
+                    for (std::size_t i = 0; i != part_values_f.size(); ++i)
                     {
-                        std::vector<T> part_values = part_f.get();
-                        std::move(part_values.begin(), part_values.end(),
-                            std::back_inserter(values));
+                        std::vector<T> part_values = part_values_f[i].get();
+                        std::vector<std::size_t> const& part_offsets =
+                            offsets[i];
+
+                        HPX_ASSERT(part_values.size() == part_offsets.size());
+                        for (std::size_t j = 0; j != part_values.size(); ++j)
+                            values[part_offsets[j]] = std::move(part_values[j]);
                     }
                     return values;
                 };
 
             // when all values are here merge them to one vector
             // and return a future to this vector
-            return dataflow(launch::async, merge_func,
+            return dataflow(launch::async, std::move(merge_func),
                 std::move(part_values_future));
         }
 
@@ -1322,14 +1334,14 @@ namespace hpx
         void set_values(launch::sync_policy, size_type part,
             std::vector<size_type> const& pos, std::vector<T> const& val)
         {
-            set_values(pos, val).get();
+            set_values(part, pos, val).get();
         }
 #if defined(HPX_HAVE_ASYNC_FUNCTION_COMPATIBILITY)
         HPX_DEPRECATED(HPX_DEPRECATED_MSG)
         void set_values_sync(size_type part, std::vector<size_type> const& pos,
             std::vector<T> const& val)
         {
-            set_values(launch::sync, pos, val);
+            set_values(launch::sync, part, pos, val);
         }
 #endif
 
@@ -1378,55 +1390,29 @@ namespace hpx
             if (pos.empty())
                 return make_ready_future();
 
-            // partition index of the current block
-            size_type part_cur = get_partition(pos[0]);
-
-            // iterator to the begin of current block
-            typename std::vector<size_type>::const_iterator pos_block_begin =
-                pos.begin();
-            typename std::vector<T>::const_iterator val_block_begin = val.begin();
+            // sort the local indices into one block per partition
+            std::vector<std::vector<size_type> > part_indices;
+            std::vector<std::vector<std::size_t> > part_offsets;
+            gather_indices(pos, part_indices, part_offsets);
 
             // vector holding futures of the state for all blocks
             std::vector<future<void> > part_futures;
+            part_futures.reserve(part_indices.size());
 
-            // going through the position vector
-            typename std::vector<size_type>::const_iterator pos_it = pos.begin();
-            typename std::vector<T>::const_iterator val_it = val.begin();
-            for (/**/; pos_it != pos.end(); ++pos_it, ++val_it)
+            for (std::size_t part = 0; part != part_indices.size(); ++part)
             {
-                // get the partition of the current position
-                size_type part = get_partition(*pos_it);
-
-                // if the partition of the current position is the same
-                // as the rest of the current block go to next position
-                if (part == part_cur)
+                if (part_indices[part].empty())
                     continue;
 
-                // if the partition of the current position is NOT the same
-                // as the positions before the block ends here
-                else
-                {
-                    // this is the end of a block containing indexes ('pos')
-                    // of the same partition ('part').
-                    // set asynchronous values for this block
-                    part_futures.push_back(set_values(part_cur,
-                        get_local_indices(std::vector<size_type>(
-                            pos_block_begin, pos_it)),
-                        std::vector<T>(val_block_begin, val_it)));
-
-                    // reset block variables to start a new one from here
-                    part_cur = part;
-                    pos_block_begin = pos_it;
-                    val_block_begin = val_it;
-                }
-            }
+                // collect the values to send to this partition
+                std::vector<T> part_values;
+                part_values.reserve(part_offsets[part].size());
+                for (std::size_t offset : part_offsets[part])
+                    part_values.push_back(val[offset]);
 
-            // the end of the vector is also an end of a block
-            // get asynchronous values for this block
-            part_futures.push_back(set_values(part_cur,
-                get_local_indices(std::vector<size_type>(
-                    pos_block_begin, pos.end())),
-                std::vector<T>(val_block_begin, val.end())));
+                part_futures.push_back(
+                    set_values(part, part_indices[part], part_values));
+            }
 
             return when_all(part_futures);
         }
@@ -0,0 +1,490 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file hpx/components/containers/unordered/detail/concurrent_hash_table.hpp
+
+#if !defined(HPX_UNORDERED_CONCURRENT_HASH_TABLE_OCT_19_2017_1054AM)
+#define HPX_UNORDERED_CONCURRENT_HASH_TABLE_OCT_19_2017_1054AM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace server { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// This is the storage used by the partition_unordered_map component.
+    ///
+    /// The table is split into a fixed number of shards, each of which is an
+    /// open-addressing (linear probing) hash table with its own lock. The
+    /// slots of a shard are kept in contiguous arrays. Concurrent accesses to
+    /// different shards never contend, and each lock is held only for the
+    /// duration of the probe sequence of a single key (or of a batch of keys
+    /// falling into the same shard).
+    template <typename Key, typename T, typename Hash, typename KeyEqual>
+    class concurrent_hash_table
+    {
+    public:
+        typedef Key key_type;
+        typedef T mapped_type;
+        typedef std::pair<Key, T> value_type;
+        typedef std::size_t size_type;
+
+    private:
+        typedef lcos::local::spinlock mutex_type;
+
+        // must be a power of two
+        static std::size_t const num_shards = 64;
+        static std::size_t const initial_capacity = 8;
+
+        enum slot_state : std::uint8_t
+        {
+            slot_empty = 0,
+            slot_occupied = 1,
+            slot_deleted = 2
+        };
+
+        struct shard
+        {
+            shard()
+              : size_(0), used_(0)
+            {}
+
+            mutable mutex_type mtx_;
+            std::vector<std::uint8_t> states_;
+            std::vector<value_type> slots_;
+            std::size_t size_;      // number of occupied slots
+            std::size_t used_;      // number of occupied and deleted slots
+        };
+
+        // spread the bits of the user supplied hash, std::hash is the
+        // identity for integral types
+        static std::uint64_t mix(std::size_t h)
+        {
+            std::uint64_t x = static_cast<std::uint64_t>(h);
+            x ^= x >> 33;
+            x *= 0xff51afd7ed558ccdULL;
+            x ^= x >> 33;
+            return x;
+        }
+
+        std::uint64_t hash_key(Key const& key) const
+        {
+            return mix(hash_(key));
+        }
+
+        bool equal_keys(Key const& lhs, Key const& rhs) const
+        {
+            return equal_(lhs, rhs);
+        }
+
+        static std::size_t shard_index(std::uint64_t h)
+        {
+            return static_cast<std::size_t>(h >> 58) & (num_shards - 1);
+        }
+
+        // find the slot holding the given key, returns std::size_t(-1) if the
+        // key is not stored in the shard
+        std::size_t find_slot(shard const& s, Key const& key,
+            std::uint64_t h) const
+        {
+            std::size_t const capacity = s.states_.size();
+            if (capacity == 0)
+                return std::size_t(-1);
+
+            std::size_t const mask = capacity - 1;
+            for (std::size_t i = static_cast<std::size_t>(h) & mask, n = 0;
+                 n != capacity; i = (i + 1) & mask, ++n)
+            {
+                std::uint8_t state = s.states_[i];
+                if (state == slot_empty)
+                    break;
+                if (state == slot_occupied && equal_keys(s.slots_[i].first, key))
+                    return i;
+            }
+            return std::size_t(-1);
+        }
+
+        // find the slot for the given key, creating it if needed
+        std::size_t find_or_create_slot(shard& s, Key const& key,
+            std::uint64_t h)
+        {
+            // keep the load factor (including tombstones) below 3/4
+            if ((s.used_ + 1) * 4 > s.states_.size() * 3)
+            {
+                rehash(s, (s.size_ + 1) * 2 > initial_capacity ?
+                    (s.size_ + 1) * 2 : initial_capacity);
+            }
+
+            std::size_t const mask = s.states_.size() - 1;
+            std::size_t insert_at = std::size_t(-1);
+            for (std::size_t i = static_cast<std::size_t>(h) & mask; /**/;
+                 i = (i + 1) & mask)
+            {
+                std::uint8_t state = s.states_[i];
+                if (state == slot_empty)
+                {
+                    if (insert_at == std::size_t(-1))
+                    {
+                        insert_at = i;
+                        ++s.used_;
+                    }
+                    break;
+                }
+                if (state == slot_deleted)
+                {
+                    if (insert_at == std::size_t(-1))
+                        insert_at = i;
+                }
+                else if (equal_keys(s.slots_[i].first, key))
+                {
+                    return i;
+                }
+            }
+
+            s.states_[insert_at] = slot_occupied;
+            s.slots_[insert_at].first = key;
+            s.slots_[insert_at].second = T();
+            ++s.size_;
+            return insert_at;
+        }
+
+        void rehash(shard& s, std::size_t min_capacity)
+        {
+            std::size_t capacity = initial_capacity;
+            while (capacity < min_capacity)
+                capacity *= 2;
+
+            std::vector<std::uint8_t> states(capacity, slot_empty);
+            std::vector<value_type> slots(capacity);
+
+            std::size_t const mask = capacity - 1;
+            for (std::size_t i = 0; i != s.states_.size(); ++i)
+            {
+                if (s.states_[i] != slot_occupied)
+                    continue;
+
+                std::size_t j =
+                    static_cast<std::size_t>(hash_key(s.slots_[i].first)) & mask;
+                while (states[j] != slot_empty)
+                    j = (j + 1) & mask;
+
+                states[j] = slot_occupied;
+                slots[j] = std::move(s.slots_[i]);
+            }
+
+            s.states_ = std::move(states);
+            s.slots_ = std::move(slots);
+            s.used_ = s.size_;
+        }
+
+        void erase_slot(shard& s, std::size_t i)
+        {
+            s.states_[i] = slot_deleted;
+            s.slots_[i] = value_type();
+            --s.size_;
+        }
+
+        // sort the indices of the given keys by the shard they belong to
+        void group_by_shard(std::vector<Key> const& keys,
+            std::vector<std::vector<std::size_t> >& indices,
+            std::vector<std::uint64_t>& hashes) const
+        {
+            indices.resize(num_shards);
+            hashes.reserve(keys.size());
+            for (std::size_t i = 0; i != keys.size(); ++i)
+            {
+                std::uint64_t h = hash_key(keys[i]);
+                hashes.push_back(h);
+                indices[shard_index(h)].push_back(i);
+            }
+        }
+
+    public:
+        concurrent_hash_table()
+          : hash_(), equal_()
+        {}
+
+        explicit concurrent_hash_table(size_type bucket_count,
+                Hash const& hash = Hash(), KeyEqual const& equal = KeyEqual())
+          : hash_(hash), equal_(equal)
+        {
+            if (bucket_count != 0)
+                reserve(bucket_count);
+        }
+
+        concurrent_hash_table(concurrent_hash_table const& rhs)
+          : hash_(rhs.hash_), equal_(rhs.equal_)
+        {
+            assign(rhs);
+        }
+
+        concurrent_hash_table& operator=(concurrent_hash_table const& rhs)
+        {
+            if (this != &rhs)
+            {
+                hash_ = rhs.hash_;
+                equal_ = rhs.equal_;
+                assign(rhs);
+            }
+            return *this;
+        }
+
+        // the shards are not movable because of their locks, moving a table
+        // moves the contents of each of the shards
+        concurrent_hash_table(concurrent_hash_table && rhs)
+          : hash_(std::move(rhs.hash_)), equal_(std::move(rhs.equal_))
+        {
+            swap_contents(rhs);
+        }
+
+        concurrent_hash_table& operator=(concurrent_hash_table && rhs)
+        {
+            if (this != &rhs)
+            {
+                hash_ = std::move(rhs.hash_);
+                equal_ = std::move(rhs.equal_);
+                swap_contents(rhs);
+                rhs.clear();
+            }
+            return *this;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        size_type size() const
+        {
+            size_type result = 0;
+            for (shard const& s : shards_)
+            {
+                std::lock_guard<mutex_type> l(s.mtx_);
+                result += s.size_;
+            }
+            return result;
+        }
+
+        size_type capacity() const
+        {
+            size_type result = 0;
+            for (shard const& s : shards_)
+            {
+                std::lock_guard<mutex_type> l(s.mtx_);
+                result += (s.states_.size() * 3) / 4;
+            }
+            return result;
+        }
+
+        size_type max_size() const
+        {
+            return std::vector<value_type>().max_size();
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        void reserve(size_type count)
+        {
+            std::size_t per_shard = (count + num_shards - 1) / num_shards;
+            for (shard& s : shards_)
+            {
+                std::lock_guard<mutex_type> l(s.mtx_);
+                if ((per_shard * 4) / 3 + 1 > s.states_.size())
+                    rehash(s, (per_shard * 4) / 3 + 1);
+            }
+        }
+
+        void clear()
+        {
+            for (shard& s : shards_)
+            {
+                std::lock_guard<mutex_type> l(s.mtx_);
+                s.states_.clear();
+                s.slots_.clear();
+                s.size_ = 0;
+                s.used_ = 0;
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Look up the given key, returns whether the key was found
+        bool find(Key const& key, T& value) const
+        {
+            std::uint64_t h = hash_key(key);
+            shard const& s = shards_[shard_index(h)];
+
+            std::lock_guard<mutex_type> l(s.mtx_);
+            std::size_t i = find_slot(s, key, h);
+            if (i == std::size_t(-1))
+                return false;
+
+            value = s.slots_[i].second;
+            return true;
+        }
+
+        /// Look up and remove the given key, returns whether the key was found
+        bool extract(Key const& key, T& value)
+        {
+            std::uint64_t h = hash_key(key);
+            shard& s = shards_[shard_index(h)];
+
+            std::lock_guard<mutex_type> l(s.mtx_);
+            std::size_t i = find_slot(s, key, h);
+            if (i == std::size_t(-1))
+                return false;
+
+            value = std::move(s.slots_[i].second);
+            erase_slot(s, i);
+            return true;
+        }
+
+        /// Insert the given value or replace the value stored for the key
+        template <typename T_>
+        void insert_or_assign(Key const& key, T_ && value)
+        {
+            std::uint64_t h = hash_key(key);
+            shard& s = shards_[shard_index(h)];
+
+            std::lock_guard<mutex_type> l(s.mtx_);
+            s.slots_[find_or_create_slot(s, key, h)].second =
+                std::forward<T_>(value);
+        }
+
+        size_type erase(Key const& key)
+        {
+            std::uint64_t h = hash_key(key);
+            shard& s = shards_[shard_index(h)];
+
+            std::lock_guard<mutex_type> l(s.mtx_);
+            std::size_t i = find_slot(s, key, h);
+            if (i == std::size_t(-1))
+                return 0;
+
+            erase_slot(s, i);
+            return 1;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Look up all of the given keys, acquiring the lock of each of the
+        /// shards at most once. Returns the index of the first key which was
+        /// not found, or std::size_t(-1) if all keys were found.
+        std::size_t find_all(std::vector<Key> const& keys,
+            std::vector<T>& values) const
+        {
+            values.resize(keys.size());
+
+            std::vector<std::vector<std::size_t> > indices;
+            std::vector<std::uint64_t> hashes;
+            group_by_shard(keys, indices, hashes);
+
+            for (std::size_t part = 0; part != num_shards; ++part)
+            {
+                if (indices[part].empty())
+                    continue;
+
+                shard const& s = shards_[part];
+                std::lock_guard<mutex_type> l(s.mtx_);
+                for (std::size_t idx : indices[part])
+                {
+                    std::size_t i = find_slot(s, keys[idx], hashes[idx]);
+                    if (i == std::size_t(-1))
+                        return idx;
+                    values[idx] = s.slots_[i].second;
+                }
+            }
+            return std::size_t(-1);
+        }
+
+        /// Insert or replace all of the given values, acquiring the lock of
+        /// each of the shards at most once.
+        void insert_or_assign_all(std::vector<Key> const& keys,
+            std::vector<T> const& values)
+        {
+            HPX_ASSERT(keys.size() == values.size());
+
+            std::vector<std::vector<std::size_t> > indices;
+            std::vector<std::uint64_t> hashes;
+            group_by_shard(keys, indices, hashes);
+
+            for (std::size_t part = 0; part != num_shards; ++part)
+            {
+                if (indices[part].empty())
+                    continue;
+
+                shard& s = shards_[part];
+                std::lock_guard<mutex_type> l(s.mtx_);
+                for (std::size_t idx : indices[part])
+                {
+                    s.slots_[find_or_create_slot(s, keys[idx], hashes[idx])]
+                        .second = values[idx];
+                }
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Invoke the given function for each of the stored elements. The
+        /// slots of each shard are scanned sequentially while holding the
+        /// lock of that shard only.
+        template <typename F>
+        void for_each(F && f) const
+        {
+            for (shard const& s : shards_)
+            {
+                std::lock_guard<mutex_type> l(s.mtx_);
+                for (std::size_t i = 0; i != s.states_.size(); ++i)
+                {
+                    if (s.states_[i] == slot_occupied)
+                        f(s.slots_[i]);
+                }
+            }
+        }
+
+    private:
+        void assign(concurrent_hash_table const& rhs)
+        {
+            for (std::size_t i = 0; i != num_shards; ++i)
+            {
+                shard const& src = rhs.shards_[i];
+                shard& dest = shards_[i];
+
+                std::lock_guard<mutex_type> l(src.mtx_);
+                std::lock_guard<mutex_type> ld(dest.mtx_);
+                dest.states_ = src.states_;
+                dest.slots_ = src.slots_;
+                dest.size_ = src.size_;
+                dest.used_ = src.used_;
+            }
+        }
+
+        void swap_contents(concurrent_hash_table& rhs)
+        {
+            for (std::size_t i = 0; i != num_shards; ++i)
+            {
+                shard& src = rhs.shards_[i];
+                shard& dest = shards_[i];
+
+                std::lock_guard<mutex_type> l(src.mtx_);
+                std::lock_guard<mutex_type> ld(dest.mtx_);
+                std::swap(dest.states_, src.states_);
+                std::swap(dest.slots_, src.slots_);
+                std::swap(dest.size_, src.size_);
+                std::swap(dest.used_, src.used_);
+            }
+        }
+
+    private:
+        Hash hash_;
+        KeyEqual equal_;
+        shard shards_[num_shards];
+    };
+}}}
+
+#endif
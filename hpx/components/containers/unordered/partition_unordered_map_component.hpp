@@ -12,7 +12,7 @@
 ///
 /// \brief The partition_unordered_map as the hpx component is defined here.
 ///
-/// The partition_unordered_map is the wrapper to the stl unordered_map class
+/// The partition_unordered_map is the wrapper to a concurrent hash table
 /// except all API'are defined as component action. All the API's in client
 /// classes are asynchronous API which return the futures.
 
@@ -23,7 +23,6 @@
 #include <hpx/runtime/actions/plain_action.hpp>
 #include <hpx/runtime/components/client_base.hpp>
 #include <hpx/runtime/components/component_factory.hpp>
-#include <hpx/runtime/components/server/locking_hook.hpp>
 #include <hpx/runtime/components/server/simple_component_base.hpp>
 #include <hpx/runtime/get_ptr.hpp>
 #include <hpx/runtime/launch_policy.hpp>
@@ -33,6 +32,8 @@
 #include <hpx/util/detail/pp/expand.hpp>
 #include <hpx/util/detail/pp/nargs.hpp>
 
+#include <hpx/components/containers/unordered/detail/concurrent_hash_table.hpp>
+
 #include <cstddef>
 #include <iostream>
 #include <memory>
@@ -48,27 +49,30 @@ namespace hpx { namespace server
     ///
     /// This contain the implementation of the partition_unordered_map's
     /// component functionality.
+    ///
+    /// The elements are stored in a concurrent hash table which synchronizes
+    /// accesses internally, this allows for actions invoked concurrently on
+    /// the same partition (and for local accesses through the pinned pointer)
+    /// to run in parallel.
     template <typename Key, typename T, typename Hash = std::hash<Key>,
         typename KeyEqual = std::equal_to<Key> >
     class partition_unordered_map
-      : public components::locking_hook<
-            hpx::components::simple_component_base<
-                partition_unordered_map<Key, T, Hash, KeyEqual> > >
+      : public hpx::components::simple_component_base<
+            partition_unordered_map<Key, T, Hash, KeyEqual> >
     {
     public:
         typedef std::unordered_map<Key, T, Hash, KeyEqual> data_type;
+        typedef detail::concurrent_hash_table<Key, T, Hash, KeyEqual>
+            storage_type;
 
-        typedef typename data_type::size_type size_type;
-        typedef typename data_type::iterator iterator_type;
-        typedef typename data_type::const_iterator const_iterator_type;
+        typedef typename storage_type::size_type size_type;
 
-        typedef components::locking_hook<
-                hpx::components::simple_component_base<
-                    partition_unordered_map<Key, T, Hash, KeyEqual> > >
+        typedef hpx::components::simple_component_base<
+                partition_unordered_map<Key, T, Hash, KeyEqual> >
             base_type;
 
     private:
-        data_type partition_unordered_map_;
+        storage_type partition_unordered_map_;
 
     public:
         ///////////////////////////////////////////////////////////////////////
@@ -124,38 +128,38 @@ namespace hpx { namespace server
         /// Duplicate the copy method for action naming
         data_type get_copied_data() const
         {
-            return partition_unordered_map_;
+            data_type data(partition_unordered_map_.size());
+            partition_unordered_map_.for_each(
+                [&data](typename storage_type::value_type const& v)
+                {
+                    data.insert(v);
+                });
+            return data;
         }
         void set_copied_data(data_type && d)
         {
-            partition_unordered_map_ = std::move(d);
-        }
+            std::vector<Key> keys;
+            std::vector<T> values;
+            keys.reserve(d.size());
+            values.reserve(d.size());
 
-        ///////////////////////////////////////////////////////////////////////
-        iterator_type begin()
-        {
-            return partition_unordered_map_.begin();
-        }
-        const_iterator_type begin() const
-        {
-            return partition_unordered_map_.begin();
-        }
-        const_iterator_type cbegin() const
-        {
-            return partition_unordered_map_.cbegin();
-        }
+            for (auto& v : d)
+            {
+                keys.push_back(v.first);
+                values.push_back(std::move(v.second));
+            }
 
-        iterator_type end()
-        {
-            return partition_unordered_map_.end();
-        }
-        const_iterator_type end() const
-        {
-            return partition_unordered_map_.end();
+            partition_unordered_map_.clear();
+            partition_unordered_map_.reserve(keys.size());
+            partition_unordered_map_.insert_or_assign_all(keys, values);
         }
-        const_iterator_type cend() const
+
+        /// Invoke the given function for each of the elements stored in this
+        /// partition.
+        template <typename F>
+        void for_each(F && f) const
         {
-            return partition_unordered_map_.cend();
+            partition_unordered_map_.for_each(std::forward<F>(f));
         }
 
         ///////////////////////////////////////////////////////////////////////
@@ -181,8 +185,7 @@ namespace hpx { namespace server
             return partition_unordered_map_.capacity();
         }
 
-        /// Checks if the container has no elements, i.e. whether
-        /// begin() == end().
+        /// Checks if the container has no elements.
         bool empty() const
         {
             return partition_unordered_map_.empty();
@@ -200,36 +203,21 @@ namespace hpx { namespace server
         /// \return Return the value of the element at position represented
         ///         by \a pos.
         ///
-        struct erase_on_exit
-        {
-            erase_on_exit(data_type& m, typename data_type::iterator& it)
-              : m_(m), it_(it)
-            {}
-            ~erase_on_exit()
-            {
-                m_.erase(it_);
-            }
-
-            data_type& m_;
-            typename data_type::iterator& it_;
-        };
-
         T get_value(Key const& key, bool erase)
         {
-            typename data_type::iterator it = partition_unordered_map_.find(key);
-            if (it == partition_unordered_map_.end())
+            T result;
+            bool found = erase ?
+                partition_unordered_map_.extract(key, result) :
+                partition_unordered_map_.find(key, result);
+
+            if (!found)
             {
                 HPX_THROW_EXCEPTION(bad_parameter,
                     "partition_unordered_map::get_value",
                     "unable to find requested key in this partition of the "
                     "unordered_map");
             }
-
-            if (!erase)
-                return it->second;
-
-            erase_on_exit t(partition_unordered_map_, it);
-            return it->second;
+            return result;
         }
 
         /// Return the element at the position \a pos in the partition_unordered_map
@@ -243,21 +231,13 @@ namespace hpx { namespace server
         std::vector<T> get_values(std::vector<Key> const& keys)
         {
             std::vector<T> result;
-            result.reserve(keys.size());
-
-            for (std::size_t i = 0; i != keys.size(); ++i)
+            if (partition_unordered_map_.find_all(keys, result) !=
+                std::size_t(-1))
             {
-                typename data_type::iterator it =
-                    partition_unordered_map_.find(keys[i]);
-                if (it == partition_unordered_map_.end())
-                {
-                    HPX_THROW_EXCEPTION(bad_parameter,
-                        "partition_unordered_map::get_values",
-                        "unable to find requested key in this partition of the "
-                        "unordered_map");
-                    break;
-                }
-                result.push_back(it->second);
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "partition_unordered_map::get_values",
+                    "unable to find requested key in this partition of the "
+                    "unordered_map");
             }
             return result;
         }
@@ -275,7 +255,7 @@ namespace hpx { namespace server
         ///
         void set_value(Key const& pos, T const& val)
         {
-            partition_unordered_map_[pos] = val;
+            partition_unordered_map_.insert_or_assign(pos, val);
         }
 
         /// Copy the value of \a val for the elements at positions \a pos in
@@ -289,10 +269,7 @@ namespace hpx { namespace server
             std::vector<T> const& val)
         {
             HPX_ASSERT(keys.size() == val.size());
-            HPX_ASSERT(keys.size() <= partition_unordered_map_.size());
-
-            for (std::size_t i = 0; i != keys.size(); ++i)
-                partition_unordered_map_[keys[i]] = val[i];
+            partition_unordered_map_.insert_or_assign_all(keys, val);
         }
 
         /// Remove all elements from the vector leaving the
@@ -9,7 +9,9 @@
 #define HPX_UNORDERED_MAP_NOV_11_2014_0852PM
 
 #include <hpx/config.hpp>
+#include <hpx/dataflow.hpp>
 #include <hpx/lcos/wait_all.hpp>
+#include <hpx/lcos/when_all.hpp>
 #include <hpx/runtime/components/client_base.hpp>
 #include <hpx/runtime/components/component_type.hpp>
 #include <hpx/runtime/components/copy_component.hpp>
@@ -334,6 +336,25 @@ namespace hpx
             return this->hasher_(key) % partitions_.size();
         }
 
+        // Sort the given keys into one block per partition. For each block
+        // this also returns the offsets of the keys in the original sequence.
+        void gather_keys(std::vector<Key> const& keys,
+            std::vector<std::vector<Key> >& part_keys,
+            std::vector<std::vector<std::size_t> >& part_offsets) const
+        {
+            part_keys.clear();
+            part_keys.resize(partitions_.size());
+            part_offsets.clear();
+            part_offsets.resize(partitions_.size());
+
+            for (std::size_t i = 0; i != keys.size(); ++i)
+            {
+                std::size_t part = get_partition(keys[i]);
+                part_keys[part].push_back(keys[i]);
+                part_offsets[part].push_back(i);
+            }
+        }
+
         std::vector<hpx::id_type> get_partition_ids() const
         {
             std::vector<hpx::id_type> ids;
@@ -693,6 +714,106 @@ namespace hpx
                 .get_value(pos, erase);
         }
 
+        /// Returns the elements with the given \a keys from the unordered_map
+        /// container.
+        ///
+        /// \param keys  Keys of the elements in the unordered_map
+        ///
+        /// \return Returns the values of the elements with the given keys,
+        ///         in the order of \a keys.
+        ///
+        std::vector<T>
+        get_values(launch::sync_policy, std::vector<Key> const& keys) const
+        {
+            return get_values(keys).get();
+        }
+
+        /// Returns the elements with the given \a keys from the partition
+        /// \a part of the unordered_map container.
+        ///
+        /// \param part  Sequence number of the partition
+        /// \param keys  Keys of the elements in the partition
+        ///
+        /// \return Returns the hpx::future to the values of the elements with
+        ///         the given keys.
+        ///
+        future<std::vector<T> >
+        get_values(size_type part, std::vector<Key> const& keys) const
+        {
+            HPX_ASSERT(part < partitions_.size());
+
+            if (partitions_[part].local_data_)
+            {
+                return make_ready_future(
+                    partitions_[part].local_data_->get_values(keys));
+            }
+
+            return partition_unordered_map_client(partitions_[part].partition_)
+                .get_values(keys);
+        }
+
+        /// Returns the elements with the given \a keys from the unordered_map
+        /// container asynchronously.
+        ///
+        /// \param keys  Keys of the elements in the unordered_map
+        ///
+        /// \return Returns the hpx::future to the values of the elements with
+        ///         the given keys, in the order of \a keys.
+        ///
+        /// \note The keys are grouped by the partition they belong to,
+        ///       exactly one request is sent to each of the partitions
+        ///       involved.
+        ///
+        future<std::vector<T> > get_values(std::vector<Key> const& keys) const
+        {
+            if (keys.empty())
+                return make_ready_future(std::vector<T>());
+
+            std::vector<std::vector<Key> > part_keys;
+            std::vector<std::vector<std::size_t> > part_offsets;
+            gather_keys(keys, part_keys, part_offsets);
+
+            std::vector<future<std::vector<T> > > part_values_future;
+            std::vector<std::vector<std::size_t> > offsets;
+
+            part_values_future.reserve(part_keys.size());
+            offsets.reserve(part_keys.size());
+
+            for (std::size_t part = 0; part != part_keys.size(); ++part)
+            {
+                if (part_keys[part].empty())
+                    continue;
+
+                part_values_future.push_back(
+                    get_values(part, part_keys[part]));
+                offsets.push_back(std::move(part_offsets[part]));
+            }
+
+            // scatter the values received from the partitions back into the
+            // order of the requested keys
+            std::size_t size = keys.size();
+            return dataflow(launch::async,
+                [size, offsets](
+                    std::vector<future<std::vector<T> > > && part_values_f)
+                ->  std::vector<T>
+                {
+                    std::vector<T> values(size);
+
+                    for (std::size_t i = 0; i != part_values_f.size(); ++i)
+                    {
+                        std::vector<T> part_values = part_values_f[i].get();
+                        std::vector<std::size_t> const& part_offsets =
+                            offsets[i];
+
+                        HPX_ASSERT(part_values.size() == part_offsets.size());
+                        for (std::size_t j = 0; j != part_values.size(); ++j)
+                            values[part_offsets[j]] = std::move(part_values[j]);
+                    }
+                    return values;
+                },
+                std::move(part_values_future));
+        }
+
         /// Copy the value of \a val in the element at position \a pos in
         /// the unordered_map container.
         ///
@@ -789,6 +910,90 @@ namespace hpx
                 .set_value(pos, std::forward<T_>(val));
         }
 
+        /// Copy the values \a vals to the elements with the given \a keys
+        /// in the unordered_map container.
+        ///
+        /// \param keys  Keys of the elements in the unordered_map
+        /// \param vals  The values to be copied
+        ///
+        void set_values(launch::sync_policy, std::vector<Key> const& keys,
+            std::vector<T> const& vals)
+        {
+            set_values(keys, vals).get();
+        }
+
+        /// Asynchronously copy the values \a vals to the elements with the
+        /// given \a keys in the partition \a part.
+        ///
+        /// \param part  Sequence number of the partition
+        /// \param keys  Keys of the elements in the partition
+        /// \param vals  The values to be copied
+        ///
+        /// \return This returns the hpx::future of type void which gets ready
+        ///         once the operation is finished.
+        ///
+        future<void> set_values(size_type part, std::vector<Key> const& keys,
+            std::vector<T> const& vals)
+        {
+            HPX_ASSERT(part < partitions_.size());
+            HPX_ASSERT(keys.size() == vals.size());
+
+            partition_data const& part_data = partitions_[part];
+            if (part_data.local_data_)
+            {
+                part_data.local_data_->set_values(keys, vals);
+                return make_ready_future();
+            }
+
+            return partition_unordered_map_client(part_data.partition_)
+                .set_values(keys, vals);
+        }
+
+        /// Asynchronously copy the values \a vals to the elements with the
+        /// given \a keys in the unordered_map container.
+        ///
+        /// \param keys  Keys of the elements in the unordered_map
+        /// \param vals  The values to be copied
+        ///
+        /// \return This returns the hpx::future of type void which gets ready
+        ///         once the operation is finished.
+        ///
+        /// \note The keys are grouped by the partition they belong to,
+        ///       exactly one request is sent to each of the partitions
+        ///       involved.
+        ///
+        future<void> set_values(std::vector<Key> const& keys,
+            std::vector<T> const& vals)
+        {
+            HPX_ASSERT(keys.size() == vals.size());
+
+            if (keys.empty())
+                return make_ready_future();
+
+            std::vector<std::vector<Key> > part_keys;
+            std::vector<std::vector<std::size_t> > part_offsets;
+            gather_keys(keys, part_keys, part_offsets);
+
+            std::vector<future<void> > part_futures;
+            part_futures.reserve(part_keys.size());
+
+            for (std::size_t part = 0; part != part_keys.size(); ++part)
+            {
+                if (part_keys[part].empty())
+                    continue;
+
+                std::vector<T> part_vals;
+                part_vals.reserve(part_offsets[part].size());
+                for (std::size_t offset : part_offsets[part])
+                    part_vals.push_back(vals[offset]);
+
+                part_futures.push_back(
+                    set_values(part, part_keys[part], part_vals));
+            }
+
+            return when_all(part_futures);
+        }
+
         /// Asynchronously compute the size of the unordered_map.
         ///
         /// \return Return the number of elements in the unordered_map
@@ -13,16 +13,25 @@
 #include <hpx/async.hpp>
 #include <hpx/components/iostreams/manipulators.hpp>
 #include <hpx/components/iostreams/server/output_stream.hpp>
+#include <hpx/components/iostreams/worker_buffer.hpp>
 #include <hpx/runtime/components/client_base.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/interval_timer.hpp>
 #include <hpx/util/register_locks.hpp>
 
 #include <boost/atomic.hpp>
 #include <boost/iostreams/stream.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <ios>
 #include <iostream>
 #include <iterator>
+#include <memory>
 #include <mutex>
 #include <sstream>
 #include <string>
@@ -121,6 +130,35 @@ namespace hpx { namespace iostreams
             return "/locality#console/output_stream#consolestream";
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // Guarantees given for the order in which the output generated on
+        // one locality appears on the console.
+        enum output_ordering
+        {
+            // output appears in the order in which it was written
+            ordering_strict = 0,
+            // output written on the same worker thread appears in order
+            ordering_worker = 1,
+            // batches of output are printed as soon as they arrive
+            ordering_none = 2
+        };
+
+        struct ostream_settings
+        {
+            ostream_settings()
+              : ordering_(ordering_strict)
+              , batch_size_(0)
+              , flush_interval_(0)
+            {}
+
+            output_ordering ordering_;
+            std::size_t batch_size_;        // [bytes]
+            std::int64_t flush_interval_;   // [ms], zero disables batching
+        };
+
+        // read the settings from the [hpx.iostreams] configuration section
+        ostream_settings get_ostream_settings();
+
         ///////////////////////////////////////////////////////////////////////
         hpx::future<naming::id_type>
         create_ostream(char const* name, std::ostream& strm);
@@ -166,10 +204,187 @@ namespace hpx { namespace iostreams
         typedef BOOST_IOSTREAMS_BASIC_OSTREAM(Char, stream_traits_type) std_stream_type;
         typedef detail::buffer::mutex_type mutex_type;
 
+        typedef detail::worker_buffer<Char> worker_buffer_type;
+
+        enum send_mode { send_lazy, send_async, send_sync };
+
     private:
         using detail::buffer::mtx_;
         boost::atomic<std::uint64_t> generational_count_;
 
+        // set while a manipulator which sends the output itself is applied
+        bool explicit_flush_;
+
+        detail::ostream_settings settings_;
+        std::vector<std::unique_ptr<worker_buffer_type> > worker_buffers_;
+        detail::pending_lines pending_lines_;
+        std::unique_ptr<util::interval_timer> flush_timer_;
+
+        ///////////////////////////////////////////////////////////////////////
+        // Send all collected output to the destination, the output of the
+        // worker threads is appended to anything written to the shared
+        // buffer. Unlocks the given lock.
+        template <typename Lock>
+        void send_locked(Lock& l, bool sync)
+        {
+            // make sure anything left in the stream reaches the buffer
+            bool explicit_flush = explicit_flush_;
+            explicit_flush_ = true;
+            static_cast<stream_base_type*>(this)->flush();
+            explicit_flush_ = explicit_flush;
+
+            if (!worker_buffers_.empty())
+            {
+                std::vector<char> data;
+                for (auto& wb : worker_buffers_)
+                    wb->collect(data);
+
+                if (!data.empty())
+                    this->detail::buffer::append_locked(data);
+            }
+
+            if (this->detail::buffer::empty_locked())
+            {
+                l.unlock();     // must unlock in any case
+                return;
+            }
+
+            // Create the next buffer, returns the previous buffer
+            buffer next = this->detail::buffer::init_locked();
+
+            // the sequence number has to be drawn while the lock is held to
+            // reflect the order of the buffers
+            std::uint64_t count = detail::order_output::unordered;
+            if (settings_.ordering_ != detail::ordering_none)
+                count = generational_count_++;
+
+            // Unlock the mutex before we cleanup.
+            l.unlock();
+
+            // since mtx_ is recursive and apply will do an AGAS lookup,
+            // we need to ignore the lock here in case we are called
+            // recursively
+            hpx::util::ignore_while_checking<Lock> il(&l);
+
+            // Perform the write operation, then destroy the old buffer and
+            // stream.
+            if (sync)
+            {
+                typedef server::output_stream::write_sync_action action_type;
+                hpx::async<action_type>(this->get_id(),
+                    hpx::get_locality_id(), count, next).get();
+            }
+            else
+            {
+                typedef server::output_stream::write_async_action action_type;
+                hpx::apply<action_type>(this->get_id(),
+                    hpx::get_locality_id(), count, next);
+            }
+        }
+
+        // Send the collected output right away only if batching is disabled
+        // or if enough output has accumulated, leave it to the flush timer
+        // otherwise.
+        template <typename Lock>
+        void send_batched_locked(Lock& l)
+        {
+            if (!flush_timer_ ||
+                this->detail::buffer::size_locked() >= settings_.batch_size_)
+            {
+                send_locked(l, false);
+            }
+            else
+            {
+                l.unlock();
+            }
+        }
+
+        // invoked periodically by the flush timer
+        bool send_pending()
+        {
+            std::unique_lock<mutex_type> l(*mtx_);
+            send_locked(l, false);
+            return true;        // keep the timer running
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Return the buffer of the calling worker thread, claimed for
+        // appending, if per-worker buffers are in use and if called from an
+        // HPX thread. Nested output (written while formatting the subject of
+        // an enclosing streaming operation) goes through the shared buffer.
+        worker_buffer_type* acquire_worker_buffer()
+        {
+            if (worker_buffers_.empty())
+                return nullptr;
+
+            std::size_t num_thread = hpx::get_worker_thread_num();
+            if (num_thread >= worker_buffers_.size() ||
+                threads::get_self_ptr() == nullptr)
+            {
+                return nullptr;         // not an HPX thread
+            }
+
+            worker_buffer_type* wb = worker_buffers_[num_thread].get();
+            if (!wb->try_acquire())
+                return nullptr;         // nested streaming operation
+            return wb;
+        }
+
+        // invoked when an HPX thread which has written a partial line exits
+        void release_pending_line(threads::thread_id_repr_type id)
+        {
+            std::vector<char> data;
+            pending_lines_.take(id, data);
+            if (data.empty())
+                return;
+
+            std::unique_lock<mutex_type> l(*mtx_);
+            this->detail::buffer::append_locked(data);
+            send_batched_locked(l);
+        }
+
+        // Performs a streaming operation on the buffer of the current worker
+        // thread, releases the buffer. Only complete lines are added to the
+        // buffer, the rest is kept as the partial line of the calling HPX
+        // thread (until that thread flushes its output).
+        template <typename T>
+        ostream& streaming_operator_worker(worker_buffer_type& wb,
+            T const& subject, send_mode mode)
+        { // {{{
+            wb.stream() << subject;
+
+            // std::flush and std::endl request the output to be sent
+            if (wb.flush_requested() && mode == send_lazy)
+                mode = send_async;
+
+            threads::thread_id_repr_type id = threads::get_self_id().get();
+            bool created = pending_lines_.add(id, wb.scratch(),
+                mode != send_lazy, wb.lines());
+
+            bool full = wb.size() >= settings_.batch_size_;
+            wb.release();
+
+            // make sure the partial line is not lost if the thread exits
+            if (created)
+            {
+                threads::add_thread_exit_callback(threads::get_self_id(),
+                    util::bind(&ostream::release_pending_line, this, id));
+            }
+
+            if (mode == send_sync ||
+                (mode == send_async && (full || !flush_timer_)))
+            {
+                std::unique_lock<mutex_type> l(*mtx_);
+                send_locked(l, mode == send_sync);
+            }
+            else if (full)
+            {
+                std::unique_lock<mutex_type> l(*mtx_);
+                send_locked(l, false);
+            }
+            return *this;
+        } // }}}
+
         // Performs a lazy streaming operation.
         template <typename T>
         ostream& streaming_operator_lazy(T const& subject)
@@ -183,26 +398,15 @@ namespace hpx { namespace iostreams
         template <typename T, typename Lock>
         ostream& streaming_operator_async(T const& subject, Lock& l)
         { // {{{
-            // apply the subject to the local stream
+            // apply the subject to the local stream, the flush triggered by
+            // the manipulator is handled here
+            explicit_flush_ = true;
             *static_cast<stream_base_type*>(this) << subject;
+            explicit_flush_ = false;
 
             // If the buffer isn't empty, send it asynchronously to the
-            // destination.
-            if (!this->detail::buffer::empty_locked())
-            {
-                // Create the next buffer, returns the previous buffer
-                buffer next = this->detail::buffer::init_locked();
-
-                // Unlock the mutex before we cleanup.
-                l.unlock();
-
-                // Perform the write operation, then destroy the old buffer and
-                // stream.
-                typedef server::output_stream::write_async_action action_type;
-                hpx::apply<action_type>(this->get_id(), hpx::get_locality_id(),
-                    generational_count_++, next);
-            }
-
+            // destination (possibly batched with later output).
+            send_batched_locked(l);
             return *this;
         } // }}}
 
@@ -210,28 +414,14 @@ namespace hpx { namespace iostreams
         template <typename T, typename Lock>
         ostream& streaming_operator_sync(T const& subject, Lock& l)
         { // {{{
-            // apply the subject to the local stream
+            // apply the subject to the local stream, the flush triggered by
+            // the manipulator is handled here
+            explicit_flush_ = true;
             *static_cast<stream_base_type*>(this) << subject;
+            explicit_flush_ = false;
 
             // If the buffer isn't empty, send it to the destination.
-            if (!this->detail::buffer::empty_locked())
-            {
-                // Create the next buffer, returns the previous buffer
-                buffer next = this->detail::buffer::init_locked();
-
-                // Unlock the mutex before we cleanup.
-                l.unlock();
-
-                // Perform the write operation, then destroy the old buffer and
-                // stream.
-                typedef server::output_stream::write_sync_action action_type;
-                hpx::async<action_type>(this->get_id(), hpx::get_locality_id(),
-                    generational_count_++, next).get();
-            }
-            else
-            {
-                l.unlock();     // must unlock in any case
-            }
+            send_locked(l, true);
             return *this;
         } // }}}
 
@@ -241,26 +431,8 @@ namespace hpx { namespace iostreams
         bool flush()
         {
             std::unique_lock<mutex_type> l(*mtx_);
-            if (!this->detail::buffer::empty_locked())
-            {
-                // Create the next buffer, returns the previous buffer
-                buffer next = this->detail::buffer::init_locked();
-
-                // Unlock the mutex before we cleanup.
-                l.unlock();
-
-                // since mtx_ is recursive and apply will do an AGAS lookup,
-                // we need to ignore the lock here in case we are called
-                // recursively
-                hpx::util::ignore_while_checking<std::unique_lock<mutex_type> >
-                    il(&l);
-
-                // Perform the write operation, then destroy the old buffer and
-                // stream.
-                typedef server::output_stream::write_async_action action_type;
-                hpx::apply<action_type>(this->get_id(), hpx::get_locality_id(),
-                    generational_count_++, next);
-            }
+            if (!explicit_flush_)
+                send_batched_locked(l);
             return true;
         }
 
@@ -273,15 +445,45 @@ namespace hpx { namespace iostreams
         void initialize(Tag tag)
         {
             *static_cast<base_type*>(this) = detail::create_ostream(tag);
+
+            settings_ = detail::get_ostream_settings();
+            if (settings_.ordering_ != detail::ordering_strict)
+            {
+                std::size_t num_threads = hpx::get_os_thread_count();
+                worker_buffers_.reserve(num_threads);
+                for (std::size_t i = 0; i != num_threads; ++i)
+                {
+                    worker_buffers_.push_back(
+                        std::unique_ptr<worker_buffer_type>(
+                            new worker_buffer_type));
+                }
+            }
+
+            if (settings_.flush_interval_ != 0)
+            {
+                flush_timer_.reset(new util::interval_timer(
+                    util::bind(&ostream::send_pending, this),
+                    settings_.flush_interval_ * 1000,
+                    detail::get_outstream_name(tag)));
+                flush_timer_->start(false);
+            }
         }
 
         // reset this object during runtime system shutdown
         template <typename Tag>
         void uninitialize(Tag tag)
         {
+            flush_timer_.reset();
+
             std::unique_lock<mutex_type> l(*mtx_, std::try_to_lock);
             if (l)
             {
+                // send partial lines of threads which are still running
+                std::vector<char> data;
+                pending_lines_.take_all(data);
+                if (!data.empty())
+                    this->detail::buffer::append_locked(data);
+
                 streaming_operator_sync(hpx::async_flush, l);   // unlocks
             }
 
@@ -296,11 +498,15 @@ namespace hpx { namespace iostreams
           , buffer()
           , stream_base_type(*this)
           , generational_count_(0)
+          , explicit_flush_(false)
         {}
 
         // hpx::flush manipulator
         ostream& operator<<(hpx::iostreams::flush_type const& m)
         {
+            if (worker_buffer_type* wb = acquire_worker_buffer())
+                return streaming_operator_worker(*wb, m, send_sync);
+
             std::unique_lock<mutex_type> l(*mtx_);
             return streaming_operator_sync(m, l);
         }
@@ -308,6 +514,9 @@ namespace hpx { namespace iostreams
         // hpx::endl manipulator
         ostream& operator<<(hpx::iostreams::endl_type const& m)
         {
+            if (worker_buffer_type* wb = acquire_worker_buffer())
+                return streaming_operator_worker(*wb, m, send_sync);
+
             std::unique_lock<mutex_type> l(*mtx_);
             return streaming_operator_sync(m, l);
         }
@@ -315,6 +524,9 @@ namespace hpx { namespace iostreams
         // hpx::async_flush manipulator
         ostream& operator<<(hpx::iostreams::async_flush_type const& m)
         {
+            if (worker_buffer_type* wb = acquire_worker_buffer())
+                return streaming_operator_worker(*wb, m, send_async);
+
             std::unique_lock<mutex_type> l(*mtx_);
             return streaming_operator_async(m, l);
         }
@@ -322,6 +534,9 @@ namespace hpx { namespace iostreams
         // hpx::async_endl manipulator
         ostream& operator<<(hpx::iostreams::async_endl_type const& m)
         {
+            if (worker_buffer_type* wb = acquire_worker_buffer())
+                return streaming_operator_worker(*wb, m, send_async);
+
             std::unique_lock<mutex_type> l(*mtx_);
             return streaming_operator_async(m, l);
         }
@@ -330,6 +545,9 @@ namespace hpx { namespace iostreams
         template <typename T>
         ostream& operator<<(T const& subject)
         {
+            if (worker_buffer_type* wb = acquire_worker_buffer())
+                return streaming_operator_worker(*wb, subject, send_lazy);
+
             std::lock_guard<mutex_type> l(*mtx_);
             return streaming_operator_lazy(subject);
         }
@@ -337,6 +555,9 @@ namespace hpx { namespace iostreams
         ///////////////////////////////////////////////////////////////////////
         ostream& operator<<(std_stream_type& (*manip_fun)(std_stream_type&))
         {
+            if (worker_buffer_type* wb = acquire_worker_buffer())
+                return streaming_operator_worker(*wb, manip_fun, send_lazy);
+
             std::unique_lock<mutex_type> l(*mtx_);
             util::ignore_while_checking<std::unique_lock<mutex_type> > ignore(&l);
             return streaming_operator_lazy(manip_fun);
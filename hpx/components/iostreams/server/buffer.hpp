@@ -15,6 +15,7 @@
 
 #include <boost/swap.hpp>
 
+#include <cstddef>
 #include <iosfwd>
 #include <memory>
 #include <mutex>
@@ -75,6 +76,11 @@ namespace hpx { namespace iostreams { namespace detail
             return !data_.get() || data_->empty();
         }
 
+        std::size_t size_locked() const
+        {
+            return data_.get() ? data_->size() : 0;
+        }
+
         buffer init()
         {
             std::lock_guard<mutex_type> l(*mtx_);
@@ -96,6 +102,23 @@ namespace hpx { namespace iostreams { namespace detail
             return n;
         }
 
+        // Move the given data to the end of this buffer.
+        void append_locked(std::vector<char>& data)
+        {
+            if (!data_.get())
+                data_.reset(new std::vector<char>);
+
+            if (data_->empty())
+            {
+                data_->swap(data);
+            }
+            else
+            {
+                data_->insert(data_->end(), data.begin(), data.end());
+                data.clear();
+            }
+        }
+
         template <typename Mutex>
         void write(write_function_type const& f, Mutex& mtx)
         {
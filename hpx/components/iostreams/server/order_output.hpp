@@ -7,64 +7,131 @@
 #define HPX_IOSTREAMS_SERVER_ORDER_OUTPUT_JUL_18_2014_0711PM
 
 #include <hpx/config.hpp>
+#include <hpx/util/assert.hpp>
 #include <hpx/util/unlock_guard.hpp>
 
 #include <hpx/components/iostreams/server/buffer.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <mutex>
 #include <utility>
+#include <vector>
 
 namespace hpx { namespace iostreams { namespace detail
 {
+    ///////////////////////////////////////////////////////////////////////////
+    // Buffers received out of order from one locality, stored in a ring of
+    // slots indexed by their sequence number. The ring grows whenever a
+    // buffer arrives which is too far ahead of the next expected one.
+    class sequence_ring
+    {
+        typedef std::pair<bool, buffer> slot_type;
+
+    public:
+        sequence_ring()
+          : next_(0)
+        {}
+
+        // sequence number of the next buffer to print
+        std::uint64_t next() const
+        {
+            return next_;
+        }
+
+        void store(std::uint64_t count, buffer const& in)
+        {
+            HPX_ASSERT(count > next_);
+            std::uint64_t distance = count - next_;
+            if (distance >= slots_.size())
+                grow(distance + 1);
+
+            slot_type& slot = slots_[count & (slots_.size() - 1)];
+            HPX_ASSERT(!slot.first);
+            slot.first = true;
+            slot.second = in;
+        }
+
+        // Advance to the next sequence number, returns true and the buffer
+        // stored for it if it is available.
+        bool advance(buffer& out)
+        {
+            ++next_;
+            if (slots_.empty())
+                return false;
+
+            slot_type& slot = slots_[next_ & (slots_.size() - 1)];
+            if (!slot.first)
+                return false;
+
+            slot.first = false;
+            out = std::move(slot.second);
+            return true;
+        }
+
+    private:
+        void grow(std::uint64_t min_size)
+        {
+            std::size_t size = slots_.empty() ? 64 : slots_.size();
+            while (size < min_size)
+                size *= 2;
+
+            // move all pending buffers to their new position
+            std::vector<slot_type> slots(size);
+            for (std::size_t i = 0; i != slots_.size(); ++i)
+            {
+                std::uint64_t count = next_ + i;
+                slot_type& slot = slots_[count & (slots_.size() - 1)];
+                if (slot.first)
+                    slots[count & (size - 1)] = std::move(slot);
+            }
+            slots_.swap(slots);
+        }
+
+    private:
+        std::uint64_t next_;
+        std::vector<slot_type> slots_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
     struct order_output
     {
-        typedef std::map<std::uint64_t, buffer> output_data_type;
-        typedef std::pair<std::uint64_t, output_data_type> data_type;
-        typedef std::map<std::uint32_t, data_type> output_data_map_type;
+        typedef std::map<std::uint32_t, sequence_ring> output_data_map_type;
+
+        // buffers sent with this sequence number are printed on arrival
+        static constexpr std::uint64_t unordered = std::uint64_t(-1);
 
         template <typename F, typename Mutex>
         void output(std::uint32_t locality_id, std::uint64_t count,
             detail::buffer const& buf_in, F const& write_f, Mutex& mtx)
         {
             detail::buffer in(buf_in);
+            if (count == unordered)
+            {
+                in.write(write_f, mtx);
+                return;
+            }
+
             std::unique_lock<Mutex> l(mtx);
-            data_type& data = output_data_map_[locality_id]; //-V108
+            sequence_ring& data = output_data_map_[locality_id]; //-V108
 
-            if (count == data.first)
+            if (count == data.next())
             {
-                // this is the next expected output line
-                if (!in.empty())
+                // this is the next expected output line, print it and all
+                // consecutive pending buffers
+                do
                 {
-                    // output the line as requested
-                    util::unlock_guard<std::unique_lock<Mutex> > ul(l);
-                    in.write(write_f, mtx);
-                }
-                ++data.first;
-
-                // print all consecutive pending buffers
-                output_data_type::iterator next = data.second.find(++count);
-                while (next != data.second.end())
-                {
-                    buffer next_in = (*next).second;
-                    if (!next_in.empty())
+                    if (!in.empty())
                     {
-                        // output the next line
                         util::unlock_guard<std::unique_lock<Mutex> > ul(l);
-                        next_in.write(write_f, mtx);
+                        in.write(write_f, mtx);
                     }
-                    data.second.erase(next);
-
-                    // find next entry in map
-                    ++data.first;
-                    next = data.second.find(++count);
-                }
+                } while (data.advance(in));
             }
             else
             {
-                HPX_ASSERT(count > data.first);
-                data.second.insert(output_data_type::value_type(count, in));
+                data.store(count, in);
             }
         }
 
@@ -74,5 +141,3 @@ namespace hpx { namespace iostreams { namespace detail
 }}}
 
 #endif
-
-
@@ -0,0 +1,322 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_IOSTREAMS_WORKER_BUFFER_APR_04_2017_0212PM)
+#define HPX_IOSTREAMS_WORKER_BUFFER_APR_04_2017_0212PM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ios>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+namespace hpx { namespace iostreams { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Unbuffered stream buffer appending all output directly to a vector. A
+    // request to synchronize the stream (std::flush, std::endl) is recorded
+    // only, the owner decides when to ship the collected data.
+    template <typename Char>
+    class worker_streambuf : public std::basic_streambuf<Char>
+    {
+        typedef std::basic_streambuf<Char> base_type;
+        typedef typename base_type::int_type int_type;
+        typedef typename base_type::traits_type traits_type;
+
+    public:
+        worker_streambuf()
+          : flush_requested_(false)
+        {}
+
+        std::vector<char>& data() { return data_; }
+        std::vector<char> const& data() const { return data_; }
+
+        bool flush_requested()
+        {
+            bool result = flush_requested_;
+            flush_requested_ = false;
+            return result;
+        }
+
+    protected:
+        std::streamsize xsputn(Char const* s, std::streamsize n)
+        {
+            data_.insert(data_.end(), s, s + n);
+            return n;
+        }
+
+        int_type overflow(int_type c)
+        {
+            if (!traits_type::eq_int_type(c, traits_type::eof()))
+                data_.push_back(traits_type::to_char_type(c));
+            return traits_type::not_eof(c);
+        }
+
+        int sync()
+        {
+            flush_requested_ = true;
+            return 0;
+        }
+
+    private:
+        std::vector<char> data_;
+        bool flush_requested_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Output buffer owned by a single worker thread, holding complete lines
+    // only. Appending to it does not require any lock, the slot is claimed by
+    // a single atomic operation. The output of a streaming operation is
+    // formatted into a separate scratch buffer first, nothing in between
+    // claiming and releasing the slot suspends.
+    template <typename Char>
+    class worker_buffer
+    {
+    public:
+        HPX_NON_COPYABLE(worker_buffer);
+
+    private:
+        enum state { idle = 0, writing = 1, collecting = 2 };
+
+    public:
+        worker_buffer()
+          : state_(idle)
+          , stream_(&buf_)
+        {}
+
+        // Claim this buffer for appending, may be called only from the
+        // owning worker thread. Returns false if the buffer is already
+        // claimed by this worker, i.e. if the output is written from inside
+        // a streaming operation (a user defined operator<< writing to the
+        // same stream).
+        bool try_acquire()
+        {
+            int expected = idle;
+            while (!state_.compare_exchange_weak(expected, writing,
+                boost::memory_order_acquire))
+            {
+                if (expected == writing)
+                    return false;
+
+                // collecting the data never suspends, wait for it to finish
+                expected = idle;
+            }
+            return true;
+        }
+
+        void release()
+        {
+            state_.store(idle, boost::memory_order_release);
+        }
+
+        // The following may be called only while the buffer is acquired.
+
+        // the stream to format the output into, and the formatted output
+        std::basic_ostream<Char>& stream() { return stream_; }
+        std::vector<char>& scratch() { return buf_.data(); }
+        bool flush_requested() { return buf_.flush_requested(); }
+
+        // the complete lines to be sent
+        std::vector<char>& lines() { return lines_; }
+        std::size_t size() const { return lines_.size(); }
+
+        // Move the collected data to the end of the given vector. The data is
+        // left in place if it is currently being appended to.
+        void collect(std::vector<char>& data)
+        {
+            int expected = idle;
+            if (!state_.compare_exchange_strong(expected, collecting,
+                    boost::memory_order_acquire))
+            {
+                return;
+            }
+
+            std::vector<char>& d = lines_;
+            if (data.empty())
+            {
+                d.swap(data);
+            }
+            else
+            {
+                data.insert(data.end(), d.begin(), d.end());
+                d.clear();
+            }
+
+            state_.store(idle, boost::memory_order_release);
+        }
+
+    private:
+        boost::atomic<int> state_;
+        worker_streambuf<Char> buf_;
+        std::basic_ostream<Char> stream_;
+        std::vector<char> lines_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Partial lines written by HPX threads, kept per HPX thread until the
+    // line is complete. A line is never mixed with the output of other HPX
+    // threads this way, even if the thread writing it gets suspended or
+    // continues on another worker thread. The entries are spread over
+    // independently locked shards based on the id of the writing thread.
+    class pending_lines
+    {
+    public:
+        HPX_NON_COPYABLE(pending_lines);
+
+    private:
+        typedef lcos::local::spinlock mutex_type;
+
+        struct entry
+        {
+            threads::thread_id_repr_type id_;
+            std::vector<char> data_;
+        };
+
+        struct shard
+        {
+            shard() : size_(0) {}
+
+            mutex_type mtx_;
+            boost::atomic<std::size_t> size_;
+            std::vector<entry> entries_;
+        };
+
+        enum { num_shards = 64 };
+
+    public:
+        pending_lines()
+          : shards_(new shard[num_shards])
+        {}
+
+        // Add the output of the given thread to its partial line, all
+        // complete lines are moved to 'lines' (and the partial line as well
+        // if 'flush' is set). Returns true if an entry was created for the
+        // thread, the entry is kept until it is removed by take().
+        bool add(threads::thread_id_repr_type id, std::vector<char>& output,
+            bool flush, std::vector<char>& lines)
+        {
+            // the part of the output up to (and including) the last newline
+            std::vector<char>::iterator last = flush ? output.end() :
+                std::find(output.rbegin(), output.rend(), '\n').base();
+
+            shard& s = get_shard(id);
+
+            // only the calling thread creates an entry for itself
+            if (last == output.end() &&
+                s.size_.load(boost::memory_order_acquire) == 0)
+            {
+                lines.insert(lines.end(), output.begin(), output.end());
+                output.clear();
+                return false;
+            }
+
+            bool created = false;
+            {
+                std::lock_guard<mutex_type> l(s.mtx_);
+
+                entry* e = find(s, id);
+                if (e == nullptr)
+                {
+                    if (last == output.end())
+                    {
+                        lines.insert(lines.end(), output.begin(), last);
+                        output.clear();
+                        return false;
+                    }
+
+                    entry new_entry = { id, std::vector<char>() };
+                    s.entries_.push_back(std::move(new_entry));
+                    ++s.size_;
+
+                    e = &s.entries_.back();
+                    created = true;
+                }
+
+                if (flush || last != output.begin())
+                {
+                    lines.insert(lines.end(), e->data_.begin(), e->data_.end());
+                    lines.insert(lines.end(), output.begin(), last);
+                    e->data_.clear();
+                }
+                e->data_.insert(e->data_.end(), last, output.end());
+            }
+
+            output.clear();
+            return created;
+        }
+
+        // Remove the entry of the given thread, its partial line is
+        // appended to 'lines'.
+        void take(threads::thread_id_repr_type id, std::vector<char>& lines)
+        {
+            shard& s = get_shard(id);
+
+            std::lock_guard<mutex_type> l(s.mtx_);
+            for (std::size_t i = 0; i != s.entries_.size(); ++i)
+            {
+                if (s.entries_[i].id_ == id)
+                {
+                    std::vector<char>& data = s.entries_[i].data_;
+                    lines.insert(lines.end(), data.begin(), data.end());
+
+                    if (i != s.entries_.size() - 1)
+                        s.entries_[i] = std::move(s.entries_.back());
+                    s.entries_.pop_back();
+                    --s.size_;
+                    return;
+                }
+            }
+        }
+
+        // Remove all entries, their partial lines are appended to 'lines'.
+        void take_all(std::vector<char>& lines)
+        {
+            for (std::size_t i = 0; i != num_shards; ++i)
+            {
+                shard& s = shards_[i];
+
+                std::lock_guard<mutex_type> l(s.mtx_);
+                for (entry& e : s.entries_)
+                    lines.insert(lines.end(), e.data_.begin(), e.data_.end());
+
+                s.entries_.clear();
+                s.size_.store(0);
+            }
+        }
+
+    private:
+        shard& get_shard(threads::thread_id_repr_type id)
+        {
+            // thread ids are addresses of (over-aligned) thread objects
+            std::size_t hash = reinterpret_cast<std::size_t>(id) >> 6;
+            return shards_[hash % num_shards];
+        }
+
+        static entry* find(shard& s, threads::thread_id_repr_type id)
+        {
+            for (entry& e : s.entries_)
+            {
+                if (e.id_ == id)
+                    return &e;
+            }
+            return nullptr;
+        }
+
+        std::unique_ptr<shard[]> shards_;
+    };
+}}}
+
+#endif
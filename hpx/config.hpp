@@ -179,6 +179,26 @@
 #  define HPX_AGAS_LOCAL_CACHE_SIZE 4096
 #endif
 
+///////////////////////////////////////////////////////////////////////////////
+/// This defines the number of shards the GVA and reference count tables of
+/// the AGAS primary namespace are split into. Must be a power of two.
+#if !defined(HPX_AGAS_PRIMARY_NAMESPACE_SHARDS)
+#  define HPX_AGAS_PRIMARY_NAMESPACE_SHARDS 64
+#endif
+
+/// This defines the log2 of the number of consecutive gids assigned to the
+/// same shard of the AGAS primary namespace tables. The default matches the
+/// number of gids a component heap binds at once.
+#if !defined(HPX_AGAS_PRIMARY_NAMESPACE_SHARD_SHIFT)
+#  define HPX_AGAS_PRIMARY_NAMESPACE_SHARD_SHIFT 16
+#endif
+
+/// This defines the number of resolved ranges cached per shard of the AGAS
+/// primary namespace for lookups without locking. Must be a power of two.
+#if !defined(HPX_AGAS_PRIMARY_NAMESPACE_CACHE_SIZE)
+#  define HPX_AGAS_PRIMARY_NAMESPACE_CACHE_SIZE 32
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 #if !defined(HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS)
 #  define HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS 4096
@@ -386,6 +406,17 @@
 #  define HPX_WRAPPER_HEAP_STEP 0xFFFFU
 #endif
 
+// Number of wrapper heap slots each worker thread takes (and returns) at
+// once, zero disables the per-worker caches. The caches are disabled while
+// debugging the wrapper heaps as those check each freed object separately.
+#if !defined(HPX_WRAPPER_HEAP_CACHE_SIZE)
+#  if defined(HPX_DEBUG_WRAPPER_HEAP) && HPX_DEBUG_WRAPPER_HEAP != 0
+#    define HPX_WRAPPER_HEAP_CACHE_SIZE 0
+#  else
+#    define HPX_WRAPPER_HEAP_CACHE_SIZE 64
+#  endif
+#endif
+
 #if !defined(HPX_INITIAL_GID_RANGE)
 #  define HPX_INITIAL_GID_RANGE 0xFFFFU
 #endif
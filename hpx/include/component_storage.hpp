@@ -9,5 +9,6 @@
 #include <hpx/components/component_storage/component_storage.hpp>
 #include <hpx/components/component_storage/migrate_from_storage.hpp>
 #include <hpx/components/component_storage/migrate_to_storage.hpp>
+#include <hpx/components/component_storage/snapshot.hpp>
 
 #endif
@@ -15,6 +15,9 @@
 
 #include <hpx/lcos/packaged_action.hpp>
 
+#include <hpx/lcos/all_gather.hpp>
+#include <hpx/lcos/all_reduce.hpp>
+#include <hpx/lcos/all_to_all.hpp>
 #include <hpx/lcos/barrier.hpp>
 #include <hpx/lcos/channel.hpp>
 #include <hpx/lcos/gather.hpp>
@@ -8,5 +8,6 @@
 
 #include <hpx/parallel/algorithms/remove_copy.hpp>
 #include <hpx/parallel/container_algorithms/remove_copy.hpp>
+#include <hpx/parallel/segmented_algorithms/remove_copy.hpp>
 
 #endif
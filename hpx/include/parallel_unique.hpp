@@ -8,6 +8,7 @@
 
 #include <hpx/parallel/algorithms/unique.hpp>
 #include <hpx/parallel/container_algorithms/unique.hpp>
+#include <hpx/parallel/segmented_algorithms/unique.hpp>
 
 #endif
 
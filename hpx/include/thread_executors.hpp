@@ -7,6 +7,7 @@
 #define HPX_THREAD_EXECUTORS_JAN_13_2013_0257PM
 
 #include <hpx/runtime/threads/executors/current_executor.hpp>
+#include <hpx/runtime/threads/executors/deadline_executor.hpp>
 #include <hpx/runtime/threads/executors/default_executor.hpp>
 #include <hpx/runtime/threads/executors/service_executors.hpp>
 #include <hpx/runtime/threads/executors/thread_pool_executors.hpp>
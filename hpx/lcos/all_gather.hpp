@@ -0,0 +1,148 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file all_gather.hpp
+
+#if !defined(HPX_LCOS_ALL_GATHER_MAR_14_2017_1104AM)
+#define HPX_LCOS_ALL_GATHER_MAR_14_2017_1104AM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/all_reduce.hpp>
+#include <hpx/lcos/async.hpp>
+#include <hpx/lcos/detail/communicator.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/runtime/get_num_localities.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/detail/pp/cat.hpp>
+#include <hpx/util/detail/pp/expand.hpp>
+#include <hpx/util/detail/pp/nargs.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        struct all_gather_tag {};
+
+        struct concatenate
+        {
+            template <typename T>
+            std::vector<T> operator()(std::vector<T> lhs,
+                std::vector<T> rhs) const
+            {
+                lhs.reserve(lhs.size() + rhs.size());
+                std::move(rhs.begin(), rhs.end(), std::back_inserter(lhs));
+                return lhs;
+            }
+        };
+
+        // all_gather is an all_reduce concatenating the values of all sites,
+        // which doubles the number of values exchanged in each step.
+        template <typename T>
+        std::vector<T> all_gather(std::string const& basename,
+            std::size_t num_sites, std::size_t generation,
+            std::size_t this_site, T value)
+        {
+            communicator<std::vector<T>, all_gather_tag> comm(
+                basename, num_sites, generation, this_site);
+
+            std::vector<T> data;
+            data.reserve(num_sites);
+            data.push_back(std::move(value));
+
+            return all_reduce_data(comm, std::move(data), concatenate());
+        }
+    }
+
+    /// Gather the values of all call sites on each of them
+    ///
+    /// \param  basename    The base name identifying the all_gather operation
+    /// \param  local_result The value contributed by this call site.
+    /// \param  num_sites   The number of participating sites (default: all
+    ///                     localities).
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the all_gather operation performed on the
+    ///                     given base name. This needs to be supplied if the
+    ///                     operation on the given base name is performed more
+    ///                     than once.
+    /// \param this_site    The sequence number of this invocation (usually
+    ///                     the locality id). This value is optional and
+    ///                     defaults to whatever hpx::get_locality_id() returns.
+    ///
+    /// \note       Each all_gather operation has to be accompanied with a
+    ///             unique usage of the \a HPX_REGISTER_ALL_GATHER macro.
+    ///
+    /// \returns    This function returns a future holding a vector with the
+    ///             values of all sites, ordered by site.
+    ///
+    template <typename T>
+    hpx::future<std::vector<typename util::decay<T>::type> >
+    all_gather(char const* basename, T && local_result,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1))
+    {
+        if (num_sites == std::size_t(-1))
+            num_sites = hpx::get_num_localities(hpx::launch::sync);
+        if (this_site == std::size_t(-1))
+            this_site = static_cast<std::size_t>(hpx::get_locality_id());
+
+        typedef typename util::decay<T>::type result_type;
+
+        return hpx::async(&detail::all_gather<result_type>,
+            std::string(basename), num_sites, generation, this_site,
+            std::forward<T>(local_result));
+    }
+}}
+
+///////////////////////////////////////////////////////////////////////////////
+#define HPX_REGISTER_ALL_GATHER_DECLARATION(...)                              \
+    HPX_REGISTER_ALL_GATHER_DECLARATION_(__VA_ARGS__)                         \
+    /**/
+
+#define HPX_REGISTER_ALL_GATHER_DECLARATION_(...)                             \
+    HPX_PP_EXPAND(HPX_PP_CAT(                                                 \
+        HPX_REGISTER_ALL_GATHER_DECLARATION_, HPX_PP_NARGS(__VA_ARGS__)       \
+    )(__VA_ARGS__))                                                           \
+    /**/
+
+#define HPX_REGISTER_ALL_GATHER_DECLARATION_1(type)                           \
+    HPX_REGISTER_ALL_GATHER_DECLARATION_2(type, HPX_PP_CAT(type, _all_gather))\
+    /**/
+
+#define HPX_REGISTER_ALL_GATHER_DECLARATION_2(type, name)                     \
+    HPX_REGISTER_COMMUNICATOR_DECLARATION_(std::vector<type>,                 \
+        hpx::lcos::detail::all_gather_tag, name)                              \
+    /**/
+
+///////////////////////////////////////////////////////////////////////////////
+#define HPX_REGISTER_ALL_GATHER(...)                                          \
+    HPX_REGISTER_ALL_GATHER_(__VA_ARGS__)                                     \
+    /**/
+
+#define HPX_REGISTER_ALL_GATHER_(...)                                         \
+    HPX_PP_EXPAND(HPX_PP_CAT(                                                 \
+        HPX_REGISTER_ALL_GATHER_, HPX_PP_NARGS(__VA_ARGS__)                   \
+    )(__VA_ARGS__))                                                           \
+    /**/
+
+#define HPX_REGISTER_ALL_GATHER_1(type)                                       \
+    HPX_REGISTER_ALL_GATHER_2(type, HPX_PP_CAT(type, _all_gather))            \
+    /**/
+
+#define HPX_REGISTER_ALL_GATHER_2(type, name)                                 \
+    HPX_REGISTER_COMMUNICATOR_(std::vector<type>,                             \
+        hpx::lcos::detail::all_gather_tag, name)                              \
+    /**/
+
+#endif
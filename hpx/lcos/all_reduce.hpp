@@ -0,0 +1,198 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file all_reduce.hpp
+
+#if !defined(HPX_LCOS_ALL_REDUCE_MAR_14_2017_1012AM)
+#define HPX_LCOS_ALL_REDUCE_MAR_14_2017_1012AM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/async.hpp>
+#include <hpx/lcos/detail/communicator.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/runtime/get_num_localities.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/detail/pp/cat.hpp>
+#include <hpx/util/detail/pp/expand.hpp>
+#include <hpx/util/detail/pp/nargs.hpp>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        struct all_reduce_tag {};
+
+        ///////////////////////////////////////////////////////////////////////
+        // Recursive doubling: in step k every site exchanges its partial
+        // result with the site whose (virtual) index differs in bit k. For a
+        // number of sites which is not a power of two, the first 2*rem sites
+        // are pairwise combined beforehand and receive the final result
+        // afterwards. Partial results are always combined in site order, so
+        // op has to be associative, but not necessarily commutative.
+        template <typename T, typename Tag, typename F>
+        T all_reduce_data(communicator<T, Tag>& comm, T value, F const& op)
+        {
+            std::size_t const num_sites = comm.num_sites();
+            std::size_t const site = comm.this_site();
+
+            std::size_t pof2 = 1;
+            std::size_t num_steps = 0;
+            while (2 * pof2 <= num_sites)
+            {
+                pof2 *= 2;
+                ++num_steps;
+            }
+            std::size_t const rem = num_sites - pof2;
+
+            std::size_t vsite = std::size_t(-1);
+            if (site < 2 * rem)
+            {
+                if (site % 2 == 0)
+                {
+                    comm.send(site + 1, 0, std::move(value));
+                }
+                else
+                {
+                    value = op(comm.receive(0).get(), std::move(value));
+                    vsite = site / 2;
+                }
+            }
+            else
+            {
+                vsite = site - rem;
+            }
+
+            if (vsite != std::size_t(-1))
+            {
+                std::size_t step = 1;
+                for (std::size_t mask = 1; mask < pof2; mask *= 2, ++step)
+                {
+                    std::size_t vpartner = vsite ^ mask;
+                    std::size_t partner = vpartner < rem ?
+                        2 * vpartner + 1 : vpartner + rem;
+
+                    comm.send(partner, step, value);
+
+                    T other = comm.receive(step).get();
+                    if (vpartner < vsite)
+                        value = op(std::move(other), std::move(value));
+                    else
+                        value = op(std::move(value), std::move(other));
+                }
+            }
+
+            if (site < 2 * rem)
+            {
+                if (site % 2 == 0)
+                    value = comm.receive(num_steps + 1).get();
+                else
+                    comm.send(site - 1, num_steps + 1, value);
+            }
+
+            comm.flush();
+            return value;
+        }
+
+        template <typename T, typename F>
+        T all_reduce(std::string const& basename, std::size_t num_sites,
+            std::size_t generation, std::size_t this_site, T value, F op)
+        {
+            communicator<T, all_reduce_tag> comm(
+                basename, num_sites, generation, this_site);
+            return all_reduce_data(comm, std::move(value), op);
+        }
+    }
+
+    /// Combine the values of all call sites and make the result available
+    /// on each of them
+    ///
+    /// \param  basename    The base name identifying the all_reduce operation
+    /// \param  local_result The value contributed by this call site.
+    /// \param  op          The (associative) binary operation used to combine
+    ///                     the contributed values. Values are combined in the
+    ///                     order of the sites they originate from.
+    /// \param  num_sites   The number of participating sites (default: all
+    ///                     localities).
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the all_reduce operation performed on the
+    ///                     given base name. This needs to be supplied if the
+    ///                     operation on the given base name is performed more
+    ///                     than once.
+    /// \param this_site    The sequence number of this invocation (usually
+    ///                     the locality id). This value is optional and
+    ///                     defaults to whatever hpx::get_locality_id() returns.
+    ///
+    /// \note       Each all_reduce operation has to be accompanied with a
+    ///             unique usage of the \a HPX_REGISTER_ALL_REDUCE macro.
+    ///
+    /// \returns    This function returns a future holding the combined value.
+    ///
+    template <typename T, typename F>
+    hpx::future<typename util::decay<T>::type>
+    all_reduce(char const* basename, T && local_result, F && op,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1))
+    {
+        if (num_sites == std::size_t(-1))
+            num_sites = hpx::get_num_localities(hpx::launch::sync);
+        if (this_site == std::size_t(-1))
+            this_site = static_cast<std::size_t>(hpx::get_locality_id());
+
+        typedef typename util::decay<T>::type result_type;
+        typedef typename util::decay<F>::type op_type;
+
+        return hpx::async(&detail::all_reduce<result_type, op_type>,
+            std::string(basename), num_sites, generation, this_site,
+            std::forward<T>(local_result), std::forward<F>(op));
+    }
+}}
+
+///////////////////////////////////////////////////////////////////////////////
+#define HPX_REGISTER_ALL_REDUCE_DECLARATION(...)                              \
+    HPX_REGISTER_ALL_REDUCE_DECLARATION_(__VA_ARGS__)                         \
+    /**/
+
+#define HPX_REGISTER_ALL_REDUCE_DECLARATION_(...)                             \
+    HPX_PP_EXPAND(HPX_PP_CAT(                                                 \
+        HPX_REGISTER_ALL_REDUCE_DECLARATION_, HPX_PP_NARGS(__VA_ARGS__)       \
+    )(__VA_ARGS__))                                                           \
+    /**/
+
+#define HPX_REGISTER_ALL_REDUCE_DECLARATION_1(type)                           \
+    HPX_REGISTER_ALL_REDUCE_DECLARATION_2(type, HPX_PP_CAT(type, _all_reduce))\
+    /**/
+
+#define HPX_REGISTER_ALL_REDUCE_DECLARATION_2(type, name)                     \
+    HPX_REGISTER_COMMUNICATOR_DECLARATION_(type,                              \
+        hpx::lcos::detail::all_reduce_tag, name)                              \
+    /**/
+
+///////////////////////////////////////////////////////////////////////////////
+#define HPX_REGISTER_ALL_REDUCE(...)                                          \
+    HPX_REGISTER_ALL_REDUCE_(__VA_ARGS__)                                     \
+    /**/
+
+#define HPX_REGISTER_ALL_REDUCE_(...)                                         \
+    HPX_PP_EXPAND(HPX_PP_CAT(                                                 \
+        HPX_REGISTER_ALL_REDUCE_, HPX_PP_NARGS(__VA_ARGS__)                   \
+    )(__VA_ARGS__))                                                           \
+    /**/
+
+#define HPX_REGISTER_ALL_REDUCE_1(type)                                       \
+    HPX_REGISTER_ALL_REDUCE_2(type, HPX_PP_CAT(type, _all_reduce))            \
+    /**/
+
+#define HPX_REGISTER_ALL_REDUCE_2(type, name)                                 \
+    HPX_REGISTER_COMMUNICATOR_(type, hpx::lcos::detail::all_reduce_tag, name) \
+    /**/
+
+#endif
@@ -0,0 +1,148 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file all_to_all.hpp
+
+#if !defined(HPX_LCOS_ALL_TO_ALL_MAR_14_2017_1132AM)
+#define HPX_LCOS_ALL_TO_ALL_MAR_14_2017_1132AM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/async.hpp>
+#include <hpx/lcos/detail/communicator.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/runtime/get_num_localities.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/detail/pp/cat.hpp>
+#include <hpx/util/detail/pp/expand.hpp>
+#include <hpx/util/detail/pp/nargs.hpp>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        struct all_to_all_tag {};
+
+        // Every site sends one value directly to each other site, tagged with
+        // its own site number. Site i starts with site i+1, which spreads the
+        // load evenly instead of having all sites target site 0 first.
+        template <typename T>
+        std::vector<T> all_to_all(std::string const& basename,
+            std::size_t num_sites, std::size_t generation,
+            std::size_t this_site, std::vector<T> values)
+        {
+            if (values.size() != num_sites)
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "hpx::lcos::all_to_all",
+                    "the number of values must match the number of sites");
+            }
+
+            communicator<T, all_to_all_tag> comm(
+                basename, num_sites, generation, this_site);
+
+            for (std::size_t i = 1; i != num_sites; ++i)
+            {
+                std::size_t site = (this_site + i) % num_sites;
+                comm.send(site, this_site, std::move(values[site]));
+            }
+
+            for (std::size_t i = 1; i != num_sites; ++i)
+            {
+                std::size_t site = (this_site + num_sites - i) % num_sites;
+                values[site] = comm.receive(site).get();
+            }
+
+            comm.flush();
+            return values;
+        }
+    }
+
+    /// Exchange one value between each pair of call sites
+    ///
+    /// \param  basename    The base name identifying the all_to_all operation
+    /// \param  local_result The values contributed by this call site, the
+    ///                     value at index i is sent to site i.
+    /// \param  num_sites   The number of participating sites (default: all
+    ///                     localities).
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the all_to_all operation performed on the
+    ///                     given base name. This needs to be supplied if the
+    ///                     operation on the given base name is performed more
+    ///                     than once.
+    /// \param this_site    The sequence number of this invocation (usually
+    ///                     the locality id). This value is optional and
+    ///                     defaults to whatever hpx::get_locality_id() returns.
+    ///
+    /// \note       Each all_to_all operation has to be accompanied with a
+    ///             unique usage of the \a HPX_REGISTER_ALL_TO_ALL macro.
+    ///
+    /// \returns    This function returns a future holding a vector where the
+    ///             value at index i was received from site i.
+    ///
+    template <typename T>
+    hpx::future<std::vector<T> >
+    all_to_all(char const* basename, std::vector<T> local_result,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1))
+    {
+        if (num_sites == std::size_t(-1))
+            num_sites = hpx::get_num_localities(hpx::launch::sync);
+        if (this_site == std::size_t(-1))
+            this_site = static_cast<std::size_t>(hpx::get_locality_id());
+
+        return hpx::async(&detail::all_to_all<T>,
+            std::string(basename), num_sites, generation, this_site,
+            std::move(local_result));
+    }
+}}
+
+///////////////////////////////////////////////////////////////////////////////
+#define HPX_REGISTER_ALL_TO_ALL_DECLARATION(...)                              \
+    HPX_REGISTER_ALL_TO_ALL_DECLARATION_(__VA_ARGS__)                         \
+    /**/
+
+#define HPX_REGISTER_ALL_TO_ALL_DECLARATION_(...)                             \
+    HPX_PP_EXPAND(HPX_PP_CAT(                                                 \
+        HPX_REGISTER_ALL_TO_ALL_DECLARATION_, HPX_PP_NARGS(__VA_ARGS__)       \
+    )(__VA_ARGS__))                                                           \
+    /**/
+
+#define HPX_REGISTER_ALL_TO_ALL_DECLARATION_1(type)                           \
+    HPX_REGISTER_ALL_TO_ALL_DECLARATION_2(type, HPX_PP_CAT(type, _all_to_all))\
+    /**/
+
+#define HPX_REGISTER_ALL_TO_ALL_DECLARATION_2(type, name)                     \
+    HPX_REGISTER_COMMUNICATOR_DECLARATION_(type,                              \
+        hpx::lcos::detail::all_to_all_tag, name)                              \
+    /**/
+
+///////////////////////////////////////////////////////////////////////////////
+#define HPX_REGISTER_ALL_TO_ALL(...)                                          \
+    HPX_REGISTER_ALL_TO_ALL_(__VA_ARGS__)                                     \
+    /**/
+
+#define HPX_REGISTER_ALL_TO_ALL_(...)                                         \
+    HPX_PP_EXPAND(HPX_PP_CAT(                                                 \
+        HPX_REGISTER_ALL_TO_ALL_, HPX_PP_NARGS(__VA_ARGS__)                   \
+    )(__VA_ARGS__))                                                           \
+    /**/
+
+#define HPX_REGISTER_ALL_TO_ALL_1(type)                                       \
+    HPX_REGISTER_ALL_TO_ALL_2(type, HPX_PP_CAT(type, _all_to_all))            \
+    /**/
+
+#define HPX_REGISTER_ALL_TO_ALL_2(type, name)                                 \
+    HPX_REGISTER_COMMUNICATOR_(type, hpx::lcos::detail::all_to_all_tag, name) \
+    /**/
+
+#endif
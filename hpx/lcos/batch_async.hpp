@@ -0,0 +1,471 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file batch_async.hpp
+
+#if defined(DOXYGEN)
+namespace hpx { namespace lcos
+{
+    /// \brief Invoke an action on many targets, sending one parcel per
+    ///        locality
+    ///
+    /// The function hpx::lcos::batch_async invokes the given action once for
+    /// each of the given global identifiers. The action can be either a
+    /// plain action (in which case the global identifiers have to refer to
+    /// localities) or a component action (in which case the global
+    /// identifiers have to refer to instances of a component type which
+    /// exposes the action).
+    ///
+    /// The targets are grouped by the locality they currently live on, as
+    /// known from the local AGAS cache. Targets missing from the cache are
+    /// grouped by the locality managing their global identifier, which
+    /// resolves them and forwards the invocations if necessary. All
+    /// invocations for targets in the same group are sent in a single parcel.
+    ///
+    /// \param ids       [in] A list of global identifiers identifying the
+    ///                  target objects for which the given action will be
+    ///                  invoked.
+    /// \param argN      [in] Any number of lists of arguments, one for each
+    ///                  parameter of the action. The n-th element of each
+    ///                  list is passed to the invocation for the n-th
+    ///                  target. All lists have to have the same size as
+    ///                  \a ids.
+    ///
+    /// \returns         This function returns a future representing the
+    ///                  results of all invocations, in the order of the
+    ///                  given targets.
+    ///
+    /// \note            If decltype(Action(...)) is void, then the result of
+    ///                  this function is future<void>.
+    ///
+    template <typename Action, typename ArgN, ...>
+    hpx::future<std::vector<decltype(Action(hpx::id_type, ArgN, ...))> >
+    batch_async(
+        std::vector<hpx::id_type> const & ids
+      , std::vector<ArgN> const & argN, ...);
+}}
+#else
+
+#ifndef HPX_LCOS_BATCH_ASYNC_HPP
+#define HPX_LCOS_BATCH_ASYNC_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/error_code.hpp>
+#include <hpx/lcos/async.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/when_all.hpp>
+#include <hpx/runtime/actions/plain_action.hpp>
+#include <hpx/runtime/agas/interface.hpp>
+#include <hpx/runtime/naming/address.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/traits/extract_action.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/detail/pack.hpp>
+#include <hpx/util/detail/pp/cat.hpp>
+#include <hpx/util/detail/pp/expand.hpp>
+#include <hpx/util/detail/pp/nargs.hpp>
+#include <hpx/util/tuple.hpp>
+
+#include <cstddef>
+#include <map>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Action>
+        struct batch_async_result
+        {
+            typedef
+                typename hpx::traits::extract_action<
+                    Action
+                >::local_result_type
+                action_result;
+            typedef
+                typename std::conditional<
+                    std::is_void<action_result>::value
+                  , void
+                  , std::vector<action_result>
+                >::type
+                type;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        std::vector<T> select_elements(std::vector<T> const& v,
+            std::vector<std::size_t> const& indices)
+        {
+            std::vector<T> result;
+            result.reserve(indices.size());
+            for (std::size_t i : indices)
+                result.push_back(v[i]);
+            return result;
+        }
+
+        template <typename Result>
+        std::vector<Result> batch_local_results(
+            hpx::future<std::vector<hpx::future<Result> > > f)
+        {
+            std::vector<hpx::future<Result> > futures = f.get();
+
+            std::vector<Result> results;
+            results.reserve(futures.size());
+            for (hpx::future<Result>& r : futures)
+                results.push_back(r.get());
+            return results;
+        }
+
+        inline void batch_void_results(
+            hpx::future<std::vector<hpx::future<void> > > f)
+        {
+            // rethrow the first exception, if any
+            for (hpx::future<void>& r : f.get())
+                r.get();
+        }
+
+        // Put the results received from all localities back into the order of
+        // the targets they were computed for.
+        template <typename Result>
+        struct batch_scatter_results
+        {
+            batch_scatter_results(std::size_t size,
+                    std::vector<std::vector<std::size_t> > && indices)
+              : size_(size), indices_(std::move(indices))
+            {}
+
+            std::vector<Result> operator()(
+                hpx::future<std::vector<hpx::future<std::vector<Result> > > > f)
+            {
+                std::vector<hpx::future<std::vector<Result> > > batches =
+                    f.get();
+
+                std::vector<Result> results(size_);
+                for (std::size_t i = 0; i != batches.size(); ++i)
+                {
+                    std::vector<Result> batch = batches[i].get();
+                    std::vector<std::size_t> const& indices = indices_[i];
+
+                    HPX_ASSERT(batch.size() == indices.size());
+                    for (std::size_t j = 0; j != batch.size(); ++j)
+                        results[indices[j]] = std::move(batch[j]);
+                }
+                return results;
+            }
+
+            std::size_t size_;
+            std::vector<std::vector<std::size_t> > indices_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The batch_invoker is executed on the locality the given targets
+        // live on, it invokes the action for all of them concurrently.
+        template <
+            typename Action
+          , typename IsVoid
+          , typename ...Ts
+        >
+        struct batch_invoker
+        {
+            typedef
+                typename batch_async_result<Action>::action_result
+                action_result;
+
+            static hpx::future<std::vector<action_result> >
+            call(
+                std::vector<hpx::id_type> const & ids
+              , std::vector<Ts> const&... vs
+            )
+            {
+                std::vector<hpx::future<action_result> > futures;
+                futures.reserve(ids.size());
+                for (std::size_t i = 0; i != ids.size(); ++i)
+                {
+                    futures.push_back(hpx::async(Action(), ids[i], vs[i]...));
+                }
+
+                return hpx::when_all(futures).then(hpx::launch::sync,
+                    &batch_local_results<action_result>);
+            }
+        };
+
+        template <
+            typename Action
+          , typename ...Ts
+        >
+        struct batch_invoker<Action, std::true_type, Ts...>
+        {
+            static hpx::future<void>
+            call(
+                std::vector<hpx::id_type> const & ids
+              , std::vector<Ts> const&... vs
+            )
+            {
+                std::vector<hpx::future<void> > futures;
+                futures.reserve(ids.size());
+                for (std::size_t i = 0; i != ids.size(); ++i)
+                {
+                    futures.push_back(hpx::async(Action(), ids[i], vs[i]...));
+                }
+
+                return hpx::when_all(futures).then(hpx::launch::sync,
+                    &batch_void_results);
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Action, typename Is>
+        struct make_batch_async_action_impl;
+
+        template <typename Action, std::size_t ...Is>
+        struct make_batch_async_action_impl<Action,
+            util::detail::pack_c<std::size_t, Is...> >
+        {
+            typedef
+                typename batch_async_result<Action>::action_result
+                action_result;
+
+            typedef detail::batch_invoker<
+                        Action
+                      , typename std::is_void<action_result>::type
+                      , typename util::tuple_element<
+                            Is, typename Action::arguments_type
+                        >::type...
+                    >
+                    batch_invoker_type;
+
+            typedef
+                typename HPX_MAKE_ACTION(batch_invoker_type::call)::type
+                type;
+        };
+
+        template <typename Action>
+        struct make_batch_async_action
+          : make_batch_async_action_impl<
+                Action
+              , typename util::detail::make_index_pack<Action::arity>::type
+            >
+        {};
+
+        ///////////////////////////////////////////////////////////////////////
+        // Group the targets by the locality they live on and send one batch
+        // to each of the localities. Targets which could not be resolved
+        // locally are sent to the locality managing their global id, where
+        // AGAS resolves them without sending any further messages. The
+        // invocations for targets which have moved elsewhere are forwarded
+        // from there.
+        template <
+            typename Action
+          , typename ...Ts
+        >
+        struct batch_dispatcher
+        {
+            typedef
+                typename batch_async_result<Action>::action_result
+                action_result;
+            typedef
+                typename batch_async_result<Action>::type
+                result_type;
+            typedef
+                typename make_batch_async_action<Action>::type
+                batch_action;
+
+            batch_dispatcher(std::vector<hpx::id_type> const & ids,
+                    std::vector<Ts> const&... vs)
+              : ids_(ids), args_(vs...)
+            {}
+
+            hpx::future<result_type> operator()(
+                std::vector<naming::address> const& addrs)
+            {
+                HPX_ASSERT(addrs.size() == ids_.size());
+
+                std::map<naming::gid_type, std::size_t> groups;
+                std::vector<hpx::id_type> localities;
+                std::vector<std::vector<std::size_t> > indices;
+
+                for (std::size_t i = 0; i != addrs.size(); ++i)
+                {
+                    naming::gid_type locality = addrs[i] ?
+                        addrs[i].locality_ :
+                        naming::get_locality_from_gid(ids_[i].get_gid());
+
+                    auto it = groups.find(locality);
+                    if (it == groups.end())
+                    {
+                        it = groups.emplace(locality, indices.size()).first;
+                        localities.push_back(hpx::id_type(
+                            locality, hpx::id_type::unmanaged));
+                        indices.emplace_back();
+                    }
+                    indices[it->second].push_back(i);
+                }
+
+                return invoke(typename std::is_void<action_result>::type(),
+                    typename util::detail::make_index_pack<
+                        sizeof...(Ts)
+                    >::type(),
+                    localities, std::move(indices));
+            }
+
+        private:
+            template <std::size_t ...Is>
+            hpx::future<result_type> invoke(std::false_type,
+                util::detail::pack_c<std::size_t, Is...>,
+                std::vector<hpx::id_type> const& localities,
+                std::vector<std::vector<std::size_t> > && indices)
+            {
+                std::vector<hpx::future<result_type> > batches;
+                batches.reserve(localities.size());
+                for (std::size_t i = 0; i != localities.size(); ++i)
+                {
+                    batches.push_back(hpx::async<batch_action>(
+                        localities[i],
+                        select_elements(ids_, indices[i]),
+                        select_elements(util::get<Is>(args_), indices[i])...));
+                }
+
+                return hpx::when_all(batches).then(hpx::launch::sync,
+                    batch_scatter_results<action_result>(
+                        ids_.size(), std::move(indices)));
+            }
+
+            template <std::size_t ...Is>
+            hpx::future<void> invoke(std::true_type,
+                util::detail::pack_c<std::size_t, Is...>,
+                std::vector<hpx::id_type> const& localities,
+                std::vector<std::vector<std::size_t> > && indices)
+            {
+                std::vector<hpx::future<void> > batches;
+                batches.reserve(localities.size());
+                for (std::size_t i = 0; i != localities.size(); ++i)
+                {
+                    batches.push_back(hpx::async<batch_action>(
+                        localities[i],
+                        select_elements(ids_, indices[i]),
+                        select_elements(util::get<Is>(args_), indices[i])...));
+                }
+
+                return hpx::when_all(batches).then(hpx::launch::sync,
+                    &batch_void_results);
+            }
+
+            std::vector<hpx::id_type> ids_;
+            util::tuple<std::vector<Ts>...> args_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <
+        typename Action
+      , typename ...Ts
+    >
+    hpx::future<
+        typename detail::batch_async_result<Action>::type
+    >
+    batch_async(
+        std::vector<hpx::id_type> const & ids
+      , std::vector<Ts> const&... vs)
+    {
+        static_assert(sizeof...(Ts) == Action::arity,
+            "batch_async requires one list of arguments for each parameter "
+            "of the action");
+
+        typedef
+            typename detail::batch_async_result<Action>::type
+            result_type;
+
+        std::size_t const sizes[] = { ids.size(), vs.size()... };
+        for (std::size_t size : sizes)
+        {
+            if (size != ids.size())
+            {
+                return hpx::make_exceptional_future<result_type>(
+                    HPX_GET_EXCEPTION(bad_parameter,
+                        "hpx::lcos::batch_async",
+                        "the lists of arguments must have the same size as "
+                        "the list of targets"));
+            }
+        }
+
+        // resolve as many targets as possible without contacting AGAS, all
+        // others are grouped by the locality managing them
+        std::vector<naming::address> addrs;
+        error_code ec(lightweight);
+        agas::resolve_cached(ids, addrs, ec);
+        if (ec)
+            addrs.assign(ids.size(), naming::address());
+
+        return detail::batch_dispatcher<Action, Ts...>(ids, vs...)(addrs);
+    }
+
+    template <
+        typename Component, typename Signature, typename Derived
+      , typename ...Ts
+    >
+    hpx::future<
+        typename detail::batch_async_result<Derived>::type
+    >
+    batch_async(
+        hpx::actions::basic_action<Component, Signature, Derived> /* act */
+      , std::vector<hpx::id_type> const & ids
+      , std::vector<Ts> const&... vs)
+    {
+        return batch_async<Derived>(
+                ids
+              , vs...
+            );
+    }
+}}
+
+///////////////////////////////////////////////////////////////////////////////
+#define HPX_REGISTER_BATCH_ASYNC_ACTION_DECLARATION(...)                      \
+    HPX_REGISTER_BATCH_ASYNC_ACTION_DECLARATION_(__VA_ARGS__)                 \
+/**/
+#define HPX_REGISTER_BATCH_ASYNC_ACTION_DECLARATION_(...)                     \
+    HPX_PP_EXPAND(HPX_PP_CAT(                                                 \
+        HPX_REGISTER_BATCH_ASYNC_ACTION_DECLARATION_,                         \
+            HPX_PP_NARGS(__VA_ARGS__)                                         \
+    )(__VA_ARGS__))                                                           \
+/**/
+
+#define HPX_REGISTER_BATCH_ASYNC_ACTION_DECLARATION_1(Action)                 \
+    HPX_REGISTER_BATCH_ASYNC_ACTION_DECLARATION_2(Action, Action)             \
+/**/
+#define HPX_REGISTER_BATCH_ASYNC_ACTION_DECLARATION_2(Action, Name)           \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        ::hpx::lcos::detail::make_batch_async_action<Action>::type            \
+      , HPX_PP_CAT(batch_async_, Name)                                        \
+    )                                                                         \
+/**/
+
+///////////////////////////////////////////////////////////////////////////////
+#define HPX_REGISTER_BATCH_ASYNC_ACTION(...)                                  \
+    HPX_REGISTER_BATCH_ASYNC_ACTION_(__VA_ARGS__)                             \
+/**/
+#define HPX_REGISTER_BATCH_ASYNC_ACTION_(...)                                 \
+    HPX_PP_EXPAND(HPX_PP_CAT(                                                 \
+        HPX_REGISTER_BATCH_ASYNC_ACTION_, HPX_PP_NARGS(__VA_ARGS__)           \
+    )(__VA_ARGS__))                                                           \
+/**/
+
+#define HPX_REGISTER_BATCH_ASYNC_ACTION_1(Action)                             \
+    HPX_REGISTER_BATCH_ASYNC_ACTION_2(Action, Action)                         \
+/**/
+#define HPX_REGISTER_BATCH_ASYNC_ACTION_2(Action, Name)                       \
+    HPX_REGISTER_ACTION(                                                      \
+        ::hpx::lcos::detail::make_batch_async_action<Action>::type            \
+      , HPX_PP_CAT(batch_async_, Name)                                        \
+    )                                                                         \
+/**/
+
+#endif
+#endif
@@ -546,7 +546,8 @@ namespace hpx { namespace lcos
         {
             if(ids.empty()) return;// hpx::lcos::make_ready_future();
 
-            std::size_t const local_fanout = HPX_BROADCAST_FANOUT;
+            std::size_t const local_fanout =
+                util::get_collectives_fanout(ids.size(), HPX_BROADCAST_FANOUT);
             std::size_t local_size = (std::min)(ids.size(), local_fanout);
             std::size_t fanout = util::calculate_fanout(ids.size(), local_fanout);
 
@@ -627,7 +628,8 @@ namespace hpx { namespace lcos
             //if(ids.empty()) return hpx::lcos::make_ready_future(result_type());
             if(ids.empty()) return result_type();
 
-            std::size_t const local_fanout = HPX_BROADCAST_FANOUT;
+            std::size_t const local_fanout =
+                util::get_collectives_fanout(ids.size(), HPX_BROADCAST_FANOUT);
             std::size_t local_size = (std::min)(ids.size(), local_fanout);
             std::size_t fanout = util::calculate_fanout(ids.size(), local_fanout);
 
@@ -700,7 +702,8 @@ namespace hpx { namespace lcos
         {
             if(ids.empty()) return;
 
-            std::size_t const local_fanout = HPX_BROADCAST_FANOUT;
+            std::size_t const local_fanout =
+                util::get_collectives_fanout(ids.size(), HPX_BROADCAST_FANOUT);
             std::size_t local_size = (std::min)(ids.size(), local_fanout);
 
             for(std::size_t i = 0; i != local_size; ++i)
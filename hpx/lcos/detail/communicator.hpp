@@ -0,0 +1,175 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_DETAIL_COMMUNICATOR_MAR_14_2017_0924AM)
+#define HPX_LCOS_DETAIL_COMMUNICATOR_MAR_14_2017_0924AM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/receive_buffer.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/runtime/basename_registration.hpp>
+#include <hpx/runtime/components/component_factory.hpp>
+#include <hpx/runtime/components/new.hpp>
+#include <hpx/runtime/components/server/simple_component_base.hpp>
+#include <hpx/runtime/get_ptr.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/naming/unmanaged.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/detail/pp/cat.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Each site participating in an all_reduce, all_gather, or all_to_all
+    // operation creates one of these and registers it with the base name of
+    // the operation. The other sites deliver their (partial) results to it,
+    // tagged with the step of the algorithm the value belongs to.
+    template <typename T, typename Tag>
+    class communicator_server
+      : public hpx::components::simple_component_base<
+            communicator_server<T, Tag> >
+    {
+    public:
+        communicator_server() //-V730
+        {
+            HPX_ASSERT(false);  // shouldn't ever be called
+        }
+
+        communicator_server(std::string const& name, std::size_t site)
+          : name_(name), site_(site)
+        {}
+
+        ~communicator_server()
+        {
+            hpx::unregister_with_basename(name_, site_);
+        }
+
+        void set_value(std::size_t step, T && t)
+        {
+            buffer_.store_received(step, std::move(t));
+        }
+
+        hpx::future<T> get_value(std::size_t step)
+        {
+            return buffer_.receive(step);
+        }
+
+        HPX_DEFINE_COMPONENT_ACTION(
+            communicator_server, set_value, set_value_action);
+
+    private:
+        lcos::local::receive_buffer<T> buffer_;
+        std::string name_;
+        std::size_t site_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Local view of a collective operation: owns this site's server and
+    // caches the ids of the servers of the other sites.
+    template <typename T, typename Tag>
+    class communicator
+    {
+        typedef communicator_server<T, Tag> server_type;
+        typedef typename server_type::set_value_action set_value_action;
+
+    public:
+        communicator(std::string const& basename, std::size_t num_sites,
+                std::size_t generation, std::size_t this_site)
+          : name_(basename), num_sites_(num_sites), this_site_(this_site),
+            sites_(num_sites)
+        {
+            if (generation != std::size_t(-1))
+                name_ += std::to_string(generation) + "/";
+
+            id_ = hpx::new_<server_type>(hpx::find_here(), name_, this_site)
+                .get();
+
+            // Register unmanaged id to avoid cyclic dependencies, unregister
+            // is done in the destructor of the server.
+            if (!hpx::register_with_basename(
+                    name_, hpx::unmanaged(id_), this_site).get())
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "hpx::lcos::detail::communicator::communicator",
+                    "the given base name for the collective operation was "
+                    "already registered: " + name_);
+            }
+
+            server_ = hpx::get_ptr<server_type>(hpx::launch::sync, id_);
+        }
+
+        ~communicator()
+        {
+            hpx::wait_all(sends_);
+        }
+
+        std::size_t num_sites() const { return num_sites_; }
+        std::size_t this_site() const { return this_site_; }
+
+        void send(std::size_t site, std::size_t step, T t)
+        {
+            hpx::id_type& id = sites_[site];
+            if (!id)
+                id = hpx::find_from_basename(name_, site).get();
+
+            sends_.push_back(
+                hpx::async(set_value_action(), id, step, std::move(t)));
+        }
+
+        hpx::future<T> receive(std::size_t step)
+        {
+            return server_->get_value(step);
+        }
+
+        // wait for all values sent so far to be delivered, rethrow errors
+        void flush()
+        {
+            hpx::wait_all(sends_);
+            for (hpx::future<void>& f : sends_)
+                f.get();
+            sends_.clear();
+        }
+
+    private:
+        std::string name_;
+        std::size_t num_sites_;
+        std::size_t this_site_;
+        hpx::id_type id_;
+        std::shared_ptr<server_type> server_;
+        std::vector<hpx::id_type> sites_;
+        std::vector<hpx::future<void> > sends_;
+    };
+}}}
+
+///////////////////////////////////////////////////////////////////////////////
+#define HPX_REGISTER_COMMUNICATOR_DECLARATION_(type, tag, name)               \
+    typedef hpx::lcos::detail::communicator_server<type, tag>                 \
+        HPX_PP_CAT(communicator_server_, name);                               \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        HPX_PP_CAT(communicator_server_, name)::set_value_action,             \
+        HPX_PP_CAT(communicator_set_value_action_, name))                     \
+    /**/
+
+#define HPX_REGISTER_COMMUNICATOR_(type, tag, name)                           \
+    typedef hpx::lcos::detail::communicator_server<type, tag>                 \
+        HPX_PP_CAT(communicator_server_, name);                               \
+    HPX_REGISTER_ACTION(                                                      \
+        HPX_PP_CAT(communicator_server_, name)::set_value_action,             \
+        HPX_PP_CAT(communicator_set_value_action_, name));                    \
+    typedef hpx::components::simple_component<                                \
+        HPX_PP_CAT(communicator_server_, name)                                \
+    > HPX_PP_CAT(communicator_, name);                                        \
+    HPX_REGISTER_COMPONENT(HPX_PP_CAT(communicator_, name))                   \
+    /**/
+
+#endif
@@ -0,0 +1,65 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_DETAIL_CONTINUATION_PLACEMENT_MAR_27_2017_0215PM)
+#define HPX_LCOS_DETAIL_CONTINUATION_PLACEMENT_MAR_27_2017_0215PM
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/thread_enums.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hpx { namespace lcos { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A continuation attached to a future is either run directly by the
+    // thread making the future ready or it is spawned as a new HPX thread.
+    // Spawned continuations are placed on the worker thread which made the
+    // future ready (its data most likely is still in that core's cache),
+    // unless hpx.continuations.placement is set to 'any'.
+    enum continuation_placement
+    {
+        continuation_inline = 0,    ///< run by the completing thread
+        continuation_local = 1,     ///< spawned on the completing worker
+        continuation_remote = 2     ///< spawned on an arbitrary worker
+    };
+
+    // Return the number of nested continuations which may be run inline
+    // before a new thread is spawned (hpx.continuations.max_inline_depth).
+    HPX_EXPORT std::size_t get_continuation_max_inline_depth();
+
+    // Return the (pool local) index of the worker thread a continuation
+    // spawned from the calling thread should be scheduled on, or
+    // std::size_t(-1) if it may run anywhere. Every call is accounted for
+    // as a local or remote placement.
+    HPX_EXPORT std::size_t get_continuation_os_thread();
+
+    // Return the priority to use for a continuation placed on the given
+    // worker thread. Locally placed continuations are boosted such that
+    // they are picked up next by the worker thread.
+    inline threads::thread_priority get_continuation_priority(
+        std::size_t os_thread, threads::thread_priority priority)
+    {
+        if (os_thread != std::size_t(-1) &&
+            (priority == threads::thread_priority_default ||
+             priority == threads::thread_priority_normal))
+        {
+            return threads::thread_priority_boost;
+        }
+        return priority;
+    }
+
+    // Account for a continuation which was run or spawned by the calling
+    // thread without using get_continuation_os_thread.
+    HPX_EXPORT void count_continuation(continuation_placement placement);
+
+    // Return the number of continuations placed as specified since the last
+    // reset (performance counters /threads/count/continuations/...).
+    HPX_EXPORT std::int64_t get_continuation_count(
+        continuation_placement placement, bool reset);
+}}}
+
+#endif
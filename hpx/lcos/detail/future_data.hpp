@@ -8,6 +8,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/error_code.hpp>
+#include <hpx/lcos/detail/continuation_placement.hpp>
 #include <hpx/lcos/local/detail/condition_variable.hpp>
 #include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/runtime/get_worker_thread_num.hpp>
@@ -56,6 +57,13 @@ namespace detail
 {
     template <typename Result> struct future_data;
 
+    ///////////////////////////////////////////////////////////////////////
+    // Callbacks invoked once a future becomes ready. Those attached by the
+    // continuation and composition facilities mostly bind a member function
+    // to one or two shared states, which fits into five pointers.
+    typedef util::unique_function_nonser<void(), 5 * sizeof(void*)>
+        completed_callback_type;
+
     ///////////////////////////////////////////////////////////////////////
     struct future_data_refcnt_base;
 
@@ -66,7 +74,7 @@ namespace detail
     struct future_data_refcnt_base
     {
     private:
-        typedef util::unique_function_nonser<void()> completed_callback_type;
+        typedef detail::completed_callback_type completed_callback_type;
 
     public:
         typedef void has_future_data_refcnt_base;
@@ -210,14 +218,13 @@ namespace detail
 
         void operator()()
         {
-            bool recurse_asynchronously = hpx::threads::get_self_ptr() == nullptr;
-#if defined(HPX_HAVE_THREADS_GET_STACK_POINTER)
-            recurse_asynchronously =
-                !this_thread::has_sufficient_stack_space();
-#else
             handle_continuation_recursion_count cnt;
+            bool recurse_asynchronously =
+                hpx::threads::get_self_ptr() == nullptr ||
+                cnt.count_ > get_continuation_max_inline_depth();
+#if defined(HPX_HAVE_THREADS_GET_STACK_POINTER)
             recurse_asynchronously = recurse_asynchronously ||
-                cnt.count_ > HPX_CONTINUATION_MAX_RECURSION_DEPTH;
+                !this_thread::has_sufficient_stack_space();
 #endif
             if (recurse_asynchronously)
             {
@@ -226,7 +233,8 @@ namespace detail
                     compose_cb_impl(std::move(f1_), std::move(f2_)),
                     "compose_cb",
                     threads::pending, true, threads::thread_priority_boost,
-                    std::size_t(-1), threads::thread_stacksize_current, ec);
+                    get_continuation_os_thread(),
+                    threads::thread_stacksize_current, ec);
                 return;
             }
 
@@ -247,7 +255,7 @@ namespace detail
     };
 
     template <typename F1, typename F2>
-    static HPX_FORCEINLINE util::unique_function_nonser<void()>
+    static HPX_FORCEINLINE completed_callback_type
     compose_cb(F1 && f1, F2 && f2)
     {
         if (!f1)
@@ -341,7 +349,7 @@ namespace detail
         HPX_NON_COPYABLE(future_data);
 
         typedef typename future_data_result<Result>::type result_type;
-        typedef util::unique_function_nonser<void()> completed_callback_type;
+        typedef detail::completed_callback_type completed_callback_type;
         typedef lcos::local::spinlock mutex_type;
         typedef typename future_data<
                 traits::detail::future_data_void
@@ -523,19 +531,21 @@ namespace detail
         void handle_on_completed(completed_callback_type && on_completed)
         {
             // We need to run the completion on a new thread if we are on a
-            // non HPX thread.
-            bool recurse_asynchronously = hpx::threads::get_self_ptr() == nullptr;
-#if defined(HPX_HAVE_THREADS_GET_STACK_POINTER)
-            recurse_asynchronously =
-                !this_thread::has_sufficient_stack_space();
-#else
+            // non HPX thread. Nested continuations are run inline only up to
+            // the configured depth to bound the time the thread making the
+            // future ready is kept busy.
             handle_continuation_recursion_count cnt;
+            bool recurse_asynchronously =
+                hpx::threads::get_self_ptr() == nullptr ||
+                cnt.count_ > get_continuation_max_inline_depth();
+#if defined(HPX_HAVE_THREADS_GET_STACK_POINTER)
             recurse_asynchronously = recurse_asynchronously ||
-                cnt.count_ > HPX_CONTINUATION_MAX_RECURSION_DEPTH;
+                !this_thread::has_sufficient_stack_space();
 #endif
             if (!recurse_asynchronously)
             {
                 // directly execute continuation on this thread
+                count_continuation(continuation_inline);
                 std::exception_ptr ptr;
                 if (!run_on_completed(std::move(on_completed), ptr))
                 {
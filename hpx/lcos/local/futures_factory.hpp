@@ -119,7 +119,11 @@ namespace hpx { namespace lcos { namespace local
                         threads::pending, false, stacksize, ec);
                     return threads::invalid_thread_id;
                 }
-                else if (policy == launch::fork) {
+                else if (policy == launch::fork &&
+                    threads::get_self_ptr() != nullptr)
+                {
+                    // run the new thread right away on this worker, the
+                    // caller is expected to yield to it (work-first)
                     return threads::register_thread_nullary(
                         util::deferred_call(&base_type::run_impl, std::move(this_)),
                         util::thread_description(f_, "task_object::apply"),
@@ -128,6 +132,8 @@ namespace hpx { namespace lcos { namespace local
                         get_worker_thread_num(), stacksize, ec);
                 }
                 else {
+                    // launch::fork falls back to launch::async outside of
+                    // HPX threads as there is nothing which could yield
                     threads::register_thread_nullary(
                         util::deferred_call(&base_type::run_impl, std::move(this_)),
                         util::thread_description(f_, "task_object::apply"),
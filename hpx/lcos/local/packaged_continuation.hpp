@@ -9,6 +9,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/error_code.hpp>
+#include <hpx/lcos/detail/continuation_placement.hpp>
 #include <hpx/lcos/detail/future_data.hpp>
 #include <hpx/lcos/future.hpp>
 #include <hpx/runtime/launch_policy.hpp>
@@ -28,6 +29,7 @@
 
 #include <boost/intrusive_ptr.hpp>
 
+#include <cstddef>
 #include <exception>
 #include <functional>
 #include <mutex>
@@ -316,11 +318,16 @@ namespace hpx { namespace lcos { namespace detail
                 typename traits::detail::shared_state_ptr_for<Future>::type &&
             ) = &continuation::async_impl_v1;
 
+            // schedule the continuation on the worker which made the future
+            // ready, if possible
+            std::size_t os_thread = get_continuation_os_thread();
+
             util::thread_description desc(f_, "continuation::async");
             applier::register_thread_plain(
                 util::bind(util::one_shot(async_impl_ptr),
                     std::move(this_), std::move(f)),
-                desc, threads::pending, true, priority);
+                desc, threads::pending, true,
+                get_continuation_priority(os_thread, priority), os_thread);
 
             if (&ec != &throws)
                 ec = make_success_code();
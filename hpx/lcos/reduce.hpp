@@ -313,7 +313,8 @@ namespace hpx { namespace lcos
 
             if(ids.empty()) return result_type();
 
-            std::size_t const local_fanout = HPX_REDUCE_FANOUT;
+            std::size_t const local_fanout =
+                util::get_collectives_fanout(ids.size(), HPX_REDUCE_FANOUT);
             std::size_t local_size = (std::min)(ids.size(), local_fanout);
             std::size_t fanout = util::calculate_fanout(ids.size(), local_fanout);
 
@@ -13,6 +13,7 @@
 #include <hpx/config.hpp>
 #include <hpx/traits/concepts.hpp>
 #include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
 #include <hpx/util/invoke.hpp>
 #include <hpx/util/tagged_pair.hpp>
 
@@ -492,6 +493,39 @@ namespace hpx { namespace parallel { inline namespace v1
                     });
             }
         };
+
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename F, typename Proj>
+        inline typename util::detail::algorithm_result<
+            ExPolicy, std::pair<FwdIter1, FwdIter2>
+        >::type
+        copy_if_(ExPolicy && policy, FwdIter1 first, FwdIter1 last,
+            FwdIter2 dest, F && f, Proj && proj, std::false_type)
+        {
+#if defined(HPX_HAVE_ALGORITHM_INPUT_ITERATOR_SUPPORT)
+            typedef std::integral_constant<bool,
+                    execution::is_sequenced_execution_policy<ExPolicy>::value ||
+                   !hpx::traits::is_forward_iterator<FwdIter1>::value ||
+                   !hpx::traits::is_forward_iterator<FwdIter2>::value
+                > is_seq;
+#else
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+#endif
+
+            return detail::copy_if<std::pair<FwdIter1, FwdIter2> >().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                first, last, dest, std::forward<F>(f),
+                std::forward<Proj>(proj));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename F, typename Proj>
+        typename util::detail::algorithm_result<
+            ExPolicy, std::pair<FwdIter1, FwdIter2>
+        >::type
+        copy_if_(ExPolicy && policy, FwdIter1 first, FwdIter1 last,
+            FwdIter2 dest, F && f, Proj && proj, std::true_type);
         /// \endcond
     }
 
@@ -595,12 +629,6 @@ namespace hpx { namespace parallel { inline namespace v1
             (hpx::traits::is_output_iterator<FwdIter2>::value ||
                 hpx::traits::is_forward_iterator<FwdIter2>::value),
             "Requires at least output iterator.");
-
-        typedef std::integral_constant<bool,
-                execution::is_sequenced_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<FwdIter1>::value ||
-               !hpx::traits::is_forward_iterator<FwdIter2>::value
-            > is_seq;
 #else
         static_assert(
             (hpx::traits::is_forward_iterator<FwdIter1>::value),
@@ -608,15 +636,14 @@ namespace hpx { namespace parallel { inline namespace v1
         static_assert(
             (hpx::traits::is_forward_iterator<FwdIter2>::value),
             "Requires at least forward iterator.");
-
-        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
 #endif
 
+        typedef hpx::traits::is_segmented_iterator<FwdIter1> is_segmented;
+
         return hpx::util::make_tagged_pair<tag::in, tag::out>(
-            detail::copy_if<std::pair<FwdIter1, FwdIter2> >().call(
-                std::forward<ExPolicy>(policy), is_seq(),
+            detail::copy_if_(std::forward<ExPolicy>(policy),
                 first, last, dest, std::forward<F>(f),
-                std::forward<Proj>(proj)));
+                std::forward<Proj>(proj), is_segmented()));
     }
 }}}
 
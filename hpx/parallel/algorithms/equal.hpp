@@ -10,6 +10,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
 #include <hpx/util/range.hpp>
 
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
@@ -144,6 +145,34 @@ namespace hpx { namespace parallel { inline namespace v1
                     });
             }
         };
+
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        inline typename util::detail::algorithm_result<ExPolicy, bool>::type
+        equal_binary_(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, FwdIter2 last2, Pred && op, std::false_type)
+        {
+#if defined(HPX_HAVE_ALGORITHM_INPUT_ITERATOR_SUPPORT)
+            typedef std::integral_constant<bool,
+                    execution::is_sequenced_execution_policy<ExPolicy>::value ||
+                   !hpx::traits::is_forward_iterator<FwdIter1>::value ||
+                   !hpx::traits::is_forward_iterator<FwdIter2>::value
+                > is_seq;
+#else
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+#endif
+
+            return detail::equal_binary().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                first1, last1, first2, last2, std::forward<Pred>(op));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        typename util::detail::algorithm_result<ExPolicy, bool>::type
+        equal_binary_(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, FwdIter2 last2, Pred && op, std::true_type);
         /// \endcond
     }
 
@@ -236,12 +265,6 @@ namespace hpx { namespace parallel { inline namespace v1
         static_assert(
             (hpx::traits::is_input_iterator<FwdIter2>::value),
             "Requires at least input iterator.");
-
-        typedef std::integral_constant<bool,
-                execution::is_sequenced_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<FwdIter1>::value ||
-               !hpx::traits::is_forward_iterator<FwdIter2>::value
-            > is_seq;
 #else
         static_assert(
             (hpx::traits::is_forward_iterator<FwdIter1>::value),
@@ -249,13 +272,13 @@ namespace hpx { namespace parallel { inline namespace v1
         static_assert(
             (hpx::traits::is_forward_iterator<FwdIter2>::value),
             "Requires at least forward iterator.");
-
-        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
 #endif
 
-        return detail::equal_binary().call(
-            std::forward<ExPolicy>(policy), is_seq(),
-            first1, last1, first2, last2, std::forward<Pred>(op));
+        typedef hpx::traits::is_segmented_iterator<FwdIter1> is_segmented;
+
+        return detail::equal_binary_(std::forward<ExPolicy>(policy),
+            first1, last1, first2, last2, std::forward<Pred>(op),
+            is_segmented());
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -332,6 +355,34 @@ namespace hpx { namespace parallel { inline namespace v1
                     });
             }
         };
+
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        inline typename util::detail::algorithm_result<ExPolicy, bool>::type
+        equal_(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, Pred && op, std::false_type)
+        {
+#if defined(HPX_HAVE_ALGORITHM_INPUT_ITERATOR_SUPPORT)
+            typedef std::integral_constant<bool,
+                    execution::is_sequenced_execution_policy<ExPolicy>::value ||
+                   !hpx::traits::is_forward_iterator<FwdIter1>::value ||
+                   !hpx::traits::is_forward_iterator<FwdIter2>::value
+                > is_seq;
+#else
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+#endif
+
+            return detail::equal().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                first1, last1, first2, std::forward<Pred>(op));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        typename util::detail::algorithm_result<ExPolicy, bool>::type
+        equal_(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, Pred && op, std::true_type);
         /// \endcond
     }
 
@@ -420,12 +471,6 @@ namespace hpx { namespace parallel { inline namespace v1
         static_assert(
             (hpx::traits::is_input_iterator<FwdIter2>::value),
             "Requires at least input iterator.");
-
-        typedef std::integral_constant<bool,
-                execution::is_sequenced_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<FwdIter1>::value ||
-               !hpx::traits::is_forward_iterator<FwdIter2>::value
-            > is_seq;
 #else
         static_assert(
             (hpx::traits::is_forward_iterator<FwdIter1>::value),
@@ -433,13 +478,12 @@ namespace hpx { namespace parallel { inline namespace v1
         static_assert(
             (hpx::traits::is_forward_iterator<FwdIter2>::value),
             "Requires at least forward iterator.");
-
-        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
 #endif
 
-        return detail::equal().call(
-            std::forward<ExPolicy>(policy), is_seq(),
-            first1, last1, first2, std::forward<Pred>(op));
+        typedef hpx::traits::is_segmented_iterator<FwdIter1> is_segmented;
+
+        return detail::equal_(std::forward<ExPolicy>(policy),
+            first1, last1, first2, std::forward<Pred>(op), is_segmented());
     }
 }}}
 
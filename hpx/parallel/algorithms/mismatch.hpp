@@ -10,6 +10,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
 #include <hpx/util/invoke.hpp>
 
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
@@ -56,7 +57,7 @@ namespace hpx { namespace parallel { inline namespace v1
 
             template <typename ExPolicy, typename InIter1, typename InIter2,
                 typename F>
-            static T
+            static std::pair<InIter1, InIter2>
             sequential(ExPolicy, InIter1 first1, InIter1 last1,
                 InIter2 first2, InIter2 last2, F && f)
             {
@@ -66,14 +67,17 @@ namespace hpx { namespace parallel { inline namespace v1
 
             template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
                 typename F>
-            static typename util::detail::algorithm_result<ExPolicy, T>::type
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::pair<FwdIter1, FwdIter2>
+            >::type
             parallel(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
                 FwdIter2 first2, FwdIter2 last2, F && f)
             {
                 if (first1 == last1 || first2 == last2)
                 {
-                    return util::detail::algorithm_result<ExPolicy, T>::get(
-                        std::make_pair(first1, first2));
+                    return util::detail::algorithm_result<
+                            ExPolicy, std::pair<FwdIter1, FwdIter2>
+                        >::get(std::make_pair(first1, first2));
                 }
 
                 typedef typename std::iterator_traits<FwdIter1>::difference_type
@@ -92,8 +96,9 @@ namespace hpx { namespace parallel { inline namespace v1
                 difference_type2 count2 = std::distance(first2, last2);
                 if (count1 != count2)
                 {
-                    return util::detail::algorithm_result<ExPolicy, T>::get(
-                        std::make_pair(first1, first2));
+                    return util::detail::algorithm_result<
+                            ExPolicy, std::pair<FwdIter1, FwdIter2>
+                        >::get(std::make_pair(first1, first2));
                 }
 
                 typedef hpx::util::zip_iterator<FwdIter1, FwdIter2> zip_iterator;
@@ -101,7 +106,9 @@ namespace hpx { namespace parallel { inline namespace v1
 
                 util::cancellation_token<std::size_t> tok(count1);
 
-                return util::partitioner<ExPolicy, T, void>::
+                return util::partitioner<
+                        ExPolicy, std::pair<FwdIter1, FwdIter2>, void
+                    >::
                     call_with_index(
                         std::forward<ExPolicy>(policy),
                         hpx::util::make_zip_iterator(first1, first2), count1, 1,
@@ -134,6 +141,39 @@ namespace hpx { namespace parallel { inline namespace v1
                         });
             }
         };
+
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        inline typename util::detail::algorithm_result<
+            ExPolicy, std::pair<FwdIter1, FwdIter2>
+        >::type
+        mismatch_binary_(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, FwdIter2 last2, Pred && op, std::false_type)
+        {
+#if defined(HPX_HAVE_ALGORITHM_INPUT_ITERATOR_SUPPORT)
+            typedef std::integral_constant<bool,
+                    execution::is_sequenced_execution_policy<ExPolicy>::value ||
+                   !hpx::traits::is_forward_iterator<FwdIter1>::value ||
+                   !hpx::traits::is_forward_iterator<FwdIter2>::value
+                > is_seq;
+#else
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+#endif
+
+            typedef std::pair<FwdIter1, FwdIter2> result_type;
+            return detail::mismatch_binary<result_type>().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                first1, last1, first2, last2, std::forward<Pred>(op));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        typename util::detail::algorithm_result<
+            ExPolicy, std::pair<FwdIter1, FwdIter2>
+        >::type
+        mismatch_binary_(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, FwdIter2 last2, Pred && op, std::true_type);
         /// \endcond
     }
 
@@ -230,12 +270,6 @@ namespace hpx { namespace parallel { inline namespace v1
         static_assert(
             (hpx::traits::is_input_iterator<FwdIter2>::value),
             "Requires at least input iterator.");
-
-        typedef std::integral_constant<bool,
-                execution::is_sequenced_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<FwdIter1>::value ||
-               !hpx::traits::is_forward_iterator<FwdIter2>::value
-            > is_seq;
 #else
         static_assert(
             (hpx::traits::is_forward_iterator<FwdIter1>::value),
@@ -243,14 +277,12 @@ namespace hpx { namespace parallel { inline namespace v1
         static_assert(
             (hpx::traits::is_forward_iterator<FwdIter2>::value),
             "Requires at least forward iterator.");
-
-        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
 #endif
 
-        typedef std::pair<FwdIter1, FwdIter2> result_type;
-        return detail::mismatch_binary<result_type>().call(
-            std::forward<ExPolicy>(policy), is_seq(),
-            first1, last1, first2, last2, std::forward<Pred>(op));
+        typedef hpx::traits::is_segmented_iterator<FwdIter1> is_segmented;
+        return detail::mismatch_binary_(std::forward<ExPolicy>(policy),
+            first1, last1, first2, last2, std::forward<Pred>(op),
+            is_segmented());
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -267,7 +299,7 @@ namespace hpx { namespace parallel { inline namespace v1
 
             template <typename ExPolicy, typename InIter1, typename InIter2,
                 typename F>
-            static T
+            static std::pair<InIter1, InIter2>
             sequential(ExPolicy, InIter1 first1, InIter1 last1, InIter2 first2,
                 F && f)
             {
@@ -276,14 +308,17 @@ namespace hpx { namespace parallel { inline namespace v1
 
             template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
                 typename F>
-            static typename util::detail::algorithm_result<ExPolicy, T>::type
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::pair<FwdIter1, FwdIter2>
+            >::type
             parallel(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
                 FwdIter2 first2, F && f)
             {
                 if (first1 == last1)
                 {
-                    return util::detail::algorithm_result<ExPolicy, T>::get(
-                        std::make_pair(first1, first2));
+                    return util::detail::algorithm_result<
+                            ExPolicy, std::pair<FwdIter1, FwdIter2>
+                        >::get(std::make_pair(first1, first2));
                 }
 
                 typedef typename std::iterator_traits<FwdIter1>::difference_type
@@ -295,7 +330,9 @@ namespace hpx { namespace parallel { inline namespace v1
 
                 util::cancellation_token<std::size_t> tok(count);
 
-                return util::partitioner<ExPolicy, T, void>::
+                return util::partitioner<
+                        ExPolicy, std::pair<FwdIter1, FwdIter2>, void
+                    >::
                     call_with_index(
                         std::forward<ExPolicy>(policy),
                         hpx::util::make_zip_iterator(first1, first2), count, 1,
@@ -326,6 +363,39 @@ namespace hpx { namespace parallel { inline namespace v1
                         });
             }
         };
+
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        inline typename util::detail::algorithm_result<
+            ExPolicy, std::pair<FwdIter1, FwdIter2>
+        >::type
+        mismatch_(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, Pred && op, std::false_type)
+        {
+#if defined(HPX_HAVE_ALGORITHM_INPUT_ITERATOR_SUPPORT)
+            typedef std::integral_constant<bool,
+                    execution::is_sequenced_execution_policy<ExPolicy>::value ||
+                   !hpx::traits::is_forward_iterator<FwdIter1>::value ||
+                   !hpx::traits::is_forward_iterator<FwdIter2>::value
+                > is_seq;
+#else
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+#endif
+
+            typedef std::pair<FwdIter1, FwdIter2> result_type;
+            return detail::mismatch<result_type>().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                first1, last1, first2, std::forward<Pred>(op));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        typename util::detail::algorithm_result<
+            ExPolicy, std::pair<FwdIter1, FwdIter2>
+        >::type
+        mismatch_(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, Pred && op, std::true_type);
         /// \endcond
     }
 
@@ -413,12 +483,6 @@ namespace hpx { namespace parallel { inline namespace v1
         static_assert(
             (hpx::traits::is_input_iterator<FwdIter2>::value),
             "Requires at least input iterator.");
-
-        typedef std::integral_constant<bool,
-                execution::is_sequenced_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<FwdIter1>::value ||
-               !hpx::traits::is_forward_iterator<FwdIter2>::value
-            > is_seq;
 #else
         static_assert(
             (hpx::traits::is_forward_iterator<FwdIter1>::value),
@@ -426,14 +490,11 @@ namespace hpx { namespace parallel { inline namespace v1
         static_assert(
             (hpx::traits::is_forward_iterator<FwdIter2>::value),
             "Requires at least forward iterator.");
-
-        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
 #endif
 
-        typedef std::pair<FwdIter1, FwdIter2> result_type;
-        return detail::mismatch<result_type>().call(
-            std::forward<ExPolicy>(policy), is_seq(),
-            first1, last1, first2, std::forward<Pred>(op));
+        typedef hpx::traits::is_segmented_iterator<FwdIter1> is_segmented;
+        return detail::mismatch_(std::forward<ExPolicy>(policy),
+            first1, last1, first2, std::forward<Pred>(op), is_segmented());
     }
 }}}
 
@@ -15,6 +15,7 @@
 #include <hpx/traits/concepts.hpp>
 #include <hpx/traits/is_callable.hpp>
 #include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
 #include <hpx/util/invoke.hpp>
 #include <hpx/util/tagged_tuple.hpp>
 #include <hpx/util/unused.hpp>
@@ -945,6 +946,27 @@ namespace hpx { namespace parallel { inline namespace v1
                     std::forward<Pred>(pred), std::forward<Proj>(proj));
             }
         };
+
+        template <typename ExPolicy, typename FwdIter, typename Pred,
+            typename Proj>
+        inline typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
+        partition_(ExPolicy && policy, FwdIter first, FwdIter last,
+            Pred && pred, Proj && proj, std::false_type)
+        {
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+
+            return detail::partition<FwdIter>().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                first, last, std::forward<Pred>(pred),
+                std::forward<Proj>(proj));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter, typename Pred,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
+        partition_(ExPolicy && policy, FwdIter first, FwdIter last,
+            Pred && pred, Proj && proj, std::true_type);
         /// \endcond
     }
 
@@ -1031,12 +1053,11 @@ namespace hpx { namespace parallel { inline namespace v1
             (hpx::traits::is_forward_iterator<FwdIter>::value),
             "Required at least forward iterator.");
 
-        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+        typedef hpx::traits::is_segmented_iterator<FwdIter> is_segmented;
 
-        return detail::partition<FwdIter>().call(
-                std::forward<ExPolicy>(policy), is_seq(),
-                first, last, std::forward<Pred>(pred),
-                std::forward<Proj>(proj));
+        return detail::partition_(std::forward<ExPolicy>(policy),
+            first, last, std::forward<Pred>(pred), std::forward<Proj>(proj),
+            is_segmented());
     }
 
     /////////////////////////////////////////////////////////////////////////////
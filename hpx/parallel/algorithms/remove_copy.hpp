@@ -11,6 +11,7 @@
 #include <hpx/config.hpp>
 #include <hpx/traits/concepts.hpp>
 #include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
 #include <hpx/util/invoke.hpp>
 #include <hpx/util/tagged_pair.hpp>
 
@@ -267,6 +268,39 @@ namespace hpx { namespace parallel { inline namespace v1
                     std::forward<Proj>(proj));
             }
         };
+
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename F, typename Proj>
+        inline typename util::detail::algorithm_result<
+            ExPolicy, std::pair<FwdIter1, FwdIter2>
+        >::type
+        remove_copy_if_(ExPolicy && policy, FwdIter1 first, FwdIter1 last,
+            FwdIter2 dest, F && f, Proj && proj, std::false_type)
+        {
+#if defined(HPX_HAVE_ALGORITHM_INPUT_ITERATOR_SUPPORT)
+            typedef std::integral_constant<bool,
+                    execution::is_sequenced_execution_policy<ExPolicy>::value ||
+                   !hpx::traits::is_forward_iterator<FwdIter1>::value ||
+                   !hpx::traits::is_forward_iterator<FwdIter2>::value
+                > is_seq;
+#else
+            typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
+#endif
+
+            return detail::remove_copy_if<std::pair<FwdIter1, FwdIter2> >().call(
+                std::forward<ExPolicy>(policy), is_seq(),
+                first, last, dest, std::forward<F>(f),
+                std::forward<Proj>(proj));
+        }
+
+        // forward declare the segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename F, typename Proj>
+        typename util::detail::algorithm_result<
+            ExPolicy, std::pair<FwdIter1, FwdIter2>
+        >::type
+        remove_copy_if_(ExPolicy && policy, FwdIter1 first, FwdIter1 last,
+            FwdIter2 dest, F && f, Proj && proj, std::true_type);
         /// \endcond
     }
 
@@ -375,12 +409,6 @@ namespace hpx { namespace parallel { inline namespace v1
             (hpx::traits::is_output_iterator<FwdIter2>::value ||
                 hpx::traits::is_forward_iterator<FwdIter2>::value),
             "Requires at least output iterator.");
-
-        typedef std::integral_constant<bool,
-                execution::is_sequenced_execution_policy<ExPolicy>::value ||
-               !hpx::traits::is_forward_iterator<FwdIter1>::value ||
-               !hpx::traits::is_forward_iterator<FwdIter2>::value
-            > is_seq;
 #else
         static_assert(
             (hpx::traits::is_forward_iterator<FwdIter1>::value),
@@ -388,15 +416,14 @@ namespace hpx { namespace parallel { inline namespace v1
         static_assert(
             (hpx::traits::is_forward_iterator<FwdIter2>::value),
             "Requires at least forward iterator.");
-
-        typedef execution::is_sequenced_execution_policy<ExPolicy> is_seq;
 #endif
 
+        typedef hpx::traits::is_segmented_iterator<FwdIter1> is_segmented;
+
         return hpx::util::make_tagged_pair<tag::in, tag::out>(
-            detail::remove_copy_if<std::pair<FwdIter1, FwdIter2> >().call(
-                std::forward<ExPolicy>(policy), is_seq(),
+            detail::remove_copy_if_(std::forward<ExPolicy>(policy),
                 first, last, dest, std::forward<F>(f),
-                std::forward<Proj>(proj)));
+                std::forward<Proj>(proj), is_segmented()));
     }
 }}}
 
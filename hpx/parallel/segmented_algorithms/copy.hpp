@@ -0,0 +1,202 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_COPY_OCT_19_2017_0509PM)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_COPY_OCT_19_2017_0509PM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/dataflow.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/unwrap.hpp>
+
+#include <hpx/parallel/algorithms/copy.hpp>
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/scatter.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/loop.hpp>
+#include <hpx/parallel/util/partitioner.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_copy_if
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // returns the values of all elements of a partition for which the
+        // (projected) predicate returns Select
+        template <typename T, bool Select = true>
+        struct seg_copy_if
+          : public detail::algorithm<seg_copy_if<T, Select>, std::vector<T> >
+        {
+            seg_copy_if()
+              : seg_copy_if::algorithm("copy_if")
+            {}
+
+            template <typename ExPolicy, typename InIter, typename Pred,
+                typename Proj>
+            static std::vector<T>
+            sequential(ExPolicy, InIter first, InIter last, Pred && pred,
+                Proj && proj)
+            {
+                std::vector<T> values;
+                for (/**/; first != last; ++first)
+                {
+                    using hpx::util::invoke;
+                    bool f = invoke(pred, invoke(proj, *first));
+                    if (f == Select)
+                        values.push_back(*first);
+                }
+                return values;
+            }
+
+            template <typename ExPolicy, typename FwdIter, typename Pred,
+                typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::vector<T>
+            >::type
+            parallel(ExPolicy && policy, FwdIter first, FwdIter last,
+                Pred && pred, Proj && proj)
+            {
+                if (first == last)
+                {
+                    return util::detail::algorithm_result<
+                            ExPolicy, std::vector<T>
+                        >::get(std::vector<T>());
+                }
+
+                return util::partitioner<ExPolicy, std::vector<T> >::call(
+                    std::forward<ExPolicy>(policy),
+                    first, std::distance(first, last),
+                    [pred, proj](FwdIter part_begin, std::size_t part_size)
+                    ->  std::vector<T>
+                    {
+                        std::vector<T> values;
+
+                        // MSVC complains if pred or proj is captured by ref
+                        util::loop_n<ExPolicy>(part_begin, part_size,
+                            [&values, pred, proj](FwdIter const& curr)
+                            {
+                                using hpx::util::invoke;
+                                bool f = invoke(pred, invoke(proj, *curr));
+                                if (f == Select)
+                                    values.push_back(*curr);
+                            });
+                        return values;
+                    },
+                    hpx::util::unwrapping(
+                        [](std::vector<std::vector<T> > && results)
+                        ->  std::vector<T>
+                        {
+                            return detail::flatten(std::move(results));
+                        }));
+            }
+        };
+
+        // sequential remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter,
+            typename OutIter, typename Pred, typename Proj>
+        static typename util::detail::algorithm_result<
+            ExPolicy, std::pair<SegIter, OutIter>
+        >::type
+        segmented_copy_if(Algo && algo, ExPolicy const& policy,
+            SegIter first, SegIter last, OutIter dest, Pred && pred,
+            Proj && proj, std::true_type)
+        {
+            typedef util::detail::algorithm_result<
+                    ExPolicy, std::pair<SegIter, OutIter>
+                > result;
+            typedef hpx::traits::is_segmented_iterator<OutIter> is_segmented;
+
+            dest = segmented_scatter(policy, dest,
+                detail::flatten(segmented_gather(std::forward<Algo>(algo),
+                    policy, first, last, std::true_type(), pred, proj)),
+                is_segmented());
+
+            return result::get(std::make_pair(last, dest));
+        }
+
+        // parallel remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter,
+            typename OutIter, typename Pred, typename Proj>
+        static typename util::detail::algorithm_result<
+            ExPolicy, std::pair<SegIter, OutIter>
+        >::type
+        segmented_copy_if(Algo && algo, ExPolicy const& policy,
+            SegIter first, SegIter last, OutIter dest, Pred && pred,
+            Proj && proj, std::false_type)
+        {
+            typedef util::detail::algorithm_result<
+                    ExPolicy, std::pair<SegIter, OutIter>
+                > result;
+            typedef hpx::traits::is_segmented_iterator<OutIter> is_segmented;
+            typedef typename hpx::util::decay<Algo>::type::result_type
+                chunk_type;
+
+            return result::get(
+                dataflow(
+                    [=](future<std::vector<chunk_type> > && f)
+                    ->  std::pair<SegIter, OutIter>
+                    {
+                        return std::make_pair(last,
+                            segmented_scatter(policy, dest,
+                                detail::flatten(f.get()), is_segmented()));
+                    },
+                    segmented_gather(std::forward<Algo>(algo), policy,
+                        first, last, std::false_type(), pred, proj)));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented implementation
+        template <typename ExPolicy, typename SegIter, typename OutIter,
+            typename F, typename Proj>
+        typename util::detail::algorithm_result<
+            ExPolicy, std::pair<SegIter, OutIter>
+        >::type
+        copy_if_(ExPolicy && policy, SegIter first, SegIter last,
+            OutIter dest, F && f, Proj && proj, std::true_type)
+        {
+            typedef parallel::execution::is_sequenced_execution_policy<
+                    ExPolicy
+                > is_seq;
+            typedef typename std::iterator_traits<SegIter>::value_type
+                value_type;
+
+            if (first == last)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, std::pair<SegIter, OutIter>
+                    >::get(std::make_pair(last, dest));
+            }
+
+            return segmented_copy_if(seg_copy_if<value_type>(),
+                std::forward<ExPolicy>(policy), first, last, dest,
+                std::forward<F>(f), std::forward<Proj>(proj), is_seq());
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename F, typename Proj>
+        typename util::detail::algorithm_result<
+            ExPolicy, std::pair<FwdIter1, FwdIter2>
+        >::type
+        copy_if_(ExPolicy && policy, FwdIter1 first, FwdIter1 last,
+            FwdIter2 dest, F && f, Proj && proj, std::false_type);
+
+        /// \endcond
+    }
+}}}
+
+#endif
@@ -8,6 +8,8 @@
 #include <hpx/config.hpp>
 #include <hpx/traits/segmented_iterator_traits.hpp>
 #include <hpx/util/invoke.hpp>
+#include <hpx/util/tuple.hpp>
+#include <hpx/util/zip_iterator.hpp>
 
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
 #include <hpx/parallel/execution_policy.hpp>
@@ -121,5 +123,67 @@ namespace hpx { namespace parallel { inline namespace v1 { namespace detail
                 }));
         }
     };
+
+    template <typename T>
+    struct seg_transform_reduce_binary
+      : public detail::algorithm<seg_transform_reduce_binary<T>, T>
+    {
+        seg_transform_reduce_binary()
+          : seg_transform_reduce_binary::algorithm("transform_reduce_binary")
+        {}
+
+        template <typename ExPolicy, typename InIter1, typename InIter2,
+            typename Reduce, typename Convert>
+        static T
+        sequential(ExPolicy, InIter1 first1, InIter1 last1, InIter2 first2,
+            Reduce && r, Convert && conv)
+        {
+            T val = hpx::util::invoke(conv, *first1, *first2);
+            for (++first1, ++first2; first1 != last1; ++first1, ++first2)
+            {
+                val = hpx::util::invoke(r, val,
+                    hpx::util::invoke(conv, *first1, *first2));
+            }
+            return val;
+        }
+
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Reduce, typename Convert>
+        static typename util::detail::algorithm_result<ExPolicy, T>::type
+        parallel(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, Reduce && r, Convert && conv)
+        {
+            typedef hpx::util::zip_iterator<FwdIter1, FwdIter2> zip_iterator;
+            typedef typename zip_iterator::reference reference;
+
+            return util::partitioner<ExPolicy, T>::call(
+                std::forward<ExPolicy>(policy),
+                hpx::util::make_zip_iterator(first1, first2),
+                std::distance(first1, last1),
+                [r, conv](zip_iterator part_begin, std::size_t part_size) -> T
+                {
+                    using hpx::util::get;
+
+                    reference t = *part_begin;
+                    T val = hpx::util::invoke(conv, get<0>(t), get<1>(t));
+                    return util::accumulate_n(++part_begin, --part_size,
+                        std::move(val),
+                        // MSVC14 bails out if r and conv are captured by
+                        // reference
+                        [=](T const& res, reference next) -> T
+                        {
+                            return hpx::util::invoke(r, res,
+                                hpx::util::invoke(conv,
+                                    get<0>(next), get<1>(next)));
+                        });
+                },
+                hpx::util::unwrapping([r](std::vector<T> && results) -> T
+                {
+                    auto rfirst = hpx::util::begin(results);
+                    auto rlast = hpx::util::end(results);
+                    return util::accumulate<T>(rfirst, rlast, r);
+                }));
+        }
+    };
 }}}}
 #endif
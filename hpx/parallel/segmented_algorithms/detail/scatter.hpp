@@ -0,0 +1,299 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/segmented_algorithms/detail/scatter.hpp
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHMS_SCATTER)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHMS_SCATTER
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/dataflow.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_remote_exceptions.hpp>
+#include <hpx/parallel/util/transfer.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1 { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// \cond NOINTERNAL
+
+    // Algorithms which compact their input (copy_if, unique_copy, etc.) can't
+    // be run partition by partition, as the position of the output of a
+    // partition depends on the number of elements selected on all partitions
+    // before it. These algorithms gather the selected values from each of the
+    // partitions first and write them to the partitions of the destination
+    // afterwards.
+
+    // copies the given values to the local range starting at dest
+    template <typename Iter>
+    struct seg_scatter : public detail::algorithm<seg_scatter<Iter>, Iter>
+    {
+        seg_scatter()
+          : seg_scatter::algorithm("scatter")
+        {}
+
+        template <typename ExPolicy, typename OutIter, typename T>
+        static OutIter
+        sequential(ExPolicy, OutIter dest, std::vector<T> const& values)
+        {
+            return util::copy(values.begin(), values.end(), dest).second;
+        }
+
+        template <typename ExPolicy, typename OutIter, typename T>
+        static typename util::detail::algorithm_result<ExPolicy, OutIter>::type
+        parallel(ExPolicy && policy, OutIter dest, std::vector<T> const& values)
+        {
+            return util::detail::algorithm_result<ExPolicy, OutIter>::get(
+                sequential(policy, dest, values));
+        }
+    };
+
+    template <typename T>
+    std::vector<T> flatten(std::vector<std::vector<T> > && chunks)
+    {
+        std::size_t size = 0;
+        for (std::vector<T> const& chunk : chunks)
+            size += chunk.size();
+
+        std::vector<T> values;
+        values.reserve(size);
+        for (std::vector<T>& chunk : chunks)
+        {
+            values.insert(values.end(),
+                std::make_move_iterator(chunk.begin()),
+                std::make_move_iterator(chunk.end()));
+        }
+        return values;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // sequential: invokes the algorithm on each of the (non-empty) partitions
+    // of [first, last) and returns the results in order
+    template <typename Algo, typename ExPolicy, typename SegIter,
+        typename... Args>
+    std::vector<typename hpx::util::decay<Algo>::type::result_type>
+    segmented_gather(Algo && algo, ExPolicy const& policy,
+        SegIter first, SegIter last, std::true_type, Args const&... args)
+    {
+        typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+        typedef typename traits::segment_iterator segment_iterator;
+        typedef typename traits::local_iterator local_iterator_type;
+        typedef typename hpx::util::decay<Algo>::type::result_type
+            result_type;
+
+        segment_iterator sit = traits::segment(first);
+        segment_iterator send = traits::segment(last);
+
+        std::vector<result_type> results;
+        results.reserve(std::distance(sit, send) + 1);
+
+        if (sit == send)
+        {
+            // all elements are on the same partition
+            local_iterator_type beg = traits::local(first);
+            local_iterator_type end = traits::local(last);
+            if (beg != end)
+            {
+                results.push_back(dispatch(traits::get_id(sit), algo, policy,
+                    std::true_type(), beg, end, args...));
+            }
+        }
+        else {
+            // handle the remaining part of the first partition
+            local_iterator_type beg = traits::local(first);
+            local_iterator_type end = traits::end(sit);
+            if (beg != end)
+            {
+                results.push_back(dispatch(traits::get_id(sit), algo, policy,
+                    std::true_type(), beg, end, args...));
+            }
+
+            // handle all of the full partitions
+            for (++sit; sit != send; ++sit)
+            {
+                beg = traits::begin(sit);
+                end = traits::end(sit);
+                if (beg != end)
+                {
+                    results.push_back(dispatch(traits::get_id(sit), algo,
+                        policy, std::true_type(), beg, end, args...));
+                }
+            }
+
+            // handle the beginning of the last partition
+            beg = traits::begin(sit);
+            end = traits::local(last);
+            if (beg != end)
+            {
+                results.push_back(dispatch(traits::get_id(sit), algo, policy,
+                    std::true_type(), beg, end, args...));
+            }
+        }
+        return results;
+    }
+
+    // parallel: all partitions are processed concurrently
+    template <typename Algo, typename ExPolicy, typename SegIter,
+        typename... Args>
+    future<std::vector<typename hpx::util::decay<Algo>::type::result_type> >
+    segmented_gather(Algo && algo, ExPolicy const& policy,
+        SegIter first, SegIter last, std::false_type, Args const&... args)
+    {
+        typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+        typedef typename traits::segment_iterator segment_iterator;
+        typedef typename traits::local_iterator local_iterator_type;
+        typedef typename hpx::util::decay<Algo>::type::result_type
+            result_type;
+
+        typedef std::integral_constant<bool,
+                !hpx::traits::is_forward_iterator<SegIter>::value
+            > forced_seq;
+
+        segment_iterator sit = traits::segment(first);
+        segment_iterator send = traits::segment(last);
+
+        std::vector<future<result_type> > segments;
+        segments.reserve(std::distance(sit, send) + 1);
+
+        if (sit == send)
+        {
+            // all elements are on the same partition
+            local_iterator_type beg = traits::local(first);
+            local_iterator_type end = traits::local(last);
+            if (beg != end)
+            {
+                segments.push_back(dispatch_async(traits::get_id(sit), algo,
+                    policy, forced_seq(), beg, end, args...));
+            }
+        }
+        else {
+            // handle the remaining part of the first partition
+            local_iterator_type beg = traits::local(first);
+            local_iterator_type end = traits::end(sit);
+            if (beg != end)
+            {
+                segments.push_back(dispatch_async(traits::get_id(sit), algo,
+                    policy, forced_seq(), beg, end, args...));
+            }
+
+            // handle all of the full partitions
+            for (++sit; sit != send; ++sit)
+            {
+                beg = traits::begin(sit);
+                end = traits::end(sit);
+                if (beg != end)
+                {
+                    segments.push_back(dispatch_async(traits::get_id(sit),
+                        algo, policy, forced_seq(), beg, end, args...));
+                }
+            }
+
+            // handle the beginning of the last partition
+            beg = traits::begin(sit);
+            end = traits::local(last);
+            if (beg != end)
+            {
+                segments.push_back(dispatch_async(traits::get_id(sit), algo,
+                    policy, forced_seq(), beg, end, args...));
+            }
+        }
+
+        return dataflow(
+            [](std::vector<future<result_type> > && r)
+            ->  std::vector<result_type>
+            {
+                // handle any remote exceptions, will throw on error
+                std::list<std::exception_ptr> errors;
+                parallel::util::detail::handle_remote_exceptions<
+                    ExPolicy
+                >::call(r, errors);
+
+                std::vector<result_type> results;
+                results.reserve(r.size());
+                for (future<result_type>& f : r)
+                    results.push_back(f.get());
+                return results;
+            },
+            std::move(segments));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // writes the values to the range starting at dest, returns the end of
+    // the written range
+    template <typename ExPolicy, typename OutIter, typename T>
+    OutIter segmented_scatter(ExPolicy const&, OutIter dest,
+        std::vector<T> && values, std::false_type)
+    {
+        return std::move(values.begin(), values.end(), dest);
+    }
+
+    template <typename ExPolicy, typename SegIter, typename T>
+    SegIter segmented_scatter(ExPolicy const& policy, SegIter dest,
+        std::vector<T> && values, std::true_type)
+    {
+        typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+        typedef typename traits::segment_iterator segment_iterator;
+        typedef typename traits::local_iterator local_iterator_type;
+
+        if (values.empty())
+            return dest;
+
+        segment_iterator sdest = traits::segment(dest);
+        local_iterator_type beg = traits::local(dest);
+
+        // each of the destination partitions receives the slice of the
+        // values which falls into it
+        std::vector<future<local_iterator_type> > segments;
+        for (std::size_t pos = 0; /**/; beg = traits::begin(++sdest))
+        {
+            std::size_t count = (std::min)(values.size() - pos,
+                std::size_t(std::distance(beg, traits::end(sdest))));
+            if (count == 0)
+                continue;
+
+            segments.push_back(dispatch_async(traits::get_id(sdest),
+                seg_scatter<local_iterator_type>(), policy, std::true_type(),
+                beg, std::vector<T>(
+                    std::make_move_iterator(values.begin() + pos),
+                    std::make_move_iterator(values.begin() + pos + count))));
+
+            pos += count;
+            if (pos == values.size())
+                break;
+        }
+
+        hpx::wait_all(segments);
+
+        // handle any remote exceptions, will throw on error
+        std::list<std::exception_ptr> errors;
+        parallel::util::detail::handle_remote_exceptions<
+            ExPolicy
+        >::call(segments, errors);
+
+        return traits::compose(sdest, segments.back().get());
+    }
+    /// \endcond
+}}}}
+
+#endif
@@ -0,0 +1,95 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHMS_SEGMENTATION)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHMS_SEGMENTATION
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+
+#include <cstddef>
+#include <iterator>
+
+namespace hpx { namespace parallel { inline namespace v1 { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Return whether the elements of the second sequence corresponding to
+    // the elements in [first1, last1) are partitioned the same way, i.e.
+    // whether each part of a partition of the first sequence has its
+    // counterpart in a single partition of the second sequence, located
+    // on the same locality.
+    template <typename SegIter1, typename SegIter2>
+    bool is_same_segmentation(SegIter1 first1, SegIter1 last1,
+        SegIter2 first2)
+    {
+        typedef hpx::traits::segmented_iterator_traits<SegIter1> traits1;
+        typedef typename traits1::segment_iterator segment_iterator1;
+        typedef hpx::traits::segmented_iterator_traits<SegIter2> traits2;
+        typedef typename traits2::segment_iterator segment_iterator2;
+
+        segment_iterator1 sit1 = traits1::segment(first1);
+        segment_iterator1 send1 = traits1::segment(last1);
+        segment_iterator2 sit2 = traits2::segment(first2);
+
+        // the part of the second partition has to be at least as long as
+        // the part of the first one, and exactly as long if more
+        // partitions follow
+        auto matches =
+            [](segment_iterator1 const& s1, std::ptrdiff_t count1,
+                segment_iterator2 const& s2, std::ptrdiff_t count2,
+                bool is_last) -> bool
+            {
+                if (naming::get_locality_id_from_id(traits1::get_id(s1)) !=
+                    naming::get_locality_id_from_id(traits2::get_id(s2)))
+                {
+                    return false;
+                }
+                return is_last ? count2 >= count1 : count2 == count1;
+            };
+
+        if (sit1 == send1)
+        {
+            // all elements are on the same partition
+            return matches(sit1,
+                std::distance(traits1::local(first1), traits1::local(last1)),
+                sit2,
+                std::distance(traits2::local(first2), traits2::end(sit2)),
+                true);
+        }
+
+        // the remaining part of the first partition
+        if (!matches(sit1,
+                std::distance(traits1::local(first1), traits1::end(sit1)),
+                sit2,
+                std::distance(traits2::local(first2), traits2::end(sit2)),
+                false))
+        {
+            return false;
+        }
+
+        // all of the full partitions
+        for (++sit1, ++sit2; sit1 != send1; ++sit1, ++sit2)
+        {
+            if (!matches(sit1,
+                    std::distance(traits1::begin(sit1), traits1::end(sit1)),
+                    sit2,
+                    std::distance(traits2::begin(sit2), traits2::end(sit2)),
+                    false))
+            {
+                return false;
+            }
+        }
+
+        // the beginning of the last partition
+        return matches(sit1,
+            std::distance(traits1::begin(sit1), traits1::local(last1)),
+            sit2,
+            std::distance(traits2::begin(sit2), traits2::end(sit2)),
+            true);
+    }
+}}}}
+
+#endif
@@ -0,0 +1,333 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_EQUAL_OCT_19_2017_0212PM)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_EQUAL_OCT_19_2017_0212PM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/dataflow.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/equal.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/segmentation.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_remote_exceptions.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_equal
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // The second sequence has to be partitioned the same way as the
+        // first (see is_same_segmentation).
+
+        // sequential remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter1,
+            typename SegIter2, typename Pred>
+        static typename util::detail::algorithm_result<ExPolicy, bool>::type
+        segmented_equal(Algo && algo, ExPolicy const& policy,
+            SegIter1 first1, SegIter1 last1, SegIter2 first2, Pred && op,
+            std::true_type)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter1> traits1;
+            typedef typename traits1::segment_iterator segment_iterator1;
+            typedef typename traits1::local_iterator local_iterator_type1;
+            typedef hpx::traits::segmented_iterator_traits<SegIter2> traits2;
+            typedef typename traits2::segment_iterator segment_iterator2;
+            typedef typename traits2::local_iterator local_iterator_type2;
+            typedef util::detail::algorithm_result<ExPolicy, bool> result;
+
+            segment_iterator1 sit1 = traits1::segment(first1);
+            segment_iterator1 send1 = traits1::segment(last1);
+            segment_iterator2 sit2 = traits2::segment(first2);
+
+            if (sit1 == send1)
+            {
+                // all elements are on the same partition
+                local_iterator_type1 beg1 = traits1::local(first1);
+                local_iterator_type1 end1 = traits1::local(last1);
+                local_iterator_type2 beg2 = traits2::local(first2);
+                if (beg1 != end1)
+                {
+                    return result::get(dispatch(traits1::get_id(sit1),
+                        algo, policy, std::true_type(), beg1, end1, beg2, op));
+                }
+                return result::get(true);
+            }
+
+            // handle the remaining part of the first partition
+            local_iterator_type1 beg1 = traits1::local(first1);
+            local_iterator_type1 end1 = traits1::end(sit1);
+            local_iterator_type2 beg2 = traits2::local(first2);
+            if (beg1 != end1 &&
+                !dispatch(traits1::get_id(sit1), algo, policy,
+                    std::true_type(), beg1, end1, beg2, op))
+            {
+                return result::get(false);
+            }
+
+            // handle all of the full partitions
+            for (++sit1, ++sit2; sit1 != send1; ++sit1, ++sit2)
+            {
+                beg1 = traits1::begin(sit1);
+                end1 = traits1::end(sit1);
+                beg2 = traits2::begin(sit2);
+                if (beg1 != end1 &&
+                    !dispatch(traits1::get_id(sit1), algo, policy,
+                        std::true_type(), beg1, end1, beg2, op))
+                {
+                    return result::get(false);
+                }
+            }
+
+            // handle the beginning of the last partition
+            beg1 = traits1::begin(sit1);
+            end1 = traits1::local(last1);
+            beg2 = traits2::begin(sit2);
+            if (beg1 != end1 &&
+                !dispatch(traits1::get_id(sit1), algo, policy,
+                    std::true_type(), beg1, end1, beg2, op))
+            {
+                return result::get(false);
+            }
+
+            return result::get(true);
+        }
+
+        // parallel remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter1,
+            typename SegIter2, typename Pred>
+        static typename util::detail::algorithm_result<ExPolicy, bool>::type
+        segmented_equal(Algo && algo, ExPolicy const& policy,
+            SegIter1 first1, SegIter1 last1, SegIter2 first2, Pred && op,
+            std::false_type)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter1> traits1;
+            typedef typename traits1::segment_iterator segment_iterator1;
+            typedef typename traits1::local_iterator local_iterator_type1;
+            typedef hpx::traits::segmented_iterator_traits<SegIter2> traits2;
+            typedef typename traits2::segment_iterator segment_iterator2;
+            typedef typename traits2::local_iterator local_iterator_type2;
+            typedef util::detail::algorithm_result<ExPolicy, bool> result;
+
+            typedef std::integral_constant<bool,
+                    !hpx::traits::is_forward_iterator<SegIter1>::value ||
+                    !hpx::traits::is_forward_iterator<SegIter2>::value
+                > forced_seq;
+
+            segment_iterator1 sit1 = traits1::segment(first1);
+            segment_iterator1 send1 = traits1::segment(last1);
+            segment_iterator2 sit2 = traits2::segment(first2);
+
+            std::vector<future<bool> > segments;
+            segments.reserve(std::distance(sit1, send1));
+
+            if (sit1 == send1)
+            {
+                // all elements are on the same partition
+                local_iterator_type1 beg1 = traits1::local(first1);
+                local_iterator_type1 end1 = traits1::local(last1);
+                local_iterator_type2 beg2 = traits2::local(first2);
+                if (beg1 != end1)
+                {
+                    segments.push_back(dispatch_async(traits1::get_id(sit1),
+                        algo, policy, forced_seq(), beg1, end1, beg2, op));
+                }
+            }
+            else {
+                // handle the remaining part of the first partition
+                local_iterator_type1 beg1 = traits1::local(first1);
+                local_iterator_type1 end1 = traits1::end(sit1);
+                local_iterator_type2 beg2 = traits2::local(first2);
+                if (beg1 != end1)
+                {
+                    segments.push_back(dispatch_async(traits1::get_id(sit1),
+                        algo, policy, forced_seq(), beg1, end1, beg2, op));
+                }
+
+                // handle all of the full partitions
+                for (++sit1, ++sit2; sit1 != send1; ++sit1, ++sit2)
+                {
+                    beg1 = traits1::begin(sit1);
+                    end1 = traits1::end(sit1);
+                    beg2 = traits2::begin(sit2);
+                    if (beg1 != end1)
+                    {
+                        segments.push_back(dispatch_async(
+                            traits1::get_id(sit1), algo, policy, forced_seq(),
+                            beg1, end1, beg2, op));
+                    }
+                }
+
+                // handle the beginning of the last partition
+                beg1 = traits1::begin(sit1);
+                end1 = traits1::local(last1);
+                beg2 = traits2::begin(sit2);
+                if (beg1 != end1)
+                {
+                    segments.push_back(dispatch_async(traits1::get_id(sit1),
+                        algo, policy, forced_seq(), beg1, end1, beg2, op));
+                }
+            }
+
+            return result::get(
+                dataflow(
+                    [](std::vector<future<bool> > && r) -> bool
+                    {
+                        // handle any remote exceptions, will throw on error
+                        std::list<std::exception_ptr> errors;
+                        parallel::util::detail::handle_remote_exceptions<
+                            ExPolicy
+                        >::call(r, errors);
+
+                        return std::all_of(r.begin(), r.end(),
+                            [](future<bool>& curr)
+                            {
+                                return curr.get();
+                            });
+                    },
+                    std::move(segments)));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // the second sequence is not segmented, use the non-segmented
+        // algorithm
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        typename util::detail::algorithm_result<ExPolicy, bool>::type
+        segmented_equal_(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, Pred && op, std::false_type)
+        {
+            return equal_(std::forward<ExPolicy>(policy), first1, last1,
+                first2, std::forward<Pred>(op), std::false_type());
+        }
+
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        typename util::detail::algorithm_result<ExPolicy, bool>::type
+        segmented_equal_(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, Pred && op, std::true_type)
+        {
+            typedef parallel::execution::is_sequenced_execution_policy<
+                    ExPolicy
+                > is_seq;
+
+            if (first1 == last1)
+            {
+                return util::detail::algorithm_result<ExPolicy, bool>::get(
+                    true);
+            }
+
+            // the partitions can be compared locally only if the partitions
+            // of both sequences line up, otherwise fall back to the
+            // non-segmented algorithm
+            if (!is_same_segmentation(first1, last1, first2))
+            {
+                return equal_(std::forward<ExPolicy>(policy), first1, last1,
+                    first2, std::forward<Pred>(op), std::false_type());
+            }
+
+            return segmented_equal(equal(), std::forward<ExPolicy>(policy),
+                first1, last1, first2, std::forward<Pred>(op), is_seq());
+        }
+
+        // segmented implementation
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        typename util::detail::algorithm_result<ExPolicy, bool>::type
+        equal_(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, Pred && op, std::true_type)
+        {
+            typedef hpx::traits::is_segmented_iterator<FwdIter2> is_segmented2;
+
+            return segmented_equal_(std::forward<ExPolicy>(policy),
+                first1, last1, first2, std::forward<Pred>(op),
+                is_segmented2());
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        typename util::detail::algorithm_result<ExPolicy, bool>::type
+        equal_(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, Pred && op, std::false_type);
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented_equal_binary
+
+        // the second sequence is not segmented, use the non-segmented
+        // algorithm
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        typename util::detail::algorithm_result<ExPolicy, bool>::type
+        segmented_equal_binary_(ExPolicy && policy, FwdIter1 first1,
+            FwdIter1 last1, FwdIter2 first2, FwdIter2 last2, Pred && op,
+            std::false_type)
+        {
+            return equal_binary_(std::forward<ExPolicy>(policy), first1, last1,
+                first2, last2, std::forward<Pred>(op), std::false_type());
+        }
+
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        typename util::detail::algorithm_result<ExPolicy, bool>::type
+        segmented_equal_binary_(ExPolicy && policy, FwdIter1 first1,
+            FwdIter1 last1, FwdIter2 first2, FwdIter2 last2, Pred && op,
+            std::true_type)
+        {
+            // sequences of different length are never equal, otherwise
+            // compare the elements as if the second sequence was unbounded
+            if (std::distance(first1, last1) != std::distance(first2, last2))
+            {
+                return util::detail::algorithm_result<ExPolicy, bool>::get(
+                    false);
+            }
+
+            return segmented_equal_(std::forward<ExPolicy>(policy),
+                first1, last1, first2, std::forward<Pred>(op),
+                std::true_type());
+        }
+
+        // segmented implementation
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        typename util::detail::algorithm_result<ExPolicy, bool>::type
+        equal_binary_(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, FwdIter2 last2, Pred && op, std::true_type)
+        {
+            typedef hpx::traits::is_segmented_iterator<FwdIter2> is_segmented2;
+
+            return segmented_equal_binary_(std::forward<ExPolicy>(policy),
+                first1, last1, first2, last2, std::forward<Pred>(op),
+                is_segmented2());
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        typename util::detail::algorithm_result<ExPolicy, bool>::type
+        equal_binary_(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, FwdIter2 last2, Pred && op, std::false_type);
+
+        /// \endcond
+    }
+}}}
+
+#endif
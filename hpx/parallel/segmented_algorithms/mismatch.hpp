@@ -0,0 +1,426 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_MISMATCH_OCT_19_2017_0304PM)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_MISMATCH_OCT_19_2017_0304PM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/dataflow.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/mismatch.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/segmentation.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_remote_exceptions.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_mismatch
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // The second sequence has to be partitioned the same way as the
+        // first (see is_same_segmentation).
+
+        // sequential remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter1,
+            typename SegIter2, typename Pred>
+        static typename util::detail::algorithm_result<
+            ExPolicy, std::pair<SegIter1, SegIter2>
+        >::type
+        segmented_mismatch(Algo && algo, ExPolicy const& policy,
+            SegIter1 first1, SegIter1 last1, SegIter2 first2, Pred && op,
+            std::true_type)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter1> traits1;
+            typedef typename traits1::segment_iterator segment_iterator1;
+            typedef typename traits1::local_iterator local_iterator_type1;
+            typedef hpx::traits::segmented_iterator_traits<SegIter2> traits2;
+            typedef typename traits2::segment_iterator segment_iterator2;
+            typedef typename traits2::local_iterator local_iterator_type2;
+            typedef util::detail::algorithm_result<
+                    ExPolicy, std::pair<SegIter1, SegIter2>
+                > result;
+
+            typedef std::pair<
+                    local_iterator_type1, local_iterator_type2
+                > local_iterator_pair;
+
+            segment_iterator1 sit1 = traits1::segment(first1);
+            segment_iterator1 send1 = traits1::segment(last1);
+            segment_iterator2 sit2 = traits2::segment(first2);
+
+            local_iterator_type1 beg1 = traits1::local(first1);
+            local_iterator_type1 end1 = traits1::local(last1);
+            local_iterator_type2 beg2 = traits2::local(first2);
+
+            if (sit1 != send1)
+            {
+                // handle the remaining part of the first partition
+                end1 = traits1::end(sit1);
+                if (beg1 != end1)
+                {
+                    local_iterator_pair p = dispatch(traits1::get_id(sit1),
+                        algo, policy, std::true_type(), beg1, end1, beg2, op);
+                    if (p.first != end1)
+                    {
+                        return result::get(std::make_pair(
+                            traits1::compose(sit1, p.first),
+                            traits2::compose(sit2, p.second)));
+                    }
+                }
+
+                // handle all of the full partitions
+                for (++sit1, ++sit2; sit1 != send1; ++sit1, ++sit2)
+                {
+                    beg1 = traits1::begin(sit1);
+                    end1 = traits1::end(sit1);
+                    beg2 = traits2::begin(sit2);
+                    if (beg1 != end1)
+                    {
+                        local_iterator_pair p = dispatch(
+                            traits1::get_id(sit1), algo, policy,
+                            std::true_type(), beg1, end1, beg2, op);
+                        if (p.first != end1)
+                        {
+                            return result::get(std::make_pair(
+                                traits1::compose(sit1, p.first),
+                                traits2::compose(sit2, p.second)));
+                        }
+                    }
+                }
+
+                // the beginning of the last partition is handled below
+                beg1 = traits1::begin(sit1);
+                end1 = traits1::local(last1);
+                beg2 = traits2::begin(sit2);
+            }
+
+            // handle the (beginning of the) last partition
+            local_iterator_type2 end2 = beg2;
+            if (beg1 != end1)
+            {
+                local_iterator_pair p = dispatch(traits1::get_id(sit1),
+                    algo, policy, std::true_type(), beg1, end1, beg2, op);
+                if (p.first != end1)
+                {
+                    return result::get(std::make_pair(
+                        traits1::compose(sit1, p.first),
+                        traits2::compose(sit2, p.second)));
+                }
+                end2 = p.second;
+            }
+
+            return result::get(
+                std::make_pair(last1, traits2::compose(sit2, end2)));
+        }
+
+        // parallel remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter1,
+            typename SegIter2, typename Pred>
+        static typename util::detail::algorithm_result<
+            ExPolicy, std::pair<SegIter1, SegIter2>
+        >::type
+        segmented_mismatch(Algo && algo, ExPolicy const& policy,
+            SegIter1 first1, SegIter1 last1, SegIter2 first2, Pred && op,
+            std::false_type)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter1> traits1;
+            typedef typename traits1::segment_iterator segment_iterator1;
+            typedef typename traits1::local_iterator local_iterator_type1;
+            typedef hpx::traits::segmented_iterator_traits<SegIter2> traits2;
+            typedef typename traits2::segment_iterator segment_iterator2;
+            typedef typename traits2::local_iterator local_iterator_type2;
+            typedef std::pair<SegIter1, SegIter2> result_type;
+            typedef util::detail::algorithm_result<ExPolicy, result_type>
+                result;
+
+            typedef std::pair<
+                    local_iterator_type1, local_iterator_type2
+                > local_iterator_pair;
+
+            typedef std::integral_constant<bool,
+                    !hpx::traits::is_forward_iterator<SegIter1>::value ||
+                    !hpx::traits::is_forward_iterator<SegIter2>::value
+                > forced_seq;
+
+            segment_iterator1 sit1 = traits1::segment(first1);
+            segment_iterator1 send1 = traits1::segment(last1);
+            segment_iterator2 sit2 = traits2::segment(first2);
+
+            std::vector<future<result_type> > segments;
+            segments.reserve(std::distance(sit1, send1) + 1);
+
+            // Each partition reports the position of its first mismatch, or
+            // last1 together with the end of its part of the second sequence.
+            auto dispatch_segment =
+                [&](segment_iterator1 const& s1, local_iterator_type1 beg1,
+                    local_iterator_type1 end1, segment_iterator2 const& s2,
+                    local_iterator_type2 beg2)
+                {
+                    segments.push_back(hpx::make_future<result_type>(
+                        dispatch_async(traits1::get_id(s1), algo, policy,
+                            forced_seq(), beg1, end1, beg2, op),
+                        [s1, s2, end1, last1](local_iterator_pair const& p)
+                            -> result_type
+                        {
+                            if (p.first != end1)
+                            {
+                                return std::make_pair(
+                                    traits1::compose(s1, p.first),
+                                    traits2::compose(s2, p.second));
+                            }
+                            return std::make_pair(last1,
+                                traits2::compose(s2, p.second));
+                        }));
+                };
+
+            if (sit1 == send1)
+            {
+                // all elements are on the same partition
+                local_iterator_type1 beg1 = traits1::local(first1);
+                local_iterator_type1 end1 = traits1::local(last1);
+                if (beg1 != end1)
+                {
+                    dispatch_segment(sit1, beg1, end1, sit2,
+                        traits2::local(first2));
+                }
+            }
+            else {
+                // handle the remaining part of the first partition
+                local_iterator_type1 beg1 = traits1::local(first1);
+                local_iterator_type1 end1 = traits1::end(sit1);
+                if (beg1 != end1)
+                {
+                    dispatch_segment(sit1, beg1, end1, sit2,
+                        traits2::local(first2));
+                }
+
+                // handle all of the full partitions
+                for (++sit1, ++sit2; sit1 != send1; ++sit1, ++sit2)
+                {
+                    beg1 = traits1::begin(sit1);
+                    end1 = traits1::end(sit1);
+                    if (beg1 != end1)
+                    {
+                        dispatch_segment(sit1, beg1, end1, sit2,
+                            traits2::begin(sit2));
+                    }
+                }
+
+                // handle the beginning of the last partition
+                beg1 = traits1::begin(sit1);
+                end1 = traits1::local(last1);
+                if (beg1 != end1)
+                {
+                    dispatch_segment(sit1, beg1, end1, sit2,
+                        traits2::begin(sit2));
+                }
+                else
+                {
+                    // last1 refers to the beginning of a partition, the
+                    // second sequence ends at the beginning of its
+                    // counterpart
+                    segments.push_back(hpx::make_ready_future(
+                        std::make_pair(last1,
+                            traits2::compose(sit2, traits2::begin(sit2)))));
+                }
+            }
+
+            return result::get(
+                dataflow(
+                    [last1](std::vector<future<result_type> > && r)
+                        -> result_type
+                    {
+                        // handle any remote exceptions, will throw on error
+                        std::list<std::exception_ptr> errors;
+                        parallel::util::detail::handle_remote_exceptions<
+                            ExPolicy
+                        >::call(r, errors);
+
+                        // the first mismatch found, or the end of both
+                        // sequences
+                        result_type res = r.back().get();
+                        for (std::size_t i = 0; i != r.size() - 1; ++i)
+                        {
+                            result_type curr = r[i].get();
+                            if (curr.first != last1)
+                                return curr;
+                        }
+                        return res;
+                    },
+                    std::move(segments)));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // the second sequence is not segmented, use the non-segmented
+        // algorithm
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        typename util::detail::algorithm_result<
+            ExPolicy, std::pair<FwdIter1, FwdIter2>
+        >::type
+        segmented_mismatch_(ExPolicy && policy, FwdIter1 first1,
+            FwdIter1 last1, FwdIter2 first2, Pred && op, std::false_type)
+        {
+            return mismatch_(std::forward<ExPolicy>(policy), first1, last1,
+                first2, std::forward<Pred>(op), std::false_type());
+        }
+
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        typename util::detail::algorithm_result<
+            ExPolicy, std::pair<FwdIter1, FwdIter2>
+        >::type
+        segmented_mismatch_(ExPolicy && policy, FwdIter1 first1,
+            FwdIter1 last1, FwdIter2 first2, Pred && op, std::true_type)
+        {
+            typedef parallel::execution::is_sequenced_execution_policy<
+                    ExPolicy
+                > is_seq;
+
+            typedef hpx::traits::segmented_iterator_traits<FwdIter1> traits1;
+            typedef hpx::traits::segmented_iterator_traits<FwdIter2> traits2;
+            typedef std::pair<
+                    typename traits1::local_iterator,
+                    typename traits2::local_iterator
+                > local_iterator_pair;
+
+            if (first1 == last1)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, std::pair<FwdIter1, FwdIter2>
+                    >::get(std::make_pair(first1, first2));
+            }
+
+            // the partitions can be compared locally only if the partitions
+            // of both sequences line up, otherwise fall back to the
+            // non-segmented algorithm
+            if (!is_same_segmentation(first1, last1, first2))
+            {
+                return mismatch_(std::forward<ExPolicy>(policy), first1,
+                    last1, first2, std::forward<Pred>(op), std::false_type());
+            }
+
+            return segmented_mismatch(mismatch<local_iterator_pair>(),
+                std::forward<ExPolicy>(policy), first1, last1, first2,
+                std::forward<Pred>(op), is_seq());
+        }
+
+        // segmented implementation
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        typename util::detail::algorithm_result<
+            ExPolicy, std::pair<FwdIter1, FwdIter2>
+        >::type
+        mismatch_(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, Pred && op, std::true_type)
+        {
+            typedef hpx::traits::is_segmented_iterator<FwdIter2> is_segmented2;
+
+            return segmented_mismatch_(std::forward<ExPolicy>(policy),
+                first1, last1, first2, std::forward<Pred>(op),
+                is_segmented2());
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        typename util::detail::algorithm_result<
+            ExPolicy, std::pair<FwdIter1, FwdIter2>
+        >::type
+        mismatch_(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, Pred && op, std::false_type);
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented_mismatch_binary
+
+        // the second sequence is not segmented, use the non-segmented
+        // algorithm
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        typename util::detail::algorithm_result<
+            ExPolicy, std::pair<FwdIter1, FwdIter2>
+        >::type
+        segmented_mismatch_binary_(ExPolicy && policy, FwdIter1 first1,
+            FwdIter1 last1, FwdIter2 first2, FwdIter2 last2, Pred && op,
+            std::false_type)
+        {
+            return mismatch_binary_(std::forward<ExPolicy>(policy), first1,
+                last1, first2, last2, std::forward<Pred>(op),
+                std::false_type());
+        }
+
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        typename util::detail::algorithm_result<
+            ExPolicy, std::pair<FwdIter1, FwdIter2>
+        >::type
+        segmented_mismatch_binary_(ExPolicy && policy, FwdIter1 first1,
+            FwdIter1 last1, FwdIter2 first2, FwdIter2 last2, Pred && op,
+            std::true_type)
+        {
+            // compare the elements up to the end of the shorter sequence
+            typedef typename std::iterator_traits<FwdIter1>::difference_type
+                difference_type;
+
+            difference_type count1 = std::distance(first1, last1);
+            difference_type count2 = std::distance(first2, last2);
+            if (count2 < count1)
+            {
+                last1 = first1;
+                std::advance(last1, count2);
+            }
+
+            return segmented_mismatch_(std::forward<ExPolicy>(policy),
+                first1, last1, first2, std::forward<Pred>(op),
+                std::true_type());
+        }
+
+        // segmented implementation
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        typename util::detail::algorithm_result<
+            ExPolicy, std::pair<FwdIter1, FwdIter2>
+        >::type
+        mismatch_binary_(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, FwdIter2 last2, Pred && op, std::true_type)
+        {
+            typedef hpx::traits::is_segmented_iterator<FwdIter2> is_segmented2;
+
+            return segmented_mismatch_binary_(std::forward<ExPolicy>(policy),
+                first1, last1, first2, last2, std::forward<Pred>(op),
+                is_segmented2());
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred>
+        typename util::detail::algorithm_result<
+            ExPolicy, std::pair<FwdIter1, FwdIter2>
+        >::type
+        mismatch_binary_(ExPolicy && policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, FwdIter2 last2, Pred && op, std::false_type);
+
+        /// \endcond
+    }
+}}}
+
+#endif
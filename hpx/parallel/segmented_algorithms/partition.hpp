@@ -0,0 +1,437 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_PARTITION_OCT_19_2017_0735PM)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_PARTITION_OCT_19_2017_0735PM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/dataflow.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/traits/is_iterator.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/partition.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/scatter.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_remote_exceptions.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_partition
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // Partitioning a segmented range is done in two steps: each partition
+        // is partitioned locally first, which yields the number of elements
+        // satisfying the predicate on each of them. This determines the
+        // global partition point. Afterwards, the elements satisfying the
+        // predicate which are located after the partition point are exchanged
+        // with the elements not satisfying it which are located before it.
+
+        // partitions a local range, returns the number of elements for which
+        // the predicate returns true
+        struct seg_partition
+          : public detail::algorithm<seg_partition, std::size_t>
+        {
+            seg_partition()
+              : seg_partition::algorithm("partition")
+            {}
+
+            template <typename ExPolicy, typename FwdIter, typename Pred,
+                typename Proj>
+            static std::size_t
+            sequential(ExPolicy, FwdIter first, FwdIter last, Pred && pred,
+                Proj && proj)
+            {
+                return std::distance(first, sequential_partition(first, last,
+                    std::forward<Pred>(pred), std::forward<Proj>(proj)));
+            }
+
+            template <typename ExPolicy, typename FwdIter, typename Pred,
+                typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::size_t
+            >::type
+            parallel(ExPolicy && policy, FwdIter first, FwdIter last,
+                Pred && pred, Proj && proj)
+            {
+                return util::detail::convert_to_result(
+                    partition_helper::call(std::forward<ExPolicy>(policy),
+                        first, last, std::forward<Pred>(pred),
+                        std::forward<Proj>(proj)),
+                    [first](FwdIter const& it) -> std::size_t
+                    {
+                        return std::distance(first, it);
+                    });
+            }
+        };
+
+        // returns the values of the elements of a local range
+        template <typename T>
+        struct seg_get_values
+          : public detail::algorithm<seg_get_values<T>, std::vector<T> >
+        {
+            seg_get_values()
+              : seg_get_values::algorithm("get_values")
+            {}
+
+            template <typename ExPolicy, typename InIter>
+            static std::vector<T>
+            sequential(ExPolicy, InIter first, InIter last)
+            {
+                return std::vector<T>(first, last);
+            }
+
+            template <typename ExPolicy, typename InIter>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::vector<T>
+            >::type
+            parallel(ExPolicy && policy, InIter first, InIter last)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, std::vector<T>
+                    >::get(sequential(policy, first, last));
+            }
+        };
+
+        // a non-empty local range of a segmented range
+        template <typename SegIter>
+        struct partition_segment
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+
+            typename traits::segment_iterator sit;
+            typename traits::local_iterator beg;
+            typename traits::local_iterator end;
+            std::size_t size;
+        };
+
+        // a range of local indices [first, last) of the given segment
+        struct partition_range
+        {
+            std::size_t segment;
+            std::size_t first;
+            std::size_t last;
+        };
+
+        // returns the non-empty local ranges of [first, last)
+        template <typename SegIter>
+        std::vector<partition_segment<SegIter> >
+        get_partition_segments(SegIter first, SegIter last)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef typename traits::segment_iterator segment_iterator;
+            typedef typename traits::local_iterator local_iterator_type;
+
+            segment_iterator sit = traits::segment(first);
+            segment_iterator send = traits::segment(last);
+
+            std::vector<partition_segment<SegIter> > segments;
+            segments.reserve(std::distance(sit, send) + 1);
+
+            auto add_segment =
+                [&segments](segment_iterator const& seg,
+                    local_iterator_type beg, local_iterator_type end)
+                {
+                    std::size_t size = std::distance(beg, end);
+                    if (size != 0)
+                    {
+                        partition_segment<SegIter> s = { seg, beg, end, size };
+                        segments.push_back(s);
+                    }
+                };
+
+            if (sit == send)
+            {
+                // all elements are on the same partition
+                add_segment(sit, traits::local(first), traits::local(last));
+            }
+            else {
+                // handle the remaining part of the first partition
+                add_segment(sit, traits::local(first), traits::end(sit));
+
+                // handle all of the full partitions
+                for (++sit; sit != send; ++sit)
+                    add_segment(sit, traits::begin(sit), traits::end(sit));
+
+                // handle the beginning of the last partition
+                add_segment(sit, traits::begin(sit), traits::local(last));
+            }
+            return segments;
+        }
+
+        // exchanges the misplaced elements of the locally partitioned
+        // segments, returns the global partition point
+        template <typename ExPolicy, typename SegIter>
+        SegIter segmented_partition_exchange(ExPolicy const& policy,
+            std::vector<partition_segment<SegIter> > const& segments,
+            std::vector<std::size_t> const& counts, SegIter last)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef typename traits::local_iterator local_iterator_type;
+            typedef typename std::iterator_traits<SegIter>::value_type
+                value_type;
+
+            std::size_t num_true = 0;
+            for (std::size_t count : counts)
+                num_true += count;
+
+            // elements satisfying the predicate located after the partition
+            // point, and elements not satisfying it located before it
+            std::vector<partition_range> misplaced_true, misplaced_false;
+
+            std::size_t offset = 0;
+            for (std::size_t i = 0; i != segments.size(); ++i)
+            {
+                std::size_t size = segments[i].size;
+                std::size_t count = counts[i];
+
+                std::size_t first_true = (std::max)(offset, num_true) - offset;
+                if (first_true < count)
+                {
+                    partition_range r = { i, first_true, count };
+                    misplaced_true.push_back(r);
+                }
+
+                if (num_true > offset)
+                {
+                    std::size_t last_false =
+                        (std::min)(size, num_true - offset);
+                    if (count < last_false)
+                    {
+                        partition_range r = { i, count, last_false };
+                        misplaced_false.push_back(r);
+                    }
+                }
+
+                offset += size;
+            }
+
+            // both sets have the same number of elements
+            if (!misplaced_true.empty())
+            {
+                auto get_values =
+                    [&](std::vector<partition_range> const& ranges)
+                    ->  std::vector<future<std::vector<value_type> > >
+                    {
+                        std::vector<future<std::vector<value_type> > > values;
+                        values.reserve(ranges.size());
+                        for (partition_range const& r : ranges)
+                        {
+                            partition_segment<SegIter> const& s =
+                                segments[r.segment];
+                            values.push_back(dispatch_async(
+                                traits::get_id(s.sit),
+                                seg_get_values<value_type>(), policy,
+                                std::true_type(), std::next(s.beg, r.first),
+                                std::next(s.beg, r.last)));
+                        }
+                        return values;
+                    };
+
+                std::vector<future<std::vector<value_type> > > true_values =
+                    get_values(misplaced_true);
+                std::vector<future<std::vector<value_type> > > false_values =
+                    get_values(misplaced_false);
+
+                hpx::wait_all(true_values);
+                hpx::wait_all(false_values);
+
+                // handle any remote exceptions, will throw on error
+                std::list<std::exception_ptr> errors;
+                parallel::util::detail::handle_remote_exceptions<
+                    ExPolicy
+                >::call(true_values, errors);
+                parallel::util::detail::handle_remote_exceptions<
+                    ExPolicy
+                >::call(false_values, errors);
+
+                auto flatten_values =
+                    [](std::vector<future<std::vector<value_type> > >& f)
+                    ->  std::vector<value_type>
+                    {
+                        std::vector<std::vector<value_type> > chunks;
+                        chunks.reserve(f.size());
+                        for (future<std::vector<value_type> >& v : f)
+                            chunks.push_back(v.get());
+                        return detail::flatten(std::move(chunks));
+                    };
+
+                // writes the values to the given ranges, in order
+                std::vector<future<local_iterator_type> > writes;
+                auto put_values =
+                    [&](std::vector<partition_range> const& ranges,
+                        std::vector<value_type> && values)
+                    {
+                        std::size_t pos = 0;
+                        for (partition_range const& r : ranges)
+                        {
+                            partition_segment<SegIter> const& s =
+                                segments[r.segment];
+                            std::size_t count = r.last - r.first;
+                            writes.push_back(dispatch_async(
+                                traits::get_id(s.sit),
+                                seg_scatter<local_iterator_type>(), policy,
+                                std::true_type(), std::next(s.beg, r.first),
+                                std::vector<value_type>(
+                                    std::make_move_iterator(
+                                        values.begin() + pos),
+                                    std::make_move_iterator(
+                                        values.begin() + pos + count))));
+                            pos += count;
+                        }
+                    };
+
+                put_values(misplaced_false, flatten_values(true_values));
+                put_values(misplaced_true, flatten_values(false_values));
+
+                hpx::wait_all(writes);
+
+                // handle any remote exceptions, will throw on error
+                parallel::util::detail::handle_remote_exceptions<
+                    ExPolicy
+                >::call(writes, errors);
+            }
+
+            // the partition point is the position num_true of the range
+            offset = 0;
+            for (partition_segment<SegIter> const& s : segments)
+            {
+                if (num_true < offset + s.size)
+                {
+                    return traits::compose(s.sit,
+                        std::next(s.beg, num_true - offset));
+                }
+                offset += s.size;
+            }
+            return last;
+        }
+
+        // sequential remote implementation
+        template <typename ExPolicy, typename SegIter, typename Pred,
+            typename Proj>
+        static typename util::detail::algorithm_result<ExPolicy, SegIter>::type
+        segmented_partition(ExPolicy const& policy, SegIter first,
+            SegIter last, Pred && pred, Proj && proj, std::true_type)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef util::detail::algorithm_result<ExPolicy, SegIter> result;
+
+            std::vector<partition_segment<SegIter> > segments =
+                get_partition_segments(first, last);
+
+            std::vector<std::size_t> counts;
+            counts.reserve(segments.size());
+            for (partition_segment<SegIter> const& s : segments)
+            {
+                counts.push_back(dispatch(traits::get_id(s.sit),
+                    seg_partition(), policy, std::true_type(), s.beg, s.end,
+                    pred, proj));
+            }
+
+            return result::get(segmented_partition_exchange(
+                policy, segments, counts, last));
+        }
+
+        // parallel remote implementation
+        template <typename ExPolicy, typename SegIter, typename Pred,
+            typename Proj>
+        static typename util::detail::algorithm_result<ExPolicy, SegIter>::type
+        segmented_partition(ExPolicy const& policy, SegIter first,
+            SegIter last, Pred && pred, Proj && proj, std::false_type)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef util::detail::algorithm_result<ExPolicy, SegIter> result;
+
+            typedef std::integral_constant<bool,
+                    !hpx::traits::is_forward_iterator<SegIter>::value
+                > forced_seq;
+
+            std::vector<partition_segment<SegIter> > segments =
+                get_partition_segments(first, last);
+
+            // all partitions are partitioned concurrently
+            std::vector<future<std::size_t> > counts;
+            counts.reserve(segments.size());
+            for (partition_segment<SegIter> const& s : segments)
+            {
+                counts.push_back(dispatch_async(traits::get_id(s.sit),
+                    seg_partition(), policy, forced_seq(), s.beg, s.end,
+                    pred, proj));
+            }
+
+            return result::get(
+                dataflow(
+                    [=](std::vector<future<std::size_t> > && r) -> SegIter
+                    {
+                        // handle any remote exceptions, will throw on error
+                        std::list<std::exception_ptr> errors;
+                        parallel::util::detail::handle_remote_exceptions<
+                            ExPolicy
+                        >::call(r, errors);
+
+                        std::vector<std::size_t> counts;
+                        counts.reserve(r.size());
+                        for (future<std::size_t>& f : r)
+                            counts.push_back(f.get());
+
+                        return segmented_partition_exchange(
+                            policy, segments, counts, last);
+                    },
+                    std::move(counts)));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented implementation
+        template <typename ExPolicy, typename SegIter, typename Pred,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, SegIter>::type
+        partition_(ExPolicy && policy, SegIter first, SegIter last,
+            Pred && pred, Proj && proj, std::true_type)
+        {
+            typedef parallel::execution::is_sequenced_execution_policy<
+                    ExPolicy
+                > is_seq;
+
+            if (first == last)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, SegIter
+                    >::get(std::move(last));
+            }
+
+            return segmented_partition(std::forward<ExPolicy>(policy),
+                first, last, std::forward<Pred>(pred),
+                std::forward<Proj>(proj), is_seq());
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter, typename Pred,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, FwdIter>::type
+        partition_(ExPolicy && policy, FwdIter first, FwdIter last,
+            Pred && pred, Proj && proj, std::false_type);
+
+        /// \endcond
+    }
+}}}
+
+#endif
@@ -0,0 +1,71 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_REMOVE_COPY_OCT_19_2017_0548PM)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_REMOVE_COPY_OCT_19_2017_0548PM
+
+#include <hpx/config.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+
+#include <hpx/parallel/algorithms/remove_copy.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/copy.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_remove_copy_if
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // segmented implementation, the elements for which the predicate
+        // returns false are gathered and written to the destination
+        template <typename ExPolicy, typename SegIter, typename OutIter,
+            typename F, typename Proj>
+        typename util::detail::algorithm_result<
+            ExPolicy, std::pair<SegIter, OutIter>
+        >::type
+        remove_copy_if_(ExPolicy && policy, SegIter first, SegIter last,
+            OutIter dest, F && f, Proj && proj, std::true_type)
+        {
+            typedef parallel::execution::is_sequenced_execution_policy<
+                    ExPolicy
+                > is_seq;
+            typedef typename std::iterator_traits<SegIter>::value_type
+                value_type;
+
+            if (first == last)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, std::pair<SegIter, OutIter>
+                    >::get(std::make_pair(last, dest));
+            }
+
+            return segmented_copy_if(seg_copy_if<value_type, false>(),
+                std::forward<ExPolicy>(policy), first, last, dest,
+                std::forward<F>(f), std::forward<Proj>(proj), is_seq());
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename F, typename Proj>
+        typename util::detail::algorithm_result<
+            ExPolicy, std::pair<FwdIter1, FwdIter2>
+        >::type
+        remove_copy_if_(ExPolicy && policy, FwdIter1 first, FwdIter1 last,
+            FwdIter2 dest, F && f, Proj && proj, std::false_type);
+
+        /// \endcond
+    }
+}}}
+
+#endif
@@ -12,13 +12,16 @@
 
 #include <hpx/parallel/algorithms/detail/dispatch.hpp>
 #include <hpx/parallel/algorithms/transform_reduce.hpp>
+#include <hpx/parallel/algorithms/transform_reduce_binary.hpp>
 #include <hpx/parallel/execution_policy.hpp>
 #include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
 #include <hpx/parallel/segmented_algorithms/detail/reduce.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/segmentation.hpp>
 #include <hpx/parallel/util/detail/algorithm_result.hpp>
 #include <hpx/parallel/util/detail/handle_remote_exceptions.hpp>
 
 #include <algorithm>
+#include <cstddef>
 #include <exception>
 #include <iterator>
 #include <list>
@@ -244,6 +247,284 @@ namespace hpx { namespace parallel { inline namespace v1
         transform_reduce_(ExPolicy&& policy, InIter first, InIter last, T && init,
             Reduce && red_op, Convert && conv_op, std::false_type);
 
+        ///////////////////////////////////////////////////////////////////////
+        // segmented_transform_reduce for two input sequences, the second
+        // sequence has to be partitioned the same way as the first (see
+        // is_same_segmentation below)
+
+        // sequential remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter1,
+            typename SegIter2, typename T, typename Reduce, typename Convert>
+        static typename util::detail::algorithm_result<ExPolicy, T>::type
+        segmented_transform_reduce(Algo && algo, ExPolicy const& policy,
+            SegIter1 first1, SegIter1 last1, SegIter2 first2, T && init,
+            Reduce && red_op, Convert && conv_op, std::true_type)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter1> traits1;
+            typedef typename traits1::segment_iterator segment_iterator1;
+            typedef typename traits1::local_iterator local_iterator_type1;
+            typedef hpx::traits::segmented_iterator_traits<SegIter2> traits2;
+            typedef typename traits2::segment_iterator segment_iterator2;
+            typedef typename traits2::local_iterator local_iterator_type2;
+            typedef util::detail::algorithm_result<ExPolicy, T> result;
+
+            segment_iterator1 sit1 = traits1::segment(first1);
+            segment_iterator1 send1 = traits1::segment(last1);
+            segment_iterator2 sit2 = traits2::segment(first2);
+
+            T overall_result = init;
+
+            if (sit1 == send1)
+            {
+                // all elements are on the same partition
+                local_iterator_type1 beg1 = traits1::local(first1);
+                local_iterator_type1 end1 = traits1::local(last1);
+                local_iterator_type2 beg2 = traits2::local(first2);
+                if (beg1 != end1)
+                {
+                    overall_result = hpx::util::invoke(red_op, overall_result,
+                        dispatch(traits1::get_id(sit1), algo, policy,
+                            std::true_type(), beg1, end1, beg2,
+                            red_op, conv_op));
+                }
+            }
+            else {
+                // handle the remaining part of the first partition
+                local_iterator_type1 beg1 = traits1::local(first1);
+                local_iterator_type1 end1 = traits1::end(sit1);
+                local_iterator_type2 beg2 = traits2::local(first2);
+                if (beg1 != end1)
+                {
+                    overall_result = hpx::util::invoke(red_op, overall_result,
+                        dispatch(traits1::get_id(sit1), algo, policy,
+                            std::true_type(), beg1, end1, beg2,
+                            red_op, conv_op));
+                }
+
+                // handle all of the full partitions
+                for (++sit1, ++sit2; sit1 != send1; ++sit1, ++sit2)
+                {
+                    beg1 = traits1::begin(sit1);
+                    end1 = traits1::end(sit1);
+                    beg2 = traits2::begin(sit2);
+                    if (beg1 != end1)
+                    {
+                        overall_result = hpx::util::invoke(red_op,
+                            overall_result,
+                            dispatch(traits1::get_id(sit1), algo, policy,
+                                std::true_type(), beg1, end1, beg2,
+                                red_op, conv_op));
+                    }
+                }
+
+                // handle the beginning of the last partition
+                beg1 = traits1::begin(sit1);
+                end1 = traits1::local(last1);
+                beg2 = traits2::begin(sit2);
+                if (beg1 != end1)
+                {
+                    overall_result = hpx::util::invoke(red_op, overall_result,
+                        dispatch(traits1::get_id(sit1), algo, policy,
+                            std::true_type(), beg1, end1, beg2,
+                            red_op, conv_op));
+                }
+            }
+
+            return result::get(std::move(overall_result));
+        }
+
+        // parallel remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter1,
+            typename SegIter2, typename T, typename Reduce, typename Convert>
+        static typename util::detail::algorithm_result<ExPolicy, T>::type
+        segmented_transform_reduce(Algo && algo, ExPolicy const& policy,
+            SegIter1 first1, SegIter1 last1, SegIter2 first2, T && init,
+            Reduce && red_op, Convert && conv_op, std::false_type)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter1> traits1;
+            typedef typename traits1::segment_iterator segment_iterator1;
+            typedef typename traits1::local_iterator local_iterator_type1;
+            typedef hpx::traits::segmented_iterator_traits<SegIter2> traits2;
+            typedef typename traits2::segment_iterator segment_iterator2;
+            typedef typename traits2::local_iterator local_iterator_type2;
+            typedef util::detail::algorithm_result<ExPolicy, T> result;
+
+            typedef std::integral_constant<bool,
+                    !hpx::traits::is_forward_iterator<SegIter1>::value ||
+                    !hpx::traits::is_forward_iterator<SegIter2>::value
+                > forced_seq;
+
+            segment_iterator1 sit1 = traits1::segment(first1);
+            segment_iterator1 send1 = traits1::segment(last1);
+            segment_iterator2 sit2 = traits2::segment(first2);
+
+            std::vector<shared_future<T> > segments;
+            segments.reserve(std::distance(sit1, send1));
+
+            if (sit1 == send1)
+            {
+                // all elements are on the same partition
+                local_iterator_type1 beg1 = traits1::local(first1);
+                local_iterator_type1 end1 = traits1::local(last1);
+                local_iterator_type2 beg2 = traits2::local(first2);
+                if (beg1 != end1)
+                {
+                    segments.push_back(
+                        dispatch_async(traits1::get_id(sit1),
+                            algo, policy, forced_seq(),
+                            beg1, end1, beg2, red_op, conv_op)
+                    );
+                }
+            }
+            else {
+                // handle the remaining part of the first partition
+                local_iterator_type1 beg1 = traits1::local(first1);
+                local_iterator_type1 end1 = traits1::end(sit1);
+                local_iterator_type2 beg2 = traits2::local(first2);
+                if (beg1 != end1)
+                {
+                    segments.push_back(
+                        dispatch_async(traits1::get_id(sit1),
+                            algo, policy, forced_seq(),
+                            beg1, end1, beg2, red_op, conv_op)
+                    );
+                }
+
+                // handle all of the full partitions
+                for (++sit1, ++sit2; sit1 != send1; ++sit1, ++sit2)
+                {
+                    beg1 = traits1::begin(sit1);
+                    end1 = traits1::end(sit1);
+                    beg2 = traits2::begin(sit2);
+                    if (beg1 != end1)
+                    {
+                        segments.push_back(
+                            dispatch_async(traits1::get_id(sit1),
+                                algo, policy, forced_seq(),
+                                beg1, end1, beg2, red_op, conv_op)
+                        );
+                    }
+                }
+
+                // handle the beginning of the last partition
+                beg1 = traits1::begin(sit1);
+                end1 = traits1::local(last1);
+                beg2 = traits2::begin(sit2);
+                if (beg1 != end1)
+                {
+                    segments.push_back(
+                        dispatch_async(traits1::get_id(sit1),
+                            algo, policy, forced_seq(),
+                            beg1, end1, beg2, red_op, conv_op)
+                    );
+                }
+            }
+
+            return result::get(
+                dataflow(
+                    [=](std::vector<shared_future<T> > && r) -> T
+                    {
+                        // handle any remote exceptions, will throw on error
+                        std::list<std::exception_ptr> errors;
+                        parallel::util::detail::handle_remote_exceptions<
+                            ExPolicy
+                        >::call(r, errors);
+
+                        // VS2015RC bails out if red_op is capture by ref
+                        return std::accumulate(
+                            r.begin(), r.end(), init,
+                            [=](T const& val, shared_future<T>& curr)
+                            {
+                                return red_op(val, curr.get());
+                            });
+                    },
+                    std::move(segments)));
+        }
+
+        // the second sequence is not segmented, use the non-segmented
+        // algorithm
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename T, typename Reduce, typename Convert>
+        typename util::detail::algorithm_result<
+            ExPolicy, typename hpx::util::decay<T>::type
+        >::type
+        segmented_transform_reduce_binary_(ExPolicy&& policy, FwdIter1 first1,
+            FwdIter1 last1, FwdIter2 first2, T && init, Reduce && red_op,
+            Convert && conv_op, std::false_type)
+        {
+            return transform_reduce_(std::forward<ExPolicy>(policy),
+                first1, last1, first2, std::forward<T>(init),
+                std::forward<Reduce>(red_op), std::forward<Convert>(conv_op),
+                std::false_type());
+        }
+
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename T, typename Reduce, typename Convert>
+        typename util::detail::algorithm_result<
+            ExPolicy, typename hpx::util::decay<T>::type
+        >::type
+        segmented_transform_reduce_binary_(ExPolicy&& policy, FwdIter1 first1,
+            FwdIter1 last1, FwdIter2 first2, T && init, Reduce && red_op,
+            Convert && conv_op, std::true_type)
+        {
+            typedef parallel::execution::is_sequenced_execution_policy<
+                    ExPolicy
+                > is_seq;
+            typedef typename hpx::util::decay<T>::type init_type;
+
+            if (first1 == last1)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, init_type
+                    >::get(std::forward<T>(init));
+            }
+
+            // the partitions can be reduced locally only if the partitions
+            // of both sequences line up, otherwise fall back to the
+            // non-segmented algorithm
+            if (!is_same_segmentation(first1, last1, first2))
+            {
+                return transform_reduce_(std::forward<ExPolicy>(policy),
+                    first1, last1, first2, std::forward<T>(init),
+                    std::forward<Reduce>(red_op),
+                    std::forward<Convert>(conv_op), std::false_type());
+            }
+
+            return segmented_transform_reduce(
+                seg_transform_reduce_binary<init_type>(),
+                std::forward<ExPolicy>(policy), first1, last1, first2,
+                std::forward<T>(init), std::forward<Reduce>(red_op),
+                std::forward<Convert>(conv_op), is_seq());
+        }
+
+        // segmented implementation
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename T, typename Reduce, typename Convert>
+        typename util::detail::algorithm_result<
+            ExPolicy, typename hpx::util::decay<T>::type
+        >::type
+        transform_reduce_(ExPolicy&& policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, T && init, Reduce && red_op, Convert && conv_op,
+            std::true_type)
+        {
+            typedef hpx::traits::is_segmented_iterator<FwdIter2> is_segmented2;
+
+            return segmented_transform_reduce_binary_(
+                std::forward<ExPolicy>(policy), first1, last1, first2,
+                std::forward<T>(init), std::forward<Reduce>(red_op),
+                std::forward<Convert>(conv_op), is_segmented2());
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename T, typename Reduce, typename Convert>
+        typename util::detail::algorithm_result<
+            ExPolicy, typename hpx::util::decay<T>::type
+        >::type
+        transform_reduce_(ExPolicy&& policy, FwdIter1 first1, FwdIter1 last1,
+            FwdIter2 first2, T && init, Reduce && red_op, Convert && conv_op,
+            std::false_type);
+
         /// \endcond
     }
 }}}
@@ -0,0 +1,264 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_UNIQUE_OCT_19_2017_0621PM)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_UNIQUE_OCT_19_2017_0621PM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/dataflow.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/unwrap.hpp>
+
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/unique.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/scatter.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/loop.hpp>
+#include <hpx/parallel/util/partitioner.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { inline namespace v1
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_unique_copy
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // returns the values of the elements of a partition which are not
+        // equivalent to their predecessor, followed by the value of the last
+        // element of the partition
+        template <typename T>
+        struct seg_unique_copy
+          : public detail::algorithm<seg_unique_copy<T>, std::vector<T> >
+        {
+            seg_unique_copy()
+              : seg_unique_copy::algorithm("unique_copy")
+            {}
+
+            template <typename ExPolicy, typename InIter, typename Pred,
+                typename Proj>
+            static std::vector<T>
+            sequential(ExPolicy, InIter first, InIter last, Pred && pred,
+                Proj && proj)
+            {
+                std::vector<T> values;
+                if (first == last)
+                    return values;
+
+                InIter base = first;
+                InIter curr = first;
+
+                values.push_back(*first);
+                while (++first != last)
+                {
+                    using hpx::util::invoke;
+                    if (!invoke(pred, invoke(proj, *base),
+                            invoke(proj, *first)))
+                    {
+                        base = first;
+                        values.push_back(*first);
+                    }
+                    curr = first;
+                }
+
+                values.push_back(*curr);
+                return values;
+            }
+
+            template <typename ExPolicy, typename FwdIter, typename Pred,
+                typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::vector<T>
+            >::type
+            parallel(ExPolicy && policy, FwdIter first, FwdIter last,
+                Pred && pred, Proj && proj)
+            {
+                typedef util::detail::algorithm_result<
+                        ExPolicy, std::vector<T>
+                    > result;
+
+                std::size_t count = std::distance(first, last);
+                if (count < 2)
+                {
+                    return result::get(sequential(policy, first, last,
+                        std::forward<Pred>(pred), std::forward<Proj>(proj)));
+                }
+
+                FwdIter back = first;
+                std::advance(back, count - 1);
+
+                // each element is compared with the one following it
+                return util::partitioner<ExPolicy, std::vector<T> >::call(
+                    std::forward<ExPolicy>(policy), first, count - 1,
+                    [pred, proj](FwdIter part_begin, std::size_t part_size)
+                    ->  std::vector<T>
+                    {
+                        std::vector<T> values;
+
+                        // MSVC complains if pred or proj is captured by ref
+                        util::loop_n<ExPolicy>(part_begin, part_size,
+                            [&values, pred, proj](FwdIter const& curr)
+                            {
+                                using hpx::util::invoke;
+
+                                FwdIter next = curr;
+                                if (!invoke(pred, invoke(proj, *curr),
+                                        invoke(proj, *++next)))
+                                {
+                                    values.push_back(*next);
+                                }
+                            });
+                        return values;
+                    },
+                    hpx::util::unwrapping(
+                        [first, back](std::vector<std::vector<T> > && results)
+                        ->  std::vector<T>
+                        {
+                            results.insert(results.begin(),
+                                std::vector<T>(1, *first));
+                            results.push_back(std::vector<T>(1, *back));
+                            return detail::flatten(std::move(results));
+                        }));
+            }
+        };
+
+        // Combines the values gathered from the partitions. The first value
+        // of a partition is dropped if it is equivalent to the last element
+        // of the partition before it.
+        template <typename T, typename Pred, typename Proj>
+        std::vector<T> merge_unique(std::vector<std::vector<T> > && chunks,
+            Pred const& pred, Proj const& proj)
+        {
+            std::size_t size = 0;
+            for (std::vector<T> const& chunk : chunks)
+                size += chunk.size() - 1;
+
+            std::vector<T> values;
+            values.reserve(size);
+            for (std::size_t i = 0; i != chunks.size(); ++i)
+            {
+                // the last value is the last element of the partition
+                typename std::vector<T>::iterator beg = chunks[i].begin();
+                typename std::vector<T>::iterator end = chunks[i].end() - 1;
+
+                using hpx::util::invoke;
+                if (i != 0 && invoke(pred, invoke(proj, chunks[i - 1].back()),
+                        invoke(proj, *beg)))
+                {
+                    ++beg;
+                }
+
+                values.insert(values.end(), std::make_move_iterator(beg),
+                    std::make_move_iterator(end));
+            }
+            return values;
+        }
+
+        // sequential remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter,
+            typename OutIter, typename Pred, typename Proj>
+        static typename util::detail::algorithm_result<
+            ExPolicy, std::pair<SegIter, OutIter>
+        >::type
+        segmented_unique_copy(Algo && algo, ExPolicy const& policy,
+            SegIter first, SegIter last, OutIter dest, Pred && pred,
+            Proj && proj, std::true_type)
+        {
+            typedef util::detail::algorithm_result<
+                    ExPolicy, std::pair<SegIter, OutIter>
+                > result;
+            typedef hpx::traits::is_segmented_iterator<OutIter> is_segmented;
+
+            dest = segmented_scatter(policy, dest,
+                merge_unique(segmented_gather(std::forward<Algo>(algo),
+                    policy, first, last, std::true_type(), pred, proj),
+                    pred, proj),
+                is_segmented());
+
+            return result::get(std::make_pair(last, dest));
+        }
+
+        // parallel remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter,
+            typename OutIter, typename Pred, typename Proj>
+        static typename util::detail::algorithm_result<
+            ExPolicy, std::pair<SegIter, OutIter>
+        >::type
+        segmented_unique_copy(Algo && algo, ExPolicy const& policy,
+            SegIter first, SegIter last, OutIter dest, Pred && pred,
+            Proj && proj, std::false_type)
+        {
+            typedef util::detail::algorithm_result<
+                    ExPolicy, std::pair<SegIter, OutIter>
+                > result;
+            typedef hpx::traits::is_segmented_iterator<OutIter> is_segmented;
+            typedef typename hpx::util::decay<Algo>::type::result_type
+                chunk_type;
+
+            return result::get(
+                dataflow(
+                    [=](future<std::vector<chunk_type> > && f)
+                    ->  std::pair<SegIter, OutIter>
+                    {
+                        return std::make_pair(last,
+                            segmented_scatter(policy, dest,
+                                merge_unique(f.get(), pred, proj),
+                                is_segmented()));
+                    },
+                    segmented_gather(std::forward<Algo>(algo), policy,
+                        first, last, std::false_type(), pred, proj)));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented implementation
+        template <typename ExPolicy, typename SegIter, typename OutIter,
+            typename Pred, typename Proj>
+        typename util::detail::algorithm_result<
+            ExPolicy, std::pair<SegIter, OutIter>
+        >::type
+        unique_copy_(ExPolicy && policy, SegIter first, SegIter last,
+            OutIter dest, Pred && pred, Proj && proj, std::true_type)
+        {
+            typedef parallel::execution::is_sequenced_execution_policy<
+                    ExPolicy
+                > is_seq;
+            typedef typename std::iterator_traits<SegIter>::value_type
+                value_type;
+
+            if (first == last)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, std::pair<SegIter, OutIter>
+                    >::get(std::make_pair(last, dest));
+            }
+
+            return segmented_unique_copy(seg_unique_copy<value_type>(),
+                std::forward<ExPolicy>(policy), first, last, dest,
+                std::forward<Pred>(pred), std::forward<Proj>(proj), is_seq());
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename FwdIter1, typename FwdIter2,
+            typename Pred, typename Proj>
+        typename util::detail::algorithm_result<
+            ExPolicy, std::pair<FwdIter1, FwdIter2>
+        >::type
+        unique_copy_(ExPolicy && policy, FwdIter1 first, FwdIter1 last,
+            FwdIter2 dest, Pred && pred, Proj && proj, std::false_type);
+
+        /// \endcond
+    }
+}}}
+
+#endif
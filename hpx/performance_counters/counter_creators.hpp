@@ -143,6 +143,25 @@ namespace hpx { namespace performance_counters
         counter_info const&, discover_counter_func const&,
         discover_counters_mode, error_code&);
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Creation function for the counters of the adaptive execution of
+    // actions received in parcels.
+    HPX_API_EXPORT naming::gid_type direct_action_execution_counter_creator(
+        counter_info const&, error_code&);
+
+    // Discoverer function for the counters of the adaptive execution of
+    // actions received in parcels.
+    HPX_API_EXPORT bool direct_action_execution_counter_discoverer(
+        counter_info const&, discover_counter_func const&,
+        discover_counters_mode, error_code&);
+
+    HPX_API_EXPORT naming::gid_type scheduled_action_execution_counter_creator(
+        counter_info const&, error_code&);
+
+    HPX_API_EXPORT bool scheduled_action_execution_counter_discoverer(
+        counter_info const&, discover_counter_func const&,
+        discover_counters_mode, error_code&);
+
 #if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
     ///////////////////////////////////////////////////////////////////////////
     // Creation function for per-action parcel data counters
@@ -158,6 +177,15 @@ namespace hpx { namespace performance_counters
         counter_info const& info, discover_counter_func const& f,
         discover_counters_mode mode, error_code& ec);
 #endif
+
+#if defined(HPX_HAVE_PERF_EVENT_COUNTERS)
+    ///////////////////////////////////////////////////////////////////////////
+    // Creation function for the counters exposing the hardware events
+    // attributed to HPX threads (the thread description has to be specified
+    // as the counter parameter).
+    HPX_API_EXPORT naming::gid_type perf_event_counter_creator(
+        counter_info const&, error_code&);
+#endif
 }}
 
 #endif
@@ -0,0 +1,182 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_ACTIONS_ADAPTIVE_DIRECT_EXECUTION_APR_28_2017_1012AM)
+#define HPX_ACTIONS_ADAPTIVE_DIRECT_EXECUTION_APR_28_2017_1012AM
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/naming/address.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
+#include <hpx/runtime/threads/thread_enums.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace hpx { namespace actions { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Return whether actions received in parcels which are not marked for
+    // direct execution may still be executed directly if they have been
+    // found to be short (hpx.parcel.adaptive_direct_execution).
+    HPX_API_EXPORT bool adaptive_direct_execution_enabled();
+
+    // Return the average execution time (in nanoseconds) below which an
+    // action is executed directly (hpx.parcel.direct_execution_threshold).
+    HPX_API_EXPORT std::int64_t get_direct_execution_threshold();
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Moving average of the execution times measured for one action type
+    class execution_time_estimate
+    {
+    public:
+        execution_time_estimate()
+          : average_(-1), skipped_(0), direct_(0), suspends_(false)
+        {}
+
+        // Return whether the action is known to execute in less than the
+        // given time (in nanoseconds)
+        bool is_below(std::int64_t threshold) const
+        {
+            std::int64_t average = average_.load(boost::memory_order_relaxed);
+            return average >= 0 && average < threshold;
+        }
+
+        // Concurrent updates may lose a sample, which is acceptable for an
+        // estimate.
+        void add_sample(std::int64_t time)
+        {
+            std::int64_t average = average_.load(boost::memory_order_relaxed);
+            if (average < 0)
+                average = time;
+            else
+                average += (time - average) / 8;
+
+            average_.store(average, boost::memory_order_relaxed);
+        }
+
+        // Return whether the next scheduled execution should be measured.
+        // Actions which are known to take much longer than the given time
+        // (in nanoseconds) are not candidates for direct execution, those are
+        // measured only occasionally to notice if they become shorter.
+        bool needs_sample(std::int64_t threshold)
+        {
+            std::int64_t average = average_.load(boost::memory_order_relaxed);
+            if (average < 2 * threshold)
+                return true;
+
+            return (skipped_.fetch_add(1, boost::memory_order_relaxed) %
+                sample_interval) == 0;
+        }
+
+        // Return whether the action was seen to suspend while it was
+        // executed. Such an action must not be executed on an OS-thread.
+        bool may_suspend() const
+        {
+            return suspends_.load(boost::memory_order_relaxed);
+        }
+
+        void set_suspends()
+        {
+            suspends_.store(true, boost::memory_order_relaxed);
+        }
+
+        // Return whether an invocation which could be executed directly on
+        // an OS-thread should be scheduled instead. This verifies once every
+        // sample_interval invocations that the action still does not suspend.
+        bool needs_recheck()
+        {
+            return (direct_.fetch_add(1, boost::memory_order_relaxed) %
+                sample_interval) == sample_interval - 1;
+        }
+
+    private:
+        static constexpr std::uint64_t sample_interval = 64;
+
+        boost::atomic<std::int64_t> average_;
+        boost::atomic<std::uint64_t> skipped_;
+        boost::atomic<std::uint64_t> direct_;
+        boost::atomic<bool> suspends_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Feeds the execution time of an action into the given estimate, and
+    // whether the executing HPX thread was suspended in between.
+    class execution_timer
+    {
+    public:
+        explicit execution_timer(execution_time_estimate& estimate)
+          : estimate_(estimate)
+          , id_(threads::get_self_ptr() != nullptr ?
+                threads::get_self_id() : threads::invalid_thread_id)
+          , phase_(id_ ? threads::get_thread_phase(id_) : 0)
+          , start_(util::high_resolution_clock::now())
+        {}
+
+        void stop()
+        {
+            estimate_.add_sample(static_cast<std::int64_t>(
+                util::high_resolution_clock::now() - start_));
+
+            // the phase is incremented whenever the thread is resumed
+            if (id_ && threads::get_thread_phase(id_) != phase_)
+                estimate_.set_suspends();
+        }
+
+    private:
+        execution_time_estimate& estimate_;
+        threads::thread_id_type id_;
+        std::size_t phase_;
+        std::uint64_t start_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Function object directly executing the given action, used to trigger
+    // a continuation with the result of an action executed directly.
+    template <typename Action>
+    struct direct_execution_invoker
+    {
+        template <typename ...Ts>
+        auto operator()(naming::address::address_type lva,
+                naming::address::component_type comptype, Ts&&... vs) const
+        ->  decltype(Action::execute_function(lva, comptype,
+                std::forward<Ts>(vs)...))
+        {
+            return Action::execute_function(lva, comptype,
+                std::forward<Ts>(vs)...);
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Thread function feeding the execution time of the wrapped thread
+    // function (and whether it suspended) into the given estimate.
+    struct timed_thread_function
+    {
+        timed_thread_function(execution_time_estimate& estimate,
+                threads::thread_function_type && f)
+          : estimate_(&estimate), f_(std::move(f))
+        {}
+
+        threads::thread_result_type operator()(
+            threads::thread_state_ex_enum state)
+        {
+            execution_timer timer(*estimate_);
+            threads::thread_result_type result = f_(state);
+
+            timer.stop();
+            return result;
+        }
+
+    private:
+        execution_time_estimate* estimate_;
+        threads::thread_function_type f_;
+    };
+}}}
+
+#endif
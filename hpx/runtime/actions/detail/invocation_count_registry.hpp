@@ -37,6 +37,8 @@ namespace hpx { namespace actions { namespace detail
 
         static invocation_count_registry& local_instance();
         static invocation_count_registry& remote_instance();
+        static invocation_count_registry& direct_instance();
+        static invocation_count_registry& scheduled_instance();
 
         void register_class(std::string const& name, get_invocation_count_type fun);
 
@@ -52,9 +54,14 @@ namespace hpx { namespace actions { namespace detail
     private:
         struct local_tag {};
         struct remote_tag {};
+        struct direct_tag {};
+        struct scheduled_tag {};
 
         friend struct hpx::util::static_<invocation_count_registry, local_tag>;
         friend struct hpx::util::static_<invocation_count_registry, remote_tag>;
+        friend struct hpx::util::static_<invocation_count_registry, direct_tag>;
+        friend struct hpx::util::static_<
+            invocation_count_registry, scheduled_tag>;
 
         map_type map_;
     };
@@ -67,6 +74,11 @@ namespace hpx { namespace actions { namespace detail
     void register_remote_action_invocation_count(
         invocation_count_registry& registry);
 
+    template <typename Action>
+    void register_action_execution_counts(
+        invocation_count_registry& direct_registry,
+        invocation_count_registry& scheduled_registry);
+
     template <typename Action>
     struct register_action_invocation_count
     {
@@ -77,6 +89,10 @@ namespace hpx { namespace actions { namespace detail
 
             register_remote_action_invocation_count<Action>(
                 invocation_count_registry::remote_instance());
+
+            register_action_execution_counts<Action>(
+                invocation_count_registry::direct_instance(),
+                invocation_count_registry::scheduled_instance());
         }
 
         static register_action_invocation_count instance;
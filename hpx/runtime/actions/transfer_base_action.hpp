@@ -13,12 +13,14 @@
 #include <hpx/runtime/actions_fwd.hpp>
 #include <hpx/runtime/actions/action_support.hpp>
 #include <hpx/runtime/actions/base_action.hpp>
+#include <hpx/runtime/actions/detail/adaptive_direct_execution.hpp>
 #include <hpx/runtime/actions/detail/invocation_count_registry.hpp>
 #include <hpx/runtime/components/pinned_ptr.hpp>
 #include <hpx/runtime/get_locality_id.hpp>
 #include <hpx/runtime/serialization/base_object.hpp>
 #include <hpx/runtime/serialization/input_archive.hpp>
 #include <hpx/runtime/serialization/output_archive.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
 #include <hpx/traits/action_does_termination_detection.hpp>
 #include <hpx/traits/action_message_handler.hpp>
 #include <hpx/traits/action_was_object_migrated.hpp>
@@ -250,6 +252,20 @@ namespace hpx { namespace actions
             return util::get_and_reset_value(invocation_count_, reset);
         }
 
+        /// Extract the number of times this action was executed directly
+        /// instead of on a new thread because it has been found to be short
+        static std::int64_t get_direct_execution_count(bool reset)
+        {
+            return util::get_and_reset_value(direct_execution_count_, reset);
+        }
+
+        /// Extract the number of times this action was executed on a new
+        /// thread because it has not been found to be short
+        static std::int64_t get_scheduled_execution_count(bool reset)
+        {
+            return util::get_and_reset_value(scheduled_execution_count_, reset);
+        }
+
         // serialization support
         // loading ...
         void load_base(hpx::serialization::input_archive & ar)
@@ -309,18 +325,69 @@ namespace hpx { namespace actions
 
     private:
         static boost::atomic<std::int64_t> invocation_count_;
+        static boost::atomic<std::int64_t> direct_execution_count_;
+        static boost::atomic<std::int64_t> scheduled_execution_count_;
+        static detail::execution_time_estimate execution_time_;
 
     protected:
         static void increment_invocation_count()
         {
             ++invocation_count_;
         }
+
+        // Decide whether an action which is not a direct action should be
+        // executed directly anyways, based on the execution times measured
+        // for earlier invocations. This is used only if
+        // hpx.parcel.adaptive_direct_execution is set.
+        //
+        // Parcels may be decoded on OS-threads (the io threads of the TCP
+        // parcelport). Those have a large stack, but they can't suspend, thus
+        // only actions which were never seen suspending are executed there.
+        // Every now and then such an action is scheduled instead to verify
+        // that this is still the case.
+        static bool execute_directly()
+        {
+            if (execution_time_.is_below(
+                    detail::get_direct_execution_threshold()))
+            {
+                bool direct = threads::get_self_ptr() == nullptr ?
+                    !execution_time_.may_suspend() &&
+                        !execution_time_.needs_recheck() :
+                    this_thread::has_sufficient_stack_space();
+
+                if (direct)
+                {
+                    ++direct_execution_count_;
+                    return true;
+                }
+            }
+
+            ++scheduled_execution_count_;
+            return false;
+        }
+
+        static detail::execution_time_estimate& get_execution_time_estimate()
+        {
+            return execution_time_;
+        }
     };
 
     template <typename Action>
     boost::atomic<std::int64_t>
         transfer_base_action<Action>::invocation_count_(0);
 
+    template <typename Action>
+    boost::atomic<std::int64_t>
+        transfer_base_action<Action>::direct_execution_count_(0);
+
+    template <typename Action>
+    boost::atomic<std::int64_t>
+        transfer_base_action<Action>::scheduled_execution_count_(0);
+
+    template <typename Action>
+    detail::execution_time_estimate
+        transfer_base_action<Action>::execution_time_;
+
     namespace detail
     {
         template <typename Action>
@@ -332,6 +399,21 @@ namespace hpx { namespace actions
                 &transfer_base_action<Action>::get_invocation_count
             );
         }
+
+        template <typename Action>
+        void register_action_execution_counts(
+            invocation_count_registry& direct_registry,
+            invocation_count_registry& scheduled_registry)
+        {
+            direct_registry.register_class(
+                hpx::actions::detail::get_action_name<Action>(),
+                &transfer_base_action<Action>::get_direct_execution_count
+            );
+            scheduled_registry.register_class(
+                hpx::actions::detail::get_action_name<Action>(),
+                &transfer_base_action<Action>::get_scheduled_execution_count
+            );
+        }
     }
 
     ///////////////////////////////////////////////////////////////////////////
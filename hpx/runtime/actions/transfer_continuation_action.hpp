@@ -12,7 +12,9 @@
 
 #include <hpx/config.hpp>
 #include <hpx/runtime/actions/continuation.hpp>
+#include <hpx/runtime/actions/detail/adaptive_direct_execution.hpp>
 #include <hpx/runtime/actions/transfer_base_action.hpp>
+#include <hpx/runtime/actions/trigger.hpp>
 #include <hpx/runtime/applier/apply_helper.hpp>
 #include <hpx/runtime/parcelset/detail/per_action_data_counter_registry.hpp>
 #include <hpx/runtime/serialization/serialization_fwd.hpp>
@@ -176,9 +178,52 @@ namespace hpx { namespace actions
             reinterpret_cast<threads::thread_id_repr_type>(this->parent_id_);
         data.parent_locality_id = this->parent_locality_;
 #endif
-        applier::detail::apply_helper<typename base_type::derived_type>::call(
-            std::move(data), std::move(cont_), target, lva, comptype,
-            this->priority_, std::move(util::get<Is>(this->arguments_))...);
+
+        typedef typename base_type::derived_type derived_type;
+        if (base_type::direct_execution::value ||
+            !detail::adaptive_direct_execution_enabled())
+        {
+            applier::detail::apply_helper<derived_type>::call(
+                std::move(data), std::move(cont_), target, lva, comptype,
+                this->priority_, std::move(util::get<Is>(this->arguments_))...);
+            return;
+        }
+
+        // decide based on the execution times measured so far, keep
+        // measuring as long as the action is a candidate
+        detail::execution_time_estimate& estimate =
+            this->get_execution_time_estimate();
+
+        if (this->execute_directly())
+        {
+            detail::execution_timer timer(estimate);
+
+            // this handles actions returning futures as well
+            actions::trigger(std::move(cont_),
+                detail::direct_execution_invoker<derived_type>(), lva, comptype,
+                std::move(util::get<Is>(this->arguments_))...);
+
+            timer.stop();
+        }
+        else
+        {
+            typedef applier::detail::apply_helper<derived_type, false>
+                apply_helper_type;
+
+            data.func = apply_helper_type::get_thread_function(
+                std::move(cont_), target, lva, comptype,
+                std::move(util::get<Is>(this->arguments_))...);
+
+            // measure only actions which may turn out to be short
+            if (estimate.needs_sample(detail::get_direct_execution_threshold()))
+            {
+                data.func = detail::timed_thread_function(
+                    estimate, std::move(data.func));
+            }
+
+            apply_helper_type::schedule(
+                std::move(data), lva, comptype, this->priority_);
+        }
     }
 
     template <typename Action>
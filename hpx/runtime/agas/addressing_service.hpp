@@ -18,6 +18,7 @@
 #include <hpx/runtime/agas_fwd.hpp>
 #include <hpx/runtime/agas/gva.hpp>
 #include <hpx/runtime/agas/component_namespace.hpp>
+#include <hpx/runtime/agas/detail/worker_refcnt_requests.hpp>
 #include <hpx/runtime/agas/locality_namespace.hpp>
 #include <hpx/runtime/agas/symbol_namespace.hpp>
 #include <hpx/runtime/agas/primary_namespace.hpp>
@@ -30,6 +31,7 @@
 #include <hpx/util/cache/statistics/local_full_statistics.hpp>
 #include <hpx/util_fwd.hpp>
 #include <hpx/util/function.hpp>
+#include <hpx/util/interval_timer.hpp>
 
 #include <boost/atomic.hpp>
 #include <boost/dynamic_bitset.hpp>
@@ -98,10 +100,23 @@ public:
 
     mutex_type refcnt_requests_mtx_;
     std::size_t refcnt_requests_count_;
-    bool enable_refcnt_caching_;
+    boost::atomic<bool> enable_refcnt_caching_;
 
     std::shared_ptr<refcnt_requests_type> refcnt_requests_;
 
+    // decrements buffered per worker thread before being merged into
+    // refcnt_requests_
+    std::size_t const max_worker_refcnt_requests_;
+    std::vector<std::unique_ptr<detail::worker_refcnt_requests> >
+        worker_refcnt_requests_;
+
+    // sends the pending requests periodically
+    std::int64_t const refcnt_flush_interval_;
+    std::unique_ptr<util::interval_timer> refcnt_flush_timer_;
+
+    boost::atomic<std::int64_t> decref_messages_;
+    boost::atomic<std::int64_t> decref_messages_avoided_;
+
     service_mode const service_type;
     runtime_mode const runtime_type;
 
@@ -200,6 +215,10 @@ public:
         error_code& ec = throws
         );
 
+    /// \brief Start sending the buffered credit decrements periodically
+    ///        (every hpx.agas.refcnt_flush_interval milliseconds).
+    void start_refcnt_flush_timer();
+
     std::int64_t synchronize_with_async_incref(
         hpx::future<std::int64_t> fut
       , naming::id_type const& id
@@ -241,6 +260,22 @@ protected:
         );
 
 private:
+    /// Move the decrements buffered by the given worker thread (all worker
+    /// threads if -1) to the pending requests. Assumes that
+    /// \a refcnt_requests_mtx_ is locked.
+    void merge_worker_refcnt_requests(
+        std::unique_lock<mutex_type>& l
+      , std::size_t num_thread = std::size_t(-1)
+        );
+
+    /// Invoked by the flush timer.
+    bool flush_refcnt_requests();
+
+    void update_decref_statistics(
+        std::size_t requests
+      , std::size_t messages
+        );
+
     /// Assumes that \a refcnt_requests_mtx_ is locked.
     void send_refcnt_requests(
         std::unique_lock<mutex_type>& l
@@ -282,6 +317,10 @@ private:
     std::uint64_t get_cache_update_entry_time(bool reset);
     std::uint64_t get_cache_erase_entry_time(bool reset);
 
+    // Helper functions to access the statistics of the sent decrements
+    std::int64_t get_decref_messages(bool reset);
+    std::int64_t get_decref_messages_avoided(bool reset);
+
 public:
     /// \brief Add a locality to the runtime.
     bool register_locality(
@@ -0,0 +1,107 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_AGAS_DETAIL_WORKER_REFCNT_REQUESTS_APR_24_2017_0930AM)
+#define HPX_AGAS_DETAIL_WORKER_REFCNT_REQUESTS_APR_24_2017_0930AM
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/naming/name.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace agas { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Credit decrements issued by the HPX threads running on one worker
+    // thread. The buffer is claimed by a single atomic operation, neither
+    // appending nor collecting the requests ever suspends, thus claiming it
+    // can only have to wait for another OS thread collecting the requests.
+    class worker_refcnt_requests
+    {
+    public:
+        HPX_NON_COPYABLE(worker_refcnt_requests);
+
+        typedef std::vector<std::pair<naming::gid_type, std::int64_t> >
+            requests_type;
+
+    private:
+        enum state { idle = 0, writing = 1, collecting = 2 };
+
+        void acquire(int desired)
+        {
+            int expected = idle;
+            while (!state_.compare_exchange_weak(expected, desired,
+                boost::memory_order_acquire))
+            {
+                expected = idle;
+            }
+        }
+
+        void release()
+        {
+            state_.store(idle, boost::memory_order_release);
+        }
+
+    public:
+        worker_refcnt_requests()
+          : state_(idle), size_(0)
+        {}
+
+        // Add a decrement of the given number of credits, returns the number
+        // of buffered requests.
+        std::size_t append(naming::gid_type const& gid, std::int64_t credits)
+        {
+            acquire(writing);
+
+            requests_.push_back(std::make_pair(gid, -credits));
+            std::size_t size = requests_.size();
+            size_.store(size, boost::memory_order_relaxed);
+
+            release();
+            return size;
+        }
+
+        // Move all buffered requests to the end of the given vector.
+        void collect(requests_type& requests)
+        {
+            if (empty())
+                return;
+
+            acquire(collecting);
+
+            if (requests.empty())
+            {
+                requests.swap(requests_);
+            }
+            else
+            {
+                requests.insert(requests.end(),
+                    requests_.begin(), requests_.end());
+                requests_.clear();
+            }
+            size_.store(0, boost::memory_order_relaxed);
+
+            release();
+        }
+
+        // The result may be outdated by the time it is used.
+        bool empty() const
+        {
+            return size_.load(boost::memory_order_relaxed) == 0;
+        }
+
+    private:
+        boost::atomic<int> state_;
+        boost::atomic<std::size_t> size_;
+        requests_type requests_;
+    };
+}}}
+
+#endif
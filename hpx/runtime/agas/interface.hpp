@@ -308,6 +308,16 @@ inline naming::address resolve_sync(
 }
 #endif
 
+// Resolve the given ids using only locally available information (the AGAS
+// cache and addresses known without asking AGAS). The entries of addrs for
+// ids which could not be resolved are left invalid. Returns whether all ids
+// have been resolved.
+HPX_API_EXPORT bool resolve_cached(
+    std::vector<naming::id_type> const& ids
+  , std::vector<naming::address>& addrs
+  , error_code& ec = throws
+    );
+
 HPX_API_EXPORT hpx::future<bool> bind(
     naming::gid_type const& gid
   , naming::address const& addr
@@ -133,21 +133,140 @@ struct HPX_EXPORT primary_namespace
     // }}}
 
   private:
-    // REVIEW: Separate mutexes might reduce contention here. This has to be
-    // investigated carefully.
-    mutex_type mutex_;
-
-    gva_table_type gvas_;
-    refcnt_table_type refcnts_;
     typedef std::map<
             naming::gid_type,
             hpx::util::tuple<bool, std::size_t, lcos::local::condition_variable_any>
         > migration_table_type;
 
+    // A small cache of recently resolved ranges which is read without
+    // acquiring the lock of its shard. Every entry is guarded by a sequence
+    // number which is odd while the entry is being modified (seqlock).
+    // Entries are modified only while the lock of the shard is held.
+    struct resolve_cache
+    {
+        struct entry
+        {
+            entry()
+              : seq_(0)
+            {
+                for (boost::atomic<std::uint64_t>& d : data_)
+                    d.store(0, boost::memory_order_relaxed);
+            }
+
+            boost::atomic<std::uint64_t> seq_;
+
+            // base gid, gva and locality of the cached range, an entry with
+            // a zero count is empty
+            boost::atomic<std::uint64_t> data_[10];
+        };
+
+        static std::size_t get_index(naming::gid_type const& id)
+        {
+            return std::size_t((id.get_lsb() * 0x9e3779b97f4a7c15ull) >> 32) &
+                (HPX_AGAS_PRIMARY_NAMESPACE_CACHE_SIZE - 1);
+        }
+
+        // look up the range holding the (stripped) id, does not lock
+        bool find(naming::gid_type const& id, resolved_type& r) const;
+
+        // all of these expect the lock of the shard to be held
+        void insert(naming::gid_type const& id, resolved_type const& r);
+        void invalidate(naming::gid_type const& base);
+        void clear();
+
+        entry entries_[HPX_AGAS_PRIMARY_NAMESPACE_CACHE_SIZE];
+    };
+
+    // The GVA table is split into shards, each shard holds the ranges of
+    // gids which overlap one of its chunks of consecutive gids (see
+    // get_shard_index). A range spanning more than one chunk is stored in
+    // all of the corresponding shards, thus every (range) lookup is served
+    // by the shard of the looked up gid. The migration state of an object
+    // is kept with its GVA as waiting for a migration to finish and
+    // resolving the gid afterwards has to happen under the same lock.
+    struct gva_shard
+    {
+        gva_shard()
+          : migrations_(0)
+        {}
+
+        mutex_type mtx_;
+        gva_table_type gvas_;
+        migration_table_type migrating_objects_;
+
+        // number of objects currently being migrated, the cache is bypassed
+        // while this is not zero
+        boost::atomic<std::size_t> migrations_;
+        resolve_cache cache_;
+    };
+
+    // The reference counts are sharded the same way, but are protected by
+    // separate locks, decrements do not block concurrent resolves.
+    struct refcnt_shard
+    {
+        mutex_type mtx_;
+        refcnt_table_type refcnts_;
+    };
+
+    // Consecutive chunks of 2^HPX_AGAS_PRIMARY_NAMESPACE_SHARD_SHIFT gids
+    // are assigned to consecutive shards. All gids handled by one instance
+    // share their MSB (the prefix of its locality), it only selects the
+    // shard the first chunk is assigned to.
+    static std::size_t get_shard_index(naming::gid_type const& id)
+    {
+        std::uint64_t msb =
+            naming::detail::strip_internal_bits_from_gid(id.get_msb());
+        msb *= 0x9e3779b97f4a7c15ull;
+        return std::size_t((msb >> 32) +
+                (id.get_lsb() >> HPX_AGAS_PRIMARY_NAMESPACE_SHARD_SHIFT)) &
+            (HPX_AGAS_PRIMARY_NAMESPACE_SHARDS - 1);
+    }
+
+    // Lockable guarding all GVA shards holding (a part of) the range of
+    // 'count' gids starting at 'id'. The shards are locked in the order of
+    // their indices to avoid deadlocks between overlapping ranges.
+    class gva_shards_lock
+    {
+    public:
+        gva_shards_lock(primary_namespace& ns, naming::gid_type const& id,
+                std::uint64_t count);
+
+        void lock();
+        void unlock();
+
+        // invoke f for all shards covered by the range
+        template <typename F>
+        void for_each_shard(F && f)
+        {
+            for (std::size_t i = 0; i != num_shards_; ++i)
+            {
+                f(ns_.gva_shards_[
+                    (first_ + i) & (HPX_AGAS_PRIMARY_NAMESPACE_SHARDS - 1)]);
+            }
+        }
+
+    private:
+        primary_namespace& ns_;
+        std::size_t first_;
+        std::size_t num_shards_;
+    };
+
+    gva_shard& get_gva_shard(naming::gid_type const& id)
+    {
+        return gva_shards_[get_shard_index(id)];
+    }
+
+    refcnt_shard& get_refcnt_shard(naming::gid_type const& id)
+    {
+        return refcnt_shards_[get_shard_index(id)];
+    }
+
+    gva_shard gva_shards_[HPX_AGAS_PRIMARY_NAMESPACE_SHARDS];
+    refcnt_shard refcnt_shards_[HPX_AGAS_PRIMARY_NAMESPACE_SHARDS];
+
     std::string instance_name_;
     naming::gid_type next_id_;      // next available gid
     naming::gid_type locality_;     // our locality id
-    migration_table_type migrating_objects_;
 
     struct update_time_on_exit;
 
@@ -226,8 +345,7 @@ struct HPX_EXPORT primary_namespace
     /// Dump the credit counts of all matching ranges. Expects that \p l
     /// is locked.
     void dump_refcnt_matches(
-        refcnt_table_type::iterator lower_it
-      , refcnt_table_type::iterator upper_it
+        refcnt_shard& shard
       , naming::gid_type const& lower
       , naming::gid_type const& upper
       , std::unique_lock<mutex_type>& l
@@ -238,13 +356,13 @@ struct HPX_EXPORT primary_namespace
     // helper function
     void wait_for_migration_locked(
         std::unique_lock<mutex_type>& l
+      , gva_shard& shard
       , naming::gid_type id
       , error_code& ec);
 
   public:
     primary_namespace()
       : base_type(HPX_AGAS_PRIMARY_NS_MSB, HPX_AGAS_PRIMARY_NS_LSB)
-      , mutex_()
       , instance_name_()
       , next_id_(naming::invalid_gid)
       , locality_(naming::invalid_gid)
@@ -316,6 +434,7 @@ struct HPX_EXPORT primary_namespace
   private:
     resolved_type resolve_gid_locked(
         std::unique_lock<mutex_type>& l
+      , gva_shard& shard
       , naming::gid_type const& gid
       , error_code& ec
         );
@@ -341,8 +460,7 @@ struct HPX_EXPORT primary_namespace
     };
 
     void resolve_free_list(
-        std::unique_lock<mutex_type>& l
-      , std::list<refcnt_table_type::iterator> const& free_list
+        std::list<naming::gid_type> const& free_list
       , std::list<free_entry>& free_entry_list
       , naming::gid_type const& lower
       , naming::gid_type const& upper
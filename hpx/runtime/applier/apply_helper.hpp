@@ -54,11 +54,10 @@ namespace hpx { namespace applier { namespace detail
     struct apply_helper<Action, /*DirectExecute=*/false>
     {
         template <typename ...Ts>
-        static void
-        call (threads::thread_init_data&& data, naming::id_type const& target,
+        static threads::thread_function_type
+        get_thread_function(naming::id_type const& target,
             naming::address::address_type lva,
-            naming::address::component_type comptype,
-            threads::thread_priority priority, Ts&&... vs)
+            naming::address::component_type comptype, Ts&&... vs)
         {
             typedef typename traits::action_continuation<Action>::type
                 continuation_type;
@@ -66,56 +65,34 @@ namespace hpx { namespace applier { namespace detail
             continuation_type cont;
             if (traits::action_decorate_continuation<Action>::call(cont)) //-V614
             {
-                data.func = Action::construct_thread_function(target,
+                return Action::construct_thread_function(target,
                     std::move(cont), lva, comptype, std::forward<Ts>(vs)...);
             }
-            else
-            {
-                data.func = Action::construct_thread_function(target, lva,
-                    comptype, std::forward<Ts>(vs)...);
-            }
 
-#if defined(HPX_HAVE_THREAD_TARGET_ADDRESS)
-            data.lva = lva;
-#endif
-#if defined(HPX_HAVE_THREAD_DESCRIPTION)
-#if HPX_HAVE_ITTNOTIFY != 0 && !defined(HPX_HAVE_APEX)
-            data.description = util::thread_description(
-                actions::detail::get_action_name<Action>(),
-                actions::detail::get_action_name_itt<Action>());
-#else
-            data.description = actions::detail::get_action_name<Action>();
-#endif
-#endif
-            data.priority = fix_priority<Action>(priority);
-            data.stacksize = threads::get_stack_size(
-                static_cast<threads::thread_stacksize>(
-                    traits::action_stacksize<Action>::value));
-
-            while (!threads::threadmanager_is_at_least(state_running))
-            {
-                compat::this_thread::sleep_for(
-                    std::chrono::milliseconds(HPX_NETWORK_RETRIES_SLEEP));
-            }
-
-            traits::action_schedule_thread<Action>::call(
-                lva, comptype, data, threads::pending);
+            return Action::construct_thread_function(target, lva,
+                comptype, std::forward<Ts>(vs)...);
         }
 
         template <typename Continuation, typename ...Ts>
-        static void
-        call (threads::thread_init_data&& data, Continuation && cont,
+        static threads::thread_function_type
+        get_thread_function(Continuation && cont,
             naming::id_type const& target, naming::address::address_type lva,
-            naming::address::component_type comptype,
-            threads::thread_priority priority, Ts&&... vs)
+            naming::address::component_type comptype, Ts&&... vs)
         {
             // first decorate the continuation
             traits::action_decorate_continuation<Action>::call(cont);
 
-            // now, schedule the thread
-            data.func = Action::construct_thread_function(target,
+            return Action::construct_thread_function(target,
                 std::move(cont), lva, comptype, std::forward<Ts>(vs)...);
+        }
 
+        // schedule a new thread running the thread function stored in data
+        static void
+        schedule(threads::thread_init_data&& data,
+            naming::address::address_type lva,
+            naming::address::component_type comptype,
+            threads::thread_priority priority)
+        {
 #if defined(HPX_HAVE_THREAD_TARGET_ADDRESS)
             data.lva = lva;
 #endif
@@ -142,6 +119,32 @@ namespace hpx { namespace applier { namespace detail
             traits::action_schedule_thread<Action>::call(
                 lva, comptype, data, threads::pending);
         }
+
+        template <typename ...Ts>
+        static void
+        call (threads::thread_init_data&& data, naming::id_type const& target,
+            naming::address::address_type lva,
+            naming::address::component_type comptype,
+            threads::thread_priority priority, Ts&&... vs)
+        {
+            data.func = get_thread_function(target, lva, comptype,
+                std::forward<Ts>(vs)...);
+
+            schedule(std::move(data), lva, comptype, priority);
+        }
+
+        template <typename Continuation, typename ...Ts>
+        static void
+        call (threads::thread_init_data&& data, Continuation && cont,
+            naming::id_type const& target, naming::address::address_type lva,
+            naming::address::component_type comptype,
+            threads::thread_priority priority, Ts&&... vs)
+        {
+            data.func = get_thread_function(std::forward<Continuation>(cont),
+                target, lva, comptype, std::forward<Ts>(vs)...);
+
+            schedule(std::move(data), lva, comptype, priority);
+        }
     };
 
     ///////////////////////////////////////////////////////////////////////////
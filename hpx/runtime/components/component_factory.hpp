@@ -42,6 +42,7 @@
 #include <hpx/runtime/components/component_factory_base.hpp>
 #include <hpx/runtime/components/component_registry.hpp>
 #include <hpx/runtime/components/component_type.hpp>
+#include <hpx/runtime/components/id_range.hpp>
 #include <hpx/runtime/components/server/create_component.hpp>
 #include <hpx/runtime/components/server/destroy_component.hpp>
 #include <hpx/runtime/components/unique_component_name.hpp>
@@ -257,6 +258,31 @@ namespace hpx { namespace components
             return naming::invalid_gid;
         }
 
+        /// \brief Create a number of new component instances and initialize
+        ///        each of them using the given constructor function.
+        ///
+        /// \param count  [in] The number of component instances to create.
+        /// \param ctor   [in] The constructor function to call in order to
+        ///               initialize each of the newly allocated objects.
+        ///
+        /// \return   Returns the global ids of the new component instances.
+        id_range bulk_create_with_args(std::size_t count,
+            util::unique_function_nonser<void(void*)> const& ctor)
+        {
+            if (isenabled_)
+            {
+                id_range ids = server::bulk_create<Component>(count, ctor);
+                refcnt_ += static_cast<long>(ids.size());
+                return ids;
+            }
+
+            HPX_THROW_EXCEPTION(bad_request,
+                "component_factory::bulk_create_with_args",
+                "this factory instance is disabled for this locality (" +
+                get_component_name() + ")");
+            return id_range();
+        }
+
         /// \brief Destroy one or more component instances
         ///
         /// \param gid    [in] The gid of the first component instance to
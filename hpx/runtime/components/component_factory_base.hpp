@@ -9,6 +9,7 @@
 #include <hpx/config.hpp>
 #include <hpx/runtime/components/component_registry_base.hpp>
 #include <hpx/runtime/components/component_type.hpp>
+#include <hpx/runtime/components/id_range.hpp>
 #include <hpx/runtime/components_fwd.hpp> // this needs to go first
 #include <hpx/runtime/naming/address.hpp>
 #include <hpx/runtime/naming/name.hpp>
@@ -92,6 +93,17 @@ namespace hpx { namespace components
             naming::gid_type const& assign_gid,
             util::unique_function_nonser<void(void*)> const& f, void **p) = 0;
 
+        /// \brief Create a number of new component instances and initialize
+        ///        each of them using the given constructor function.
+        ///
+        /// \param count  [in] The number of component instances to create.
+        /// \param f      [in] The constructor function to call in order to
+        ///               initialize each of the newly allocated objects.
+        ///
+        /// \return   Returns the global ids of the new component instances.
+        virtual id_range bulk_create_with_args(std::size_t count,
+            util::unique_function_nonser<void(void*)> const& f) = 0;
+
         /// \brief Destroy one or more component instances
         ///
         /// \param gid    [in] The gid of the first component instance to
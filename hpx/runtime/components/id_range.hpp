@@ -0,0 +1,216 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file id_range.hpp
+
+#if !defined(HPX_COMPONENTS_ID_RANGE_APR_26_2017_0845AM)
+#define HPX_COMPONENTS_ID_RANGE_APR_26_2017_0845AM
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/runtime/serialization/serialization_fwd.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace components
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// The \a id_range is a compact representation of the global ids of
+    /// component instances created in bulk. The ids are stored as runs of
+    /// consecutive global ids, usually one run for each block of memory the
+    /// instances were allocated from.
+    ///
+    /// The global ids carry the global reference credits of the new
+    /// instances, which is why an \a id_range can be moved but not copied.
+    /// The credits are handed over to the \a id_type instances returned from
+    /// \a release_ids, or along with the serialized range. Credits still held
+    /// by a range when it is destroyed are given back, which releases the
+    /// instances nobody has taken ownership of.
+    class id_range
+    {
+    public:
+        /// A run of consecutive global ids
+        struct run
+        {
+            naming::gid_type first_;
+            std::uint64_t count_;
+
+        private:
+            friend class hpx::serialization::access;
+
+            template <typename Archive>
+            void serialize(Archive& ar, unsigned int const)
+            {
+                ar & first_ & count_;
+            }
+        };
+
+        id_range()
+          : size_(0)
+        {}
+
+        id_range(id_range const&) = delete;
+        id_range& operator=(id_range const&) = delete;
+
+        id_range(id_range && rhs) noexcept
+          : runs_(std::move(rhs.runs_)), size_(rhs.size_)
+        {
+            rhs.runs_.clear();
+            rhs.size_ = 0;
+        }
+
+        ~id_range()
+        {
+            if (size_ != 0)
+                release_ids();
+        }
+
+        id_range& operator=(id_range && rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                if (size_ != 0)
+                    release_ids();
+
+                runs_ = std::move(rhs.runs_);
+                size_ = rhs.size_;
+                rhs.runs_.clear();
+                rhs.size_ = 0;
+            }
+            return *this;
+        }
+
+        /// Append \a count consecutive global ids starting at \a first,
+        /// extends the last run if possible.
+        void append(naming::gid_type const& first, std::size_t count)
+        {
+            if (count == 0)
+                return;
+
+            size_ += count;
+            if (!runs_.empty())
+            {
+                run& last = runs_.back();
+                if (last.first_ + last.count_ == first)
+                {
+                    last.count_ += count;
+                    return;
+                }
+            }
+
+            run r = { first, static_cast<std::uint64_t>(count) };
+            runs_.push_back(r);
+        }
+
+        /// Return the number of global ids in this range
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        bool empty() const
+        {
+            return size_ == 0;
+        }
+
+        /// Return the runs of consecutive global ids in this range
+        std::vector<run> const& runs() const
+        {
+            return runs_;
+        }
+
+        /// Return the global id at the given position (without credits)
+        naming::gid_type get_gid(std::size_t pos) const
+        {
+            HPX_ASSERT(pos < size_);
+
+            for (run const& r : runs_)
+            {
+                if (pos < r.count_)
+                    return naming::detail::get_stripped_gid(r.first_ + pos);
+                pos -= r.count_;
+            }
+            return naming::invalid_gid;
+        }
+
+        /// Return the ids of all instances as managed ids, this range is
+        /// empty afterwards.
+        std::vector<naming::id_type> release_ids()
+        {
+            std::vector<naming::id_type> ids;
+            ids.reserve(size_);
+
+            for (run const& r : runs_)
+            {
+                bool has_credits = naming::detail::has_credits(r.first_);
+                for (std::uint64_t i = 0; i != r.count_; ++i)
+                {
+                    ids.push_back(naming::id_type(r.first_ + i,
+                        has_credits ?
+                            naming::id_type::managed :
+                            naming::id_type::unmanaged));
+                }
+            }
+
+            runs_.clear();
+            size_ = 0;
+            return ids;
+        }
+
+        /// Forget all global ids without giving back their credits, used if
+        /// the instances have been destroyed otherwise.
+        void detach()
+        {
+            runs_.clear();
+            size_ = 0;
+        }
+
+    private:
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        void load(Archive& ar, unsigned int const)
+        {
+            HPX_ASSERT(size_ == 0);
+            ar >> runs_ >> size_;
+        }
+
+        // the credits are handed over with the serialized data
+        template <typename Archive>
+        void save(Archive& ar, unsigned int const) const
+        {
+            ar << runs_ << size_;
+            if (!ar.is_preprocessing())
+                const_cast<id_range&>(*this).detach();
+        }
+
+        HPX_SERIALIZATION_SPLIT_MEMBER()
+
+        std::vector<run> runs_;
+        std::size_t size_;
+    };
+
+    namespace detail
+    {
+        // continuation turning the (future) range of ids of newly created
+        // instances into their managed ids
+        struct release_ids
+        {
+            template <typename Future>
+            std::vector<naming::id_type> operator()(Future&& f) const
+            {
+                return f.get().release_ids();
+            }
+        };
+    }
+}}
+
+#endif
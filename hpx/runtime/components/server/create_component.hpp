@@ -9,9 +9,11 @@
 
 #include <hpx/config.hpp>
 #include <hpx/runtime/applier/applier.hpp>
+#include <hpx/runtime/components/id_range.hpp>
 #include <hpx/runtime/components/server/create_component_fwd.hpp>
 #include <hpx/runtime/naming/address.hpp>
 #include <hpx/throw_exception.hpp>
+#include <hpx/util/always_void.hpp>
 #include <hpx/util/bind.hpp>
 #include <hpx/util/decay.hpp>
 #include <hpx/util/functional/new.hpp>
@@ -21,6 +23,7 @@
 #include <cstddef>
 #include <sstream>
 #include <utility>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace components { namespace server
@@ -145,6 +148,102 @@ namespace hpx { namespace components { namespace server
         return naming::invalid_gid;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Components allocated separately are created one by one.
+        template <typename Component, typename Enable = void>
+        struct bulk_create_helper
+        {
+            static id_range call(std::size_t count,
+                util::unique_function_nonser<void(void*)> const& ctor)
+            {
+                id_range ids;
+                for (std::size_t i = 0; i != count; ++i)
+                    ids.append(server::create<Component>(ctor), 1);
+                return ids;
+            }
+        };
+
+        // Components living on a wrapper heap are allocated as blocks of
+        // consecutive objects. The global ids of those are consecutive as
+        // well, and all of them are covered by the single range of ids the
+        // heap binds in AGAS.
+        template <typename Component>
+        struct bulk_create_helper<Component,
+            typename util::always_void<
+                decltype(&Component::heap_type::alloc_batch)
+            >::type>
+        {
+            typedef typename Component::heap_type heap_type;
+
+            static Component* create_block(std::size_t& count,
+                util::unique_function_nonser<void(void*)> const& ctor)
+            {
+                Component* p =
+                    static_cast<Component*>(heap_type::alloc_batch(count));
+
+                std::size_t constructed = 0;
+                try {
+                    for (/**/; constructed != count; ++constructed)
+                        ctor(p + constructed);
+                }
+                catch (...) {
+                    Component::destroy(p, constructed);
+                    heap_type::free(p + constructed, count - constructed);
+                    throw;
+                }
+                return p;
+            }
+
+            static id_range call(std::size_t count,
+                util::unique_function_nonser<void(void*)> const& ctor)
+            {
+                id_range ids;
+                std::vector<std::pair<Component*, std::size_t> > blocks;
+
+                try {
+                    while (count != 0)
+                    {
+                        std::size_t block_size = count;
+                        Component* p = create_block(block_size, ctor);
+                        blocks.push_back(std::make_pair(p, block_size));
+
+                        naming::gid_type gid = heap_type::get_gid(p);
+                        if (!gid)
+                        {
+                            HPX_THROW_EXCEPTION(
+                                hpx::unknown_component_address,
+                                "bulk_create<Component>",
+                                "can't assign global ids");
+                        }
+
+                        ids.append(gid, block_size);
+                        count -= block_size;
+                    }
+                }
+                catch (...) {
+                    // the instances are gone, their credits must not be
+                    // given back
+                    ids.detach();
+                    for (auto const& block : blocks)
+                        Component::destroy(block.first, block.second);
+                    throw;
+                }
+                return ids;
+            }
+        };
+    }
+
+    /// Create \a count components, initializing each of them using the
+    /// given constructor function
+    template <typename Component>
+    id_range bulk_create(std::size_t count,
+        util::unique_function_nonser<void(void*)> const& ctor)
+    {
+        return detail::bulk_create_helper<Component>::call(count, ctor);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     /// Create component with arguments
     namespace detail
@@ -162,6 +261,19 @@ namespace hpx { namespace components { namespace server
                 util::one_shot(util::functional::placement_new<type>()),
                 util::placeholders::_1, std::forward<Ts>(vs)...);
         }
+
+        // The arguments are copied for each constructed object.
+        template <typename Component, typename ...Ts>
+        util::detail::bound<
+            util::functional::placement_new<typename Component::derived_type>
+                (util::detail::placeholder<1> const&, Ts&&...)
+        > bulk_construct_function(Ts&&... vs)
+        {
+            typedef typename Component::derived_type type;
+
+            return util::bind(util::functional::placement_new<type>(),
+                util::placeholders::_1, std::forward<Ts>(vs)...);
+        }
     }
 
     template <typename Component, typename ...Ts>
@@ -9,6 +9,7 @@
 #define HPX_COMPONENTS_SERVER_CREATE_COMPONENT_FWD_JUN_22_2015_0206PM
 
 #include <hpx/config.hpp>
+#include <hpx/runtime/components/id_range.hpp>
 #include <hpx/runtime/naming/address.hpp>
 #include <hpx/util/unique_function.hpp>
 
@@ -33,6 +34,10 @@ namespace hpx { namespace components { namespace server
 
     template <typename Component, typename ...Ts>
     naming::gid_type create_with_args(Ts&&... ts);
+
+    template <typename Component>
+    id_range bulk_create(std::size_t count,
+        util::unique_function_nonser<void(void*)> const& ctor);
 }}}
 
 #endif
@@ -316,6 +316,10 @@ namespace hpx { namespace components
             {
                 return get_heap().alloc(count);
             }
+            static void* alloc_batch(std::size_t& count)
+            {
+                return get_heap().alloc_batch(count);
+            }
             static void free(void* p, std::size_t count = 1)
             {
                 get_heap().free(p, count);
@@ -11,14 +11,28 @@
 #include <hpx/lcos/local/promise.hpp>
 #include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/runtime/agas/interface.hpp>
+#include <hpx/runtime/components/component_type.hpp>
 #include <hpx/runtime/components/pinned_ptr.hpp>
+#include <hpx/runtime/components/server/runtime_support.hpp>
+#include <hpx/runtime/components/server/snapshot_registry.hpp>
 #include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/serialization/input_archive.hpp>
+#include <hpx/runtime/serialization/output_archive.hpp>
+#include <hpx/runtime/serialization/shared_ptr.hpp>
+#include <hpx/runtime/serialization/string.hpp>
 #include <hpx/runtime/threads_fwd.hpp>
 #include <hpx/traits/action_decorate_function.hpp>
 #include <hpx/util/bind.hpp>
+#include <hpx/util/detail/yield_k.hpp>
+#include <hpx/util/unlock_guard.hpp>
 
+#include <boost/atomic.hpp>
+
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <type_traits>
 #include <utility>
 
@@ -26,6 +40,16 @@ namespace hpx { namespace components
 {
     /// This hook has to be inserted into the derivation chain of any component
     /// for it to support migration.
+    ///
+    /// All instances of migratable components are registered with the
+    /// snapshot registry of their locality as soon as they have been assigned
+    /// a global id, which allows to save them all using
+    /// hpx::components::snapshot. An instance is considered modified whenever
+    /// an action was executed on it; instances modified directly (through a
+    /// local pointer) have to call mark_dirty() to be part of the next
+    /// incremental snapshot. Components using this hook must not override
+    /// finalize(), as this removes the instance from the registry before any
+    /// part of it is destroyed.
     template <typename BaseComponent, typename Mutex = lcos::local::spinlock>
     struct migration_support : BaseComponent
     {
@@ -40,10 +64,16 @@ namespace hpx { namespace components
           : base_type(std::forward<Arg>(arg)...)
           , pin_count_(0)
           , was_marked_for_migration_(false)
+          , registered_(false)
+          , snapshotted_(false)
+          , dirty_(true)
+          , snapshot_refs_(0)
         {}
 
         ~migration_support()
         {
+            unregister_snapshot();
+
             // prevent base destructor from unregistering the gid if this
             // instance has been migrated
             if (pin_count_ == ~0x0u)
@@ -56,9 +86,25 @@ namespace hpx { namespace components
             // we don't store migrating objects in the AGAS cache
             naming::gid_type result = this->base_type::get_base_gid(assign_gid);
             naming::detail::set_dont_store_in_cache(result);
+
+            register_snapshot();
             return result;
         }
 
+        /// finalize() will be called just before the instance gets destructed
+        void finalize()
+        {
+            unregister_snapshot();
+            this->base_type::finalize();
+        }
+
+        /// Make sure this instance becomes part of the next incremental
+        /// snapshot.
+        void mark_dirty()
+        {
+            dirty_.store(true, boost::memory_order_relaxed);
+        }
+
         // This component type supports migration.
         static HPX_CONSTEXPR bool supports_migration() { return true; }
 
@@ -194,15 +240,201 @@ namespace hpx { namespace components
             threads::thread_function_type && f,
             components::pinned_ptr)
         {
+            action_scope scope(*this);
             return f(state);
         }
 
+    private:
+        ///////////////////////////////////////////////////////////////////////
+        // Snapshot support
+        //
+        // All actions pass the gate of the snapshot registry, a snapshot
+        // serializes the instances of the locality while no action is
+        // executing on any of them.
+        struct action_scope
+        {
+            explicit action_scope(migration_support& ms)
+              : counter_(detail::snapshot_registry::instance().enter_action())
+            {
+                if (!ms.dirty_.load(boost::memory_order_relaxed))
+                    ms.dirty_.store(true, boost::memory_order_relaxed);
+            }
+            ~action_scope()
+            {
+                detail::snapshot_registry::instance().leave_action(counter_);
+            }
+
+            std::size_t counter_;
+        };
+
+        void* instance_ptr() const
+        {
+            return const_cast<this_component_type*>(
+                static_cast<this_component_type const*>(this));
+        }
+
+        static migration_support* get_instance(void* p)
+        {
+            return static_cast<this_component_type*>(p);
+        }
+
+        void register_snapshot() const
+        {
+            static_assert(std::is_same<
+                    decltype(&this_component_type::finalize),
+                    void (migration_support::*)()
+                >::value,
+                "components supporting migration must not override "
+                "finalize()");
+
+            // make sure the type can be restored from a snapshot
+            HPX_UNUSED(registrar_);
+
+            std::lock_guard<mutex_type> l(mtx_);
+            if (registered_ || pin_count_ == ~0x0u)
+                return;
+
+            registered_ = true;
+            detail::snapshot_registry::instance().add(
+                instance_ptr(), &snapshot_vtable_);
+        }
+
+        void unregister_snapshot()
+        {
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                if (!registered_)
+                    return;
+
+                registered_ = false;
+
+                detail::snapshot_registry& registry =
+                    detail::snapshot_registry::instance();
+                registry.remove(instance_ptr());
+
+                // the next snapshot has to drop this instance, even if it
+                // was migrated elsewhere
+                if (snapshotted_)
+                    registry.erased(naming::detail::get_stripped_gid(this->gid_));
+            }
+
+            // wait for snapshots still referring to this instance
+            for (std::size_t k = 0; snapshot_refs_.load() != 0; ++k)
+            {
+                util::detail::yield_k(k,
+                    "hpx::components::migration_support::unregister_snapshot");
+            }
+        }
+
+        static components::component_type snapshot_get_type()
+        {
+            return components::get_component_type<this_component_type>();
+        }
+
+        static void snapshot_acquire(void* p)
+        {
+            ++get_instance(p)->snapshot_refs_;
+        }
+
+        static void snapshot_release(void* p)
+        {
+            --get_instance(p)->snapshot_refs_;
+        }
+
+        static bool snapshot_save(void* p, bool incremental,
+            naming::gid_type& gid, serialization::output_archive& ar)
+        {
+            return get_instance(p)->save(incremental, gid, ar);
+        }
+
+        bool save(bool incremental, naming::gid_type& gid,
+            serialization::output_archive& ar)
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+            if (!registered_ || pin_count_ == ~0x0u ||
+                (incremental && !dirty_.load(boost::memory_order_relaxed)))
+            {
+                return false;
+            }
+
+            gid = naming::detail::get_stripped_gid(this->gid_);
+
+            // modifications made through a local pointer while the instance
+            // is being serialized are caught by the next snapshot
+            dirty_.store(false, boost::memory_order_relaxed);
+
+            try {
+                util::unlock_guard<std::unique_lock<mutex_type> > ul(l);
+
+                // the instance is not owned by the pointer
+                std::shared_ptr<this_component_type> ptr(
+                    static_cast<this_component_type*>(this),
+                    [](this_component_type*) {});
+
+                ar << get_component_type_name(snapshot_get_type()) << ptr;
+            }
+            catch (...) {
+                dirty_.store(true, boost::memory_order_relaxed);
+                throw;
+            }
+
+            snapshotted_ = true;
+            return true;
+        }
+
+        // recreate the instance using the same steps as when migrating an
+        // object from a component storage
+        static void snapshot_restore(naming::gid_type const& gid,
+            serialization::input_archive& ar)
+        {
+            std::shared_ptr<this_component_type> ptr;
+            ar >> ptr;
+
+            ptr->pin();
+            get_runtime_support_ptr()->
+                template migrate_component_to_here<this_component_type>(
+                    ptr, naming::id_type(gid, naming::id_type::unmanaged));
+            ptr->mark_as_migrated();
+        }
+
+        struct snapshot_type_registrar
+        {
+            snapshot_type_registrar()
+            {
+                detail::snapshot_registry::instance().register_type(
+                    &snapshot_vtable_);
+            }
+        };
+
+        static detail::snapshot_vtable const snapshot_vtable_;
+        static snapshot_type_registrar registrar_;
+
     private:
         mutable mutex_type mtx_;
         std::uint32_t pin_count_;
         hpx::lcos::local::promise<void> trigger_migration_;
         bool was_marked_for_migration_;
+
+        mutable bool registered_;       // instance is known to the registry
+        bool snapshotted_;              // instance is part of a snapshot
+        boost::atomic<bool> dirty_;     // modified since the last snapshot
+        boost::atomic<std::uint32_t> snapshot_refs_;
     };
+
+    template <typename BaseComponent, typename Mutex>
+    detail::snapshot_vtable const
+        migration_support<BaseComponent, Mutex>::snapshot_vtable_ =
+    {
+        &migration_support::snapshot_get_type,
+        &migration_support::snapshot_acquire,
+        &migration_support::snapshot_release,
+        &migration_support::snapshot_save,
+        &migration_support::snapshot_restore
+    };
+
+    template <typename BaseComponent, typename Mutex>
+    typename migration_support<BaseComponent, Mutex>::snapshot_type_registrar
+        migration_support<BaseComponent, Mutex>::registrar_;
 }}
 
 #endif
@@ -22,6 +22,7 @@
 #include <hpx/runtime/agas/gva.hpp>
 #include <hpx/runtime/components/component_factory_base.hpp>
 #include <hpx/runtime/components/component_type.hpp>
+#include <hpx/runtime/components/id_range.hpp>
 #include <hpx/runtime/components/server/create_component.hpp>
 #include <hpx/runtime/components/static_factory_data.hpp>
 #include <hpx/runtime/get_lva.hpp>
@@ -162,11 +163,10 @@ namespace hpx { namespace components { namespace server
         naming::gid_type create_component(T v, Ts... vs);
 
         template <typename Component>
-        std::vector<naming::gid_type> bulk_create_component(std::size_t count);
+        id_range bulk_create_component(std::size_t count);
 
         template <typename Component, typename T, typename ...Ts>
-        std::vector<naming::gid_type> bulk_create_component(
-            std::size_t count, T v, Ts... vs);
+        id_range bulk_create_component(std::size_t count, T v, Ts... vs);
 
         template <typename Component>
         naming::gid_type copy_create_component(
@@ -570,8 +570,7 @@ namespace hpx { namespace components { namespace server
 #endif
 
     template <typename Component>
-    std::vector<naming::gid_type>
-    runtime_support::bulk_create_component(std::size_t count)
+    id_range runtime_support::bulk_create_component(std::size_t count)
     {
         components::component_type const type =
             components::get_component_type<
@@ -590,7 +589,7 @@ namespace hpx { namespace components { namespace server
             HPX_THROW_EXCEPTION(hpx::bad_component_type,
                 "runtime_support::create_component",
                 strm.str());
-            return std::vector<naming::gid_type>();
+            return id_range();
         }
 
         if (!(*it).second.first) {
@@ -604,19 +603,18 @@ namespace hpx { namespace components { namespace server
             HPX_THROW_EXCEPTION(hpx::bad_component_type,
                 "runtime_support::create_component",
                 strm.str());
-            return std::vector<naming::gid_type>();
+            return id_range();
         }
 
-        std::vector<naming::gid_type> ids;
-        ids.reserve(count);
+        typedef typename Component::wrapping_type wrapping_type;
+
+        id_range ids;
 
         std::shared_ptr<component_factory_base> factory((*it).second.first);
         {
             util::unlock_guard<std::unique_lock<component_map_mutex_type> > ul(l);
-            for (std::size_t i = 0; i != count; ++i)
-            {
-                ids.push_back(factory->create());
-            }
+            ids = factory->bulk_create_with_args(count,
+                detail::bulk_construct_function<wrapping_type>());
         }
         LRT_(info) << "successfully created " << count //-V128
                    << " component(s) of type: "
@@ -626,8 +624,8 @@ namespace hpx { namespace components { namespace server
     }
 
     template <typename Component, typename T, typename ...Ts>
-    std::vector<naming::gid_type>
-    runtime_support::bulk_create_component(std::size_t count, T v, Ts ... vs)
+    id_range runtime_support::bulk_create_component(std::size_t count,
+        T v, Ts ... vs)
     {
         components::component_type const type =
             components::get_component_type<
@@ -646,7 +644,7 @@ namespace hpx { namespace components { namespace server
             HPX_THROW_EXCEPTION(hpx::bad_component_type,
                 "runtime_support::create_component",
                 strm.str());
-            return std::vector<naming::gid_type>();
+            return id_range();
         }
 
         if (!(*it).second.first) {
@@ -660,28 +658,21 @@ namespace hpx { namespace components { namespace server
             HPX_THROW_EXCEPTION(hpx::bad_component_type,
                 "runtime_support::create_component",
                 strm.str());
-            return std::vector<naming::gid_type>();
+            return id_range();
         }
 
-        std::vector<naming::gid_type> ids;
-        ids.reserve(count);
+        typedef typename Component::wrapping_type wrapping_type;
+
+        id_range ids;
 
         std::shared_ptr<component_factory_base> factory((*it).second.first);
         {
             util::unlock_guard<std::unique_lock<component_map_mutex_type> > ul(l);
-            for (std::size_t i = 0; i != count; ++i)
-            {
-                typedef typename Component::wrapping_type wrapping_type;
-
-                // Note, T and Ts can't be (non-const) references, and parameters
-                // should be moved to allow for move-only constructor argument
-                // types.
-                ids.push_back(
-                    factory->create_with_args(
-                        detail::construct_function<wrapping_type>(v, vs...)
-                    )
-                );
-            }
+
+            // Note, T and Ts can't be (non-const) references, the arguments
+            // are copied for each of the new instances.
+            ids = factory->bulk_create_with_args(count,
+                detail::bulk_construct_function<wrapping_type>(v, vs...));
         }
         LRT_(info) << "successfully created " << count //-V128
                    << " component(s) of type: "
@@ -950,7 +941,7 @@ namespace hpx { namespace components { namespace server
     template <typename Component, typename ...Ts>
     struct bulk_create_component_action
       : ::hpx::actions::action<
-            std::vector<naming::gid_type> (runtime_support::*)(std::size_t, Ts...)
+            id_range (runtime_support::*)(std::size_t, Ts...)
           , &runtime_support::bulk_create_component<Component, Ts...>
           , bulk_create_component_action<Component, Ts...> >
     {};
@@ -958,7 +949,7 @@ namespace hpx { namespace components { namespace server
     template <typename Component>
     struct bulk_create_component_action<Component>
       : ::hpx::actions::action<
-            std::vector<naming::gid_type> (runtime_support::*)(std::size_t)
+            id_range (runtime_support::*)(std::size_t)
           , &runtime_support::bulk_create_component<Component>
           , bulk_create_component_action<Component> >
     {};
@@ -966,7 +957,7 @@ namespace hpx { namespace components { namespace server
     template <typename Component, typename ...Ts>
     struct bulk_create_component_direct_action
       : ::hpx::actions::direct_action<
-            std::vector<naming::gid_type> (runtime_support::*)(std::size_t, Ts...)
+            id_range (runtime_support::*)(std::size_t, Ts...)
           , &runtime_support::bulk_create_component<Component, Ts...>
           , bulk_create_component_direct_action<Component, Ts...> >
     {};
@@ -974,7 +965,7 @@ namespace hpx { namespace components { namespace server
     template <typename Component>
     struct bulk_create_component_direct_action<Component>
       : ::hpx::actions::direct_action<
-            std::vector<naming::gid_type> (runtime_support::*)(std::size_t)
+            id_range (runtime_support::*)(std::size_t)
           , &runtime_support::bulk_create_component<Component>
           , bulk_create_component_direct_action<Component> >
     {};
@@ -0,0 +1,144 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_COMPONENTS_SERVER_SNAPSHOT_REGISTRY_APR_17_2017_1005AM)
+#define HPX_COMPONENTS_SERVER_SNAPSHOT_REGISTRY_APR_17_2017_1005AM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/components/component_type.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/runtime/serialization/serialization_fwd.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace components { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Type specific operations needed to take and to restore a snapshot of
+    // the instances of a migratable component type (see migration_support).
+    struct snapshot_vtable
+    {
+        components::component_type (*get_type)();
+
+        // Keep the instance alive while it is referenced by a snapshot. This
+        // is invoked while the registry is locked.
+        void (*acquire)(void* p);
+        void (*release)(void* p);
+
+        // Serialize the instance, this is invoked while the action gate of
+        // the registry is closed. Returns false if the instance was skipped because it was not
+        // modified since the last snapshot (or was migrated away).
+        bool (*save)(void* p, bool incremental, naming::gid_type& gid,
+            serialization::output_archive& ar);
+
+        // Recreate an instance from the given archive and bind it to the
+        // given global id.
+        void (*restore)(naming::gid_type const& gid,
+            serialization::input_archive& ar);
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // All instances of migratable components living on this locality. The
+    // instances are spread over several independently locked shards to keep
+    // the creation and destruction of components from contending.
+    //
+    // The registry also holds the gate all actions executed on migratable
+    // components pass. A snapshot closes the gate, which waits for all
+    // actions in flight to finish and holds back new ones until the snapshot
+    // has been taken. While the gate is open, entering and leaving it does
+    // not acquire any lock.
+    class HPX_EXPORT snapshot_registry
+    {
+    public:
+        HPX_NON_COPYABLE(snapshot_registry);
+
+    private:
+        typedef lcos::local::spinlock mutex_type;
+
+        struct shard
+        {
+            mutex_type mtx_;
+            std::unordered_map<void*, snapshot_vtable const*> instances_;
+        };
+
+        enum { num_shards = 16 };
+
+        // number of actions executing, counted separately per worker thread
+        // (modulo num_gate_counters)
+        struct gate_counter
+        {
+            gate_counter() : active_(0) {}
+
+            boost::atomic<std::int64_t> active_;
+            char padding_[64 - sizeof(boost::atomic<std::int64_t>)];
+        };
+
+        enum { num_gate_counters = 64 };
+
+    public:
+        typedef std::pair<void*, snapshot_vtable const*> instance_type;
+
+        snapshot_registry()
+          : gate_closed_(false)
+        {}
+
+        static snapshot_registry& instance();
+
+        // component types which can be restored from a snapshot
+        void register_type(snapshot_vtable const* vt);
+        snapshot_vtable const* find_type(std::string const& name) const;
+
+        void add(void* p, snapshot_vtable const* vt);
+        void remove(void* p);
+
+        // Return all registered instances, every instance is acquired (see
+        // snapshot_vtable) before it is returned.
+        std::vector<instance_type> acquire_all();
+
+        // Record that a component which is part of a snapshot was destroyed,
+        // the next snapshot removes it.
+        void erased(naming::gid_type const& gid);
+        std::vector<naming::gid_type> take_erased();
+
+        // Pass the gate before an action is executed, waits while the gate
+        // is closed. The returned value has to be handed to leave_action.
+        std::size_t enter_action();
+        void leave_action(std::size_t counter)
+        {
+            --gate_counters_[counter].active_;
+        }
+
+        // Close the gate and wait for all actions in flight to finish. Only
+        // one snapshot can close the gate at a time.
+        void close_gate();
+        void open_gate();
+
+    private:
+        shard& get_shard(void* p)
+        {
+            return shards_[(reinterpret_cast<std::size_t>(p) >> 4) % num_shards];
+        }
+
+    private:
+        shard shards_[num_shards];
+
+        gate_counter gate_counters_[num_gate_counters];
+        boost::atomic<bool> gate_closed_;
+
+        mutable mutex_type mtx_;
+        std::vector<snapshot_vtable const*> types_;
+        std::vector<naming::gid_type> erased_;
+    };
+}}}
+
+#endif
@@ -19,6 +19,7 @@
 #include <hpx/util/unlock_guard.hpp>
 
 #include <boost/aligned_storage.hpp>
+#include <boost/atomic.hpp>
 #include <boost/type_traits/alignment_of.hpp>
 
 #include <cstddef>
@@ -104,7 +105,7 @@ namespace hpx { namespace components { namespace detail
             std::size_t step = static_cast<std::size_t>(-1)
         )
           : pool_(nullptr), first_free_(nullptr), step_(step), size_(0), free_size_(0),
-            base_gid_(naming::invalid_gid),
+            base_gid_(naming::invalid_gid), has_base_gid_(false),
             class_name_(class_name),
 #if defined(HPX_DEBUG)
             alloc_count_(0), free_count_(0), heap_count_(count),
@@ -129,7 +130,7 @@ namespace hpx { namespace components { namespace detail
         wrapper_heap()
           : pool_(nullptr), first_free_(nullptr),
             step_(heap_step), size_(0), free_size_(0),
-            base_gid_(naming::invalid_gid),
+            base_gid_(naming::invalid_gid), has_base_gid_(false),
 #if defined(HPX_DEBUG)
             alloc_count_(0), free_count_(0), heap_count_(0),
 #endif
@@ -181,24 +182,29 @@ namespace hpx { namespace components { namespace detail
             if (!ensure_pool(count))
                 return false;
 
-#if defined(HPX_DEBUG)
-            alloc_count_ += count;
-#endif
+            *result = alloc_locked(count);
+            return true;
+        }
 
-            value_type* p = static_cast<value_type*>(first_free_->address()); //-V707
-            HPX_ASSERT(p != nullptr);
+        // Allocate up to 'count' consecutive objects, 'count' is set to the
+        // number of objects actually allocated.
+        bool alloc_batch(T** result, std::size_t& count)
+        {
+            util::itt::heap_allocate heap_allocate(
+                heap_alloc_function_, result, count*sizeof(storage_type),
+                HPX_WRAPPER_HEAP_INITIALIZED_MEMORY);
 
-            first_free_ += count;
+            scoped_lock l(mtx_);
 
-            HPX_ASSERT(free_size_ >= count);
-            free_size_ -= count;
+            if (!ensure_pool(1))
+                return false;
 
-#if HPX_DEBUG_WRAPPER_HEAP != 0
-            // init memory blocks
-            debug::fill_bytes(p, initial_value, count*sizeof(storage_type));
-#endif
+            std::size_t available =
+                static_cast<std::size_t>(pool_ + size_ - first_free_);
+            if (count > available)
+                count = available;
 
-            *result = p;
+            *result = alloc_locked(count);
             return true;
         }
 
@@ -256,9 +262,18 @@ namespace hpx { namespace components { namespace detail
 
             HPX_ASSERT(did_alloc(p));
 
-            scoped_lock l(mtx_);
             value_type* addr = static_cast<value_type*>(pool_->address());
 
+            // the base GID does not change while any object of this heap is
+            // alive
+            if (has_base_gid_.load(boost::memory_order_acquire))
+            {
+                return base_gid_ + static_cast<std::uint64_t>(
+                    static_cast<value_type*>(p) - addr);
+            }
+
+            scoped_lock l(mtx_);
+
             if (!base_gid_) {
                 naming::gid_type base_gid;
 
@@ -284,6 +299,7 @@ namespace hpx { namespace components { namespace detail
                 {
                     // this is the first thread succeeding in binding the new gid range
                     base_gid_ = base_gid;
+                    has_base_gid_.store(true, boost::memory_order_release);
                 }
                 else
                 {
@@ -303,6 +319,7 @@ namespace hpx { namespace components { namespace detail
 
             scoped_lock l(mtx_);
             base_gid_ = g;
+            has_base_gid_.store(!!g, boost::memory_order_release);
         }
 
         naming::address get_address()
@@ -316,6 +333,28 @@ namespace hpx { namespace components { namespace detail
         }
 
     protected:
+        value_type* alloc_locked(std::size_t count)
+        {
+#if defined(HPX_DEBUG)
+            alloc_count_ += count;
+#endif
+
+            value_type* p = static_cast<value_type*>(first_free_->address()); //-V707
+            HPX_ASSERT(p != nullptr);
+
+            first_free_ += count;
+
+            HPX_ASSERT(free_size_ >= count);
+            free_size_ -= count;
+
+#if HPX_DEBUG_WRAPPER_HEAP != 0
+            // init memory blocks
+            debug::fill_bytes(p, initial_value, count*sizeof(storage_type));
+#endif
+
+            return p;
+        }
+
         bool test_release(scoped_lock& lk)
         {
             if (pool_ == nullptr || free_size_ < size_ || first_free_ < pool_+size_)
@@ -325,6 +364,7 @@ namespace hpx { namespace components { namespace detail
             // unbind in AGAS service
             if (base_gid_) {
                 naming::gid_type base_gid = base_gid_;
+                has_base_gid_.store(false, boost::memory_order_relaxed);
                 base_gid_ = naming::invalid_gid;
 
                 util::unlock_guard<scoped_lock> ull(lk);
@@ -408,6 +448,7 @@ namespace hpx { namespace components { namespace detail
         // these values are used for AGAS registration of all elements of this
         // managed_component heap
         naming::gid_type base_gid_;
+        boost::atomic<bool> has_base_gid_;
 
         mutable mutex_type mtx_;
 
@@ -32,6 +32,11 @@ namespace hpx { namespace components { namespace detail
         ///
         naming::gid_type get_gid(void* p)
         {
+            // objects are usually registered by the worker which just
+            // allocated them
+            if (Heap* heap = this->get_cached_heap(p))
+                return heap->get_gid(id_range_, p, type_);
+
             typename base_type::unique_lock_type guard(this->mtx_);
 
             typedef typename base_type::const_iterator iterator;
@@ -14,6 +14,7 @@
 #include <hpx/runtime/actions/manage_object_action.hpp>
 #include <hpx/runtime/applier/register_apply_colocated.hpp>
 #include <hpx/runtime/components/component_type.hpp>
+#include <hpx/runtime/components/id_range.hpp>
 #include <hpx/runtime/components/server/runtime_support.hpp>
 #include <hpx/runtime/naming/name.hpp>
 #include <hpx/runtime/serialization/vector.hpp>
@@ -81,7 +82,8 @@ namespace hpx { namespace components { namespace stubs
             > action_type;
 
             return hpx::detail::async_colocated<action_type>(gid, count,
-                std::forward<Ts>(vs)...);
+                    std::forward<Ts>(vs)...)
+                .then(launch::sync, components::detail::release_ids());
         }
 
         /// Create multiple new components \a type using the runtime_support
@@ -115,7 +117,8 @@ namespace hpx { namespace components { namespace stubs
                 Component, typename hpx::util::decay<Ts>::type...
             > action_type;
             return hpx::async<action_type>(gid, count,
-                std::forward<Ts>(vs)...);
+                    std::forward<Ts>(vs)...)
+                .then(launch::sync, components::detail::release_ids());
         }
 
         /// Create multiple new components \a type using the runtime_support
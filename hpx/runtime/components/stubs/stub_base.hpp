@@ -13,6 +13,8 @@
 #include <hpx/lcos/detail/async_implementations_fwd.hpp>
 #include <hpx/lcos/future.hpp>
 #include <hpx/runtime/components/component_type.hpp>
+#include <hpx/runtime/components/id_range.hpp>
+#include <hpx/runtime/launch_policy.hpp>
 #include <hpx/runtime/naming/id_type.hpp>
 #include <hpx/runtime/naming/name.hpp>
 #include <hpx/throw_exception.hpp>
@@ -81,6 +83,26 @@ namespace hpx { namespace components
                 return lcos::make_ready_future(std::vector<naming::id_type>());
             }
 
+            return bulk_create_range_async(gid, count, std::forward<Ts>(vs)...)
+                .then(launch::sync, detail::release_ids());
+        }
+
+        /// Asynchronously create new instances of a component, the ids of
+        /// the new instances are returned in their compact form.
+        template <typename ...Ts>
+        static lcos::future<id_range>
+        bulk_create_range_async(naming::id_type const& gid, std::size_t count,
+            Ts&&... vs)
+        {
+            if (!naming::is_locality(gid))
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "stubs::runtime_support::bulk_create_range_async",
+                    "The id passed as the first argument is not representing"
+                        " a locality");
+                return lcos::make_ready_future(id_range());
+            }
+
             typedef server::bulk_create_component_action<
                 ServerComponent, typename hpx::util::decay<Ts>::type...
             > action_type;
@@ -130,7 +152,8 @@ namespace hpx { namespace components
             > action_type;
 
             return hpx::detail::async_colocated<action_type>(gid, count,
-                std::forward<Ts>(vs)...);
+                    std::forward<Ts>(vs)...)
+                .then(launch::sync, detail::release_ids());
         }
 
         template <typename ...Ts>
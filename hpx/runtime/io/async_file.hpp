@@ -0,0 +1,158 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file async_file.hpp
+
+#if !defined(HPX_RUNTIME_IO_ASYNC_FILE_MAR_29_2017_0912AM)
+#define HPX_RUNTIME_IO_ASYNC_FILE_MAR_29_2017_0912AM
+
+#include <hpx/config.hpp>
+
+#if !defined(HPX_WINDOWS)
+#include <hpx/error_code.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/runtime/io_fwd.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace io
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// A contiguous memory region data is read into.
+    struct mutable_buffer
+    {
+        mutable_buffer()
+          : data_(nullptr), size_(0)
+        {}
+        mutable_buffer(void* data, std::size_t size)
+          : data_(data), size_(size)
+        {}
+
+        void* data_;
+        std::size_t size_;
+    };
+
+    /// A contiguous memory region data is written from.
+    struct const_buffer
+    {
+        const_buffer()
+          : data_(nullptr), size_(0)
+        {}
+        const_buffer(void const* data, std::size_t size)
+          : data_(data), size_(size)
+        {}
+        const_buffer(mutable_buffer const& b)
+          : data_(b.data_), size_(b.size_)
+        {}
+
+        void const* data_;
+        std::size_t size_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Flags controlling how a file is opened by \a async_file::open.
+    enum open_mode
+    {
+        mode_read = 0x01,           ///< open for reading
+        mode_write = 0x02,          ///< open for writing
+        mode_read_write = 0x03,     ///< open for reading and writing
+        mode_create = 0x04,         ///< create the file if it does not exist
+        mode_truncate = 0x08,       ///< truncate an existing file
+        mode_direct = 0x10          ///< bypass the page cache (O_DIRECT),
+                                    ///< all buffers, offsets and sizes have
+                                    ///< to be suitably aligned
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A file supporting asynchronous reads and writes at explicit offsets.
+    ///
+    /// All operations return a future which becomes ready once the operation
+    /// has completed. Read and write operations yield the number of bytes
+    /// transferred, which (as for pread and pwrite) may be less than the
+    /// number of bytes requested. The buffers passed to an operation and the
+    /// file object itself have to stay alive until the operation has
+    /// completed.
+    ///
+    /// The operations are performed using io_uring, if available (see the
+    /// configuration setting hpx.io.backend), otherwise they are run as
+    /// blocking system calls on the internal IO thread pool.
+    class HPX_EXPORT async_file
+    {
+    public:
+        async_file();
+        async_file(std::string const& path, int mode, error_code& ec = throws);
+
+        async_file(async_file const&) = delete;
+        async_file& operator=(async_file const&) = delete;
+
+        async_file(async_file && rhs);
+        async_file& operator=(async_file && rhs);
+
+        ~async_file();
+
+        /// Open the given file using the given \a open_mode flags.
+        void open(std::string const& path, int mode, error_code& ec = throws);
+
+        /// Close the file, all operations have to be completed.
+        void close(error_code& ec = throws);
+
+        bool is_open() const
+        {
+            return fd_ >= 0;
+        }
+
+        int native_handle() const
+        {
+            return fd_;
+        }
+
+        /// Return the current size of the file.
+        std::uint64_t size(error_code& ec = throws) const;
+
+        ///////////////////////////////////////////////////////////////////////
+        hpx::future<std::size_t> read(
+            std::uint64_t offset, void* data, std::size_t size);
+        hpx::future<std::size_t> write(
+            std::uint64_t offset, void const* data, std::size_t size);
+
+        /// Scatter/gather versions of \a read and \a write.
+        hpx::future<std::size_t> readv(
+            std::uint64_t offset, std::vector<mutable_buffer> buffers);
+        hpx::future<std::size_t> writev(
+            std::uint64_t offset, std::vector<const_buffer> buffers);
+
+        /// Flush all data written to the file to the storage device.
+        hpx::future<void> fsync();
+
+    private:
+        int fd_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Register the given memory regions with the kernel. Reads into and
+    /// writes from memory lying entirely inside one of the registered regions
+    /// avoid mapping the user pages for each operation. Replaces any
+    /// previously registered regions, no operation may be in flight while
+    /// doing so. Does nothing if io_uring is not used.
+    HPX_EXPORT void register_buffers(
+        std::vector<mutable_buffer> const& buffers, error_code& ec = throws);
+
+    /// Unregister all memory regions registered by \a register_buffers.
+    HPX_EXPORT void unregister_buffers(error_code& ec = throws);
+
+    /// Return the name of the backend used for asynchronous file operations
+    /// ("io_uring" or "thread_pool").
+    HPX_EXPORT char const* get_backend_name();
+}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
+#endif
@@ -0,0 +1,76 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_RUNTIME_IO_DETAIL_IO_BACKEND_MAR_29_2017_0945AM)
+#define HPX_RUNTIME_IO_DETAIL_IO_BACKEND_MAR_29_2017_0945AM
+
+#include <hpx/config.hpp>
+
+#if !defined(HPX_WINDOWS)
+#include <hpx/error_code.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/runtime/io/async_file.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace hpx { namespace io { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The mechanism used to perform the operations of all async_file
+    // instances of a locality.
+    class io_backend
+    {
+    public:
+        virtual ~io_backend() {}
+
+        virtual hpx::future<std::size_t> read(int fd, std::uint64_t offset,
+            void* data, std::size_t size) = 0;
+        virtual hpx::future<std::size_t> write(int fd, std::uint64_t offset,
+            void const* data, std::size_t size) = 0;
+
+        virtual hpx::future<std::size_t> readv(int fd, std::uint64_t offset,
+            std::vector<mutable_buffer> && buffers) = 0;
+        virtual hpx::future<std::size_t> writev(int fd, std::uint64_t offset,
+            std::vector<const_buffer> && buffers) = 0;
+
+        virtual hpx::future<void> fsync(int fd) = 0;
+
+        virtual void register_buffers(
+            std::vector<mutable_buffer> const& buffers, error_code& ec) = 0;
+        virtual void unregister_buffers(error_code& ec) = 0;
+
+        // wait for all operations to complete, operations which were not
+        // started yet and operations started afterwards fail
+        virtual void drain() = 0;
+
+        // handle completed operations without blocking, returns whether
+        // any operation was completed
+        virtual bool poll()
+        {
+            return false;
+        }
+
+        virtual char const* name() const = 0;
+    };
+
+    // Return the backend used by this locality, the backend is created on
+    // first use according to hpx.io.backend. Throws once the runtime is
+    // shutting down and the backend has been destroyed.
+    HPX_EXPORT io_backend& get_io_backend();
+
+    // Return a new io_uring based backend, or an empty pointer if io_uring
+    // is not supported by the system.
+    std::unique_ptr<io_backend> create_io_uring_backend(
+        std::size_t queue_depth);
+
+    // Return a new backend running blocking system calls on the IO pool.
+    std::unique_ptr<io_backend> create_thread_pool_backend();
+}}}
+
+#endif
+#endif
@@ -0,0 +1,306 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_RUNTIME_IO_DETAIL_IO_URING_MAR_29_2017_1105AM)
+#define HPX_RUNTIME_IO_DETAIL_IO_URING_MAR_29_2017_1105AM
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_IO_URING)
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace hpx { namespace io { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Minimal wrapper around the raw io_uring system call interface. The
+    // submission side and the completion side have to be protected by (two
+    // independent) locks by the user of this class.
+    class io_uring_queue
+    {
+    public:
+        HPX_NON_COPYABLE(io_uring_queue);
+
+    public:
+        io_uring_queue()
+          : fd_(-1)
+          , sq_ring_(nullptr), sq_ring_size_(0)
+          , cq_ring_(nullptr), cq_ring_size_(0)
+          , sqes_(nullptr), sqes_size_(0)
+          , sq_head_(nullptr), sq_tail_(nullptr), sq_mask_(0), sq_entries_(0)
+          , sq_array_(nullptr)
+          , cq_head_(nullptr), cq_tail_(nullptr), cq_mask_(0)
+          , cqes_(nullptr)
+          , sqe_tail_(0)
+        {}
+
+        ~io_uring_queue()
+        {
+            close();
+        }
+
+        // Set up a ring with (at least) the given number of submission queue
+        // entries, returns 0 on success or the error number otherwise.
+        int open(unsigned entries)
+        {
+            io_uring_params p;
+            std::memset(&p, 0, sizeof(p));
+
+            int fd = static_cast<int>(
+                ::syscall(__NR_io_uring_setup, entries, &p));
+            if (fd < 0)
+                return errno;
+            fd_ = fd;
+
+            sq_ring_size_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+            cq_ring_size_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+
+            bool single_mmap = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (single_mmap && cq_ring_size_ > sq_ring_size_)
+                sq_ring_size_ = cq_ring_size_;
+
+            sq_ring_ = map(sq_ring_size_, IORING_OFF_SQ_RING);
+            if (sq_ring_ == nullptr)
+                return fail();
+
+            if (single_mmap)
+            {
+                cq_ring_ = sq_ring_;
+                cq_ring_size_ = 0;      // shares the mapping of the sq ring
+            }
+            else
+            {
+                cq_ring_ = map(cq_ring_size_, IORING_OFF_CQ_RING);
+                if (cq_ring_ == nullptr)
+                    return fail();
+            }
+
+            sqes_size_ = p.sq_entries * sizeof(io_uring_sqe);
+            sqes_ = static_cast<io_uring_sqe*>(
+                map(sqes_size_, IORING_OFF_SQES));
+            if (sqes_ == nullptr)
+                return fail();
+
+            char* sq = static_cast<char*>(sq_ring_);
+            sq_head_ = reinterpret_cast<std::atomic<unsigned>*>(
+                sq + p.sq_off.head);
+            sq_tail_ = reinterpret_cast<std::atomic<unsigned>*>(
+                sq + p.sq_off.tail);
+            sq_mask_ = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+            sq_entries_ = p.sq_entries;
+            sq_array_ = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+
+            char* cq = static_cast<char*>(cq_ring_);
+            cq_head_ = reinterpret_cast<std::atomic<unsigned>*>(
+                cq + p.cq_off.head);
+            cq_tail_ = reinterpret_cast<std::atomic<unsigned>*>(
+                cq + p.cq_off.tail);
+            cq_mask_ = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+            cqes_ = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+
+            sqe_tail_ = sq_tail_->load(std::memory_order_relaxed);
+            return 0;
+        }
+
+        void close()
+        {
+            if (sqes_ != nullptr)
+                ::munmap(sqes_, sqes_size_);
+            if (cq_ring_ != nullptr && cq_ring_size_ != 0)
+                ::munmap(cq_ring_, cq_ring_size_);
+            if (sq_ring_ != nullptr)
+                ::munmap(sq_ring_, sq_ring_size_);
+            if (fd_ >= 0)
+                ::close(fd_);
+
+            fd_ = -1;
+            sq_ring_ = cq_ring_ = nullptr;
+            sqes_ = nullptr;
+        }
+
+        bool is_open() const
+        {
+            return fd_ >= 0;
+        }
+
+        // number of submission queue entries
+        unsigned capacity() const
+        {
+            return sq_entries_;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Return the next free submission queue entry (cleared), or nullptr
+        // if the submission queue is full.
+        io_uring_sqe* get_sqe()
+        {
+            unsigned head = sq_head_->load(std::memory_order_acquire);
+            if (sqe_tail_ - head >= sq_entries_)
+                return nullptr;
+
+            unsigned index = sqe_tail_ & sq_mask_;
+            io_uring_sqe* sqe = &sqes_[index];
+            std::memset(sqe, 0, sizeof(io_uring_sqe));
+
+            sq_array_[index] = index;
+            ++sqe_tail_;
+            return sqe;
+        }
+
+        // Hand all entries retrieved by get_sqe to the kernel, returns the
+        // number of submitted entries or a negative error number. Entries
+        // not consumed by the kernel are handed over again by the next call.
+        int submit()
+        {
+            sq_tail_->store(sqe_tail_, std::memory_order_release);
+
+            unsigned to_submit =
+                sqe_tail_ - sq_head_->load(std::memory_order_acquire);
+            if (to_submit == 0)
+                return 0;
+
+            return enter(to_submit, 0, 0);
+        }
+
+        // Return the number of entries retrieved by get_sqe which have not
+        // been consumed by the kernel yet.
+        unsigned unsubmitted() const
+        {
+            return sqe_tail_ - sq_head_->load(std::memory_order_acquire);
+        }
+
+        // Remove all entries which have not been consumed by the kernel yet,
+        // invoking the given function with the user data of each of them.
+        // Returns the number of removed entries.
+        template <typename F>
+        std::size_t discard(F && f)
+        {
+            unsigned head = sq_head_->load(std::memory_order_acquire);
+
+            std::size_t count = 0;
+            for (unsigned i = head; i != sqe_tail_; ++i, ++count)
+                f(sqes_[sq_array_[i & sq_mask_]].user_data);
+
+            sqe_tail_ = head;
+            sq_tail_->store(head, std::memory_order_release);
+            return count;
+        }
+
+        // Block until at least one completion is available, returns 0 or a
+        // negative error number.
+        int wait()
+        {
+            int result = enter(0, 1, IORING_ENTER_GETEVENTS);
+            return result < 0 ? result : 0;
+        }
+
+        // Invoke the given function for all available completions with the
+        // user data and the result of the operation, returns the number of
+        // completions handled.
+        template <typename F>
+        std::size_t drain(F && f)
+        {
+            unsigned head = cq_head_->load(std::memory_order_relaxed);
+            unsigned tail = cq_tail_->load(std::memory_order_acquire);
+
+            std::size_t count = 0;
+            for (/**/; head != tail; ++head, ++count)
+            {
+                io_uring_cqe const& cqe = cqes_[head & cq_mask_];
+                std::uint64_t user_data = cqe.user_data;
+                std::int32_t res = cqe.res;
+
+                // release the entry before handling it, the handler may
+                // submit new requests
+                cq_head_->store(head + 1, std::memory_order_release);
+                f(user_data, res);
+            }
+            return count;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Register the given buffers with the kernel, they can be referred to
+        // by index from IORING_OP_READ_FIXED and IORING_OP_WRITE_FIXED
+        // operations afterwards. Returns 0 or the error number.
+        int register_buffers(iovec const* buffers, unsigned count)
+        {
+            return do_register(IORING_REGISTER_BUFFERS, buffers, count);
+        }
+
+        int unregister_buffers()
+        {
+            return do_register(IORING_UNREGISTER_BUFFERS, nullptr, 0);
+        }
+
+    private:
+        int enter(unsigned to_submit, unsigned min_complete, unsigned flags)
+        {
+            int result;
+            do
+            {
+                result = static_cast<int>(::syscall(__NR_io_uring_enter, fd_,
+                    to_submit, min_complete, flags, nullptr, 0));
+            } while (result < 0 && errno == EINTR);
+            return result < 0 ? -errno : result;
+        }
+
+        int do_register(unsigned opcode, void const* arg, unsigned count)
+        {
+            int result = static_cast<int>(::syscall(
+                __NR_io_uring_register, fd_, opcode, arg, count));
+            return result < 0 ? errno : 0;
+        }
+
+        void* map(std::size_t size, off_t offset)
+        {
+            void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE, fd_, offset);
+            return p == MAP_FAILED ? nullptr : p;
+        }
+
+        int fail()
+        {
+            int result = errno;
+            close();
+            return result;
+        }
+
+    private:
+        int fd_;
+
+        void* sq_ring_;
+        std::size_t sq_ring_size_;
+        void* cq_ring_;
+        std::size_t cq_ring_size_;
+        io_uring_sqe* sqes_;
+        std::size_t sqes_size_;
+
+        std::atomic<unsigned>* sq_head_;
+        std::atomic<unsigned>* sq_tail_;
+        unsigned sq_mask_;
+        unsigned sq_entries_;
+        unsigned* sq_array_;
+
+        std::atomic<unsigned>* cq_head_;
+        std::atomic<unsigned>* cq_tail_;
+        unsigned cq_mask_;
+        io_uring_cqe* cqes_;
+
+        unsigned sqe_tail_;     // entries retrieved but not submitted yet
+    };
+}}}
+
+#endif
+#endif
@@ -0,0 +1,29 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_RUNTIME_IO_FWD_HPP
+#define HPX_RUNTIME_IO_FWD_HPP
+
+#include <hpx/config.hpp>
+
+#include <cstddef>
+
+namespace hpx {
+    ///////////////////////////////////////////////////////////////////////////
+    /// \namespace io
+    namespace io
+    {
+        struct mutable_buffer;
+        struct const_buffer;
+
+        class HPX_API_EXPORT async_file;
+
+        /// Handle completed asynchronous file operations, this is invoked as
+        /// part of the background work of the worker threads.
+        HPX_API_EXPORT bool do_background_work(std::size_t num_thread = 0);
+    }
+}
+
+#endif
@@ -397,7 +397,10 @@ namespace hpx
         HPX_EXPORT static const detail::async_policy async;
 
         /// Predefined launch policy representing asynchronous execution.The
-        /// new thread is executed in a preferred way
+        /// new thread is executed in a preferred way: it runs immediately on
+        /// the calling worker thread while the continuation of the caller
+        /// can be stolen by other worker threads (work-first). Outside of
+        /// HPX threads this is equivalent to \a launch::async.
         HPX_EXPORT static const detail::fork_policy fork;
 
         /// Predefined launch policy representing synchronous execution
@@ -11,6 +11,7 @@
 #include <hpx/exception.hpp>
 #include <hpx/exception_info.hpp>
 #include <hpx/performance_counters/parcels/data_point.hpp>
+#include <hpx/runtime/actions/base_action.hpp>
 #include <hpx/runtime/naming/name.hpp>
 #include <hpx/runtime/naming/resolver_client.hpp>
 #include <hpx/runtime/parcelset/parcel.hpp>
@@ -19,6 +20,7 @@
 #include <hpx/runtime_fwd.hpp>
 #include <hpx/util/high_resolution_timer.hpp>
 #include <hpx/util/logging.hpp>
+#include <hpx/util/tracing.hpp>
 
 #include <boost/exception/exception.hpp>
 
@@ -155,6 +157,12 @@ namespace hpx { namespace parcelset
 
                         std::int64_t add_parcel_time = timer.elapsed_nanoseconds();
 
+                        if (HPX_UNLIKELY(util::tracing::enabled()))
+                        {
+                            util::tracing::record_parcel_receive(
+                                p.get_action()->get_action_name());
+                        }
+
 #if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
                         performance_counters::parcels::data_point action_data;
                         action_data.bytes_ = archive.current_pos() - archive_pos;
@@ -44,6 +44,8 @@ namespace hpx { namespace resource { namespace detail
         bool pu_is_exclusive(std::size_t virt_core) const;
         bool pu_is_assigned(std::size_t virt_core) const;
 
+        std::size_t num_assigned_pus() const;
+
         void assign_first_core(std::size_t first_core);
 
         friend class resource::detail::partitioner;
@@ -69,6 +71,11 @@ namespace hpx { namespace resource { namespace detail
         // counter for number of threads bound to this pool
         std::size_t num_threads_;
         scheduler_function create_function_;
+
+        // bounds for the number of active threads of an elastic pool
+        bool elastic_;
+        std::size_t min_threads_;
+        std::size_t max_threads_;
     };
 
     ///////////////////////////////////////////////////////////////////////
@@ -173,6 +180,18 @@ namespace hpx { namespace resource { namespace detail
         std::size_t expand_pool(std::string const& pool_name,
             util::function_nonser<void(std::size_t)> const& add_pu);
 
+        // manage elastic pools
+        void set_elastic_bounds(std::string const& pool_name,
+            std::size_t min_threads, std::size_t max_threads);
+        bool is_elastic(std::string const& pool_name) const;
+        std::size_t get_num_assigned_pus(std::string const& pool_name) const;
+
+        bool move_pu(std::string const& from_pool, std::string const& to_pool,
+            util::function_nonser<void(std::size_t)> const& remove_pu,
+            util::function_nonser<void(std::size_t)> const& add_pu);
+        std::size_t release_shared_pus(std::string const& pool_name,
+            util::function_nonser<void(std::size_t)> const& remove_pu);
+
     private:
         ////////////////////////////////////////////////////////////////////////
         void fill_topology_vectors();
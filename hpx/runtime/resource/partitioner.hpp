@@ -207,6 +207,14 @@ namespace hpx { namespace resource
             std::vector<hpx::resource::numa_domain> const& ndv,
             std::string const& pool_name, bool exclusive = true);
 
+        // Let the number of active threads of the given pool vary between
+        // min_threads and max_threads at runtime. Threads are moved between
+        // elastic pools depending on their load, which requires the pools
+        // to share (non-exclusive) processing units.
+        HPX_EXPORT void set_elastic_bounds(std::string const& pool_name,
+            std::size_t min_threads,
+            std::size_t max_threads = std::size_t(-1));
+
         // Access all available NUMA domains
         HPX_EXPORT std::vector<numa_domain> const& numa_domains() const;
 
@@ -63,7 +63,8 @@ namespace hpx
             abp_priority = 5,
             hierarchy = 6,
             periodic_priority = 7,
-            throttle = 8
+            throttle = 8,
+            deadline = 9
         };
     }
 }
@@ -59,7 +59,7 @@ namespace hpx { namespace threads { namespace coroutines
         typedef impl_type::result_type result_type;
         typedef impl_type::arg_type arg_type;
 
-        typedef util::unique_function_nonser<result_type(arg_type)> functor_type;
+        typedef impl_type::functor_type functor_type;
 
         coroutine() : m_pimpl(nullptr) {}
 
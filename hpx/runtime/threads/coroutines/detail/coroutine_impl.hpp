@@ -39,9 +39,9 @@
 #include <hpx/runtime/threads/coroutines/coroutine_fwd.hpp>
 #include <hpx/runtime/threads/coroutines/detail/context_base.hpp>
 #include <hpx/runtime/threads/coroutines/detail/coroutine_accessor.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
 #include <hpx/runtime/threads/thread_enums.hpp>
 #include <hpx/util/assert.hpp>
-#include <hpx/util/unique_function.hpp>
 
 #include <boost/intrusive_ptr.hpp>
 
@@ -67,7 +67,7 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         typedef std::pair<thread_state_enum, thread_id_type> result_type;
         typedef thread_state_ex_enum arg_type;
 
-        typedef util::unique_function_nonser<result_type(arg_type)> functor_type;
+        typedef threads::thread_function_type functor_type;
 
         typedef boost::intrusive_ptr<coroutine_impl> pointer;
 
@@ -0,0 +1,83 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_RUNTIME_THREADS_DETAIL_ELASTIC_CONTROLLER_MAR_22_2017_1042AM)
+#define HPX_RUNTIME_THREADS_DETAIL_ELASTIC_CONTROLLER_MAR_22_2017_1042AM
+
+#include <hpx/config.hpp>
+#include <hpx/util/interval_timer.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace threads
+{
+    class HPX_EXPORT threadmanager;
+}}
+
+namespace hpx { namespace threads { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Periodically samples the load of all elastic thread pools (see
+    // resource::partitioner::set_elastic_bounds) and moves processing units
+    // from underutilized pools to overloaded ones.
+    //
+    // A pool is considered overloaded if its (smoothed) utilization is above
+    // the configured threshold and more tasks are pending than it has active
+    // threads, it is considered underutilized if its utilization is below
+    // the threshold and it has at most one pending task per thread. A pool
+    // has to be in the same state for a number of consecutive samples before
+    // any processing unit is moved, at most one processing unit is moved per
+    // sample.
+    class HPX_EXPORT elastic_controller
+    {
+    public:
+        HPX_NON_COPYABLE(elastic_controller);
+
+        explicit elastic_controller(threadmanager& tm);
+        ~elastic_controller();
+
+        // start sampling the pools, the first sample releases the processing
+        // units shared between elastic pools
+        void start();
+        void stop();
+
+        // sample all elastic pools once, returns whether a processing unit
+        // was moved
+        bool evaluate();
+
+    private:
+        bool on_timer();
+
+        struct pool_state
+        {
+            std::string name_;
+            std::int64_t utilization_;      // percent, smoothed
+            std::size_t overloaded_;        // consecutive samples
+            std::size_t underutilized_;     // consecutive samples
+        };
+
+        threadmanager& tm_;
+        std::vector<pool_state> pools_;
+
+        std::size_t hysteresis_;
+        std::int64_t utilization_threshold_;
+        std::int64_t queue_threshold_;
+
+        bool released_;
+        boost::atomic<bool> evaluating_;
+        util::interval_timer timer_;
+    };
+}}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
@@ -0,0 +1,161 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_RUNTIME_THREADS_DETAIL_PARKING_SLOT_MAR_24_2017_0912AM)
+#define HPX_RUNTIME_THREADS_DETAIL_PARKING_SLOT_MAR_24_2017_0912AM
+
+#include <hpx/config.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__linux) || defined(linux) || defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#define HPX_PARKING_SLOT_USE_FUTEX
+#else
+#include <hpx/compat/condition_variable.hpp>
+#include <hpx/compat/mutex.hpp>
+#include <mutex>
+#endif
+
+namespace hpx { namespace threads { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The place an idle worker thread sleeps in until it is notified about
+    // new work (or until a timeout expires). Every worker owns one slot, which
+    // allows waking up a specific worker instead of an arbitrary one. On
+    // Linux the slot is a futex word, elsewhere it falls back to a condition
+    // variable.
+    class parking_slot
+    {
+    public:
+        HPX_NON_COPYABLE(parking_slot);
+
+    private:
+        enum slot_state : std::uint32_t
+        {
+            running = 0,
+            parked = 1,
+            notified = 2
+        };
+
+    public:
+        parking_slot()
+          : state_(running), wait_count_(0)
+        {}
+
+        bool is_parked() const
+        {
+            return state_.load(boost::memory_order_relaxed) == parked;
+        }
+
+        // Put the calling worker to sleep for at most the given time, unless
+        // has_work returns true after the slot has been marked as parked.
+        // Returns true if the worker was woken up by unpark().
+        template <typename F>
+        bool park(std::chrono::milliseconds timeout, F && has_work)
+        {
+            state_.store(parked, boost::memory_order_seq_cst);
+
+            if (!has_work())
+                wait(timeout);
+
+            return state_.exchange(running, boost::memory_order_acquire) ==
+                notified;
+        }
+
+        // Wake up the worker parked in this slot, returns false if the
+        // worker was not parked.
+        bool unpark()
+        {
+            if (!is_parked())
+                return false;
+
+#if defined(HPX_PARKING_SLOT_USE_FUTEX)
+            std::uint32_t expected = parked;
+            if (!state_.compare_exchange_strong(expected, notified,
+                    boost::memory_order_release))
+            {
+                return false;
+            }
+            ::syscall(SYS_futex, address(), FUTEX_WAKE_PRIVATE, 1,
+                nullptr, nullptr, 0);
+#else
+            std::lock_guard<compat::mutex> l(mtx_);
+            std::uint32_t expected = parked;
+            if (!state_.compare_exchange_strong(expected, notified,
+                    boost::memory_order_release))
+            {
+                return false;
+            }
+            cond_.notify_one();
+#endif
+            return true;
+        }
+
+        // number of consecutive idle periods since the owning worker last
+        // found work, used for the backoff of the owning worker only
+        std::uint32_t next_wait_count()
+        {
+            return ++wait_count_;
+        }
+
+        // called by the owning worker whenever it found work, avoids writing
+        // to the slot while the worker stays busy
+        void reset_wait_count()
+        {
+            if (wait_count_ != 0)
+                wait_count_ = 0;
+        }
+
+    private:
+        void wait(std::chrono::milliseconds timeout)
+        {
+#if defined(HPX_PARKING_SLOT_USE_FUTEX)
+            timespec ts;
+            ts.tv_sec = static_cast<time_t>(timeout.count() / 1000);
+            ts.tv_nsec = static_cast<long>((timeout.count() % 1000) * 1000000);
+
+            // returns early if the slot is not marked as parked anymore
+            ::syscall(SYS_futex, address(), FUTEX_WAIT_PRIVATE,
+                std::uint32_t(parked), &ts, nullptr, 0);
+#else
+            std::unique_lock<compat::mutex> l(mtx_);
+            cond_.wait_for(l, timeout,
+                [this]() { return state_.load() != parked; });
+#endif
+        }
+
+#if defined(HPX_PARKING_SLOT_USE_FUTEX)
+        std::uint32_t* address()
+        {
+            static_assert(
+                sizeof(boost::atomic<std::uint32_t>) == sizeof(std::uint32_t),
+                "the futex word has to be a plain 32 bit integer");
+            return reinterpret_cast<std::uint32_t*>(&state_);
+        }
+#endif
+
+    private:
+        boost::atomic<std::uint32_t> state_;
+        std::uint32_t wait_count_;
+
+#if !defined(HPX_PARKING_SLOT_USE_FUTEX)
+        compat::mutex mtx_;
+        compat::condition_variable cond_;
+#endif
+
+        // avoid false sharing between the slots of neighboring workers
+        char padding_[64 - 2 * sizeof(std::uint32_t)];
+    };
+}}}
+
+#endif
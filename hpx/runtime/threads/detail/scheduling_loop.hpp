@@ -17,7 +17,10 @@
 #include <hpx/util/function.hpp>
 #include <hpx/util/hardware/timestamp.hpp>
 #include <hpx/util/itt_notify.hpp>
+#include <hpx/util/perf_events.hpp>
 #include <hpx/util/safe_lexical_cast.hpp>
+#include <hpx/util/sampling_profiler.hpp>
+#include <hpx/util/tracing.hpp>
 
 #include <boost/atomic.hpp>
 
@@ -446,6 +449,10 @@ namespace hpx { namespace threads { namespace detail
         thread_data* thrd = nullptr;
         thread_data* next_thrd = nullptr;
 
+        // the thread which has yielded to a thread it has just created (see
+        // launch::fork), it is resumed as soon as the new thread has run
+        thread_data* continuation = nullptr;
+
         std::shared_ptr<bool> background_running = nullptr;
         thread_id_type background_thread = nullptr;
 
@@ -458,8 +465,16 @@ namespace hpx { namespace threads { namespace detail
         }
 
         while (true) {
+            // make threads pending whose timed suspension has expired
+            scheduler.SchedulingPolicy::expire_timers(num_thread);
+
             // Get the next HPX thread from the queue
             thrd = next_thrd;
+            if (HPX_UNLIKELY(thrd == nullptr && continuation != nullptr))
+            {
+                thrd = continuation;
+                continuation = nullptr;
+            }
             bool running = this_state.load(
                 boost::memory_order_relaxed) < state_stopping;
 
@@ -471,6 +486,7 @@ namespace hpx { namespace threads { namespace detail
 
                 idle_loop_count = 0;
                 ++busy_loop_count;
+                scheduler.SchedulingPolicy::reset_idle_backoff(num_thread);
 
                 may_exit = false;
 
@@ -511,6 +527,25 @@ namespace hpx { namespace threads { namespace detail
                                 // and add to aggregate execution time.
                                 exec_time_wrapper exec_time_collector(idle_rate);
 
+                                if (HPX_UNLIKELY(util::tracing::enabled()))
+                                {
+                                    util::tracing::record_task_begin(
+                                        thrd, thrd->get_description());
+                                }
+                                if (HPX_UNLIKELY(util::sampling_profiler::enabled()))
+                                {
+                                    util::sampling_profiler::record_task_begin(
+                                        thrd->get_description(),
+                                        thrd->get_parent_description());
+                                }
+#if defined(HPX_HAVE_PERF_EVENT_COUNTERS)
+                                if (HPX_UNLIKELY(util::perf_events::enabled()))
+                                {
+                                    util::perf_events::record_task_begin(
+                                        thrd->get_description());
+                                }
+#endif
+
 #if defined(HPX_HAVE_APEX)
                                 // get the APEX data pointer, in case we are resuming the
                                 // thread and have to restore any leaf timers from
@@ -534,6 +569,21 @@ namespace hpx { namespace threads { namespace detail
                                 }
 #else
                                 thrd_stat = (*thrd)();
+#endif
+                                if (HPX_UNLIKELY(util::tracing::enabled()))
+                                {
+                                    util::tracing::record_task_end(
+                                        thrd, thrd_stat.get_previous());
+                                }
+                                if (HPX_UNLIKELY(util::sampling_profiler::enabled()))
+                                {
+                                    util::sampling_profiler::record_task_end();
+                                }
+#if defined(HPX_HAVE_PERF_EVENT_COUNTERS)
+                                if (HPX_UNLIKELY(util::perf_events::enabled()))
+                                {
+                                    util::perf_events::record_task_end();
+                                }
 #endif
                             }
 
@@ -583,13 +633,30 @@ namespace hpx { namespace threads { namespace detail
                             // schedule other work
                             scheduler.SchedulingPolicy::wait_or_add_new(
                                 num_thread, running, idle_loop_count);
-                        }
 
-                        // schedule this thread again, make sure it ends up at
-                        // the end of the queue
-                        scheduler.SchedulingPolicy::schedule_thread_last(thrd,
-                            num_thread);
-                        scheduler.SchedulingPolicy::do_some_work(num_thread);
+                            // schedule this thread again, make sure it ends
+                            // up at the end of the queue
+                            scheduler.SchedulingPolicy::schedule_thread_last(
+                                thrd, num_thread);
+                            scheduler.SchedulingPolicy::do_some_work(
+                                num_thread);
+                        }
+                        else {
+                            // this thread has yielded to a new thread (work-
+                            // first), keep it aside to resume it once the new
+                            // thread has run. An older continuation is handed
+                            // to the queues where other workers can steal it,
+                            // which bounds the number of threads held back
+                            // by this worker.
+                            if (continuation != nullptr)
+                            {
+                                scheduler.SchedulingPolicy::schedule_thread(
+                                    continuation, num_thread);
+                                scheduler.SchedulingPolicy::do_some_work(
+                                    num_thread);
+                            }
+                            continuation = thrd;
+                        }
                     }
                     else if (HPX_UNLIKELY(state_val == pending_boost))
                     {
@@ -656,12 +723,32 @@ namespace hpx { namespace threads { namespace detail
 #endif
                     scheduler.SchedulingPolicy::destroy_thread(thrd, busy_loop_count);
                 }
+
+                // resume the continuation of a forked thread directly, unless
+                // another thread has to be run next
+                if (continuation != nullptr && continuation != thrd)
+                {
+                    if (next_thrd == nullptr)
+                    {
+                        next_thrd = continuation;
+                    }
+                    else
+                    {
+                        scheduler.SchedulingPolicy::schedule_thread(
+                            continuation, num_thread);
+                        scheduler.SchedulingPolicy::do_some_work(num_thread);
+                    }
+                    continuation = nullptr;
+                }
             }
 
             // if nothing else has to be done either wait or terminate
             else {
                 ++idle_loop_count;
 
+                // take care of the timers of worker threads which are busy
+                scheduler.SchedulingPolicy::expire_all_timers();
+
                 if (scheduler.SchedulingPolicy::wait_or_add_new(
                         num_thread, running, idle_loop_count))
                 {
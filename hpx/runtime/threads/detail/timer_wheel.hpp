@@ -0,0 +1,308 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_RUNTIME_THREADS_DETAIL_TIMER_WHEEL_MAR_20_2017_0214PM)
+#define HPX_RUNTIME_THREADS_DETAIL_TIMER_WHEEL_MAR_20_2017_0214PM
+
+#include <hpx/config.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/spinlock.hpp>
+#include <hpx/util/steady_clock.hpp>
+#include <hpx/util/unique_function.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace threads { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A hierarchical timing wheel holding the timers of one worker thread.
+    //
+    // Time is divided into ticks of 2^16ns (~65us). The wheel consists of
+    // four levels of 256 slots each, level l holding the timers expiring
+    // within 256^(l+1) ticks. Whenever the lower levels wrap around, the
+    // corresponding slot of the next level is cascaded down. Adding and
+    // canceling a timer is O(1), expiring timers is O(1) per elapsed tick
+    // (plus the cost of the cascaded and fired timers). Timers further out
+    // than the range of the wheel (~78h) are parked in the last slot and
+    // re-inserted when it is cascaded.
+    class timer_wheel
+    {
+    public:
+        HPX_NON_COPYABLE(timer_wheel);
+
+        typedef util::unique_function_nonser<void()> callback_type;
+
+    private:
+        typedef util::spinlock mutex_type;
+
+        static std::size_t const level_bits = 8;
+        static std::size_t const num_slots = std::size_t(1) << level_bits;
+        static std::size_t const num_levels = 4;
+        static std::size_t const tick_shift = 16;
+
+        struct entry
+        {
+            entry(timer_wheel* wheel, std::uint64_t tick, callback_type && f)
+              : wheel_(wheel), tick_(tick), f_(std::move(f)),
+                prev_(nullptr), next_(nullptr), head_(nullptr)
+            {}
+
+            timer_wheel* wheel_;
+            std::uint64_t tick_;
+            callback_type f_;
+
+            // links into the slot this entry is currently stored in, head_ is
+            // nullptr if the entry has fired or was canceled
+            entry* prev_;
+            entry* next_;
+            entry** head_;
+
+            // keeps the entry alive as long as it is stored in the wheel
+            std::shared_ptr<entry> self_;
+        };
+
+    public:
+        typedef std::weak_ptr<entry> handle_type;
+
+        timer_wheel()
+          : size_(0), current_tick_(to_tick(util::steady_clock::now())),
+            due_(nullptr)
+        {
+            for (std::size_t l = 0; l != num_levels; ++l)
+            {
+                for (std::size_t s = 0; s != num_slots; ++s)
+                    slots_[l][s] = nullptr;
+            }
+        }
+
+        ~timer_wheel()
+        {
+            // release all timers which did not fire
+            std::vector<std::shared_ptr<entry> > pending;
+            {
+                std::lock_guard<mutex_type> lk(mtx_);
+                take_all(due_, pending);
+                for (std::size_t l = 0; l != num_levels; ++l)
+                {
+                    for (std::size_t s = 0; s != num_slots; ++s)
+                        take_all(slots_[l][s], pending);
+                }
+            }
+        }
+
+        bool empty() const
+        {
+            return size_.load(boost::memory_order_relaxed) == 0;
+        }
+
+        std::size_t size() const
+        {
+            return size_.load(boost::memory_order_relaxed);
+        }
+
+        // Register f to be called once abs_time has passed.
+        handle_type add(util::steady_clock::time_point const& abs_time,
+            callback_type && f)
+        {
+            std::uint64_t tick = to_tick(abs_time, true);
+            std::shared_ptr<entry> e =
+                std::make_shared<entry>(this, tick, std::move(f));
+
+            std::lock_guard<mutex_type> lk(mtx_);
+            if (size_.load(boost::memory_order_relaxed) == 0)
+            {
+                // nothing has to be cascaded, skip all elapsed ticks
+                std::uint64_t now = to_tick(util::steady_clock::now());
+                if (now > current_tick_)
+                    current_tick_ = now;
+            }
+
+            e->self_ = e;
+            insert(e.get());
+            ++size_;
+
+            return e;
+        }
+
+        // Remove the timer referred to by h, returns false if the timer has
+        // already fired (or has been canceled before).
+        static bool cancel(handle_type const& h)
+        {
+            std::shared_ptr<entry> e = h.lock();
+            if (!e)
+                return false;
+
+            timer_wheel& wheel = *e->wheel_;
+            std::lock_guard<mutex_type> lk(wheel.mtx_);
+            if (e->head_ == nullptr)
+                return false;
+
+            unlink(e.get());
+            e->self_.reset();
+            --wheel.size_;
+            return true;
+        }
+
+        // Invoke all timers which have expired at the given point in time,
+        // returns the number of invoked timers. If try_lock is true this
+        // returns immediately if the wheel is being accessed concurrently.
+        std::size_t expire(util::steady_clock::time_point const& now,
+            bool try_lock = false)
+        {
+            if (empty())
+                return 0;
+
+            std::vector<std::shared_ptr<entry> > fired;
+            {
+                std::unique_lock<mutex_type> lk(mtx_, std::defer_lock);
+                if (try_lock)
+                {
+                    if (!lk.try_lock())
+                        return 0;
+                }
+                else
+                {
+                    lk.lock();
+                }
+
+                take_all(due_, fired);
+
+                std::uint64_t now_tick = to_tick(now);
+                while (current_tick_ < now_tick &&
+                    size_.load(boost::memory_order_relaxed) != fired.size())
+                {
+                    ++current_tick_;
+
+                    // cascade the next level down whenever a level wraps
+                    for (std::size_t l = 1; l != num_levels; ++l)
+                    {
+                        std::size_t shift = l * level_bits;
+                        if (current_tick_ & ((std::uint64_t(1) << shift) - 1))
+                            break;
+                        cascade(slots_[l][(current_tick_ >> shift) %
+                            num_slots]);
+                    }
+
+                    take_all(slots_[0][current_tick_ % num_slots], fired);
+                }
+
+                if (current_tick_ < now_tick)
+                    current_tick_ = now_tick;
+
+                take_all(due_, fired);
+                size_ -= fired.size();
+            }
+
+            for (std::shared_ptr<entry> const& e : fired)
+                e->f_();
+
+            return fired.size();
+        }
+
+    private:
+        static std::uint64_t to_tick(
+            util::steady_clock::time_point const& t, bool round_up = false)
+        {
+            std::uint64_t ns = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    t.time_since_epoch()).count());
+            if (round_up)
+                ns += (std::uint64_t(1) << tick_shift) - 1;
+            return ns >> tick_shift;
+        }
+
+        static void link(entry** head, entry* e)
+        {
+            e->head_ = head;
+            e->prev_ = nullptr;
+            e->next_ = *head;
+            if (*head != nullptr)
+                (*head)->prev_ = e;
+            *head = e;
+        }
+
+        static void unlink(entry* e)
+        {
+            HPX_ASSERT(e->head_ != nullptr);
+            if (e->prev_ != nullptr)
+                e->prev_->next_ = e->next_;
+            else
+                *e->head_ = e->next_;
+            if (e->next_ != nullptr)
+                e->next_->prev_ = e->prev_;
+            e->head_ = nullptr;
+            e->prev_ = e->next_ = nullptr;
+        }
+
+        // store the entry in the slot corresponding to its expiration tick
+        void insert(entry* e)
+        {
+            if (e->tick_ <= current_tick_)
+            {
+                link(&due_, e);
+                return;
+            }
+
+            for (std::size_t l = 0; l != num_levels; ++l)
+            {
+                std::size_t shift = l * level_bits;
+                if ((e->tick_ >> shift) - (current_tick_ >> shift) < num_slots)
+                {
+                    link(&slots_[l][(e->tick_ >> shift) % num_slots], e);
+                    return;
+                }
+            }
+
+            // out of range, park it in the slot to be cascaded last
+            std::size_t shift = (num_levels - 1) * level_bits;
+            link(&slots_[num_levels - 1][
+                ((current_tick_ >> shift) - 1) % num_slots], e);
+        }
+
+        void cascade(entry*& head)
+        {
+            entry* e = head;
+            head = nullptr;
+            while (e != nullptr)
+            {
+                entry* next = e->next_;
+                insert(e);
+                e = next;
+            }
+        }
+
+        static void take_all(entry*& head,
+            std::vector<std::shared_ptr<entry> >& entries)
+        {
+            entry* e = head;
+            head = nullptr;
+            while (e != nullptr)
+            {
+                entry* next = e->next_;
+                e->head_ = nullptr;
+                e->prev_ = e->next_ = nullptr;
+                entries.push_back(std::move(e->self_));
+                e = next;
+            }
+        }
+
+    private:
+        mutable mutex_type mtx_;
+        boost::atomic<std::size_t> size_;
+        std::uint64_t current_tick_;
+        entry* due_;
+        entry* slots_[num_levels][num_slots];
+    };
+}}}
+
+#endif
@@ -0,0 +1,339 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_THREADMANAGER_SCHEDULING_DEADLINE_QUEUE_APR_21_2017_1105AM)
+#define HPX_THREADMANAGER_SCHEDULING_DEADLINE_QUEUE_APR_21_2017_1105AM
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_DEADLINE_SCHEDULER)
+#include <hpx/compat/mutex.hpp>
+#include <hpx/error_code.hpp>
+#include <hpx/runtime/threads/policies/deadline_statistics.hpp>
+#include <hpx/runtime/threads/policies/local_priority_queue_scheduler.hpp>
+#include <hpx/runtime/threads/policies/lockfree_queue_backends.hpp>
+#include <hpx/runtime/threads/thread_data.hpp>
+#include <hpx/runtime/threads/thread_init_data.hpp>
+#include <hpx/runtime/threads_fwd.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/tracing.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace threads { namespace policies
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// The deadline_queue_scheduler extends the local_priority_queue_scheduler
+    /// by one additional queue per OS thread holding the threads which were
+    /// created with a deadline (see thread_init_data::deadline). These
+    /// threads are executed before any other work, earliest deadline first.
+    /// An OS thread looking for work picks the thread with the earliest
+    /// deadline from its own queue and the queues it is allowed to steal
+    /// from. All threads without a deadline are handled exactly as by the
+    /// local_priority_queue_scheduler.
+    template <typename Mutex = compat::mutex,
+        typename PendingQueuing = lockfree_fifo,
+        typename StagedQueuing = lockfree_fifo,
+        typename TerminatedQueuing = lockfree_lifo>
+    class HPX_EXPORT deadline_queue_scheduler
+      : public local_priority_queue_scheduler<
+            Mutex, PendingQueuing, StagedQueuing, TerminatedQueuing
+        >
+    {
+    public:
+        typedef local_priority_queue_scheduler<
+            Mutex, PendingQueuing, StagedQueuing, TerminatedQueuing
+        > base_type;
+
+        typedef typename base_type::init_parameter_type
+            init_parameter_type;
+
+    private:
+        HPX_STATIC_CONSTEXPR std::uint64_t no_deadline = std::uint64_t(-1);
+
+        // The threads with a deadline associated with one OS thread, ordered
+        // by their deadline (threads with equal deadlines are run in the
+        // order they were scheduled).
+        class deadline_queue
+        {
+            typedef Mutex mutex_type;
+
+            struct entry
+            {
+                std::uint64_t deadline_;
+                std::uint64_t sequence_;
+                threads::thread_data* thrd_;
+            };
+
+            struct later
+            {
+                bool operator()(entry const& lhs, entry const& rhs) const
+                {
+                    return lhs.deadline_ > rhs.deadline_ ||
+                        (lhs.deadline_ == rhs.deadline_ &&
+                            lhs.sequence_ > rhs.sequence_);
+                }
+            };
+
+        public:
+            deadline_queue()
+              : earliest_(no_deadline), sequence_(0)
+            {}
+
+            void push(threads::thread_data* thrd)
+            {
+                entry e = { thrd->get_deadline(), 0, thrd };
+
+                std::lock_guard<mutex_type> l(mtx_);
+                e.sequence_ = sequence_++;
+                heap_.push_back(e);
+                std::push_heap(heap_.begin(), heap_.end(), later());
+                earliest_.store(heap_.front().deadline_,
+                    boost::memory_order_relaxed);
+            }
+
+            bool pop(threads::thread_data*& thrd)
+            {
+                if (earliest() == no_deadline)
+                    return false;
+
+                std::lock_guard<mutex_type> l(mtx_);
+                if (heap_.empty())
+                    return false;
+
+                std::pop_heap(heap_.begin(), heap_.end(), later());
+                thrd = heap_.back().thrd_;
+                heap_.pop_back();
+
+                earliest_.store(
+                    heap_.empty() ? no_deadline : heap_.front().deadline_,
+                    boost::memory_order_relaxed);
+                return true;
+            }
+
+            // The deadline of the next thread in this queue, may be
+            // outdated by the time it is used.
+            std::uint64_t earliest() const
+            {
+                return earliest_.load(boost::memory_order_relaxed);
+            }
+
+            std::int64_t size() const
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                return std::int64_t(heap_.size());
+            }
+
+        private:
+            mutable mutex_type mtx_;
+            std::vector<entry> heap_;
+            boost::atomic<std::uint64_t> earliest_;
+            std::uint64_t sequence_;
+        };
+
+    public:
+        deadline_queue_scheduler(init_parameter_type const& init,
+                bool deferred_initialization = true)
+          : base_type(init, deferred_initialization)
+        {
+            deadline_queues_.reserve(init.num_queues_);
+            for (std::size_t i = 0; i != init.num_queues_; ++i)
+                deadline_queues_.emplace_back(new deadline_queue);
+        }
+
+        static std::string get_scheduler_name()
+        {
+            return "deadline_queue_scheduler";
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // create a new thread and schedule it if the initial state is equal to
+        // pending
+        void create_thread(thread_init_data& data, thread_id_type* id,
+            thread_state_enum initial_state, bool run_now, error_code& ec,
+            std::size_t num_thread)
+        {
+            if (data.deadline == 0 || initial_state != pending)
+            {
+                base_type::create_thread(data, id, initial_state, run_now,
+                    ec, num_thread);
+                return;
+            }
+
+            num_thread = select_queue(num_thread);
+
+            // the thread object is created right away as it has to be
+            // ordered by its deadline
+            thread_id_type thrd;
+            this->queues_[num_thread]->create_thread(data, &thrd,
+                pending_do_not_schedule, true, ec);
+            if (ec) return;
+
+            deadline_queues_[num_thread]->push(thrd.get());
+
+            if (id) *id = std::move(thrd);
+        }
+
+        /// Return the next thread to be executed, return false if none is
+        /// available
+        bool get_next_thread(std::size_t num_thread, bool running,
+            std::int64_t& idle_loop_count, threads::thread_data*& thrd)
+        {
+            HPX_ASSERT(num_thread < deadline_queues_.size());
+
+            // find the queue holding the earliest deadline among this
+            // OS thread's queue and the ones it may steal from
+            std::size_t victim = num_thread;
+            std::uint64_t earliest = deadline_queues_[num_thread]->earliest();
+
+            for (std::size_t idx : this->victim_threads_[num_thread])
+            {
+                std::uint64_t deadline = deadline_queues_[idx]->earliest();
+                if (deadline < earliest)
+                {
+                    earliest = deadline;
+                    victim = idx;
+                }
+            }
+
+            if (earliest != no_deadline)
+            {
+                if (deadline_queues_[victim]->pop(thrd))
+                {
+                    if (victim != num_thread)
+                    {
+                        this->queues_[victim]->
+                            increment_num_stolen_from_pending();
+                        this->queues_[num_thread]->
+                            increment_num_stolen_to_pending();
+                        if (HPX_UNLIKELY(util::tracing::enabled()))
+                            util::tracing::record_task_steal(thrd, victim);
+                    }
+                    return true;
+                }
+
+                // somebody else was faster
+                if (victim != num_thread &&
+                    deadline_queues_[num_thread]->pop(thrd))
+                {
+                    return true;
+                }
+            }
+
+            return base_type::get_next_thread(num_thread, running,
+                idle_loop_count, thrd);
+        }
+
+        /// Schedule the passed thread
+        void schedule_thread(threads::thread_data* thrd,
+            std::size_t num_thread,
+            thread_priority priority = thread_priority_normal)
+        {
+            if (thrd->get_deadline() == 0)
+            {
+                base_type::schedule_thread(thrd, num_thread, priority);
+                return;
+            }
+            deadline_queues_[select_queue(num_thread)]->push(thrd);
+        }
+
+        void schedule_thread_last(threads::thread_data* thrd,
+            std::size_t num_thread,
+            thread_priority priority = thread_priority_normal)
+        {
+            if (thrd->get_deadline() == 0)
+            {
+                base_type::schedule_thread_last(thrd, num_thread, priority);
+                return;
+            }
+            deadline_queues_[select_queue(num_thread)]->push(thrd);
+        }
+
+        /// Destroy the passed thread as it has been terminated
+        bool destroy_thread(threads::thread_data* thrd, std::int64_t& busy_count)
+        {
+            std::uint64_t deadline = thrd->get_deadline();
+            if (deadline != 0)
+            {
+                record_deadline(
+                    std::int64_t(util::high_resolution_clock::now()) -
+                        std::int64_t(deadline));
+            }
+            return base_type::destroy_thread(thrd, busy_count);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // This returns the current length of the queues (work items and new items)
+        std::int64_t get_queue_length(
+            std::size_t num_thread = std::size_t(-1)) const
+        {
+            std::int64_t count = base_type::get_queue_length(num_thread);
+
+            if (std::size_t(-1) != num_thread)
+            {
+                HPX_ASSERT(num_thread < deadline_queues_.size());
+                return count + deadline_queues_[num_thread]->size();
+            }
+
+            for (auto const& q : deadline_queues_)
+                count += q->size();
+            return count;
+        }
+
+        /// This is a function which gets called periodically by the thread
+        /// manager to allow for maintenance tasks to be executed in the
+        /// scheduler. Returns true if the OS thread calling this function
+        /// has to be terminated (i.e. no more work has to be done).
+        bool wait_or_add_new(std::size_t num_thread, bool running,
+            std::int64_t& idle_loop_count)
+        {
+            if (!base_type::wait_or_add_new(num_thread, running,
+                    idle_loop_count))
+            {
+                return false;
+            }
+
+            for (auto const& q : deadline_queues_)
+            {
+                if (q->earliest() != no_deadline)
+                    return false;
+            }
+            return true;
+        }
+
+    private:
+        std::size_t select_queue(std::size_t num_thread)
+        {
+            std::size_t queue_size = this->queues_.size();
+
+            if (std::size_t(-1) == num_thread)
+                num_thread = this->curr_queue_++ % queue_size;
+
+            if (num_thread >= queue_size)
+                num_thread %= queue_size;
+
+            return num_thread;
+        }
+
+        std::vector<std::unique_ptr<deadline_queue> > deadline_queues_;
+    };
+}}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
+#endif
@@ -0,0 +1,35 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_THREADMANAGER_DEADLINE_STATISTICS_APR_21_2017_1012AM)
+#define HPX_THREADMANAGER_DEADLINE_STATISTICS_APR_21_2017_1012AM
+
+#include <hpx/config.hpp>
+#include <hpx/error_code.hpp>
+#include <hpx/performance_counters/counters.hpp>
+#include <hpx/runtime/naming_fwd.hpp>
+
+#include <cstdint>
+
+namespace hpx { namespace threads { namespace policies
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Account for a thread with a deadline which has finished executing,
+    // 'lateness' is the time elapsed since its deadline [ns] (negative if
+    // the deadline was met).
+    HPX_EXPORT void record_deadline(std::int64_t lateness);
+
+    // Return the number of threads which have met (or missed) their deadline
+    // since the last reset (performance counters /threads/count/deadlines/...).
+    HPX_EXPORT std::int64_t get_deadline_count(bool missed, bool reset);
+
+    // Creation function for the /threads/time/deadline-lateness-histogram
+    // performance counter. The counter parameters are the lower and upper
+    // boundaries [ns] and the number of buckets of the histogram.
+    HPX_EXPORT naming::gid_type deadline_lateness_histogram_counter_creator(
+        performance_counters::counter_info const& info, error_code& ec);
+}}}
+
+#endif
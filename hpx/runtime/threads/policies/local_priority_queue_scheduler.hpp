@@ -18,6 +18,7 @@
 #include <hpx/throw_exception.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/logging.hpp>
+#include <hpx/util/tracing.hpp>
 #include <hpx/util_fwd.hpp>
 
 #include <boost/atomic.hpp>
@@ -552,6 +553,8 @@ namespace hpx { namespace threads { namespace policies
                         q->increment_num_stolen_from_pending();
                         this_high_priority_queue->
                             increment_num_stolen_to_pending();
+                        if (HPX_UNLIKELY(util::tracing::enabled()))
+                            util::tracing::record_task_steal(thrd, idx);
                         return true;
                     }
                 }
@@ -560,6 +563,8 @@ namespace hpx { namespace threads { namespace policies
                 {
                     queues_[idx]->increment_num_stolen_from_pending();
                     this_queue->increment_num_stolen_to_pending();
+                    if (HPX_UNLIKELY(util::tracing::enabled()))
+                        util::tracing::record_task_steal(thrd, idx);
                     return true;
                 }
             }
@@ -20,6 +20,7 @@
 #include <hpx/throw_exception.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/logging.hpp>
+#include <hpx/util/tracing.hpp>
 #include <hpx/util_fwd.hpp>
 
 #include <boost/atomic.hpp>
@@ -376,6 +377,8 @@ namespace hpx { namespace threads { namespace policies
                         {
                             q->increment_num_stolen_from_pending();
                             queues_[num_thread]->increment_num_stolen_to_pending();
+                            if (HPX_UNLIKELY(util::tracing::enabled()))
+                                util::tracing::record_task_steal(thrd, idx);
                             return true;
                         }
                     }
@@ -405,6 +408,8 @@ namespace hpx { namespace threads { namespace policies
                         {
                             q->increment_num_stolen_from_pending();
                             queues_[num_thread]->increment_num_stolen_to_pending();
+                            if (HPX_UNLIKELY(util::tracing::enabled()))
+                                util::tracing::record_task_steal(thrd, idx);
                             return true;
                         }
                     }
@@ -426,6 +431,8 @@ namespace hpx { namespace threads { namespace policies
                     {
                         q->increment_num_stolen_from_pending();
                         queues_[num_thread]->increment_num_stolen_to_pending();
+                        if (HPX_UNLIKELY(util::tracing::enabled()))
+                            util::tracing::record_task_steal(thrd, idx);
                         return true;
                     }
                 }
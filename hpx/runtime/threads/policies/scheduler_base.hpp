@@ -7,16 +7,21 @@
 #define HPX_THREADMANAGER_SCHEDULING_SCHEDULER_BASE_JUL_14_2013_1132AM
 
 #include <hpx/config.hpp>
-#include <hpx/compat/condition_variable.hpp>
-#include <hpx/compat/mutex.hpp>
 #include <hpx/runtime/agas/interface.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
+#include <hpx/runtime/io_fwd.hpp>
 #include <hpx/runtime/parcelset_fwd.hpp>
 #include <hpx/runtime/resource/detail/partitioner.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/threads/detail/parking_slot.hpp>
 #include <hpx/runtime/threads/detail/thread_pool_base.hpp>
+#include <hpx/runtime/threads/detail/timer_wheel.hpp>
 #include <hpx/runtime/threads/policies/scheduler_mode.hpp>
 #include <hpx/runtime/threads/thread_init_data.hpp>
 #include <hpx/state.hpp>
 #include <hpx/util/assert.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+#include <hpx/util/steady_clock.hpp>
 #include <hpx/util_fwd.hpp>
 #if defined(HPX_HAVE_SCHEDULER_LOCAL_STORAGE)
 #include <hpx/runtime/threads/coroutines/detail/tss.hpp>
@@ -75,7 +80,12 @@ namespace hpx { namespace threads { namespace policies
                 scheduler_mode mode = nothing_special)
           : mode_(mode)
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-          , wait_count_(0)
+          , parking_slots_(new threads::detail::parking_slot[num_threads])
+          , num_parked_(0)
+          , park_delay_(util::safe_lexical_cast<std::uint32_t>(
+                get_config_entry("hpx.idle_park_delay", 0), 0))
+          , max_idle_backoff_time_(util::safe_lexical_cast<std::uint32_t>(
+                get_config_entry("hpx.max_idle_backoff_time", 100), 100))
 #endif
           , states_(num_threads)
           , description_(description)
@@ -83,6 +93,13 @@ namespace hpx { namespace threads { namespace policies
         {
             for (std::size_t i = 0; i != num_threads; ++i)
                 states_[i].store(state_initialized);
+
+            timers_.reserve(num_threads);
+            for (std::size_t i = 0; i != num_threads; ++i)
+            {
+                timers_.push_back(std::unique_ptr<threads::detail::timer_wheel>(
+                    new threads::detail::timer_wheel));
+            }
         }
 
         virtual ~scheduler_base()
@@ -107,15 +124,46 @@ namespace hpx { namespace threads { namespace policies
 
         char const* get_description() const { return description_; }
 
-        void idle_callback(std::size_t /*num_thread*/)
+        void idle_callback(std::size_t num_thread)
         {
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-            // Put this thread to sleep for some time, additionally it gets
-            // woken up on new work.
-            std::chrono::milliseconds period(++wait_count_);
+            if (parent_pool_ != nullptr)
+                num_thread = global_to_local_thread_index(num_thread);
+            HPX_ASSERT(num_thread < states_.size());
+
+            // Keep spinning in the scheduling loop for the configured number
+            // of idle periods, then park this thread for a growing amount of
+            // time. It gets woken up early on new work.
+            threads::detail::parking_slot& slot = parking_slots_[num_thread];
+            std::uint32_t wait_count = slot.next_wait_count();
+            if (wait_count <= park_delay_)
+                return;
+
+            std::chrono::milliseconds period(
+                (std::min)(wait_count - park_delay_, max_idle_backoff_time_));
+
+            // don't oversleep pending timers
+            if (period > std::chrono::milliseconds(1) && has_pending_timers())
+                period = std::chrono::milliseconds(1);
+
+            ++num_parked_;
+            slot.park(period,
+                [this, num_thread]() -> bool
+                {
+                    return this->get_queue_length(num_thread) != 0;
+                });
+            --num_parked_;
+#endif
+        }
 
-            std::unique_lock<compat::mutex> l(mtx_);
-            cond_.wait_for(l, period);
+        /// This function gets called by the scheduling loop whenever the
+        /// given (pool local) OS thread found work, restarting its idle
+        /// backoff
+        void reset_idle_backoff(std::size_t num_thread)
+        {
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+            HPX_ASSERT(num_thread < states_.size());
+            parking_slots_[num_thread].reset_wait_count();
 #endif
         }
 
@@ -124,6 +172,8 @@ namespace hpx { namespace threads { namespace policies
             bool result = false;
             if (hpx::parcelset::do_background_work(num_thread))
                 result = true;
+            if (hpx::io::do_background_work(num_thread))
+                result = true;
 
             if (0 == num_thread)
                 hpx::agas::garbage_collect_non_blocking();
@@ -136,15 +186,103 @@ namespace hpx { namespace threads { namespace policies
         void do_some_work(std::size_t num_thread)
         {
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-            wait_count_.store(0, boost::memory_order_release);
+            if (num_parked_.load(boost::memory_order_seq_cst) == 0)
+                return;
 
+            std::size_t const num_threads = states_.size();
             if (num_thread == std::size_t(-1))
-                cond_.notify_all();
-            else
-                cond_.notify_one();
+            {
+                for (std::size_t i = 0; i != num_threads; ++i)
+                    parking_slots_[i].unpark();
+                return;
+            }
+
+            // wake up the thread the work was meant for, if it is parked
+            num_thread %= num_threads;
+            if (parking_slots_[num_thread].unpark())
+                return;
+
+            // otherwise wake up the parked thread closest to the one which
+            // produced the work, that one is likely to share its caches
+            std::size_t producer = hpx::get_worker_thread_num();
+            if (parent_pool_ != nullptr && producer != std::size_t(-1))
+                producer = global_to_local_thread_index(producer);
+            if (producer >= num_threads)
+                producer = num_thread;
+
+            for (std::size_t d = 1; d <= num_threads / 2; ++d)
+            {
+                if (parking_slots_[(producer + d) % num_threads].unpark() ||
+                    parking_slots_[(producer + num_threads - d) % num_threads]
+                        .unpark())
+                {
+                    return;
+                }
+            }
 #endif
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // Timers used for the timed suspension of threads. Every worker thread
+        // owns a timer wheel, which is checked by its scheduling loop.
+        typedef threads::detail::timer_wheel::handle_type timer_handle_type;
+
+        // register f to be invoked once abs_time has passed, the timer is
+        // added to the wheel of the calling worker thread
+        timer_handle_type add_timer(
+            util::steady_clock::time_point const& abs_time,
+            threads::detail::timer_wheel::callback_type && f)
+        {
+            std::size_t num_thread = hpx::get_worker_thread_num();
+            if (parent_pool_ != nullptr && num_thread != std::size_t(-1))
+                num_thread = global_to_local_thread_index(num_thread);
+
+            // threads not belonging to this scheduler use any of the wheels
+            num_thread %= timers_.size();
+            return timers_[num_thread]->add(abs_time, std::move(f));
+        }
+
+        // returns false if the timer has already expired
+        static bool cancel_timer(timer_handle_type const& timer)
+        {
+            return threads::detail::timer_wheel::cancel(timer);
+        }
+
+        // invoke the expired timers of the given worker thread
+        std::size_t expire_timers(std::size_t num_thread)
+        {
+            HPX_ASSERT(num_thread < timers_.size());
+            threads::detail::timer_wheel& timers = *timers_[num_thread];
+            if (timers.empty())
+                return 0;
+            return timers.expire(util::steady_clock::now());
+        }
+
+        // invoke the expired timers of all worker threads, this is done by
+        // idling worker threads to cover for workers busy running long tasks
+        std::size_t expire_all_timers()
+        {
+            if (!has_pending_timers())
+                return 0;
+
+            util::steady_clock::time_point now = util::steady_clock::now();
+
+            std::size_t expired = 0;
+            for (auto& timers : timers_)
+                expired += timers->expire(now, true);
+            return expired;
+        }
+
+        bool has_pending_timers() const
+        {
+            for (auto const& timers : timers_)
+            {
+                if (!timers->empty())
+                    return true;
+            }
+            return false;
+        }
+
         // allow to access/manipulate states
         boost::atomic<hpx::state>& get_state(std::size_t num_thread)
         {
@@ -350,15 +488,19 @@ namespace hpx { namespace threads { namespace policies
         boost::atomic<scheduler_mode> mode_;
 
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-        // support for suspension on idle queues
-        compat::mutex mtx_;
-        compat::condition_variable cond_;
-        boost::atomic<std::uint32_t> wait_count_;
+        // support for suspension on idle queues, one slot per thread
+        std::unique_ptr<threads::detail::parking_slot[]> parking_slots_;
+        boost::atomic<std::size_t> num_parked_;
+        std::uint32_t const park_delay_;
+        std::uint32_t const max_idle_backoff_time_;     // [ms]
 #endif
 
         std::vector<boost::atomic<hpx::state> > states_;
         char const* description_;
 
+        // timer wheels, one per worker thread
+        std::vector<std::unique_ptr<threads::detail::timer_wheel> > timers_;
+
         // the pool that owns this scheduler
         threads::detail::thread_pool_base *parent_pool_;
 
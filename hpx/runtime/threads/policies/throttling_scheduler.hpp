@@ -16,6 +16,7 @@
 #include <hpx/runtime/get_worker_thread_num.hpp>
 #include <hpx/runtime/get_os_thread_count.hpp>
 #include <hpx/runtime/threads_fwd.hpp>
+#include <hpx/compat/condition_variable.hpp>
 #include <hpx/compat/mutex.hpp>
 
 #include <hwloc.h>
@@ -66,12 +67,6 @@ namespace hpx { namespace threads { namespace policies
         using local_queue_scheduler<
             Mutex, PendingQueuing, StagedQueuing, TerminatedQueuing>::queues_;
 
-#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-        using local_queue_scheduler<
-            Mutex, PendingQueuing, StagedQueuing, TerminatedQueuing>::mtx_;
-        using local_queue_scheduler<
-            Mutex, PendingQueuing, StagedQueuing, TerminatedQueuing>::cond_;
-#endif
         using local_queue_scheduler<
             Mutex, PendingQueuing, StagedQueuing, TerminatedQueuing>::curr_queue_;
 
@@ -275,10 +270,8 @@ namespace hpx { namespace threads { namespace policies
     protected:
         typedef hpx::lcos::local::spinlock mutex_type;
         mutex_type throttle_mtx_;
-#if !defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
         mutable compat::mutex mtx_;
         compat::condition_variable cond_;
-#endif
         mutable boost::dynamic_bitset<> disabled_os_threads_;
         int num_physical_cores;
         int num_logical_cores;
@@ -343,6 +343,12 @@ namespace hpx { namespace threads
         {
             return 0;
         }
+
+        /// Return the description of the parent thread
+        util::thread_description get_parent_description() const
+        {
+            return util::thread_description("<unknown>");
+        }
 #else
         /// Return the locality of the parent thread
         std::uint32_t get_parent_locality_id() const
@@ -361,6 +367,13 @@ namespace hpx { namespace threads
         {
             return parent_thread_phase_;
         }
+
+        /// Return the description of the parent thread (if it was running
+        /// on this locality when this thread was created)
+        util::thread_description get_parent_description() const
+        {
+            return parent_description_;
+        }
 #endif
 
 #ifdef HPX_HAVE_THREAD_MINIMAL_DEADLOCK_DETECTION
@@ -454,6 +467,17 @@ namespace hpx { namespace threads
             priority_ = priority;
         }
 
+        // the point in time (see util::high_resolution_clock) this thread
+        // should have finished executing, zero if it has no deadline
+        std::uint64_t get_deadline() const
+        {
+            return deadline_;
+        }
+        void set_deadline(std::uint64_t deadline)
+        {
+            deadline_ = deadline;
+        }
+
         // handle thread interruption
         bool interruption_requested() const
         {
@@ -590,6 +614,7 @@ namespace hpx { namespace threads
             parent_locality_id_(init_data.parent_locality_id),
             parent_thread_id_(init_data.parent_id),
             parent_thread_phase_(init_data.parent_phase),
+            parent_description_("<unknown>"),
 #endif
 #ifdef HPX_HAVE_THREAD_MINIMAL_DEADLOCK_DETECTION
             marked_state_(unknown),
@@ -598,6 +623,7 @@ namespace hpx { namespace threads
             backtrace_(nullptr),
 #endif
             priority_(init_data.priority),
+            deadline_(init_data.deadline),
             requested_interrupt_(false),
             enabled_interrupt_(true),
             ran_exit_funcs_(false),
@@ -620,6 +646,8 @@ namespace hpx { namespace threads
                 {
                     parent_thread_id_ = threads::get_self_id().get();
                     parent_thread_phase_ = self->get_thread_phase();
+                    parent_description_ =
+                        threads::get_self_id()->get_description();
                 }
             }
             if (0 == parent_locality_id_)
@@ -647,6 +675,7 @@ namespace hpx { namespace threads
             parent_locality_id_ = init_data.parent_locality_id;
             parent_thread_id_ = init_data.parent_id;
             parent_thread_phase_ = init_data.parent_phase;
+            parent_description_ = util::thread_description("<unknown>");
 #endif
 #ifdef HPX_HAVE_THREAD_MINIMAL_DEADLOCK_DETECTION
             set_marked_state(unknown);
@@ -655,6 +684,7 @@ namespace hpx { namespace threads
             backtrace_ = nullptr;
 #endif
             priority_ = init_data.priority;
+            deadline_ = init_data.deadline;
             requested_interrupt_ = false;
             enabled_interrupt_ = true;
             ran_exit_funcs_ = false;
@@ -675,6 +705,8 @@ namespace hpx { namespace threads
                 {
                     parent_thread_id_ = threads::get_self_id().get();
                     parent_thread_phase_ = self->get_thread_phase();
+                    parent_description_ =
+                        threads::get_self_id()->get_description();
                 }
             }
             if (0 == parent_locality_id_)
@@ -699,6 +731,7 @@ namespace hpx { namespace threads
         std::uint32_t parent_locality_id_;
         thread_id_repr_type parent_thread_id_;
         std::size_t parent_thread_phase_;
+        util::thread_description parent_description_;
 #endif
 
 #ifdef HPX_HAVE_THREAD_MINIMAL_DEADLOCK_DETECTION
@@ -715,6 +748,7 @@ namespace hpx { namespace threads
 
         ///////////////////////////////////////////////////////////////////////
         thread_priority priority_;
+        std::uint64_t deadline_;
 
         bool requested_interrupt_;
         bool enabled_interrupt_;
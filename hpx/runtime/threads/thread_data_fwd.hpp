@@ -48,8 +48,13 @@ namespace hpx { namespace threads
     typedef std::pair<thread_state_enum, thread_id_type> thread_result_type;
     typedef thread_state_ex_enum thread_arg_type;
 
+    // Thread functions are stored inline if they fit into eight pointers,
+    // which holds for the thread functions of most actions (target, local
+    // address, component type and arguments) and of hpx::async.
     typedef thread_result_type thread_function_sig(thread_arg_type);
-    typedef util::unique_function_nonser<thread_function_sig> thread_function_type;
+    typedef util::unique_function_nonser<
+            thread_function_sig, 8 * sizeof(void*)
+        > thread_function_type;
 
     HPX_API_EXPORT void intrusive_ptr_add_ref(thread_data* p);
     HPX_API_EXPORT void intrusive_ptr_release(thread_data* p);
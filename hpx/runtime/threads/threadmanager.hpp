@@ -17,6 +17,7 @@
 #include <hpx/performance_counters/counters.hpp>
 #include <hpx/runtime/naming/name.hpp>
 #include <hpx/runtime/resource/detail/partitioner.hpp>
+#include <hpx/runtime/threads/detail/elastic_controller.hpp>
 #include <hpx/runtime/threads/detail/thread_num_tss.hpp>
 #include <hpx/runtime/threads/detail/thread_pool_base.hpp>
 #include <hpx/runtime/threads/policies/scheduler_mode.hpp>
@@ -301,6 +302,13 @@ namespace hpx { namespace threads
         std::size_t shrink_pool(std::string const& pool_name);
         std::size_t expand_pool(std::string const& pool_name);
 
+        // move one processing unit shared between the given elastic pools
+        bool move_processing_unit(
+            std::string const& from_pool, std::string const& to_pool);
+
+        // start rebalancing the elastic pools, if any
+        void start_elastic_controller();
+
     private:
         // counter creator functions
         naming::gid_type thread_counts_counter_creator(
@@ -413,6 +421,9 @@ private:
 #endif
         pool_vector pools_;
 
+        // moves processing units between elastic pools
+        std::unique_ptr<detail::elastic_controller> elastic_controller_;
+
         notification_policy_type& notifier_;
     };
 }}
@@ -6,10 +6,19 @@
 #if !defined(HPX_UTIL_CALCULATE_FANOUT_APR_23_2014_0124PM)
 #define HPX_UTIL_CALCULATE_FANOUT_APR_23_2014_0124PM
 
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+
 #include <cstddef>
+#include <cstdint>
 
 namespace hpx { namespace util
 {
+    // Return the number of targets handed to each of the subtrees spawned by
+    // a node of a tree-shaped collective operation. The node itself handles
+    // the first local_fanout targets, the remaining ones are split evenly
+    // into at most local_fanout subtrees, which keeps the depth of the tree
+    // logarithmic in the number of targets.
     inline std::size_t
     calculate_fanout(std::size_t size, std::size_t local_fanout)
     {
@@ -18,13 +27,33 @@ namespace hpx { namespace util
         if (size <= local_fanout)
             return size;
 
-        std::size_t fanout = 1;
         size -= local_fanout;
-        while (fanout < size)
+        return (size + local_fanout - 1) / local_fanout;
+    }
+
+    // Return the local fanout to use for a collective operation on size
+    // targets. This is taken from hpx.lcos.collectives.fanout, if given,
+    // otherwise dflt is used. A configured fanout of zero derives the fanout
+    // from the number of targets such that the tree has a depth of two.
+    inline std::size_t
+    get_collectives_fanout(std::size_t size, std::size_t dflt)
+    {
+        // the entry is read on every call as it may be changed at runtime,
+        // which is cheap compared to the collective operation itself
+        std::int64_t const fanout = util::safe_lexical_cast<std::int64_t>(
+            get_config_entry("hpx.lcos.collectives.fanout", "-1"),
+            std::int64_t(-1));
+        if (fanout < 0)
+            return dflt;
+
+        std::size_t local_fanout = static_cast<std::size_t>(fanout);
+        if (local_fanout == 0)
         {
-            fanout *= local_fanout;
+            local_fanout = 2;
+            while (local_fanout * (local_fanout + 1) < size)
+                ++local_fanout;
         }
-        return fanout;
+        return local_fanout;
     }
 }}
 
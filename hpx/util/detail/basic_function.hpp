@@ -52,12 +52,23 @@ namespace hpx { namespace util { namespace detail
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    template <typename VTable, typename Sig>
+    template <typename VTable, typename Sig, std::size_t StorageSize>
     class function_base;
 
-    template <typename VTable, typename R, typename ...Ts>
-    class function_base<VTable, R(Ts...)>
+    // Callables of up to StorageSize bytes are stored inline, larger ones are
+    // allocated on the heap. Non-trivial objects stored inline beyond the
+    // default storage are move constructed into their new location through
+    // vtable::relocate, everything else is relocated by copying the storage.
+    template <typename VTable, typename R, typename ...Ts,
+        std::size_t StorageSize>
+    class function_base<VTable, R(Ts...), StorageSize>
     {
+        static_assert(StorageSize >= vtable::function_storage_size,
+            "the function storage shall not be smaller than the default");
+
+        static const std::size_t storage_size =
+            (StorageSize + sizeof(void*) - 1) / sizeof(void*) * sizeof(void*);
+
         // make sure the empty table instance is initialized in time, even
         // during early startup
         static VTable const* get_empty_table()
@@ -71,7 +82,7 @@ namespace hpx { namespace util { namespace detail
         function_base() noexcept
           : vptr(get_empty_table())
         {
-            std::memset(object, 0, vtable::function_storage_size);
+            std::memset(object, 0, storage_size);
             vtable::default_construct<empty_function<R(Ts...)> >(object);
         }
 
@@ -79,14 +90,15 @@ namespace hpx { namespace util { namespace detail
           : vptr(other.vptr)
         {
             // move-construct
-            std::memcpy(object, other.object, vtable::function_storage_size);
+            relocate(vptr, object, other.object);
             other.vptr = get_empty_table();
             vtable::default_construct<empty_function<R(Ts...)> >(other.object);
         }
 
         ~function_base()
         {
-            vptr->delete_(object);
+            if (!vptr->trivial)
+                vptr->delete_(object);
         }
 
         function_base& operator=(function_base&& other) noexcept
@@ -109,7 +121,9 @@ namespace hpx { namespace util { namespace detail
         {
             if (!is_empty_function(f))
             {
-                typedef typename std::decay<F>::type target_type;
+                typedef typename vtable::vtable_key<
+                        typename std::decay<F>::type, StorageSize
+                    >::type target_type;
 
                 VTable const* f_vptr = get_vtable<target_type>();
                 if (vptr == f_vptr)
@@ -131,7 +145,8 @@ namespace hpx { namespace util { namespace detail
         {
             if (!vptr->empty)
             {
-                vptr->delete_(object);
+                if (!vptr->trivial)
+                    vptr->delete_(object);
 
                 vptr = get_empty_table();
                 vtable::default_construct<empty_function<R(Ts...)> >(object);
@@ -140,8 +155,16 @@ namespace hpx { namespace util { namespace detail
 
         void swap(function_base& f) noexcept
         {
+            if (vptr->relocate == nullptr && f.vptr->relocate == nullptr)
+            {
+                std::swap(object, f.object); // swap
+            } else {
+                void* tmp[storage_size / sizeof(void*)];
+                relocate(vptr, tmp, object);
+                relocate(f.vptr, object, f.object);
+                relocate(vptr, f.object, tmp);
+            }
             std::swap(vptr, f.vptr);
-            std::swap(object, f.object); // swap
         }
 
         bool empty() const noexcept
@@ -168,11 +191,14 @@ namespace hpx { namespace util { namespace detail
                 traits::is_invocable_r<R, target_type&, Ts...>::value
               , "T shall be Callable with the function signature");
 
-            VTable const* f_vptr = get_vtable<target_type>();
+            typedef typename vtable::vtable_key<target_type, StorageSize>::type
+                key_type;
+
+            VTable const* f_vptr = get_vtable<key_type>();
             if (vptr != f_vptr || empty())
                 return nullptr;
 
-            return &vtable::get<target_type>(object);
+            return &vtable::get<key_type>(object);
         }
 
         template <typename T>
@@ -184,11 +210,14 @@ namespace hpx { namespace util { namespace detail
                 traits::is_invocable_r<R, target_type&, Ts...>::value
               , "T shall be Callable with the function signature");
 
-            VTable const* f_vptr = get_vtable<target_type>();
+            typedef typename vtable::vtable_key<target_type, StorageSize>::type
+                key_type;
+
+            VTable const* f_vptr = get_vtable<key_type>();
             if (vptr != f_vptr || empty())
                 return nullptr;
 
-            return &vtable::get<target_type>(object);
+            return &vtable::get<key_type>(object);
         }
 
         HPX_FORCEINLINE R operator()(Ts... vs) const
@@ -230,30 +259,51 @@ namespace hpx { namespace util { namespace detail
             return detail::get_vtable<VTable, T>();
         }
 
+        static void relocate(VTable const* f_vptr, void** dst, void** src)
+            noexcept
+        {
+            if (f_vptr->relocate == nullptr)
+            {
+                std::memcpy(dst, src, storage_size);
+            } else {
+                f_vptr->relocate(dst, src);
+            }
+        }
+
     protected:
         VTable const *vptr;
-        mutable void* object[(vtable::function_storage_size / sizeof(void*))];
+        mutable void* object[storage_size / sizeof(void*)];
     };
 
-    template <typename Sig, typename VTable>
-    static bool is_empty_function(function_base<VTable, Sig> const& f) noexcept
+    template <typename Sig, typename VTable, std::size_t StorageSize>
+    static bool is_empty_function(
+        function_base<VTable, Sig, StorageSize> const& f) noexcept
     {
         return f.empty();
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    template <typename VTable, typename Sig, bool Serializable>
+    template <typename VTable, typename Sig, bool Serializable,
+        std::size_t StorageSize = vtable::function_storage_size>
     class basic_function;
 
-    template <typename VTable, typename R, typename ...Ts>
-    class basic_function<VTable, R(Ts...), true>
+    // Serializable functions are reconstructed from the name of the stored
+    // callable, they always use the default storage.
+    template <typename VTable, typename R, typename ...Ts,
+        std::size_t StorageSize>
+    class basic_function<VTable, R(Ts...), true, StorageSize>
       : public function_base<
             serializable_function_vtable<VTable>
-          , R(Ts...)
+          , R(Ts...), vtable::function_storage_size
         >
     {
+        static_assert(StorageSize == detail::vtable::function_storage_size,
+            "serializable functions shall use the default storage");
+
         typedef serializable_function_vtable<VTable> vtable;
-        typedef function_base<vtable, R(Ts...)> base_type;
+        typedef function_base<
+                vtable, R(Ts...), detail::vtable::function_storage_size
+            > base_type;
 
     public:
         typedef R result_type;
@@ -307,11 +357,12 @@ namespace hpx { namespace util { namespace detail
         HPX_SERIALIZATION_SPLIT_MEMBER()
     };
 
-    template <typename VTable, typename R, typename ...Ts>
-    class basic_function<VTable, R(Ts...), false>
-      : public function_base<VTable, R(Ts...)>
+    template <typename VTable, typename R, typename ...Ts,
+        std::size_t StorageSize>
+    class basic_function<VTable, R(Ts...), false, StorageSize>
+      : public function_base<VTable, R(Ts...), StorageSize>
     {
-        typedef function_base<VTable, R(Ts...)> base_type;
+        typedef function_base<VTable, R(Ts...), StorageSize> base_type;
 
     public:
         typedef R result_type;
@@ -331,9 +382,11 @@ namespace hpx { namespace util { namespace detail
         }
     };
 
-    template <typename Sig, typename VTable, bool Serializable>
+    template <typename Sig, typename VTable, bool Serializable,
+        std::size_t StorageSize>
     static bool is_empty_function(
-        basic_function<VTable, Sig, Serializable> const& f) noexcept
+        basic_function<VTable, Sig, Serializable, StorageSize> const& f)
+        noexcept
     {
         return f.empty();
     }
@@ -9,10 +9,13 @@
 #include <hpx/util/function.hpp>
 #include <hpx/util/unique_function.hpp>
 
+#include <cstddef>
+
 namespace hpx { namespace util { namespace detail
 {
-    template <typename Sig, bool Serializable>
-    inline void reset_function(hpx::util::function<Sig, Serializable>& f)
+    template <typename Sig, bool Serializable, std::size_t StorageSize>
+    inline void reset_function(
+        hpx::util::function<Sig, Serializable, StorageSize>& f)
     {
         f.reset();
     }
@@ -23,8 +26,9 @@ namespace hpx { namespace util { namespace detail
         f.reset();
     }
 
-    template <typename Sig, bool Serializable>
-    inline void reset_function(hpx::util::unique_function<Sig, Serializable>& f)
+    template <typename Sig, bool Serializable, std::size_t StorageSize>
+    inline void reset_function(
+        hpx::util::unique_function<Sig, Serializable, StorageSize>& f)
     {
         f.reset();
     }
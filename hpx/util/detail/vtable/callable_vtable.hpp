@@ -25,14 +25,18 @@ namespace hpx { namespace util { namespace detail
         template <typename T>
         HPX_FORCEINLINE static std::size_t _get_function_address(void** f)
         {
-            return traits::get_function_address<T>::call(vtable::get<T>(f));
+            return traits::get_function_address<
+                    typename vtable::object<T>::type
+                >::call(vtable::get<T>(f));
         }
         std::size_t (*get_function_address)(void**);
 
         template <typename T>
         HPX_FORCEINLINE static char const* _get_function_annotation(void** f)
         {
-            return traits::get_function_annotation<T>::call(vtable::get<T>(f));
+            return traits::get_function_annotation<
+                    typename vtable::object<T>::type
+                >::call(vtable::get<T>(f));
         }
         char const* (*get_function_annotation)(void**);
 
@@ -40,7 +44,9 @@ namespace hpx { namespace util { namespace detail
         template <typename T>
         HPX_FORCEINLINE static char const* _get_function_annotation_itt(void** f)
         {
-            return traits::get_function_annotation_itt<T>::call(vtable::get<T>(f));
+            return traits::get_function_annotation_itt<
+                    typename vtable::object<T>::type
+                >::call(vtable::get<T>(f));
         }
         char const* (*get_function_annotation_itt)(void**);
 #endif
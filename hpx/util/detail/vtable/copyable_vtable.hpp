@@ -18,12 +18,7 @@ namespace hpx { namespace util { namespace detail
         template <typename T>
         HPX_FORCEINLINE static void _copy(void** v, void* const* src)
         {
-            if (sizeof(T) <= vtable::function_storage_size)
-            {
-                new (v) T(vtable::get<T>(src));
-            } else {
-                *v = new T(vtable::get<T>(src));
-            }
+            vtable::construct<T>(v, vtable::get<T>(src));
         }
         void (*copy)(void**, void* const*);
 
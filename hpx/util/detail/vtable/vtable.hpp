@@ -41,52 +41,96 @@ namespace hpx { namespace util { namespace detail
         return &vtables<VTable, T>::instance;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Objects which do not fit into the default function storage, but which
+    // are stored inline in a function with a larger storage, use the vtable
+    // of inline_object<T> instead of the one of T.
+    template <typename T>
+    struct inline_object {};
+
     ///////////////////////////////////////////////////////////////////////////
     struct vtable
     {
         static const std::size_t function_storage_size = 3*sizeof(void*);
 
+        // The type used to select the vtable of an object of type T stored in
+        // a function with the given storage size. Objects exceeding the
+        // default storage are stored inline only if they can be relocated
+        // without throwing.
+        template <typename T, std::size_t StorageSize>
+        struct vtable_key
+        {
+            typedef typename std::conditional<
+                (sizeof(T) <= function_storage_size)
+             || (sizeof(T) > StorageSize)
+             || !std::is_nothrow_move_constructible<T>::value
+              , T, inline_object<T>
+            >::type type;
+        };
+
+        // The type of the object and whether it is stored inline, given the
+        // type used to select its vtable.
+        template <typename T>
+        struct object
+        {
+            typedef T type;
+            static const bool is_inline = sizeof(T) <= function_storage_size;
+        };
+
         template <typename T>
-        HPX_FORCEINLINE static T& get(void** v)
+        struct object<inline_object<T> >
         {
-            if (sizeof(T) <= function_storage_size)
+            typedef T type;
+            static const bool is_inline = true;
+        };
+
+        template <typename T>
+        HPX_FORCEINLINE static typename object<T>::type& get(void** v)
+        {
+            typedef typename object<T>::type object_type;
+            if (object<T>::is_inline)
             {
-                return *reinterpret_cast<T*>(v);
+                return *reinterpret_cast<object_type*>(v);
             } else {
-                return **reinterpret_cast<T**>(v);
+                return **reinterpret_cast<object_type**>(v);
             }
         }
 
         template <typename T>
-        HPX_FORCEINLINE static T const& get(void* const* v)
+        HPX_FORCEINLINE static typename object<T>::type const& get(
+            void* const* v)
         {
-            if (sizeof(T) <= function_storage_size)
+            typedef typename object<T>::type object_type;
+            if (object<T>::is_inline)
             {
-                return *reinterpret_cast<T const*>(v);
+                return *reinterpret_cast<object_type const*>(v);
             } else {
-                return **reinterpret_cast<T* const*>(v);
+                return **reinterpret_cast<object_type* const*>(v);
             }
         }
 
         template <typename T>
         HPX_FORCEINLINE static void default_construct(void** v)
         {
-            if (sizeof(T) <= function_storage_size)
+            typedef typename object<T>::type object_type;
+            if (object<T>::is_inline)
             {
-                ::new (static_cast<void*>(v)) T; //-V206
+                ::new (static_cast<void*>(v)) object_type; //-V206
             } else {
-                *v = new T;
+                *v = new object_type;
             }
         }
 
         template <typename T, typename Arg>
         HPX_FORCEINLINE static void construct(void** v, Arg&& arg)
         {
-            if (sizeof(T) <= function_storage_size)
+            typedef typename object<T>::type object_type;
+            if (object<T>::is_inline)
             {
-                ::new (static_cast<void*>(v)) T(std::forward<Arg>(arg)); //-V206
+                ::new (static_cast<void*>(v)) //-V206
+                    object_type(std::forward<Arg>(arg));
             } else {
-                *v = new T(std::forward<Arg>(arg));
+                *v = new object_type(std::forward<Arg>(arg));
             }
         }
 
@@ -100,21 +144,22 @@ namespace hpx { namespace util { namespace detail
         template <typename T>
         HPX_FORCEINLINE static std::type_info const& _get_type()
         {
-            return typeid(T);
+            return typeid(typename object<T>::type);
         }
         std::type_info const& (*get_type)();
 
         template <typename T>
         HPX_FORCEINLINE static void _destruct(void** v)
         {
-            get<T>(v).~T();
+            typedef typename object<T>::type object_type;
+            get<T>(v).~object_type();
         }
         void (*destruct)(void**);
 
         template <typename T>
         HPX_FORCEINLINE static void _delete(void** v)
         {
-            if (sizeof(T) <= function_storage_size)
+            if (object<T>::is_inline)
             {
                 _destruct<T>(v);
             } else {
@@ -123,11 +168,58 @@ namespace hpx { namespace util { namespace detail
         }
         void (*delete_)(void**);
 
+        // Objects stored inline which are trivially copyable are copied with
+        // memcpy and are not destroyed, without calling through the vtable.
+        template <typename T>
+        HPX_CONSTEXPR static bool is_trivial() noexcept
+        {
+#if defined(HPX_HAVE_CXX11_STD_IS_TRIVIALLY_COPYABLE)
+            return object<T>::is_inline &&
+                std::is_trivially_copyable<typename object<T>::type>::value;
+#else
+            return false;
+#endif
+        }
+        bool trivial;
+
+        // Objects stored in the default storage are relocated with memcpy,
+        // objects exceeding it but stored inline are move constructed into
+        // their new location (unless they are trivially copyable).
+        template <typename T>
+        HPX_FORCEINLINE static void _relocate(void** dst, void** src)
+        {
+            typedef typename object<T>::type object_type;
+            object_type& obj = get<T>(src);
+            ::new (static_cast<void*>(dst)) object_type(std::move(obj)); //-V206
+            obj.~object_type();
+        }
+        void (*relocate)(void**, void**);
+
+        template <typename T>
+        HPX_CONSTEXPR static void (*get_relocate(std::true_type))(
+            void**, void**)
+        {
+            return &vtable::template _relocate<T>;
+        }
+
+        template <typename T>
+        HPX_CONSTEXPR static void (*get_relocate(std::false_type))(
+            void**, void**)
+        {
+            return nullptr;
+        }
+
         template <typename T>
         HPX_CONSTEXPR vtable(construct_vtable<T>) noexcept
           : get_type(&vtable::template _get_type<T>)
           , destruct(&vtable::template _destruct<T>)
           , delete_(&vtable::template _delete<T>)
+          , trivial(vtable::template is_trivial<T>())
+          , relocate(vtable::template get_relocate<T>(
+                std::integral_constant<bool,
+                    !std::is_same<T, typename object<T>::type>::value &&
+                    !vtable::template is_trivial<T>()
+                >()))
         {}
     };
 }}}
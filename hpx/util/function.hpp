@@ -20,24 +20,28 @@
 #include <hpx/util_fwd.hpp>
 
 #include <cstddef>
+#include <cstring>
 #include <type_traits>
 #include <utility>
 
 namespace hpx { namespace util
 {
     ///////////////////////////////////////////////////////////////////////////
-    template <typename Sig, bool Serializable>
+    template <typename Sig, bool Serializable, std::size_t StorageSize>
     class function;
 
-    template <typename R, typename ...Ts, bool Serializable>
-    class function<R(Ts...), Serializable>
+    template <typename R, typename ...Ts, bool Serializable,
+        std::size_t StorageSize>
+    class function<R(Ts...), Serializable, StorageSize>
       : public detail::basic_function<
             detail::function_vtable<R(Ts...)>
-          , R(Ts...), Serializable
+          , R(Ts...), Serializable, StorageSize
         >
     {
         typedef detail::function_vtable<R(Ts...)> vtable;
-        typedef detail::basic_function<vtable, R(Ts...), Serializable> base_type;
+        typedef detail::basic_function<
+                vtable, R(Ts...), Serializable, StorageSize
+            > base_type;
 
     public:
         typedef typename base_type::result_type result_type;
@@ -58,7 +62,11 @@ namespace hpx { namespace util
             >(this->object);
 
             this->vptr = other.vptr;
-            if (!this->vptr->empty)
+            if (this->vptr->trivial)
+            {
+                std::memcpy(this->object, other.object, sizeof(this->object));
+            }
+            else if (!this->vptr->empty)
             {
                 this->vptr->copy(this->object, other.object);
             }
@@ -92,7 +100,12 @@ namespace hpx { namespace util
                 >(this->object);
 
                 this->vptr = other.vptr;
-                if (!this->vptr->empty)
+                if (this->vptr->trivial)
+                {
+                    std::memcpy(this->object, other.object,
+                        sizeof(this->object));
+                }
+                else if (!this->vptr->empty)
                 {
                     this->vptr->copy(this->object, other.object);
                 }
@@ -128,9 +141,9 @@ namespace hpx { namespace util
         using base_type::target;
     };
 
-    template <typename Sig, bool Serializable>
+    template <typename Sig, bool Serializable, std::size_t StorageSize>
     static bool is_empty_function(
-        function<Sig, Serializable> const& f) noexcept
+        function<Sig, Serializable, StorageSize> const& f) noexcept
     {
         return f.empty();
     }
@@ -140,32 +153,35 @@ namespace hpx { namespace util
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace traits
 {
-    template <typename Sig, bool Serializable>
-    struct get_function_address<util::function<Sig, Serializable> >
+    template <typename Sig, bool Serializable, std::size_t StorageSize>
+    struct get_function_address<
+        util::function<Sig, Serializable, StorageSize> >
     {
-        static std::size_t
-            call(util::function<Sig, Serializable> const& f) noexcept
+        static std::size_t call(
+            util::function<Sig, Serializable, StorageSize> const& f) noexcept
         {
             return f.get_function_address();
         }
     };
 
-    template <typename Sig, bool Serializable>
-    struct get_function_annotation<util::function<Sig, Serializable> >
+    template <typename Sig, bool Serializable, std::size_t StorageSize>
+    struct get_function_annotation<
+        util::function<Sig, Serializable, StorageSize> >
     {
-        static char const*
-            call(util::function<Sig, Serializable> const& f) noexcept
+        static char const* call(
+            util::function<Sig, Serializable, StorageSize> const& f) noexcept
         {
             return f.get_function_annotation();
         }
     };
 
 #if HPX_HAVE_ITTNOTIFY != 0 && !defined(HPX_HAVE_APEX)
-    template <typename Sig, bool Serializable>
-    struct get_function_annotation_itt<util::function<Sig, Serializable> >
+    template <typename Sig, bool Serializable, std::size_t StorageSize>
+    struct get_function_annotation_itt<
+        util::function<Sig, Serializable, StorageSize> >
     {
-        static char const*
-            call(util::function<Sig, Serializable> const& f) noexcept
+        static char const* call(
+            util::function<Sig, Serializable, StorageSize> const& f) noexcept
         {
             return f.get_function_annotation_itt();
         }
@@ -9,6 +9,8 @@
 
 #include <hpx/config.hpp>
 #include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
 #include <hpx/runtime/threads/thread_data_fwd.hpp>
 #include <hpx/state.hpp>
 #include <hpx/throw_exception.hpp>
@@ -19,6 +21,7 @@
 #include <hpx/util/one_size_heap_list_base.hpp>
 #include <hpx/util/unlock_guard.hpp>
 
+#include <boost/atomic.hpp>
 #include <boost/format.hpp>
 
 #include <cstddef>
@@ -26,6 +29,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace util
@@ -55,6 +59,7 @@ namespace hpx { namespace util
 
         explicit one_size_heap_list(char const* class_name = "")
             : class_name_(class_name)
+            , num_caches_(0)
 #if defined(HPX_DEBUG)
             , alloc_count_(0L)
             , free_count_(0L)
@@ -67,6 +72,7 @@ namespace hpx { namespace util
 
         explicit one_size_heap_list(std::string const& class_name)
             : class_name_(class_name)
+            , num_caches_(0)
 #if defined(HPX_DEBUG)
             , alloc_count_(0L)
             , free_count_(0L)
@@ -101,18 +107,16 @@ namespace hpx { namespace util
 #endif
         }
 
-        // operations
-        void* alloc(std::size_t count = 1)
+    private:
+        // Allocate 'count' consecutive objects from the first heap which can
+        // provide them, create a new heap if none can. If 'partial' is set,
+        // the heaps may return fewer objects, 'count' is set to the number
+        // of objects actually allocated.
+        value_type* alloc_slots(std::size_t& count, bool partial,
+            heap_type*& allocating_heap)
         {
             unique_lock_type guard(mtx_);
 
-            if (HPX_UNLIKELY(0 == count))
-            {
-                HPX_THROW_EXCEPTION(bad_parameter,
-                    name() + "::alloc",
-                    "cannot allocate 0 objects");
-            }
-
             //std::size_t size = 0;
             value_type* p = nullptr;
             {
@@ -126,11 +130,14 @@ namespace hpx { namespace util
 
                         {
                             util::unlock_guard<unique_lock_type> ul(guard);
-                            allocated = heap->alloc(&p, count);
+                            allocated = partial ?
+                                heap->alloc_batch(&p, count) :
+                                heap->alloc(&p, count);
                         }
 
                         if (allocated)
                         {
+                            allocating_heap = heap.get();
 #if defined(HPX_DEBUG)
                             // Allocation succeeded, update statistics.
                             alloc_count_ += count;
@@ -172,8 +179,11 @@ namespace hpx { namespace util
 
                 {
                     util::unlock_guard<unique_lock_type> ul(guard);
-                    result = heap->alloc(&p, count);
+                    result = partial ?
+                        heap->alloc_batch(&p, count) :
+                        heap->alloc(&p, count);
                 }
+                allocating_heap = heap.get();
 
                 if (HPX_UNLIKELY(!result || nullptr == p))
                 {
@@ -205,7 +215,46 @@ namespace hpx { namespace util
             guard.unlock();
 
             // Try again, we just got a new heap, so we should be good.
-            return alloc(count);
+            return alloc_slots(count, partial, allocating_heap);
+        }
+
+    public:
+        // operations
+        void* alloc(std::size_t count = 1)
+        {
+            if (HPX_UNLIKELY(0 == count))
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    name() + "::alloc",
+                    "cannot allocate 0 objects");
+            }
+
+#if HPX_WRAPPER_HEAP_CACHE_SIZE != 0
+            if (count == 1)
+            {
+                cache_guard g(get_worker_cache());
+                if (g.cache_ != nullptr)
+                    return alloc_cached(*g.cache_);
+            }
+#endif
+
+            heap_type* heap = nullptr;
+            return alloc_slots(count, false, heap);
+        }
+
+        // Allocate up to 'count' consecutive objects from one heap, 'count'
+        // is set to the number of objects actually allocated.
+        void* alloc_batch(std::size_t& count)
+        {
+            if (HPX_UNLIKELY(0 == count))
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    name() + "::alloc_batch",
+                    "cannot allocate 0 objects");
+            }
+
+            heap_type* heap = nullptr;
+            return alloc_slots(count, true, heap);
         }
 
         heap_type* alloc_heap()
@@ -257,11 +306,23 @@ namespace hpx { namespace util
 
         void free(void* p, std::size_t count = 1)
         {
-            unique_lock_type ul(mtx_);
-
             if (nullptr == p || !threads::threadmanager_is(state_running))
                 return;
 
+#if HPX_WRAPPER_HEAP_CACHE_SIZE != 0
+            if (count == 1)
+            {
+                cache_guard g(get_worker_cache());
+                if (g.cache_ != nullptr)
+                {
+                    free_cached(*g.cache_, p);
+                    return;
+                }
+            }
+#endif
+
+            unique_lock_type ul(mtx_);
+
             // if this is called from outside a HPX thread we need to
             // re-schedule the request
             if (reschedule(p, count))
@@ -323,12 +384,195 @@ namespace hpx { namespace util
         }
 
     protected:
+        // The slots taken from and returned to the heaps by the HPX threads
+        // running on one worker thread. The heaps hand out their slots
+        // consecutively, thus the cached slots are described by the heap
+        // they were taken from, the next slot and their number. The returned
+        // slots are counted and given back to their heap in one go. Neither
+        // operation suspends while the cache is claimed, thus a failed claim
+        // means that another HPX thread on this worker has been suspended
+        // while talking to a heap (the caller falls back to the heap list).
+        struct worker_cache
+        {
+            worker_cache()
+              : busy_(false), alloc_heap_(nullptr), next_(nullptr),
+                available_(0), free_heap_(nullptr), last_freed_(nullptr),
+                freed_(0)
+            {}
+
+            boost::atomic<bool> busy_;
+
+            heap_type* alloc_heap_;
+            value_type* next_;
+            std::size_t available_;
+
+            heap_type* free_heap_;
+            void* last_freed_;
+            std::size_t freed_;
+        };
+
+        struct cache_guard
+        {
+            HPX_NON_COPYABLE(cache_guard);
+
+            explicit cache_guard(worker_cache* cache)
+              : cache_(cache)
+            {}
+
+            ~cache_guard()
+            {
+                if (cache_ != nullptr)
+                    cache_->busy_.store(false, boost::memory_order_release);
+            }
+
+            worker_cache* cache_;
+        };
+
+        // Claim the cache of the calling worker thread, returns nullptr if
+        // this is not an HPX thread or the cache is in use.
+        worker_cache* get_worker_cache()
+        {
+            std::size_t num_thread = hpx::get_worker_thread_num();
+            if (num_thread == std::size_t(-1) ||
+                nullptr == threads::get_self_ptr())
+            {
+                return nullptr;
+            }
+
+            std::size_t num_caches =
+                num_caches_.load(boost::memory_order_acquire);
+            if (num_caches == 0)
+                num_caches = init_caches();
+
+            if (num_thread >= num_caches)
+                return nullptr;
+
+            worker_cache* cache = caches_[num_thread].get();
+            if (cache->busy_.exchange(true, boost::memory_order_acquire))
+                return nullptr;
+            return cache;
+        }
+
+        std::size_t init_caches()
+        {
+            unique_lock_type ul(mtx_);
+
+            std::size_t num_caches =
+                num_caches_.load(boost::memory_order_relaxed);
+            if (num_caches == 0)
+            {
+                num_caches = hpx::get_os_thread_count();
+
+                caches_.reserve(num_caches);
+                for (std::size_t i = 0; i != num_caches; ++i)
+                    caches_.emplace_back(new worker_cache);
+
+                num_caches_.store(num_caches, boost::memory_order_release);
+            }
+            return num_caches;
+        }
+
+        value_type* alloc_cached(worker_cache& cache)
+        {
+            if (cache.available_ == 0)
+            {
+                std::size_t count = HPX_WRAPPER_HEAP_CACHE_SIZE;
+                cache.next_ = alloc_slots(count, true, cache.alloc_heap_);
+                cache.available_ = count;
+            }
+
+            --cache.available_;
+            return cache.next_++;
+        }
+
+        void free_cached(worker_cache& cache, void* p)
+        {
+            // the heap holding the returned slots can't be released before
+            // those are given back
+            if (cache.freed_ != 0 && cache.free_heap_->did_alloc(p))
+            {
+                cache.last_freed_ = p;
+                if (++cache.freed_ == HPX_WRAPPER_HEAP_CACHE_SIZE)
+                    flush_freed(cache);
+                return;
+            }
+
+            heap_type* heap = nullptr;
+            if (cache.available_ != 0 && cache.alloc_heap_->did_alloc(p))
+                heap = cache.alloc_heap_;
+            else
+                heap = find_heap(p);
+
+            flush_freed(cache);
+
+            cache.free_heap_ = heap;
+            cache.last_freed_ = p;
+            cache.freed_ = 1;
+        }
+
+        // give the returned slots back to their heap
+        void flush_freed(worker_cache& cache)
+        {
+            if (cache.freed_ == 0)
+                return;
+
+            std::size_t count = cache.freed_;
+            heap_type* heap = cache.free_heap_;
+
+            cache.freed_ = 0;
+            cache.free_heap_ = nullptr;
+
+            heap->free(cache.last_freed_, count);
+
+#if defined(HPX_DEBUG)
+            unique_lock_type ul(mtx_);
+            free_count_ += count;
+#endif
+        }
+
+        // Find the heap which allocated the given pointer. The heaps are
+        // never removed from the list.
+        heap_type* find_heap(void* p)
+        {
+            unique_lock_type ul(mtx_);
+            for (iterator it = heap_list_.begin(); it != heap_list_.end(); ++it)
+            {
+                if ((*it)->did_alloc(p))
+                    return it->get();
+            }
+
+            HPX_THROW_EXCEPTION(bad_parameter,
+                name() + "::free",
+                boost::str(boost::format(
+                    "pointer %1% was not allocated by this %2%")
+                    % p % name()));
+            return nullptr;
+        }
+
+        // Return the heap the calling worker thread currently takes its
+        // slots from if it has allocated the given pointer.
+        heap_type* get_cached_heap(void* p)
+        {
+#if HPX_WRAPPER_HEAP_CACHE_SIZE != 0
+            cache_guard g(get_worker_cache());
+            if (g.cache_ != nullptr && g.cache_->available_ != 0 &&
+                g.cache_->alloc_heap_->did_alloc(p))
+            {
+                return g.cache_->alloc_heap_;
+            }
+#endif
+            return nullptr;
+        }
+
         mutable mutex_type mtx_;
         list_type heap_list_;
 
     private:
         std::string const class_name_;
 
+        boost::atomic<std::size_t> num_caches_;
+        std::vector<std::unique_ptr<worker_cache> > caches_;
+
     public:
 #if defined(HPX_DEBUG)
         std::size_t alloc_count_;
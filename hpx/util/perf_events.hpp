@@ -0,0 +1,81 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Attribution of hardware events (cycles, instructions, last level cache
+// misses, and branch misses) to HPX threads. Every worker thread opens a
+// group of perf_event counters which is read whenever an HPX thread starts
+// or stops running. The differences are accumulated per thread description
+// and are exposed as the /threads/perf/<event>@<description> performance
+// counters. Counting starts when the first of these counters is created.
+
+#if !defined(HPX_UTIL_PERF_EVENTS_MAY_29_2017_0937AM)
+#define HPX_UTIL_PERF_EVENTS_MAY_29_2017_0937AM
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PERF_EVENT_COUNTERS)
+#include <hpx/util/thread_description.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace hpx { namespace util { namespace perf_events
+{
+    ///////////////////////////////////////////////////////////////////////////
+    enum event_type
+    {
+        cycles = 0,             ///< CPU cycles
+        instructions = 1,       ///< retired instructions
+        llc_misses = 2,         ///< last level cache misses
+        branch_misses = 3,      ///< mispredicted branches
+        num_events = 4
+    };
+
+    namespace detail
+    {
+        HPX_EXPORT extern boost::atomic<bool> enabled;
+    }
+
+    /// Return whether hardware events are being attributed to HPX threads
+    inline bool enabled()
+    {
+        return detail::enabled.load(boost::memory_order_relaxed);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The functions below must be invoked only if counting is enabled.
+
+    /// The HPX thread with the given description starts (or resumes) running
+    /// on this worker thread
+    HPX_EXPORT void record_task_begin(util::thread_description const& desc);
+
+    /// The running HPX thread has returned to the scheduler
+    HPX_EXPORT void record_task_end();
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Return whether the hardware events can be counted on this system
+    HPX_EXPORT bool available();
+
+    /// Start attributing hardware events to HPX threads
+    HPX_EXPORT void enable();
+
+    /// Stop counting and release the counters of all worker threads. This
+    /// must be called only after all worker threads have stopped.
+    HPX_EXPORT void stop();
+
+    /// Return the number of events of the given type counted while HPX
+    /// threads with the given description were running
+    HPX_EXPORT std::int64_t get_value(event_type type,
+        std::string const& description, bool reset);
+
+    /// Return the event type for the given counter name (for instance
+    /// 'llc-misses'), or num_events if the name is not known
+    HPX_EXPORT event_type get_event_type(std::string const& name);
+}}}
+
+#endif
+#endif
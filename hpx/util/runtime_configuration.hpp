@@ -79,6 +79,14 @@ namespace hpx { namespace util
 
         std::size_t get_agas_max_pending_refcnt_requests() const;
 
+        // Get the number of credit decrements buffered by each worker thread
+        // before they are merged into the pending requests
+        std::size_t get_agas_max_pending_worker_refcnt_requests() const;
+
+        // Get the interval [ms] in which the pending credit decrements are
+        // sent (0 disables the periodic flush)
+        std::int64_t get_agas_refcnt_flush_interval() const;
+
         // Load application specific configuration and merge it with the
         // default configuration loaded from hpx.ini
         bool load_application_configuration(char const* filename,
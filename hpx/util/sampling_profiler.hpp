@@ -0,0 +1,59 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Built-in sampling profiler attributing time to HPX threads. Each worker
+// thread periodically interrupts itself (using a per-thread CPU time timer)
+// and records the description of the running HPX thread, the description of
+// its parent, and the call stack of the HPX thread. The samples are
+// aggregated per worker thread and written as folded stacks (as consumed by
+// flamegraph.pl or speedscope) when the runtime shuts down. The profiler is
+// enabled at runtime with --hpx:profile (or hpx.profiler.enable=1).
+
+#if !defined(HPX_UTIL_SAMPLING_PROFILER_MAY_26_2017_1104AM)
+#define HPX_UTIL_SAMPLING_PROFILER_MAY_26_2017_1104AM
+
+#include <hpx/config.hpp>
+#include <hpx/util/thread_description.hpp>
+#include <hpx/util_fwd.hpp>
+
+#include <cstdint>
+
+namespace hpx { namespace util { namespace sampling_profiler
+{
+    namespace detail
+    {
+        // set while the runtime starts up, not modified afterwards
+        HPX_EXPORT extern bool enabled;
+    }
+
+    /// Return whether the sampling profiler has been enabled for this run
+    inline bool enabled()
+    {
+        return detail::enabled;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The functions below must be invoked only if the profiler is enabled.
+
+    /// The HPX thread with the given descriptions starts (or resumes) running
+    /// on this worker thread
+    HPX_EXPORT void record_task_begin(util::thread_description const& desc,
+        util::thread_description const& parent);
+
+    /// The running HPX thread has returned to the scheduler
+    HPX_EXPORT void record_task_end();
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Enable the profiler if requested by the [hpx.profiler] configuration
+    /// section, discarding all previously collected samples.
+    HPX_EXPORT void start(util::section const& cfg);
+
+    /// Disable the profiler and write the collected samples to the
+    /// configured destination. This must be called only after all worker
+    /// threads have stopped.
+    HPX_EXPORT void stop(std::uint32_t locality_id);
+}}}
+
+#endif
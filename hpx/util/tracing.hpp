@@ -0,0 +1,111 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Built-in tracing of task begin and end, suspension, stealing, and parcel
+// send and receive. Events are recorded into a lock-free ring buffer per
+// OS-thread and are written as a Chrome trace (JSON) or as a Perfetto trace
+// (protobuf) when the runtime shuts down. Tracing is enabled at runtime with
+// --hpx:trace (or hpx.trace.enable=1).
+
+#if !defined(HPX_UTIL_TRACING_MAY_22_2017_0915AM)
+#define HPX_UTIL_TRACING_MAY_22_2017_0915AM
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/thread_enums.hpp>
+#include <hpx/util/thread_description.hpp>
+#include <hpx/util_fwd.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hpx { namespace util { namespace tracing
+{
+    ///////////////////////////////////////////////////////////////////////////
+    enum event_type
+    {
+        task_begin = 0,         ///< an HPX thread starts or resumes running
+        task_end = 1,           ///< an HPX thread has terminated
+        task_suspend = 2,       ///< an HPX thread was suspended or has yielded
+        task_steal = 3,         ///< an HPX thread was stolen from another queue
+        parcel_send = 4,        ///< a parcel was handed to the parcel layer
+        parcel_receive = 5      ///< a parcel was received and scheduled
+    };
+
+    namespace detail
+    {
+        // set while the runtime starts up, not modified afterwards
+        HPX_EXPORT extern bool enabled;
+
+        // The name is either a string (which must stay valid until the trace
+        // has been written) or the address of a function.
+        HPX_EXPORT void record(event_type type, void const* id,
+            char const* name, std::size_t address, std::uint32_t data);
+
+        inline void record(event_type type, void const* id,
+            util::thread_description const& desc, std::uint32_t data)
+        {
+            if (desc.kind() == util::thread_description::data_type_description)
+                record(type, id, desc.get_description(), 0, data);
+            else
+                record(type, id, nullptr, desc.get_address(), data);
+        }
+    }
+
+    /// Return whether tracing has been enabled for this run
+    inline bool enabled()
+    {
+        return detail::enabled;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The functions below must be invoked only if tracing is enabled.
+
+    /// The given HPX thread starts (or resumes) running on this OS-thread
+    inline void record_task_begin(void const* thrd,
+        util::thread_description const& desc)
+    {
+        detail::record(task_begin, thrd, desc, 0);
+    }
+
+    /// The given HPX thread has returned to the scheduler with a new state
+    inline void record_task_end(void const* thrd,
+        threads::thread_state_enum state)
+    {
+        detail::record(state == threads::terminated ? task_end : task_suspend,
+            thrd, nullptr, 0, static_cast<std::uint32_t>(state));
+    }
+
+    /// The given HPX thread was stolen from the queue of another worker
+    inline void record_task_steal(void const* thrd, std::size_t victim)
+    {
+        detail::record(task_steal, thrd, nullptr, 0,
+            static_cast<std::uint32_t>(victim));
+    }
+
+    /// A parcel for the given action is sent to the given locality
+    inline void record_parcel_send(char const* action,
+        std::uint32_t destination)
+    {
+        detail::record(parcel_send, nullptr, action, 0, destination);
+    }
+
+    /// A parcel for the given action was received and scheduled
+    inline void record_parcel_receive(char const* action)
+    {
+        detail::record(parcel_receive, nullptr, action, 0, 0);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Enable tracing if requested by the [hpx.trace] configuration section,
+    /// discarding all previously recorded events.
+    HPX_EXPORT void start(util::section const& cfg);
+
+    /// Disable tracing and write all recorded events to the configured
+    /// destination. This must be called only after all worker threads have
+    /// stopped.
+    HPX_EXPORT void stop(std::uint32_t locality_id);
+}}}
+
+#endif
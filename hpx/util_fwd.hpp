@@ -10,6 +10,9 @@
 #define HPX_UTIL_FWD_HPP
 
 #include <hpx/config.hpp>
+#include <hpx/util/detail/vtable/vtable.hpp>
+
+#include <cstddef>
 
 namespace hpx { namespace util
 {
@@ -18,22 +21,26 @@ namespace hpx { namespace util
 
     struct command_line_handling;
 
-    template <typename Sig, bool Serializable = true>
+    template <typename Sig, bool Serializable = true,
+        std::size_t StorageSize = detail::vtable::function_storage_size>
     class function;
 
-    template <typename Sig>
-    using function_nonser = function<Sig, false>;
+    template <typename Sig,
+        std::size_t StorageSize = detail::vtable::function_storage_size>
+    using function_nonser = function<Sig, false, StorageSize>;
 
     class HPX_EXPORT io_service_pool;
 
     class HPX_EXPORT runtime_configuration;
     class HPX_EXPORT section;
 
-    template <typename Sig, bool Serializable = true>
+    template <typename Sig, bool Serializable = true,
+        std::size_t StorageSize = detail::vtable::function_storage_size>
     class unique_function;
 
-    template <typename Sig>
-    using unique_function_nonser = unique_function<Sig, false>;
+    template <typename Sig,
+        std::size_t StorageSize = detail::vtable::function_storage_size>
+    using unique_function_nonser = unique_function<Sig, false, StorageSize>;
     /// \endcond
 }}
 
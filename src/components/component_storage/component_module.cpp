@@ -31,3 +31,18 @@ HPX_REGISTER_ACTION(
 HPX_REGISTER_ACTION(
     hpx::components::server::component_storage::size_action,
     component_storage_size_action);
+HPX_REGISTER_ACTION(
+    hpx::components::server::component_storage::compact_action,
+    component_storage_compact_action);
+HPX_REGISTER_ACTION(
+    hpx::components::server::component_storage::store_snapshot_action,
+    component_storage_store_snapshot_action);
+HPX_REGISTER_ACTION(
+    hpx::components::server::component_storage::commit_snapshot_action,
+    component_storage_commit_snapshot_action);
+HPX_REGISTER_ACTION(
+    hpx::components::server::component_storage::snapshot_keys_action,
+    component_storage_snapshot_keys_action);
+HPX_REGISTER_ACTION(
+    hpx::components::server::component_storage::load_snapshot_action,
+    component_storage_load_snapshot_action);
@@ -10,6 +10,8 @@
 #include <hpx/components/component_storage/component_storage.hpp>
 
 #include <cstddef>
+#include <cstdint>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -23,6 +25,12 @@ namespace hpx { namespace components
       : base_type(std::move(f))
     {}
 
+    component_storage::component_storage(hpx::id_type target_locality,
+            std::string const& path, std::size_t segment_size)
+      : base_type(hpx::new_<server::component_storage>(
+            target_locality, path, segment_size))
+    {}
+
     ///////////////////////////////////////////////////////////////////////////
     hpx::future<naming::id_type> component_storage::migrate_to_here(
         std::vector<char> const& data, naming::id_type const& id,
@@ -63,4 +71,73 @@ namespace hpx { namespace components
     {
         return size().get();
     }
+
+    hpx::future<std::uint64_t> component_storage::compact(
+        double max_live_ratio)
+    {
+        typedef server::component_storage::compact_action action_type;
+        return hpx::async<action_type>(this->get_id(), max_live_ratio);
+    }
+
+    std::uint64_t component_storage::compact(launch::sync_policy,
+        double max_live_ratio)
+    {
+        return compact(max_live_ratio).get();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<void> component_storage::store_snapshot(
+        std::vector<naming::gid_type> const& ids,
+        std::vector<std::vector<char> > const& data) const
+    {
+        typedef server::component_storage::store_snapshot_action action_type;
+        return hpx::async<action_type>(this->get_id(), ids, data);
+    }
+
+    void component_storage::store_snapshot(launch::sync_policy,
+        std::vector<naming::gid_type> const& ids,
+        std::vector<std::vector<char> > const& data) const
+    {
+        store_snapshot(ids, data).get();
+    }
+
+    hpx::future<void> component_storage::commit_snapshot(
+        std::vector<naming::gid_type> const& erased) const
+    {
+        typedef server::component_storage::commit_snapshot_action action_type;
+        return hpx::async<action_type>(this->get_id(), erased);
+    }
+
+    void component_storage::commit_snapshot(launch::sync_policy,
+        std::vector<naming::gid_type> const& erased) const
+    {
+        commit_snapshot(erased).get();
+    }
+
+    hpx::future<std::vector<naming::id_type> >
+    component_storage::snapshot_keys() const
+    {
+        typedef server::component_storage::snapshot_keys_action action_type;
+        return hpx::async<action_type>(this->get_id());
+    }
+
+    std::vector<naming::id_type> component_storage::snapshot_keys(
+        launch::sync_policy) const
+    {
+        return snapshot_keys().get();
+    }
+
+    hpx::future<std::vector<std::vector<char> > >
+    component_storage::load_snapshot(
+        std::vector<naming::gid_type> const& ids) const
+    {
+        typedef server::component_storage::load_snapshot_action action_type;
+        return hpx::async<action_type>(this->get_id(), ids);
+    }
+
+    std::vector<std::vector<char> > component_storage::load_snapshot(
+        launch::sync_policy, std::vector<naming::gid_type> const& ids) const
+    {
+        return load_snapshot(ids).get();
+    }
 }}
@@ -6,14 +6,35 @@
 #include <hpx/config.hpp>
 #include <hpx/components/component_storage/server/component_storage.hpp>
 #include <hpx/runtime/find_localities.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
 
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <sstream>
+#include <string>
 #include <vector>
 
 namespace hpx { namespace components { namespace server
 {
     component_storage::component_storage()
-      : data_(container_layout(find_all_localities()))
+      : data_(new data_type(container_layout(find_all_localities())))
+    {}
+
+    component_storage::component_storage(std::string const& path,
+            std::size_t segment_size)
+    {
+#if !defined(HPX_WINDOWS)
+        log_.reset(new segment_log(path, segment_size));
+#else
+        HPX_THROW_EXCEPTION(not_implemented,
+            "component_storage::component_storage",
+            "persistent component storage is not supported on this platform");
+#endif
+    }
+
+    component_storage::~component_storage()
     {}
 
     ///////////////////////////////////////////////////////////////////////////
@@ -22,7 +43,20 @@ namespace hpx { namespace components { namespace server
         naming::address const& current_lva)
     {
         naming::gid_type gid(naming::detail::get_stripped_gid(id.get_gid()));
-        data_[gid] = data;
+#if !defined(HPX_WINDOWS)
+        if (log_)
+        {
+            log_->store(gid, data);
+        }
+        else
+#endif
+        {
+            (*data_)[gid] = data;
+
+            // the stored data does not belong to a snapshot anymore
+            std::lock_guard<mutex_type> l(mtx_);
+            snapshot_keys_.erase(gid);
+        }
 
         // rebind the object to this storage locality
         naming::address addr(current_lva);
@@ -46,9 +80,114 @@ namespace hpx { namespace components { namespace server
     std::vector<char> component_storage::migrate_from_here(
         naming::gid_type const& id)
     {
+        naming::gid_type gid(naming::detail::get_stripped_gid(id));
+
+#if !defined(HPX_WINDOWS)
+        // the data is read from the segment only now
+        if (log_)
+            return log_->load(gid, true);
+#endif
+
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            snapshot_keys_.erase(gid);
+        }
+
         // return the stored data and erase it from the map
-        return data_.get_value(launch::sync,
-            naming::detail::get_stripped_gid(id), true);
+        return data_->get_value(launch::sync, gid, true);
+    }
+
+    std::size_t component_storage::size() const
+    {
+#if !defined(HPX_WINDOWS)
+        if (log_)
+            return log_->size();
+#endif
+        return data_->size();
+    }
+
+    std::uint64_t component_storage::compact(double max_live_ratio)
+    {
+#if !defined(HPX_WINDOWS)
+        if (log_)
+            return log_->compact(max_live_ratio);
+#endif
+        return 0;       // nothing to do for data kept in memory
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void component_storage::store_snapshot(
+        std::vector<naming::gid_type> const& ids,
+        std::vector<std::vector<char> > const& data)
+    {
+        HPX_ASSERT(ids.size() == data.size());
+
+#if !defined(HPX_WINDOWS)
+        if (log_)
+        {
+            for (std::size_t i = 0; i != ids.size(); ++i)
+                log_->store(ids[i], data[i], true);
+            return;
+        }
+#endif
+
+        data_->set_values(launch::sync, ids, data);
+
+        std::lock_guard<mutex_type> l(mtx_);
+        snapshot_keys_.insert(ids.begin(), ids.end());
+    }
+
+    void component_storage::commit_snapshot(
+        std::vector<naming::gid_type> const& erased)
+    {
+#if !defined(HPX_WINDOWS)
+        if (log_)
+        {
+            for (naming::gid_type const& id : erased)
+                log_->erase(id, true);
+            log_->flush();
+            return;
+        }
+#endif
+
+        for (naming::gid_type const& id : erased)
+        {
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                if (snapshot_keys_.erase(id) == 0)
+                    continue;
+            }
+            data_->get_value(launch::sync, id, true);
+        }
+    }
+
+    std::vector<naming::gid_type> component_storage::snapshot_keys() const
+    {
+#if !defined(HPX_WINDOWS)
+        if (log_)
+            return log_->keys(true);
+#endif
+
+        std::lock_guard<mutex_type> l(mtx_);
+        return std::vector<naming::gid_type>(
+            snapshot_keys_.begin(), snapshot_keys_.end());
+    }
+
+    std::vector<std::vector<char> > component_storage::load_snapshot(
+        std::vector<naming::gid_type> const& ids) const
+    {
+#if !defined(HPX_WINDOWS)
+        if (log_)
+        {
+            std::vector<std::vector<char> > result;
+            result.reserve(ids.size());
+            for (naming::gid_type const& id : ids)
+                result.push_back(log_->load(id, false));
+            return result;
+        }
+#endif
+
+        return data_->get_values(launch::sync, ids);
     }
 }}}
 
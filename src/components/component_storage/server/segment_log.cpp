@@ -0,0 +1,641 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if !defined(HPX_WINDOWS)
+#include <hpx/components/component_storage/server/segment_log.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/logging.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace components { namespace server
+{
+    namespace
+    {
+        ///////////////////////////////////////////////////////////////////////
+        enum record_state
+        {
+            record_free = 0,        // end of the used part of a segment
+            record_reserved = 1,    // the data has not been written (yet)
+            record_data = 2,        // serialized state of a component
+            record_erased = 3,      // tombstone, the component was removed
+            record_dead = 4,        // discarded copy made during compaction
+            record_snapshot = 5     // serialized state written by a snapshot
+        };
+
+        inline bool has_data(std::uint32_t state)
+        {
+            return state == record_data || state == record_snapshot;
+        }
+
+        std::uint32_t const record_magic = 0x53585048;     // "HPXS"
+
+        struct record_header
+        {
+            std::uint32_t magic_;
+            std::uint32_t state_;
+            std::uint64_t msb_;
+            std::uint64_t lsb_;
+            std::uint64_t size_;
+        };
+
+        // records are aligned to 8 bytes
+        inline std::size_t record_size(std::size_t size)
+        {
+            return (sizeof(record_header) + size + 7) & ~std::size_t(7);
+        }
+
+        std::string segment_name(std::uint64_t number)
+        {
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "segment-%016llu.log",
+                static_cast<unsigned long long>(number));
+            return buffer;
+        }
+
+        bool parse_segment_name(std::string const& name, std::uint64_t& number)
+        {
+            unsigned long long value = 0;
+            int length = 0;
+            if (std::sscanf(name.c_str(), "segment-%16llu.log%n",
+                    &value, &length) != 1 ||
+                length != static_cast<int>(name.size()))
+            {
+                return false;
+            }
+            number = value;
+            return true;
+        }
+
+        std::string errno_message(char const* what, std::string const& name)
+        {
+            return std::string(what) + " '" + name + "': " +
+                std::strerror(errno);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct segment_log::segment
+    {
+        HPX_NON_COPYABLE(segment);
+
+        segment(std::uint64_t number, std::string const& filename)
+          : number_(number), filename_(filename), fd_(-1)
+          , data_(nullptr), capacity_(0)
+          , used_(0), live_bytes_(0), tombstones_(0), pending_(0)
+        {}
+
+        ~segment()
+        {
+            if (data_ != nullptr)
+                ::munmap(data_, capacity_);
+            if (fd_ >= 0)
+                ::close(fd_);
+        }
+
+        // map the file, create it with the given size if required
+        void open(std::size_t size, bool create)
+        {
+            int flags = O_RDWR | O_CLOEXEC;
+            if (create)
+                flags |= O_CREAT | O_EXCL;
+
+            fd_ = ::open(filename_.c_str(), flags, 0644);
+            if (fd_ < 0)
+            {
+                HPX_THROW_EXCEPTION(filesystem_error,
+                    "segment_log::segment::open",
+                    errno_message("could not open segment", filename_));
+            }
+
+            if (create)
+            {
+                if (::ftruncate(fd_, static_cast<off_t>(size)) != 0)
+                {
+                    HPX_THROW_EXCEPTION(filesystem_error,
+                        "segment_log::segment::open",
+                        errno_message("could not resize segment", filename_));
+                }
+            }
+            else
+            {
+                struct stat st;
+                if (::fstat(fd_, &st) != 0)
+                {
+                    HPX_THROW_EXCEPTION(filesystem_error,
+                        "segment_log::segment::open",
+                        errno_message("could not query segment", filename_));
+                }
+                size = static_cast<std::size_t>(st.st_size);
+            }
+
+            if (size != 0)
+            {
+                void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED, fd_, 0);
+                if (p == MAP_FAILED)
+                {
+                    HPX_THROW_EXCEPTION(filesystem_error,
+                        "segment_log::segment::open",
+                        errno_message("could not map segment", filename_));
+                }
+                data_ = static_cast<char*>(p);
+            }
+            capacity_ = size;
+        }
+
+        record_header* header(std::size_t offset) const
+        {
+            return reinterpret_cast<record_header*>(data_ + offset);
+        }
+
+        char const* payload(std::size_t offset) const
+        {
+            return data_ + offset + sizeof(record_header);
+        }
+
+        std::uint64_t number_;
+        std::string filename_;
+        int fd_;
+        char* data_;
+        std::size_t capacity_;
+
+        // the following are protected by the lock of the log
+        std::size_t used_;          // bytes reserved for records
+        std::size_t live_bytes_;    // bytes of records referenced by the index
+        std::size_t tombstones_;    // number of tombstones
+        std::size_t pending_;       // appends which have not been published
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    constexpr std::size_t segment_log::default_segment_size;
+
+    segment_log::segment_log(std::string const& path, std::size_t segment_size)
+      : path_(path)
+      , segment_size_((std::max)(segment_size, std::size_t(4096)))
+      , next_segment_(0)
+    {
+        boost::system::error_code ec;
+        boost::filesystem::create_directories(path_, ec);
+        if (ec)
+        {
+            HPX_THROW_EXCEPTION(filesystem_error, "segment_log::segment_log",
+                "could not create directory '" + path_ + "': " + ec.message());
+        }
+
+        recover();
+    }
+
+    segment_log::~segment_log()
+    {
+        try {
+            flush();
+        }
+        catch (...) {
+            ;   // there is nothing we can do here
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Rebuild the index from the record headers stored in all segments
+    void segment_log::recover()
+    {
+        namespace fs = boost::filesystem;
+
+        std::map<std::uint64_t, std::string> files;
+        boost::system::error_code ec;
+        for (fs::directory_iterator it(path_, ec), end; !ec && it != end;
+             it.increment(ec))
+        {
+            std::uint64_t number = 0;
+            if (parse_segment_name(it->path().filename().string(), number))
+                files[number] = it->path().string();
+        }
+
+        for (auto const& file : files)
+        {
+            segment_ptr seg = std::make_shared<segment>(
+                file.first, file.second);
+            seg->open(0, false);
+
+            std::size_t offset = 0;
+            while (offset + sizeof(record_header) <= seg->capacity_)
+            {
+                record_header const* hdr = seg->header(offset);
+                if (hdr->magic_ != record_magic || hdr->state_ == record_free)
+                    break;
+
+                std::size_t size = static_cast<std::size_t>(hdr->size_);
+                std::size_t rec = record_size(size);
+                if (offset + rec > seg->capacity_)
+                    break;      // truncated record
+
+                naming::gid_type gid(hdr->msb_, hdr->lsb_);
+                if (has_data(hdr->state_) || hdr->state_ == record_erased)
+                {
+                    index_type::iterator it = index_.find(gid);
+                    if (it != index_.end())
+                    {
+                        it->second.segment_->live_bytes_ -=
+                            record_size(it->second.size_);
+                        index_.erase(it);
+                    }
+
+                    if (has_data(hdr->state_))
+                    {
+                        location loc = {
+                            seg, offset, size, hdr->state_ == record_snapshot
+                        };
+                        index_.insert(index_type::value_type(gid, loc));
+                        seg->live_bytes_ += rec;
+                    }
+                    else
+                    {
+                        ++seg->tombstones_;
+                    }
+                }
+                offset += rec;
+            }
+
+            seg->used_ = offset;
+            segments_[file.first] = seg;
+            next_segment_ = file.first + 1;
+        }
+
+        // continue appending to the most recent segment
+        if (!segments_.empty())
+            active_ = segments_.rbegin()->second;
+
+        LRT_(info) << "segment_log: recovered " << index_.size()
+                   << " components from " << segments_.size()
+                   << " segments in '" << path_ << "'";
+    }
+
+    segment_log::segment_ptr segment_log::create_segment(std::size_t min_size)
+    {
+        std::uint64_t number = next_segment_++;
+        std::string filename =
+            (boost::filesystem::path(path_) / segment_name(number)).string();
+
+        segment_ptr seg = std::make_shared<segment>(number, filename);
+        seg->open((std::max)(segment_size_, min_size), true);
+
+        segments_[number] = seg;
+        return seg;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t segment_log::reserve(std::size_t size, segment_ptr& seg)
+    {
+        std::size_t rec = record_size(size);
+        if (!active_ || active_->used_ + rec > active_->capacity_)
+            active_ = create_segment(rec);
+
+        seg = active_;
+        std::size_t offset = seg->used_;
+        seg->used_ += rec;
+        ++seg->pending_;
+
+        record_header* hdr = seg->header(offset);
+        hdr->state_ = record_reserved;
+        hdr->size_ = size;
+        hdr->magic_ = record_magic;
+        return offset;
+    }
+
+    // Append a record, the caller is responsible for publishing it and for
+    // decrementing the number of pending appends of the segment afterwards.
+    void segment_log::append(std::uint32_t state, naming::gid_type const& gid,
+        char const* data, std::size_t size, location* loc)
+    {
+        segment_ptr seg;
+        std::size_t offset = 0;
+
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            offset = reserve(size, seg);
+        }
+
+        // copy the data without holding the lock, this is where concurrent
+        // appends overlap
+        record_header* hdr = seg->header(offset);
+        hdr->msb_ = gid.get_msb();
+        hdr->lsb_ = gid.get_lsb();
+        if (size != 0)
+            std::memcpy(seg->data_ + offset + sizeof(record_header), data, size);
+        hdr->state_ = state;
+
+        loc->segment_ = std::move(seg);
+        loc->offset_ = offset;
+        loc->size_ = size;
+        loc->snapshot_ = state == record_snapshot;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void segment_log::store(naming::gid_type const& gid,
+        std::vector<char> const& data, bool snapshot)
+    {
+        location loc;
+        append(snapshot ? record_snapshot : record_data, gid, data.data(),
+            data.size(), &loc);
+
+        std::unique_lock<mutex_type> l(mtx_);
+
+        loc.segment_->live_bytes_ += record_size(loc.size_);
+        --loc.segment_->pending_;
+
+        index_type::iterator it = index_.find(gid);
+        if (it != index_.end())
+        {
+            location old = it->second;
+            it->second = loc;
+            retire(old.segment_, record_size(old.size_), l);
+        }
+        else
+        {
+            index_.insert(index_type::value_type(gid, loc));
+        }
+    }
+
+    std::vector<char> segment_log::load(naming::gid_type const& gid,
+        bool erase)
+    {
+        location loc;
+
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+            index_type::iterator it = index_.find(gid);
+            if (it == index_.end())
+            {
+                l.unlock();
+                HPX_THROW_EXCEPTION(bad_parameter, "segment_log::load",
+                    "no data is stored for the given component");
+            }
+
+            loc = it->second;
+            if (erase)
+                index_.erase(it);
+        }
+
+        // the segment stays mapped as long as we hold on to it
+        char const* data = loc.segment_->payload(loc.offset_);
+        std::vector<char> result(data, data + loc.size_);
+
+        if (erase)
+            append_tombstone(gid, loc);
+
+        return result;
+    }
+
+    bool segment_log::erase(naming::gid_type const& gid, bool snapshot)
+    {
+        location loc;
+
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            index_type::iterator it = index_.find(gid);
+            if (it == index_.end() || (snapshot && !it->second.snapshot_))
+                return false;
+
+            loc = it->second;
+            index_.erase(it);
+        }
+
+        append_tombstone(gid, loc);
+        return true;
+    }
+
+    // the record at the given location was removed from the index
+    void segment_log::append_tombstone(naming::gid_type const& gid,
+        location const& loc)
+    {
+        location tombstone;
+        append(record_erased, gid, nullptr, 0, &tombstone);
+
+        std::unique_lock<mutex_type> l(mtx_);
+        ++tombstone.segment_->tombstones_;
+        --tombstone.segment_->pending_;
+        retire(loc.segment_, record_size(loc.size_), l);
+    }
+
+    std::size_t segment_log::size() const
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        return index_.size();
+    }
+
+    std::vector<naming::gid_type> segment_log::keys(bool snapshot) const
+    {
+        std::vector<naming::gid_type> result;
+
+        std::lock_guard<mutex_type> l(mtx_);
+        result.reserve(index_.size());
+        for (index_type::value_type const& v : index_)
+        {
+            if (!snapshot || v.second.snapshot_)
+                result.push_back(v.first);
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A record in the given segment is not referenced anymore, remove the
+    // segment if it does not hold anything needed anymore.
+    void segment_log::retire(segment_ptr const& seg, std::size_t record_size,
+        std::unique_lock<mutex_type>& l)
+    {
+        HPX_ASSERT(l.owns_lock());
+        HPX_ASSERT(seg->live_bytes_ >= record_size);
+        seg->live_bytes_ -= record_size;
+
+        if (seg->live_bytes_ != 0 || seg->pending_ != 0 || seg == active_)
+            return;
+
+        // tombstones have to be kept as long as older segments exist which
+        // may hold records they refer to
+        if (seg->tombstones_ == 0 || segments_.begin()->second == seg)
+        {
+            remove_segment(seg);
+
+            // this may have made the oldest segment removable as well
+            while (!segments_.empty())
+            {
+                segment_ptr oldest = segments_.begin()->second;
+                if (oldest == active_ || oldest->live_bytes_ != 0 ||
+                    oldest->pending_ != 0)
+                {
+                    break;
+                }
+                remove_segment(oldest);
+            }
+        }
+    }
+
+    void segment_log::remove_segment(segment_ptr const& seg)
+    {
+        segments_.erase(seg->number_);
+
+        // the file stays mapped until the last reference to it is released
+        if (::unlink(seg->filename_.c_str()) != 0)
+        {
+            LRT_(warning) << "segment_log: "
+                << errno_message("could not remove segment", seg->filename_);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::uint64_t segment_log::compact(double max_live_ratio)
+    {
+        std::lock_guard<mutex_type> cl(compaction_mtx_);
+
+        std::vector<segment_ptr> candidates;
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            for (auto const& p : segments_)
+            {
+                segment_ptr const& seg = p.second;
+                if (seg != active_ && seg->pending_ == 0 && seg->used_ != 0 &&
+                    seg->live_bytes_ < max_live_ratio * seg->used_)
+                {
+                    candidates.push_back(seg);
+                }
+            }
+        }
+
+        std::uint64_t reclaimed = 0;
+        for (segment_ptr const& seg : candidates)
+        {
+            // stream all records still needed to the end of the log
+            std::size_t offset = 0;
+            while (offset < seg->used_)
+            {
+                record_header const* hdr = seg->header(offset);
+                std::size_t size = static_cast<std::size_t>(hdr->size_);
+                std::size_t rec = record_size(size);
+                naming::gid_type gid(hdr->msb_, hdr->lsb_);
+
+                if (has_data(hdr->state_))
+                {
+                    bool live = false;
+                    {
+                        std::lock_guard<mutex_type> l(mtx_);
+                        index_type::iterator it = index_.find(gid);
+                        live = it != index_.end() &&
+                            it->second.segment_ == seg &&
+                            it->second.offset_ == offset;
+                    }
+
+                    if (live)
+                    {
+                        location loc;
+                        append(hdr->state_, gid, seg->payload(offset), size,
+                            &loc);
+
+                        std::unique_lock<mutex_type> l(mtx_);
+                        --loc.segment_->pending_;
+
+                        index_type::iterator it = index_.find(gid);
+                        if (it != index_.end() &&
+                            it->second.segment_ == seg &&
+                            it->second.offset_ == offset)
+                        {
+                            loc.segment_->live_bytes_ += rec;
+                            seg->live_bytes_ -= rec;
+                            it->second = loc;
+                        }
+                        else
+                        {
+                            // the component was removed or replaced while
+                            // it was copied, the copy must not be recovered
+                            loc.segment_->header(loc.offset_)->state_ =
+                                record_dead;
+                        }
+                    }
+                }
+                else if (hdr->state_ == record_erased)
+                {
+                    bool needed = false;
+                    {
+                        std::lock_guard<mutex_type> l(mtx_);
+                        needed = segments_.begin()->second != seg &&
+                            index_.find(gid) == index_.end();
+                    }
+
+                    if (needed)
+                    {
+                        location loc;
+                        append(record_erased, gid, nullptr, 0, &loc);
+
+                        std::lock_guard<mutex_type> l(mtx_);
+                        ++loc.segment_->tombstones_;
+                        --loc.segment_->pending_;
+                    }
+                }
+
+                offset += rec;
+            }
+
+            std::lock_guard<mutex_type> l(mtx_);
+            HPX_ASSERT(seg->live_bytes_ == 0);
+            if (segments_.find(seg->number_) != segments_.end())
+            {
+                reclaimed += seg->used_;
+                remove_segment(seg);
+            }
+        }
+
+        LRT_(info) << "segment_log: compaction reclaimed " << reclaimed
+                   << " bytes in '" << path_ << "'";
+        return reclaimed;
+    }
+
+    void segment_log::flush()
+    {
+        std::vector<segment_ptr> segments;
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            segments.reserve(segments_.size());
+            for (auto const& p : segments_)
+                segments.push_back(p.second);
+        }
+
+        for (segment_ptr const& seg : segments)
+        {
+            if (seg->data_ != nullptr && seg->used_ != 0 &&
+                ::msync(seg->data_, seg->capacity_, MS_SYNC) != 0)
+            {
+                HPX_THROW_EXCEPTION(filesystem_error, "segment_log::flush",
+                    errno_message("could not write back segment",
+                        seg->filename_));
+            }
+        }
+    }
+}}}
+
+#endif
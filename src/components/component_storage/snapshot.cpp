@@ -0,0 +1,257 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/runtime/components/server/snapshot_registry.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/runtime/serialization/input_archive.hpp>
+#include <hpx/runtime/serialization/output_archive.hpp>
+#include <hpx/runtime/serialization/string.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <hpx/components/component_storage/component_storage.hpp>
+#include <hpx/components/component_storage/snapshot.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace components
+{
+    namespace detail
+    {
+        // amount of data sent to the storage at once
+        static std::size_t const snapshot_batch_size = 1024 * 1024;
+
+        // number of components restored at once
+        static std::size_t const restore_batch_size = 256;
+
+        typedef snapshot_registry::instance_type instance_type;
+
+        std::size_t snapshot_concurrency(std::size_t count)
+        {
+            return (std::max)(std::size_t(1),
+                (std::min)(count, std::size_t(hpx::get_os_thread_count())));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Serialize every n-th of the given instances, starting at the given
+        // one. Only one batch per task is in flight at any time.
+        std::uint64_t save_instances(component_storage const& storage,
+            std::vector<instance_type> const& instances, std::size_t first,
+            std::size_t stride, bool incremental)
+        {
+            std::uint64_t bytes = 0;
+
+            std::vector<naming::gid_type> ids;
+            std::vector<std::vector<char> > data;
+            std::size_t batch_bytes = 0;
+            future<void> pending;
+
+            std::size_t i = first;
+            try {
+                for (/**/; i < instances.size(); i += stride)
+                {
+                    instance_type const& inst = instances[i];
+
+                    naming::gid_type gid;
+                    std::vector<char> buffer;
+                    bool saved = false;
+
+                    {
+                        serialization::output_archive archive(buffer);
+                        saved = inst.second->save(inst.first, incremental,
+                            gid, archive);
+                    }
+
+                    inst.second->release(inst.first);
+                    if (!saved)
+                        continue;
+
+                    batch_bytes += buffer.size();
+                    ids.push_back(gid);
+                    data.push_back(std::move(buffer));
+
+                    if (batch_bytes >= snapshot_batch_size)
+                    {
+                        if (pending.valid())
+                            pending.get();
+
+                        pending = storage.store_snapshot(ids, data);
+
+                        bytes += batch_bytes;
+                        batch_bytes = 0;
+                        ids.clear();
+                        data.clear();
+                    }
+                }
+            }
+            catch (...) {
+                // the instance which failed and all remaining ones are still
+                // referenced by this task
+                for (/**/; i < instances.size(); i += stride)
+                    instances[i].second->release(instances[i].first);
+                throw;
+            }
+
+            if (!ids.empty())
+            {
+                if (pending.valid())
+                    pending.get();
+
+                pending = storage.store_snapshot(ids, data);
+                bytes += batch_bytes;
+            }
+
+            if (pending.valid())
+                pending.get();
+
+            return bytes;
+        }
+
+        // keeps the action gate of the registry closed while a snapshot is
+        // being taken
+        struct close_gate
+        {
+            explicit close_gate(snapshot_registry& registry)
+              : registry_(registry)
+            {
+                registry_.close_gate();
+            }
+            ~close_gate()
+            {
+                registry_.open_gate();
+            }
+
+            snapshot_registry& registry_;
+        };
+
+        std::uint64_t snapshot_here(component_storage const& storage,
+            bool incremental)
+        {
+            snapshot_registry& registry = snapshot_registry::instance();
+
+            // no action executes on any of the instances from here on, which
+            // makes the snapshot a consistent cut of the locality
+            close_gate gate(registry);
+
+            // components destroyed after this point will be removed by the
+            // next snapshot
+            std::vector<naming::gid_type> erased = registry.take_erased();
+            std::vector<instance_type> instances = registry.acquire_all();
+
+            std::size_t const concurrency =
+                snapshot_concurrency(instances.size());
+
+            std::vector<future<std::uint64_t> > tasks;
+            tasks.reserve(concurrency);
+            for (std::size_t i = 0; i != concurrency; ++i)
+            {
+                tasks.push_back(hpx::async(&save_instances, std::cref(storage),
+                    std::cref(instances), i, concurrency, incremental));
+            }
+            wait_all(tasks);
+
+            std::uint64_t bytes = 0;
+            for (future<std::uint64_t>& f : tasks)
+                bytes += f.get();
+
+            storage.commit_snapshot(launch::sync, erased);
+            return bytes;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void restore_instances(component_storage const& storage,
+            std::vector<naming::gid_type> const& keys, std::size_t first,
+            std::size_t stride)
+        {
+            snapshot_registry& registry = snapshot_registry::instance();
+
+            std::size_t const batch_stride = stride * restore_batch_size;
+            for (std::size_t i = first * restore_batch_size; i < keys.size();
+                 i += batch_stride)
+            {
+                std::size_t const last =
+                    (std::min)(i + restore_batch_size, keys.size());
+                std::vector<naming::gid_type> ids(
+                    keys.begin() + i, keys.begin() + last);
+
+                std::vector<std::vector<char> > data =
+                    storage.load_snapshot(launch::sync, ids);
+
+                for (std::size_t j = 0; j != ids.size(); ++j)
+                {
+                    serialization::input_archive archive(
+                        data[j], data[j].size(), nullptr);
+
+                    std::string name;
+                    archive >> name;
+
+                    snapshot_vtable const* vt = registry.find_type(name);
+                    if (vt == nullptr)
+                    {
+                        HPX_THROW_EXCEPTION(bad_component_type,
+                            "hpx::components::restore_snapshot",
+                            "the snapshot refers to an unknown component "
+                            "type: " + name);
+                    }
+
+                    vt->restore(ids[j], archive);
+                }
+            }
+        }
+
+        std::size_t restore_here(component_storage const& storage)
+        {
+            std::vector<naming::gid_type> keys;
+            {
+                std::vector<naming::id_type> ids =
+                    storage.snapshot_keys(launch::sync);
+
+                keys.reserve(ids.size());
+                for (naming::id_type const& id : ids)
+                    keys.push_back(id.get_gid());
+            }
+
+            std::size_t const concurrency = snapshot_concurrency(
+                (keys.size() + restore_batch_size - 1) / restore_batch_size);
+
+            std::vector<future<void> > tasks;
+            tasks.reserve(concurrency);
+            for (std::size_t i = 0; i != concurrency; ++i)
+            {
+                tasks.push_back(hpx::async(&restore_instances,
+                    std::cref(storage), std::cref(keys), i, concurrency));
+            }
+            wait_all(tasks);
+
+            for (future<void>& f : tasks)
+                f.get();
+
+            return keys.size();
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    future<std::uint64_t> snapshot(component_storage const& storage,
+        bool incremental)
+    {
+        return hpx::async(&detail::snapshot_here, storage, incremental);
+    }
+
+    future<std::size_t> restore_snapshot(component_storage const& storage)
+    {
+        return hpx::async(&detail::restore_here, storage);
+    }
+}}
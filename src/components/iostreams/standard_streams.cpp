@@ -10,11 +10,16 @@
 #include <hpx/runtime/agas/interface.hpp>
 #include <hpx/runtime/components/server/component.hpp>
 #include <hpx/runtime/components/server/create_component.hpp>
+#include <hpx/runtime/config_entry.hpp>
 #include <hpx/runtime/runtime_fwd.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
 
 #include <hpx/components/iostreams/ostream.hpp>
 #include <hpx/components/iostreams/standard_streams.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <sstream>
 #include <string>
@@ -29,6 +34,41 @@ namespace hpx { namespace iostreams { namespace detail
         return console_stream;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    ostream_settings get_ostream_settings()
+    {
+        ostream_settings settings;
+
+        std::string ordering = get_config_entry(
+            "hpx.iostreams.ordering", "strict");
+        if (ordering == "strict")
+        {
+            settings.ordering_ = ordering_strict;
+        }
+        else if (ordering == "worker")
+        {
+            settings.ordering_ = ordering_worker;
+        }
+        else if (ordering == "none")
+        {
+            settings.ordering_ = ordering_none;
+        }
+        else
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "hpx::iostreams::detail::get_ostream_settings",
+                "unknown output ordering (hpx.iostreams.ordering): " +
+                    ordering);
+        }
+
+        settings.batch_size_ = util::safe_lexical_cast<std::size_t>(
+            get_config_entry("hpx.iostreams.batch_size", 4096), 4096);
+        settings.flush_interval_ = util::safe_lexical_cast<std::int64_t>(
+            get_config_entry("hpx.iostreams.flush_interval", "10"), 10);
+
+        return settings;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     naming::id_type return_id_type(future<bool> f, naming::id_type id)
     {
@@ -0,0 +1,108 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/detail/continuation_placement.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
+#include <hpx/runtime/threads/detail/thread_pool_base.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
+#include <hpx/runtime/threads/threadmanager.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace hpx { namespace lcos { namespace detail
+{
+    namespace
+    {
+        // The counters are updated by all worker threads for every
+        // continuation, spread them over separate cache lines to keep the
+        // updates from contending with each other.
+        struct continuation_counts
+        {
+            boost::atomic<std::int64_t> counts_[3];
+            char padding_[64 - 3 * sizeof(std::int64_t)];
+        };
+
+        HPX_CONSTEXPR_OR_CONST std::size_t num_count_slots = 64;
+        continuation_counts counts[num_count_slots];
+
+        void increment_count(continuation_placement placement,
+            std::size_t global_thread_num)
+        {
+            // non-HPX threads (std::size_t(-1)) share the first slot
+            continuation_counts& c =
+                counts[(global_thread_num + 1) % num_count_slots];
+            c.counts_[placement].fetch_add(1, boost::memory_order_relaxed);
+        }
+
+        bool place_continuations_locally()
+        {
+            static bool const place_locally =
+                get_config_entry("hpx.continuations.placement", "local") !=
+                    "any";
+            return place_locally;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t get_continuation_max_inline_depth()
+    {
+        static std::size_t const max_inline_depth =
+            util::safe_lexical_cast<std::size_t>(
+                get_config_entry("hpx.continuations.max_inline_depth",
+                    HPX_CONTINUATION_MAX_RECURSION_DEPTH),
+                HPX_CONTINUATION_MAX_RECURSION_DEPTH);
+        return max_inline_depth;
+    }
+
+    std::size_t get_continuation_os_thread()
+    {
+        std::size_t global_thread_num = hpx::get_worker_thread_num();
+        if (global_thread_num != std::size_t(-1) &&
+            place_continuations_locally())
+        {
+            // continuations are always scheduled on the default pool, they
+            // can be placed locally only if the calling worker belongs to it
+            threads::detail::thread_pool_base& pool =
+                threads::get_thread_manager().default_pool();
+
+            std::size_t offset = pool.get_thread_offset();
+            if (global_thread_num >= offset &&
+                global_thread_num - offset < pool.get_os_thread_count())
+            {
+                increment_count(continuation_local, global_thread_num);
+                return global_thread_num - offset;
+            }
+        }
+
+        increment_count(continuation_remote, global_thread_num);
+        return std::size_t(-1);
+    }
+
+    void count_continuation(continuation_placement placement)
+    {
+        increment_count(placement, hpx::get_worker_thread_num());
+    }
+
+    std::int64_t get_continuation_count(
+        continuation_placement placement, bool reset)
+    {
+        std::int64_t result = 0;
+        for (continuation_counts& c : counts)
+        {
+            if (reset)
+                result += c.counts_[placement].exchange(0);
+            else
+                result += c.counts_[placement].load();
+        }
+        return result;
+    }
+}}}
@@ -8,6 +8,7 @@
 #include <hpx/util/unique_function.hpp>
 #include <hpx/util/detail/yield_k.hpp>
 #include <hpx/lcos/local/futures_factory.hpp>
+#include <hpx/lcos/detail/continuation_placement.hpp>
 #include <hpx/lcos/detail/future_data.hpp>
 #include <hpx/runtime/threads/thread.hpp>
 #include <hpx/runtime/launch_policy.hpp>
@@ -26,6 +27,10 @@ namespace hpx { namespace lcos { namespace detail
         if (!is_hpx_thread)
             policy = launch::async;
 
+        // launch::fork runs the new thread on the calling worker right away
+        count_continuation(
+            is_hpx_thread ? continuation_local : continuation_remote);
+
         // launch a new thread executing the given function
         threads::thread_id_type tid = p.apply(
             policy, threads::thread_priority_boost,
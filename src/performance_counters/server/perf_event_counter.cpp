@@ -0,0 +1,92 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PERF_EVENT_COUNTERS)
+#include <hpx/performance_counters/counters.hpp>
+#include <hpx/performance_counters/counter_creators.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/function.hpp>
+#include <hpx/util/perf_events.hpp>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace performance_counters
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Creation function for the counters exposing the hardware events
+    // attributed to HPX threads
+    naming::gid_type perf_event_counter_creator(counter_info const& info,
+        error_code& ec)
+    {
+        switch (info.type_) {
+        case counter_raw:
+            {
+                counter_path_elements paths;
+                get_counter_path_elements(info.fullname_, paths, ec);
+                if (ec) return naming::invalid_gid;
+
+                if (paths.parentinstance_is_basename_) {
+                    HPX_THROWS_IF(ec, bad_parameter,
+                        "perf_event_counter_creator",
+                        "invalid perf_event counter name (instance name "
+                        "must not be a valid base counter name)");
+                    return naming::invalid_gid;
+                }
+
+                if (paths.parameters_.empty()) {
+                    HPX_THROWS_IF(ec, bad_parameter,
+                        "perf_event_counter_creator",
+                        "invalid perf_event counter parameter: must specify "
+                        "a thread description");
+                    return naming::invalid_gid;
+                }
+
+                // the counter name is 'perf/<event>'
+                std::string::size_type p = paths.countername_.rfind('/');
+                util::perf_events::event_type type =
+                    util::perf_events::num_events;
+                if (p != std::string::npos)
+                {
+                    type = util::perf_events::get_event_type(
+                        paths.countername_.substr(p + 1));
+                }
+
+                if (type == util::perf_events::num_events)
+                {
+                    HPX_THROWS_IF(ec, bad_parameter,
+                        "perf_event_counter_creator",
+                        "invalid perf_event counter name: " +
+                            paths.countername_);
+                    return naming::invalid_gid;
+                }
+
+                // counting starts with the first counter being created
+                util::perf_events::enable();
+
+                using util::placeholders::_1;
+                hpx::util::function_nonser<std::int64_t(bool)> f =
+                    util::bind(&util::perf_events::get_value, type,
+                        std::move(paths.parameters_), _1);
+
+                return detail::create_raw_counter(info, std::move(f), ec);
+            }
+            break;
+
+        default:
+            HPX_THROWS_IF(ec, bad_parameter,
+                "perf_event_counter_creator",
+                "invalid counter type requested");
+            return naming::invalid_gid;
+        }
+    }
+}}
+
+#endif
@@ -93,6 +93,9 @@ int pre_main(runtime_mode mode)
     using components::stubs::runtime_support;
 
     naming::resolver_client& agas_client = naming::get_agas_client();
+
+    // Send the buffered reference counting operations periodically.
+    agas_client.start_refcnt_flush_timer();
     runtime& rt = get_runtime();
 
     int exit_code = 0;
@@ -534,12 +534,87 @@ namespace hpx
               &performance_counters::remote_action_invocation_counter_creator,
               &performance_counters::remote_action_invocation_counter_discoverer,
               ""
+            },
+
+            // adaptive action execution counters
+            { "/runtime/count/direct-action-execution",
+              performance_counters::counter_raw,
+              "returns the number of times a specific action received in a "
+              "parcel was executed directly because it has been found to be "
+              "short (the action type has to be specified as the counter "
+              "parameter)",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &performance_counters::direct_action_execution_counter_creator,
+              &performance_counters::direct_action_execution_counter_discoverer,
+              ""
+            },
+
+            { "/runtime/count/scheduled-action-execution",
+              performance_counters::counter_raw,
+              "returns the number of times a specific action received in a "
+              "parcel was executed on a new thread because it has not been "
+              "found to be short (the action type has to be specified as the "
+              "counter parameter)",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &performance_counters::scheduled_action_execution_counter_creator,
+              &performance_counters::scheduled_action_execution_counter_discoverer,
+              ""
             }
         };
         performance_counters::install_counter_types(
             statistic_counter_types,
             sizeof(statistic_counter_types)/sizeof(statistic_counter_types[0]));
 
+#if defined(HPX_HAVE_PERF_EVENT_COUNTERS)
+        // hardware events attributed to HPX threads
+        performance_counters::generic_counter_type_data perf_event_counter_types[] =
+        {
+            { "/threads/perf/cycles", performance_counters::counter_raw,
+              "returns the number of CPU cycles counted while HPX threads "
+              "with a specific description were running on this locality "
+              "(the thread description has to be specified as the counter "
+              "parameter)",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &performance_counters::perf_event_counter_creator,
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/threads/perf/instructions", performance_counters::counter_raw,
+              "returns the number of retired instructions counted while HPX "
+              "threads with a specific description were running on this "
+              "locality (the thread description has to be specified as the "
+              "counter parameter)",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &performance_counters::perf_event_counter_creator,
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/threads/perf/llc-misses", performance_counters::counter_raw,
+              "returns the number of last level cache misses counted while "
+              "HPX threads with a specific description were running on this "
+              "locality (the thread description has to be specified as the "
+              "counter parameter)",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &performance_counters::perf_event_counter_creator,
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/threads/perf/branch-misses", performance_counters::counter_raw,
+              "returns the number of mispredicted branches counted while HPX "
+              "threads with a specific description were running on this "
+              "locality (the thread description has to be specified as the "
+              "counter parameter)",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &performance_counters::perf_event_counter_creator,
+              &performance_counters::locality_counter_discoverer,
+              ""
+            }
+        };
+        performance_counters::install_counter_types(
+            perf_event_counter_types,
+            sizeof(perf_event_counter_types)/sizeof(perf_event_counter_types[0]));
+#endif
+
         performance_counters::generic_counter_type_data arithmetic_counter_types[] =
         {
             // adding counter
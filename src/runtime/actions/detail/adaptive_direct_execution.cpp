@@ -0,0 +1,32 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/actions/detail/adaptive_direct_execution.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+
+#include <cstdint>
+
+namespace hpx { namespace actions { namespace detail
+{
+    // Both settings are read only once, parcels are received only after the
+    // runtime configuration has been established.
+    bool adaptive_direct_execution_enabled()
+    {
+        static bool enabled = util::safe_lexical_cast<int>(
+            get_config_entry("hpx.parcel.adaptive_direct_execution", "0"),
+            0) != 0;
+        return enabled;
+    }
+
+    std::int64_t get_direct_execution_threshold()
+    {
+        static std::int64_t threshold = util::safe_lexical_cast<std::int64_t>(
+            get_config_entry("hpx.parcel.direct_execution_threshold", "5000"),
+            std::int64_t(5000));
+        return threshold;
+    }
+}}}
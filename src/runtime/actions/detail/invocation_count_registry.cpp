@@ -27,6 +27,18 @@ namespace hpx { namespace actions { namespace detail
         return registry.get();
     }
 
+    invocation_count_registry& invocation_count_registry::direct_instance()
+    {
+        hpx::util::static_<invocation_count_registry, direct_tag> registry;
+        return registry.get();
+    }
+
+    invocation_count_registry& invocation_count_registry::scheduled_instance()
+    {
+        hpx::util::static_<invocation_count_registry, scheduled_tag> registry;
+        return registry.get();
+    }
+
     void invocation_count_registry::register_class(std::string const& name,
         get_invocation_count_type fun)
     {
@@ -29,6 +29,7 @@
 #include <hpx/runtime/agas/detail/bootstrap_component_namespace.hpp>
 #include <hpx/runtime/agas/detail/bootstrap_locality_namespace.hpp>
 #include <hpx/runtime/find_localities.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
 #include <hpx/runtime/naming/split_gid.hpp>
 #include <hpx/util/bind.hpp>
 #include <hpx/util/logging.hpp>
@@ -37,6 +38,7 @@
 #include <hpx/util/assert.hpp>
 #include <hpx/util/register_locks.hpp>
 #include <hpx/util/unlock_guard.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
 #include <hpx/util/insert_checked.hpp>
 #include <hpx/performance_counters/counters.hpp>
 #include <hpx/performance_counters/counter_creators.hpp>
@@ -135,6 +137,11 @@ addressing_service::addressing_service(
   , refcnt_requests_count_(0)
   , enable_refcnt_caching_(true)
   , refcnt_requests_(new refcnt_requests_type)
+  , max_worker_refcnt_requests_(
+        ini_.get_agas_max_pending_worker_refcnt_requests())
+  , refcnt_flush_interval_(ini_.get_agas_refcnt_flush_interval())
+  , decref_messages_(0)
+  , decref_messages_avoided_(0)
   , service_type(ini_.get_agas_service_mode())
   , runtime_type(runtime_type_)
   , caching_(ini_.get_agas_caching_mode())
@@ -150,6 +157,17 @@ addressing_service::addressing_service(
     if (caching_)
         gva_cache_->reserve(ini_.get_agas_local_cache_size());
 
+    if (max_worker_refcnt_requests_ > 1)
+    {
+        std::size_t num_threads = ini_.get_os_thread_count();
+        worker_refcnt_requests_.reserve(num_threads);
+        for (std::size_t i = 0; i != num_threads; ++i)
+        {
+            worker_refcnt_requests_.emplace_back(
+                new detail::worker_refcnt_requests);
+        }
+    }
+
 #if defined(HPX_HAVE_NETWORKING)
     std::shared_ptr<parcelset::parcelport> pp = ph.get_bootstrap_parcelport();
     create_big_boot_barrier(pp ? pp.get() : nullptr, ph.endpoints(), ini_);
@@ -1472,7 +1490,12 @@ lcos::future<std::int64_t> addressing_service::incref_async(
     std::int64_t pending_decrefs = 0;
 
     {
-        std::lock_guard<mutex_type> l(refcnt_requests_mtx_);
+        std::unique_lock<mutex_type> l(refcnt_requests_mtx_);
+
+        // give the decrements buffered by all worker threads a chance to be
+        // compensated as well, the matching decrement may have been issued
+        // on a different worker
+        merge_worker_refcnt_requests(l);
 
         typedef refcnt_requests_type::iterator iterator;
 
@@ -1570,6 +1593,29 @@ void addressing_service::decref(
     }
 
     try {
+        // Buffer the request with the calling worker thread, the buffered
+        // requests are merged into the table of pending requests once they
+        // are too many, when the flush timer fires, or when an incref needs
+        // to see them.
+        std::size_t num_thread = get_worker_thread_num();
+        if (num_thread < worker_refcnt_requests_.size() &&
+            enable_refcnt_caching_.load(boost::memory_order_relaxed))
+        {
+            std::size_t count =
+                worker_refcnt_requests_[num_thread]->append(raw, credit);
+            if (count < max_worker_refcnt_requests_)
+            {
+                if (&ec != &throws)
+                    ec = make_success_code();
+                return;
+            }
+
+            std::unique_lock<mutex_type> l(refcnt_requests_mtx_);
+            merge_worker_refcnt_requests(l, num_thread);
+            send_refcnt_requests(l, ec);
+            return;
+        }
+
         std::unique_lock<mutex_type> l(refcnt_requests_mtx_);
 
         // Match the decref request with entries in the incref table
@@ -1598,6 +1644,7 @@ void addressing_service::decref(
             }
         }
 
+        ++refcnt_requests_count_;
         send_refcnt_requests(l, ec);
     }
     catch (hpx::exception const& e) {
@@ -2016,8 +2063,11 @@ void addressing_service::start_shutdown(error_code& ec)
     if (!caching_)
         return;
 
+    refcnt_flush_timer_.reset();
+
     std::unique_lock<mutex_type> l(refcnt_requests_mtx_);
     enable_refcnt_caching_ = false;
+    merge_worker_refcnt_requests(l);
     send_refcnt_requests_sync(l, ec);
 }
 
@@ -2172,6 +2222,17 @@ std::uint64_t addressing_service::get_cache_insertions(bool reset)
     return gva_cache_->get_statistics().insertions(reset);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+std::int64_t addressing_service::get_decref_messages(bool reset)
+{
+    return util::get_and_reset_value(decref_messages_, reset);
+}
+
+std::int64_t addressing_service::get_decref_messages_avoided(bool reset)
+{
+    return util::get_and_reset_value(decref_messages_avoided_, reset);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 std::uint64_t addressing_service::get_cache_get_entry_count(bool reset)
 {
@@ -2265,6 +2326,12 @@ void addressing_service::register_counter_types()
         util::bind(
             &addressing_service::get_cache_erase_entry_time, this, _1));
 
+    util::function_nonser<std::int64_t(bool)> decref_messages(
+        util::bind(&addressing_service::get_decref_messages, this, _1));
+    util::function_nonser<std::int64_t(bool)> decref_messages_avoided(
+        util::bind(
+            &addressing_service::get_decref_messages_avoided, this, _1));
+
     performance_counters::generic_counter_type_data const counter_types[] =
     {
         { "/agas/count/cache/entries", performance_counters::counter_raw,
@@ -2379,6 +2446,26 @@ void addressing_service::register_counter_types()
           &performance_counters::locality_counter_discoverer,
           ""
         },
+        { "/agas/count/decref/messages", performance_counters::counter_raw,
+          "returns the number of messages sent to decrement the global "
+                "reference counts of objects",
+          HPX_PERFORMANCE_COUNTER_V1,
+          util::bind(&performance_counters::locality_raw_counter_creator,
+              _1, decref_messages, _2),
+          &performance_counters::locality_counter_discoverer,
+          ""
+        },
+        { "/agas/count/decref/messages-avoided",
+          performance_counters::counter_raw,
+          "returns the number of global reference count decrements which "
+                "did not need a message of their own as they were combined "
+                "with other decrements or compensated by increments",
+          HPX_PERFORMANCE_COUNTER_V1,
+          util::bind(&performance_counters::locality_raw_counter_creator,
+              _1, decref_messages_avoided, _2),
+          &performance_counters::locality_counter_discoverer,
+          ""
+        },
     };
     performance_counters::install_counter_types(
         counter_types, sizeof(counter_types)/sizeof(counter_types[0]));
@@ -2405,6 +2492,7 @@ void addressing_service::garbage_collect_non_blocking(
     std::unique_lock<mutex_type> l(refcnt_requests_mtx_, std::try_to_lock);
     if (!l.owns_lock()) return;     // no need to compete for garbage collection
 
+    merge_worker_refcnt_requests(l);
     send_refcnt_requests_non_blocking(l, ec);
 }
 
@@ -2415,9 +2503,63 @@ void addressing_service::garbage_collect(
     std::unique_lock<mutex_type> l(refcnt_requests_mtx_, std::try_to_lock);
     if (!l.owns_lock()) return;     // no need to compete for garbage collection
 
+    merge_worker_refcnt_requests(l);
     send_refcnt_requests_sync(l, ec);
 }
 
+void addressing_service::start_refcnt_flush_timer()
+{
+    if (refcnt_flush_interval_ <= 0 || refcnt_flush_timer_)
+        return;
+
+    refcnt_flush_timer_.reset(new util::interval_timer(
+        util::bind(&addressing_service::flush_refcnt_requests, this),
+        refcnt_flush_interval_ * 1000, "addressing_service::refcnt_flush",
+        true));
+    refcnt_flush_timer_->start(false);
+}
+
+bool addressing_service::flush_refcnt_requests()
+{
+    std::unique_lock<mutex_type> l(refcnt_requests_mtx_, std::try_to_lock);
+    if (l.owns_lock())
+    {
+        merge_worker_refcnt_requests(l);
+
+        error_code ec(lightweight);
+        send_refcnt_requests_non_blocking(l, ec);
+    }
+    return true;        // keep the timer running
+}
+
+void addressing_service::merge_worker_refcnt_requests(
+    std::unique_lock<addressing_service::mutex_type>& l
+  , std::size_t num_thread
+    )
+{
+    HPX_ASSERT(l.owns_lock());
+
+    if (worker_refcnt_requests_.empty())
+        return;
+
+    detail::worker_refcnt_requests::requests_type requests;
+    if (num_thread == std::size_t(-1))
+    {
+        for (auto& wr : worker_refcnt_requests_)
+            wr->collect(requests);
+    }
+    else if (num_thread < worker_refcnt_requests_.size())
+    {
+        worker_refcnt_requests_[num_thread]->collect(requests);
+    }
+
+    // decrements of the same gid are combined into one request
+    for (auto const& r : requests)
+        (*refcnt_requests_)[r.first] += r.second;
+
+    refcnt_requests_count_ += requests.size();
+}
+
 void addressing_service::send_refcnt_requests(
     std::unique_lock<addressing_service::mutex_type>& l
   , error_code& ec
@@ -2431,13 +2573,28 @@ void addressing_service::send_refcnt_requests(
         return;
     }
 
-    if (!enable_refcnt_caching_ || max_refcnt_requests_ == ++refcnt_requests_count_)
+    if (!enable_refcnt_caching_ ||
+        refcnt_requests_count_ >= max_refcnt_requests_)
+    {
         send_refcnt_requests_non_blocking(l, ec);
+    }
 
     else if (&ec != &throws)
         ec = make_success_code();
 }
 
+// Account for sending the given number of requests (each decrement issued since
+// the last time) using the given number of messages.
+void addressing_service::update_decref_statistics(
+    std::size_t requests
+  , std::size_t messages
+    )
+{
+    decref_messages_ += messages;
+    if (requests > messages)
+        decref_messages_avoided_ += requests - messages;
+}
+
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
     void dump_refcnt_requests(
         std::unique_lock<addressing_service::mutex_type>& l
@@ -2486,6 +2643,7 @@ void addressing_service::send_refcnt_requests_non_blocking(
         std::shared_ptr<refcnt_requests_type> p(new refcnt_requests_type);
 
         p.swap(refcnt_requests_);
+        std::size_t count = refcnt_requests_count_;
         refcnt_requests_count_ = 0;
 
         l.unlock();
@@ -2525,6 +2683,8 @@ void addressing_service::send_refcnt_requests_non_blocking(
             requests[target].push_back(hpx::util::make_tuple(e.second, raw, raw));
         }
 
+        update_decref_statistics(count, requests.size());
+
         // send requests to all locality
         requests_type::iterator end = requests.end();
         for (requests_type::iterator it = requests.begin(); it != end; ++it)
@@ -2559,6 +2719,7 @@ addressing_service::send_refcnt_requests_async(
     std::shared_ptr<refcnt_requests_type> p(new refcnt_requests_type);
 
     p.swap(refcnt_requests_);
+    std::size_t count = refcnt_requests_count_;
     refcnt_requests_count_ = 0;
 
     l.unlock();
@@ -2599,6 +2760,8 @@ addressing_service::send_refcnt_requests_async(
         requests[target].push_back(hpx::util::make_tuple(e.second, raw, raw));
     }
 
+    update_decref_statistics(count, requests.size());
+
     // send requests to all locality
     requests_type::const_iterator end = requests.end();
     for (requests_type::const_iterator it = requests.begin(); it != end; ++it)
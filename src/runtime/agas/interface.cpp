@@ -248,6 +248,27 @@ naming::address resolve(
     return agas_.resolve_async(id).get(ec);
 }
 
+bool resolve_cached(
+    std::vector<naming::id_type> const& ids
+  , std::vector<naming::address>& addrs
+  , error_code& ec
+    )
+{
+    std::size_t const count = ids.size();
+
+    std::vector<naming::gid_type> gids;
+    gids.reserve(count);
+    for (naming::id_type const& id : ids)
+        gids.push_back(id.get_gid());
+
+    addrs.clear();
+    addrs.resize(count);
+
+    boost::dynamic_bitset<> locals;
+    return naming::get_agas_client().resolve_cached(gids.data(),
+        addrs.data(), count, locals, ec);
+}
+
 hpx::future<bool> bind(
     naming::gid_type const& gid
   , naming::address const& addr
@@ -60,6 +60,164 @@ naming::id_type bootstrap_primary_namespace_id()
 namespace server
 {
 
+static_assert((HPX_AGAS_PRIMARY_NAMESPACE_SHARDS &
+        (HPX_AGAS_PRIMARY_NAMESPACE_SHARDS - 1)) == 0,
+    "HPX_AGAS_PRIMARY_NAMESPACE_SHARDS must be a power of two");
+static_assert((HPX_AGAS_PRIMARY_NAMESPACE_CACHE_SIZE &
+        (HPX_AGAS_PRIMARY_NAMESPACE_CACHE_SIZE - 1)) == 0,
+    "HPX_AGAS_PRIMARY_NAMESPACE_CACHE_SIZE must be a power of two");
+
+///////////////////////////////////////////////////////////////////////////////
+bool primary_namespace::resolve_cache::find(
+    naming::gid_type const& id
+  , resolved_type& r
+    ) const
+{
+    entry const& e = entries_[get_index(id)];
+
+    std::uint64_t const seq = e.seq_.load(boost::memory_order_acquire);
+    if (seq & 1)
+        return false;           // the entry is being modified
+
+    std::uint64_t data[10];
+    for (std::size_t i = 0; i != 10; ++i)
+        data[i] = e.data_[i].load(boost::memory_order_relaxed);
+
+    boost::atomic_thread_fence(boost::memory_order_acquire);
+    if (e.seq_.load(boost::memory_order_relaxed) != seq)
+        return false;           // the entry was modified while being read
+
+    // check whether the cached range holds the id
+    if (data[5] == 0 || data[0] != id.get_msb() || id.get_lsb() < data[1] ||
+        id.get_lsb() - data[1] >= data[5])
+    {
+        return false;
+    }
+
+    r = resolved_type(
+        naming::gid_type(data[0], data[1]),
+        gva(naming::gid_type(data[2], data[3]),
+            static_cast<gva::component_type>(data[4]), data[5],
+            gva::lva_type(data[6]), data[7]),
+        naming::gid_type(data[8], data[9]));
+    return true;
+}
+
+void primary_namespace::resolve_cache::insert(
+    naming::gid_type const& id
+  , resolved_type const& r
+    )
+{
+    using hpx::util::get;
+
+    naming::gid_type const& base = get<0>(r);
+    gva const& g = get<1>(r);
+    naming::gid_type const& locality = get<2>(r);
+
+    std::uint64_t const data[10] = {
+        base.get_msb(), base.get_lsb(),
+        g.prefix.get_msb(), g.prefix.get_lsb(),
+        std::uint64_t(std::uint32_t(g.type)), g.count, g.lva(), g.offset,
+        locality.get_msb(), locality.get_lsb()
+    };
+
+    entry& e = entries_[get_index(id)];
+
+    std::uint64_t const seq = e.seq_.load(boost::memory_order_relaxed);
+    e.seq_.store(seq + 1, boost::memory_order_relaxed);
+    boost::atomic_thread_fence(boost::memory_order_release);
+
+    for (std::size_t i = 0; i != 10; ++i)
+        e.data_[i].store(data[i], boost::memory_order_relaxed);
+
+    e.seq_.store(seq + 2, boost::memory_order_release);
+}
+
+void primary_namespace::resolve_cache::invalidate(naming::gid_type const& base)
+{
+    for (entry& e : entries_)
+    {
+        if (e.data_[5].load(boost::memory_order_relaxed) == 0 ||
+            e.data_[0].load(boost::memory_order_relaxed) != base.get_msb() ||
+            e.data_[1].load(boost::memory_order_relaxed) != base.get_lsb())
+        {
+            continue;
+        }
+
+        std::uint64_t const seq = e.seq_.load(boost::memory_order_relaxed);
+        e.seq_.store(seq + 1, boost::memory_order_relaxed);
+        boost::atomic_thread_fence(boost::memory_order_release);
+
+        e.data_[5].store(0, boost::memory_order_relaxed);
+
+        e.seq_.store(seq + 2, boost::memory_order_release);
+    }
+}
+
+void primary_namespace::resolve_cache::clear()
+{
+    for (entry& e : entries_)
+    {
+        if (e.data_[5].load(boost::memory_order_relaxed) == 0)
+            continue;
+
+        std::uint64_t const seq = e.seq_.load(boost::memory_order_relaxed);
+        e.seq_.store(seq + 1, boost::memory_order_relaxed);
+        boost::atomic_thread_fence(boost::memory_order_release);
+
+        e.data_[5].store(0, boost::memory_order_relaxed);
+
+        e.seq_.store(seq + 2, boost::memory_order_release);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+primary_namespace::gva_shards_lock::gva_shards_lock(
+    primary_namespace& ns
+  , naming::gid_type const& id
+  , std::uint64_t count
+    )
+  : ns_(ns)
+  , first_(get_shard_index(id))
+  , num_shards_(HPX_AGAS_PRIMARY_NAMESPACE_SHARDS)
+{
+    std::uint64_t const lower = id.get_lsb();
+    std::uint64_t const upper = lower + (count ? count - 1 : 0);
+
+    // a range crossing the MSB is rejected later on, lock all shards
+    if (upper >= lower)
+    {
+        std::uint64_t const chunks =
+            (upper >> HPX_AGAS_PRIMARY_NAMESPACE_SHARD_SHIFT) -
+            (lower >> HPX_AGAS_PRIMARY_NAMESPACE_SHARD_SHIFT) + 1;
+        if (chunks < HPX_AGAS_PRIMARY_NAMESPACE_SHARDS)
+            num_shards_ = std::size_t(chunks);
+    }
+}
+
+void primary_namespace::gva_shards_lock::lock()
+{
+    if (num_shards_ == 1)
+    {
+        ns_.gva_shards_[first_].mtx_.lock();
+        return;
+    }
+
+    for (std::size_t i = 0; i != HPX_AGAS_PRIMARY_NAMESPACE_SHARDS; ++i)
+    {
+        if (((i - first_) & (HPX_AGAS_PRIMARY_NAMESPACE_SHARDS - 1)) <
+            num_shards_)
+        {
+            ns_.gva_shards_[i].mtx_.lock();
+        }
+    }
+}
+
+void primary_namespace::gva_shards_lock::unlock()
+{
+    for_each_shard([](gva_shard& shard) { shard.mtx_.unlock(); });
+}
+
 // register all performance counter types exposed by this component
 void primary_namespace::register_counter_types(
     error_code& ec
@@ -231,9 +389,10 @@ primary_namespace::begin_migration(naming::gid_type id)
     counter_data_.increment_begin_migration_count();
     using hpx::util::get;
 
-    std::unique_lock<mutex_type> l(mutex_);
+    gva_shard& shard = get_gva_shard(id);
+    std::unique_lock<mutex_type> l(shard.mtx_);
 
-    resolved_type r = resolve_gid_locked(l, id, hpx::throws);
+    resolved_type r = resolve_gid_locked(l, shard, id, hpx::throws);
     if (get<0>(r) == naming::invalid_gid)
     {
         l.unlock();
@@ -245,18 +404,24 @@ primary_namespace::begin_migration(naming::gid_type id)
         return std::make_pair(naming::invalid_id, naming::address());
     }
 
-    migration_table_type::iterator it = migrating_objects_.find(id);
-    if (it == migrating_objects_.end())
+    migration_table_type::iterator it = shard.migrating_objects_.find(id);
+    if (it == shard.migrating_objects_.end())
     {
         std::pair<migration_table_type::iterator, bool> p =
-            migrating_objects_.emplace(std::piecewise_construct,
+            shard.migrating_objects_.emplace(std::piecewise_construct,
                 std::forward_as_tuple(id), std::forward_as_tuple());
         HPX_ASSERT(p.second);
         it = p.first;
     }
 
-    // flag this id as being migrated
-    hpx::util::get<0>(it->second) = true; //-V601
+    // flag this id as being migrated, lookups bypass the cache of the shard
+    // until the migration has ended
+    if (!hpx::util::get<0>(it->second))
+    {
+        hpx::util::get<0>(it->second) = true; //-V601
+        ++shard.migrations_;
+        shard.cache_.clear();
+    }
 
     gva const& g(hpx::util::get<1>(r));
     naming::address addr(g.prefix, g.type, g.lva());
@@ -272,12 +437,13 @@ bool primary_namespace::end_migration(naming::gid_type id)
     );
     counter_data_.increment_end_migration_count();
 
-    std::unique_lock<mutex_type> l(mutex_);
+    gva_shard& shard = get_gva_shard(id);
+    std::unique_lock<mutex_type> l(shard.mtx_);
 
     using hpx::util::get;
 
-    migration_table_type::iterator it = migrating_objects_.find(id);
-    if (it == migrating_objects_.end() || !get<0>(it->second))
+    migration_table_type::iterator it = shard.migrating_objects_.find(id);
+    if (it == shard.migrating_objects_.end() || !get<0>(it->second))
         return false;
 
     // ignore before notifying everyone about the ended migration.
@@ -288,6 +454,7 @@ bool primary_namespace::end_migration(naming::gid_type id)
 
     // flag this id as not being migrated anymore
     get<0>(it->second) = false;
+    --shard.migrations_;
 
     return true;
 }
@@ -295,6 +462,7 @@ bool primary_namespace::end_migration(naming::gid_type id)
 // wait if given object is currently being migrated
 void primary_namespace::wait_for_migration_locked(
     std::unique_lock<mutex_type>& l
+  , gva_shard& shard
   , naming::gid_type id
   , error_code& ec)
 {
@@ -302,15 +470,15 @@ void primary_namespace::wait_for_migration_locked(
 
     using hpx::util::get;
 
-    migration_table_type::iterator it = migrating_objects_.find(id);
-    if (it != migrating_objects_.end() && get<0>(it->second))
+    migration_table_type::iterator it = shard.migrating_objects_.find(id);
+    if (it != shard.migrating_objects_.end() && get<0>(it->second))
     {
         ++get<1>(it->second);
 
         get<2>(it->second).wait(l, ec);
 
         if (--get<1>(it->second) == 0 && !get<0>(it->second))
-            migrating_objects_.erase(it);
+            shard.migrating_objects_.erase(it);
     }
 }
 
@@ -328,11 +496,16 @@ bool primary_namespace::bind_gid(
 
     naming::detail::strip_internal_bits_from_gid(id);
 
-    std::unique_lock<mutex_type> l(mutex_);
+    // The shard of the first gid holds all ranges covering it, the range is
+    // stored in all shards it spans.
+    gva_shards_lock shards(*this, id, g.count);
+    std::unique_lock<gva_shards_lock> l(shards);
 
-    gva_table_type::iterator it = gvas_.lower_bound(id)
-                           , begin = gvas_.begin()
-                           , end = gvas_.end();
+    gva_table_type& gvas = get_gva_shard(id).gvas_;
+
+    gva_table_type::iterator it = gvas.lower_bound(id)
+                           , begin = gvas.begin()
+                           , end = gvas.end();
 
     if (it != end)
     {
@@ -340,8 +513,7 @@ bool primary_namespace::bind_gid(
         // binding (e.g. move semantics).
         if (it->first == id)
         {
-            gva& gaddr = it->second.first;
-            naming::gid_type& loc = it->second.second;
+            gva const& gaddr = it->second.first;
 
             // Check for count mismatch (we can't change block sizes of
             // existing bindings).
@@ -379,12 +551,23 @@ bool primary_namespace::bind_gid(
                         % id % g % locality));
             }
 
-            // Store the new endpoint and offset
-            gaddr.prefix = g.prefix;
-            gaddr.type   = g.type;
-            gaddr.lva(g.lva());
-            gaddr.offset = g.offset;
-            loc = locality;
+            // Store the new endpoint and offset in all shards holding the
+            // range.
+            shards.for_each_shard(
+                [&](gva_shard& shard)
+                {
+                    gva_table_type::iterator sit = shard.gvas_.find(id);
+                    HPX_ASSERT(sit != shard.gvas_.end());
+
+                    gva& addr = sit->second.first;
+                    addr.prefix = g.prefix;
+                    addr.type   = g.type;
+                    addr.lva(g.lva());
+                    addr.offset = g.offset;
+                    sit->second.second = locality;
+
+                    shard.cache_.invalidate(id);
+                });
 
             l.unlock();
 
@@ -415,7 +598,7 @@ bool primary_namespace::bind_gid(
         }
     }
 
-    else if (HPX_LIKELY(!gvas_.empty()))
+    else if (HPX_LIKELY(!gvas.empty()))
     {
         --it;
 
@@ -454,9 +637,20 @@ bool primary_namespace::bind_gid(
                 % id % g % locality));
     }
 
-    // Insert a GID -> GVA entry into the GVA table.
-    if (HPX_UNLIKELY(!util::insert_checked(gvas_.insert(
-            std::make_pair(id, std::make_pair(g, locality))))))
+    // Insert a GID -> GVA entry into the GVA tables of all shards holding
+    // the range.
+    bool inserted = true;
+    shards.for_each_shard(
+        [&](gva_shard& shard)
+        {
+            if (!util::insert_checked(shard.gvas_.insert(
+                    std::make_pair(id, std::make_pair(g, locality)))))
+            {
+                inserted = false;
+            }
+        });
+
+    if (HPX_UNLIKELY(!inserted))
     {
         l.unlock();
 
@@ -487,14 +681,25 @@ primary_namespace::resolved_type primary_namespace::resolve_gid(naming::gid_type
 
     resolved_type r;
 
+    naming::gid_type stripped_id = id;
+    naming::detail::strip_internal_bits_from_gid(stripped_id);
+
+    // Try to resolve the id without acquiring the lock first. This is not
+    // possible while objects held by the shard are being migrated.
+    gva_shard& shard = get_gva_shard(stripped_id);
+    if (shard.migrations_.load(boost::memory_order_acquire) != 0 ||
+        !shard.cache_.find(stripped_id, r))
     {
-        std::unique_lock<mutex_type> l(mutex_);
+        std::unique_lock<mutex_type> l(shard.mtx_);
 
         // wait for any migration to be completed
-        wait_for_migration_locked(l, id, hpx::throws);
+        wait_for_migration_locked(l, shard, id, hpx::throws);
 
         // now, resolve the id
-        r = resolve_gid_locked(l, id, hpx::throws);
+        r = resolve_gid_locked(l, shard, id, hpx::throws);
+
+        if (get<0>(r) != naming::invalid_gid && shard.migrations_ == 0)
+            shard.cache_.insert(stripped_id, r);
     }
 
     if (get<0>(r) == naming::invalid_gid)
@@ -532,10 +737,12 @@ naming::address primary_namespace::unbind_gid(
 
     naming::detail::strip_internal_bits_from_gid(id);
 
-    std::unique_lock<mutex_type> l(mutex_);
+    gva_shards_lock shards(*this, id, count);
+    std::unique_lock<gva_shards_lock> l(shards);
 
-    gva_table_type::iterator it = gvas_.find(id)
-                           , end = gvas_.end();
+    gva_shard& shard = get_gva_shard(id);
+    gva_table_type::iterator it = shard.gvas_.find(id)
+                           , end = shard.gvas_.end();
 
     if (it != end)
     {
@@ -550,7 +757,12 @@ naming::address primary_namespace::unbind_gid(
 
         gva_table_data_type data = it->second;
 
-        gvas_.erase(it);
+        shards.for_each_shard(
+            [&](gva_shard& s)
+            {
+                s.gvas_.erase(id);
+                s.cache_.invalidate(id);
+            });
 
         l.unlock();
         LAGAS_(info) << (boost::format(
@@ -717,8 +929,7 @@ std::pair<naming::gid_type, naming::gid_type> primary_namespace::allocate(
 
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
     void primary_namespace::dump_refcnt_matches(
-        refcnt_table_type::iterator lower_it
-      , refcnt_table_type::iterator upper_it
+        refcnt_shard& shard
       , naming::gid_type const& lower
       , naming::gid_type const& upper
       , std::unique_lock<mutex_type>& l
@@ -727,7 +938,22 @@ std::pair<naming::gid_type, naming::gid_type> primary_namespace::allocate(
     { // dump_refcnt_matches implementation
         HPX_ASSERT(l.owns_lock());
 
-        if (lower_it == refcnts_.end() && upper_it == refcnts_.end())
+        refcnt_table_type& refcnts = shard.refcnts_;
+
+        // Find the mappings that we're about to touch.
+        refcnt_table_type::iterator lower_it = refcnts.find(lower);
+        refcnt_table_type::iterator upper_it;
+        if (lower != upper)
+        {
+            upper_it = refcnts.find(upper);
+        }
+        else
+        {
+            upper_it = lower_it;
+            ++upper_it;
+        }
+
+        if (lower_it == refcnts.end() && upper_it == refcnts.end())
             // We got nothing, bail - our caller is probably about to throw.
             return;
 
@@ -759,30 +985,6 @@ void primary_namespace::increment(
   , error_code& ec
     )
 { // {{{ increment implementation
-    std::unique_lock<mutex_type> l(mutex_);
-
-#if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
-    if (LAGAS_ENABLED(debug))
-    {
-        typedef refcnt_table_type::iterator iterator;
-
-        // Find the mappings that we're about to touch.
-        refcnt_table_type::iterator lower_it = refcnts_.find(lower);
-        refcnt_table_type::iterator upper_it;
-        if (lower != upper)
-        {
-            upper_it = refcnts_.find(upper);
-        }
-        else
-        {
-            upper_it = lower_it;
-            ++upper_it;
-        }
-
-        dump_refcnt_matches(lower_it, upper_it, lower, upper, l,
-            "primary_namespace::increment");
-    }
-#endif
 
     // TODO: Whine loudly if a reference count overflows. We reserve ~0 for
     // internal bookkeeping in the decrement algorithm, so the maximum global
@@ -794,39 +996,58 @@ void primary_namespace::increment(
     // allocate/bind them, so if a GID is not in the refcnt table, we know that
     // it's global reference count is the initial global reference count.
 
-    for (naming::gid_type raw = lower; raw != upper; ++raw)
+    naming::gid_type raw = lower;
+    while (raw != upper)
     {
-        refcnt_table_type::iterator it = refcnts_.find(raw);
-        if (it == refcnts_.end())
+        // Lock the shard once for all consecutive gids it holds.
+        std::size_t const shard_index = get_shard_index(raw);
+        refcnt_shard& shard = refcnt_shards_[shard_index];
+        refcnt_table_type& refcnts = shard.refcnts_;
+
+        std::unique_lock<mutex_type> l(shard.mtx_);
+
+#if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
+        if (LAGAS_ENABLED(debug))
         {
-            std::int64_t count =
-                std::int64_t(HPX_GLOBALCREDIT_INITIAL) + credits;
+            dump_refcnt_matches(shard, raw, upper, l,
+                "primary_namespace::increment");
+        }
+#endif
 
-            std::pair<refcnt_table_type::iterator, bool> p =
-                refcnts_.insert(refcnt_table_type::value_type(raw, count));
-            if (!p.second)
+        for (/**/; raw != upper && get_shard_index(raw) == shard_index; ++raw)
+        {
+            refcnt_table_type::iterator it = refcnts.find(raw);
+            if (it == refcnts.end())
             {
-                l.unlock();
+                std::int64_t count =
+                    std::int64_t(HPX_GLOBALCREDIT_INITIAL) + credits;
 
-                HPX_THROWS_IF(ec, invalid_data
-                    , "primary_namespace::increment"
-                    , boost::str(boost::format(
-                        "couldn't create entry in reference count table, "
-                        "raw(%1%), ref-count(%3%)")
-                        % raw % count));
-                return;
+                std::pair<refcnt_table_type::iterator, bool> p =
+                    refcnts.insert(refcnt_table_type::value_type(raw, count));
+                if (!p.second)
+                {
+                    l.unlock();
+
+                    HPX_THROWS_IF(ec, invalid_data
+                        , "primary_namespace::increment"
+                        , boost::str(boost::format(
+                            "couldn't create entry in reference count table, "
+                            "raw(%1%), ref-count(%3%)")
+                            % raw % count));
+                    return;
+                }
+
+                it = p.first;
+            }
+            else
+            {
+                it->second += credits;
             }
 
-            it = p.first;
-        }
-        else
-        {
-            it->second += credits;
+            LAGAS_(info) << (boost::format(
+                "primary_namespace::increment, raw(%1%), refcnt(%2%)")
+                % lower % it->second);
         }
-
-        LAGAS_(info) << (boost::format(
-            "primary_namespace::increment, raw(%1%), refcnt(%2%)")
-            % lower % it->second);
     }
 
     if (&ec != &throws)
@@ -835,32 +1056,25 @@ void primary_namespace::increment(
 
 ///////////////////////////////////////////////////////////////////////////////
 void primary_namespace::resolve_free_list(
-    std::unique_lock<mutex_type>& l
-  , std::list<refcnt_table_type::iterator> const& free_list
+    std::list<naming::gid_type> const& free_list
   , std::list<free_entry>& free_entry_list
   , naming::gid_type const& lower
   , naming::gid_type const& upper
   , error_code& ec
     )
 {
-    HPX_ASSERT_OWNS_LOCK(l);
-
     using hpx::util::get;
 
-    typedef refcnt_table_type::iterator iterator;
-
-    for (iterator const& it : free_list)
+    for (naming::gid_type const& gid : free_list)
     {
-        typedef refcnt_table_type::key_type key_type;
-
-        // The mapping's key space.
-        key_type gid = it->first;
+        gva_shard& shard = get_gva_shard(gid);
+        std::unique_lock<mutex_type> l(shard.mtx_);
 
         // wait for any migration to be completed
-        wait_for_migration_locked(l, gid, ec);
+        wait_for_migration_locked(l, shard, gid, ec);
 
         // Resolve the query GID.
-        resolved_type r = resolve_gid_locked(l, gid, ec);
+        resolved_type r = resolve_gid_locked(l, shard, gid, ec);
         if (ec) return;
 
         naming::gid_type& raw = get<0>(r);
@@ -906,6 +1120,8 @@ void primary_namespace::resolve_free_list(
             return;
         }
 
+        l.unlock();
+
         LAGAS_(info) << (boost::format(
             "primary_namespace::resolve_free_list, resolved match, "
             "gid(%1%), gva(%2%)")
@@ -917,9 +1133,6 @@ void primary_namespace::resolve_free_list(
         // Add the information needed to destroy these components to the
         // free list.
         free_entry_list.push_back(free_entry(resolved, gid, get<2>(r)));
-
-        // remove this entry from the refcnt table
-        refcnts_.erase(it);
     }
 }
 
@@ -939,46 +1152,39 @@ void primary_namespace::decrement_sweep(
 
     free_entry_list.clear();
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Apply the decrement across the entire key space (e.g. [lower, upper]).
+
+    // The third parameter we pass here is the default data to use in case
+    // the key is not mapped. We don't insert GIDs into the refcnt table
+    // when we allocate/bind them, so if a GID is not in the refcnt table,
+    // we know that it's global reference count is the initial global
+    // reference count.
+
+    std::list<naming::gid_type> free_list;
+
+    naming::gid_type raw = lower;
+    while (raw != upper)
     {
-        std::unique_lock<mutex_type> l(mutex_);
+        // Lock the shard once for all consecutive gids it holds.
+        std::size_t const shard_index = get_shard_index(raw);
+        refcnt_shard& shard = refcnt_shards_[shard_index];
+        refcnt_table_type& refcnts = shard.refcnts_;
+
+        std::unique_lock<mutex_type> l(shard.mtx_);
 
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
         if (LAGAS_ENABLED(debug))
         {
-            typedef refcnt_table_type::iterator iterator;
-
-            // Find the mappings that we just added or modified.
-            refcnt_table_type::iterator lower_it = refcnts_.find(lower);
-            refcnt_table_type::iterator upper_it;
-            if (lower != upper)
-            {
-                upper_it = refcnts_.find(upper);
-            }
-            else
-            {
-                upper_it = lower_it;
-                ++upper_it;
-            }
-
-            dump_refcnt_matches(lower_it, upper_it, lower, upper, l,
+            dump_refcnt_matches(shard, raw, upper, l,
                 "primary_namespace::decrement_sweep");
         }
 #endif
 
-        ///////////////////////////////////////////////////////////////////////
-        // Apply the decrement across the entire key space (e.g. [lower, upper]).
-
-        // The third parameter we pass here is the default data to use in case
-        // the key is not mapped. We don't insert GIDs into the refcnt table
-        // when we allocate/bind them, so if a GID is not in the refcnt table,
-        // we know that it's global reference count is the initial global
-        // reference count.
-
-        std::list<refcnt_table_type::iterator> free_list;
-        for (naming::gid_type raw = lower; raw != upper; ++raw)
+        for (/**/; raw != upper && get_shard_index(raw) == shard_index; ++raw)
         {
-            refcnt_table_type::iterator it = refcnts_.find(raw);
-            if (it == refcnts_.end())
+            refcnt_table_type::iterator it = refcnts.find(raw);
+            if (it == refcnts.end())
             {
                 if (credits > std::int64_t(HPX_GLOBALCREDIT_INITIAL))
                 {
@@ -998,7 +1204,7 @@ void primary_namespace::decrement_sweep(
                     std::int64_t(HPX_GLOBALCREDIT_INITIAL) - credits;
 
                 std::pair<refcnt_table_type::iterator, bool> p =
-                    refcnts_.insert(refcnt_table_type::value_type(raw, count));
+                    refcnts.insert(refcnt_table_type::value_type(raw, count));
                 if (!p.second)
                 {
                     l.unlock();
@@ -1033,15 +1239,19 @@ void primary_namespace::decrement_sweep(
                 return;
             }
 
-            // this objects needs to be deleted
+            // this objects needs to be deleted, nobody can refer to it
+            // anymore, thus the entry can be removed right away
             if (it->second == 0)
-                free_list.push_back(it);
+            {
+                free_list.push_back(raw);
+                refcnts.erase(it);
+            }
         }
+    } // Unlock the shard.
 
-        // Resolve the objects which have to be deleted.
-        resolve_free_list(l, free_list, free_entry_list, lower, upper, ec);
-
-    } // Unlock the mutex.
+    // Resolve the objects which have to be deleted.
+    resolve_free_list(free_list, free_entry_list, lower, upper, ec);
+    if (ec) return;
 
     if (&ec != &throws)
         ec = make_success_code();
@@ -1110,6 +1320,7 @@ void primary_namespace::free_components_sync(
 
 primary_namespace::resolved_type primary_namespace::resolve_gid_locked(
     std::unique_lock<mutex_type>& l
+  , gva_shard& shard
   , naming::gid_type const& gid
   , error_code& ec
     )
@@ -1120,9 +1331,10 @@ primary_namespace::resolved_type primary_namespace::resolve_gid_locked(
     naming::gid_type id = gid;
     naming::detail::strip_internal_bits_from_gid(id);
 
-    gva_table_type::const_iterator it = gvas_.lower_bound(id)
-                                 , begin = gvas_.begin()
-                                 , end = gvas_.end();
+    gva_table_type const& gvas = shard.gvas_;
+    gva_table_type::const_iterator it = gvas.lower_bound(id)
+                                 , begin = gvas.begin()
+                                 , end = gvas.end();
 
     if (it != end)
     {
@@ -1165,7 +1377,7 @@ primary_namespace::resolved_type primary_namespace::resolve_gid_locked(
         }
     }
 
-    else if (HPX_LIKELY(!gvas_.empty()))
+    else if (HPX_LIKELY(!gvas.empty()))
     {
         --it;
 
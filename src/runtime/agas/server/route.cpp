@@ -41,12 +41,13 @@ namespace hpx { namespace agas { namespace server
         // resolve destination addresses, we should be able to resolve all of
         // them, otherwise it's an error
         {
-            std::unique_lock<mutex_type> l(mutex_);
+            gva_shard& shard = get_gva_shard(gid);
+            std::unique_lock<mutex_type> l(shard.mtx_);
 
             // wait for any migration to be completed
-            wait_for_migration_locked(l, gid, ec);
+            wait_for_migration_locked(l, shard, gid, ec);
 
-            cache_address = resolve_gid_locked(l, gid, ec);
+            cache_address = resolve_gid_locked(l, shard, gid, ec);
 
             if (ec || hpx::util::get<0>(cache_address) == naming::invalid_gid)
             {
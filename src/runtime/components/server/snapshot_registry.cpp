@@ -0,0 +1,141 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/components/component_type.hpp>
+#include <hpx/runtime/components/server/snapshot_registry.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/util/detail/yield_k.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hpx { namespace components { namespace detail
+{
+    snapshot_registry& snapshot_registry::instance()
+    {
+        static snapshot_registry registry;
+        return registry;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void snapshot_registry::register_type(snapshot_vtable const* vt)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        if (std::find(types_.begin(), types_.end(), vt) == types_.end())
+            types_.push_back(vt);
+    }
+
+    snapshot_vtable const* snapshot_registry::find_type(
+        std::string const& name) const
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        for (snapshot_vtable const* vt : types_)
+        {
+            if (get_component_type_name(vt->get_type()) == name)
+                return vt;
+        }
+        return nullptr;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void snapshot_registry::add(void* p, snapshot_vtable const* vt)
+    {
+        shard& s = get_shard(p);
+
+        std::lock_guard<mutex_type> l(s.mtx_);
+        s.instances_[p] = vt;
+    }
+
+    void snapshot_registry::remove(void* p)
+    {
+        shard& s = get_shard(p);
+
+        std::lock_guard<mutex_type> l(s.mtx_);
+        s.instances_.erase(p);
+    }
+
+    std::vector<snapshot_registry::instance_type>
+    snapshot_registry::acquire_all()
+    {
+        std::vector<instance_type> result;
+        for (shard& s : shards_)
+        {
+            std::lock_guard<mutex_type> l(s.mtx_);
+            result.reserve(result.size() + s.instances_.size());
+            for (auto const& inst : s.instances_)
+            {
+                inst.second->acquire(inst.first);
+                result.push_back(instance_type(inst.first, inst.second));
+            }
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void snapshot_registry::erased(naming::gid_type const& gid)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        erased_.push_back(gid);
+    }
+
+    std::vector<naming::gid_type> snapshot_registry::take_erased()
+    {
+        std::vector<naming::gid_type> result;
+
+        std::lock_guard<mutex_type> l(mtx_);
+        result.swap(erased_);
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t snapshot_registry::enter_action()
+    {
+        std::size_t const counter =
+            hpx::get_worker_thread_num() % num_gate_counters;
+        boost::atomic<std::int64_t>& active = gate_counters_[counter].active_;
+
+        for (std::size_t k = 0; /**/; ++k)
+        {
+            // announce the action before checking the gate, close_gate
+            // closes the gate before it looks at the counters
+            ++active;
+            if (!gate_closed_.load())
+                return counter;
+            --active;
+
+            util::detail::yield_k(k,
+                "hpx::components::detail::snapshot_registry::enter_action");
+        }
+    }
+
+    void snapshot_registry::close_gate()
+    {
+        // wait for concurrent snapshots to open the gate again
+        for (std::size_t k = 0; gate_closed_.exchange(true); ++k)
+        {
+            util::detail::yield_k(k,
+                "hpx::components::detail::snapshot_registry::close_gate");
+        }
+
+        for (gate_counter& c : gate_counters_)
+        {
+            for (std::size_t k = 0; c.active_.load() != 0; ++k)
+            {
+                util::detail::yield_k(k,
+                    "hpx::components::detail::snapshot_registry::close_gate");
+            }
+        }
+    }
+
+    void snapshot_registry::open_gate()
+    {
+        gate_closed_.store(false);
+    }
+}}}
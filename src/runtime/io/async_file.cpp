@@ -0,0 +1,318 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/io_fwd.hpp>
+
+#if !defined(HPX_WINDOWS)
+#include <hpx/compat/mutex.hpp>
+#include <hpx/error_code.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/io/async_file.hpp>
+#include <hpx/runtime/io/detail/io_backend.hpp>
+#include <hpx/runtime_fwd.hpp>
+#include <hpx/runtime/shutdown_function.hpp>
+#include <hpx/runtime/threads/thread.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/logging.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace io
+{
+    namespace detail
+    {
+        namespace
+        {
+            compat::mutex backend_mtx;
+            std::unique_ptr<io_backend> backend;
+
+            // the backend as seen by the background work, together with the
+            // number of threads currently polling it
+            boost::atomic<io_backend*> active_backend(nullptr);
+            boost::atomic<std::size_t> active_polls(0);
+
+            void destroy_io_backend()
+            {
+                std::unique_ptr<io_backend> b;
+                {
+                    std::lock_guard<compat::mutex> l(backend_mtx);
+                    b = std::move(backend);
+                }
+                if (!b)
+                    return;
+
+                // complete all operations while the runtime is still
+                // operational, operations started from now on fail
+                b->drain();
+
+                active_backend.store(nullptr);
+                while (active_polls.load() != 0)
+                    hpx::this_thread::yield();
+            }
+
+            std::unique_ptr<io_backend> create_io_backend()
+            {
+                std::string type =
+                    get_config_entry("hpx.io.backend", "auto");
+
+                if (type == "auto" || type == "io_uring")
+                {
+                    std::size_t queue_depth =
+                        util::safe_lexical_cast<std::size_t>(
+                            get_config_entry("hpx.io.queue_depth", 256), 256);
+
+                    std::unique_ptr<io_backend> result =
+                        create_io_uring_backend(queue_depth);
+                    if (result)
+                        return result;
+                }
+                else if (type != "thread_pool")
+                {
+                    HPX_THROW_EXCEPTION(bad_parameter,
+                        "hpx::io::detail::get_io_backend",
+                        "unknown asynchronous file I/O backend: " + type);
+                }
+
+                return create_thread_pool_backend();
+            }
+        }
+
+        io_backend& get_io_backend()
+        {
+            io_backend* b = active_backend.load(boost::memory_order_acquire);
+            if (b != nullptr)
+                return *b;
+
+            std::lock_guard<compat::mutex> l(backend_mtx);
+            if (!backend)
+            {
+                // the backend has been destroyed already, don't create a new
+                // one which would never be released
+                if (hpx::is_stopped_or_shutting_down())
+                {
+                    HPX_THROW_EXCEPTION(invalid_status,
+                        "hpx::io::detail::get_io_backend",
+                        "asynchronous file I/O is not available after the "
+                        "runtime has been shut down");
+                }
+
+                backend = create_io_backend();
+                LRT_(info) << "get_io_backend: using the '" << backend->name()
+                           << "' backend for asynchronous file I/O";
+
+                // the backend refers to the runtime, release it while the
+                // runtime is still operational
+                register_shutdown_function(&destroy_io_backend);
+                active_backend.store(backend.get());
+            }
+            return *backend;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool do_background_work(std::size_t)
+    {
+        if (detail::active_backend.load(boost::memory_order_relaxed) == nullptr)
+            return false;
+
+        ++detail::active_polls;
+        detail::io_backend* b = detail::active_backend.load();
+        bool result = b != nullptr && b->poll();
+        --detail::active_polls;
+
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    async_file::async_file()
+      : fd_(-1)
+    {}
+
+    async_file::async_file(std::string const& path, int mode, error_code& ec)
+      : fd_(-1)
+    {
+        open(path, mode, ec);
+    }
+
+    async_file::async_file(async_file && rhs)
+      : fd_(rhs.fd_)
+    {
+        rhs.fd_ = -1;
+    }
+
+    async_file& async_file::operator=(async_file && rhs)
+    {
+        if (this != &rhs)
+        {
+            close(throws);
+            fd_ = rhs.fd_;
+            rhs.fd_ = -1;
+        }
+        return *this;
+    }
+
+    async_file::~async_file()
+    {
+        error_code ec(lightweight);
+        close(ec);
+    }
+
+    void async_file::open(std::string const& path, int mode, error_code& ec)
+    {
+        if (is_open())
+        {
+            HPX_THROWS_IF(ec, invalid_status, "hpx::io::async_file::open",
+                "the file is already open");
+            return;
+        }
+
+        int flags = O_CLOEXEC;
+        switch (mode & mode_read_write)
+        {
+        case mode_read: flags |= O_RDONLY; break;
+        case mode_write: flags |= O_WRONLY; break;
+        case mode_read_write: flags |= O_RDWR; break;
+        default:
+            HPX_THROWS_IF(ec, bad_parameter, "hpx::io::async_file::open",
+                "the file has to be opened for reading and/or writing");
+            return;
+        }
+
+        if (mode & mode_create)
+            flags |= O_CREAT;
+        if (mode & mode_truncate)
+            flags |= O_TRUNC;
+#if defined(O_DIRECT)
+        if (mode & mode_direct)
+            flags |= O_DIRECT;
+#endif
+
+        int fd = ::open(path.c_str(), flags, 0644);
+        if (fd < 0)
+        {
+            HPX_THROWS_IF(ec, filesystem_error, "hpx::io::async_file::open",
+                "could not open '" + path + "': " + std::strerror(errno));
+            return;
+        }
+        fd_ = fd;
+
+        if (&ec != &throws)
+            ec = make_success_code();
+    }
+
+    void async_file::close(error_code& ec)
+    {
+        if (is_open())
+        {
+            int fd = fd_;
+            fd_ = -1;
+            if (::close(fd) != 0)
+            {
+                HPX_THROWS_IF(ec, filesystem_error,
+                    "hpx::io::async_file::close",
+                    std::string("closing the file failed: ") +
+                        std::strerror(errno));
+                return;
+            }
+        }
+
+        if (&ec != &throws)
+            ec = make_success_code();
+    }
+
+    std::uint64_t async_file::size(error_code& ec) const
+    {
+        struct stat st;
+        if (::fstat(fd_, &st) != 0)
+        {
+            HPX_THROWS_IF(ec, filesystem_error, "hpx::io::async_file::size",
+                std::string("querying the file size failed: ") +
+                    std::strerror(errno));
+            return 0;
+        }
+
+        if (&ec != &throws)
+            ec = make_success_code();
+        return static_cast<std::uint64_t>(st.st_size);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<std::size_t> async_file::read(
+        std::uint64_t offset, void* data, std::size_t size)
+    {
+        return detail::get_io_backend().read(fd_, offset, data, size);
+    }
+
+    hpx::future<std::size_t> async_file::write(
+        std::uint64_t offset, void const* data, std::size_t size)
+    {
+        return detail::get_io_backend().write(fd_, offset, data, size);
+    }
+
+    hpx::future<std::size_t> async_file::readv(
+        std::uint64_t offset, std::vector<mutable_buffer> buffers)
+    {
+        return detail::get_io_backend().readv(fd_, offset, std::move(buffers));
+    }
+
+    hpx::future<std::size_t> async_file::writev(
+        std::uint64_t offset, std::vector<const_buffer> buffers)
+    {
+        return detail::get_io_backend().writev(
+            fd_, offset, std::move(buffers));
+    }
+
+    hpx::future<void> async_file::fsync()
+    {
+        return detail::get_io_backend().fsync(fd_);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void register_buffers(
+        std::vector<mutable_buffer> const& buffers, error_code& ec)
+    {
+        detail::get_io_backend().register_buffers(buffers, ec);
+    }
+
+    void unregister_buffers(error_code& ec)
+    {
+        detail::get_io_backend().unregister_buffers(ec);
+    }
+
+    char const* get_backend_name()
+    {
+        return detail::get_io_backend().name();
+    }
+}}
+
+#else
+
+namespace hpx { namespace io
+{
+    bool do_background_work(std::size_t)
+    {
+        return false;
+    }
+}}
+
+#endif
@@ -0,0 +1,577 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if !defined(HPX_WINDOWS)
+#include <hpx/compat/thread.hpp>
+#include <hpx/error_code.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/promise.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/io/async_file.hpp>
+#include <hpx/runtime/io/detail/io_backend.hpp>
+#include <hpx/runtime/io/detail/io_uring.hpp>
+#include <hpx/runtime/threads/thread.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/logging.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(HPX_HAVE_IO_URING)
+namespace hpx { namespace io { namespace detail
+{
+    namespace
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // An operation which has been handed to the kernel (or which waits
+        // for a free submission queue entry), deletes itself on completion.
+        struct operation
+        {
+            virtual ~operation() {}
+
+            virtual void prepare(io_uring_sqe& sqe) = 0;
+            virtual void complete(int result) = 0;
+        };
+
+        // operations together with their result (or negative error number),
+        // those have to be completed while no lock is held
+        typedef std::vector<std::pair<operation*, int> > operation_results;
+
+        void complete(operation_results const& ops)
+        {
+            for (auto const& op : ops)
+                op.first->complete(op.second);
+        }
+
+        std::exception_ptr make_exception(int error, char const* function)
+        {
+            return HPX_GET_EXCEPTION(filesystem_error, function,
+                std::string("asynchronous file operation failed: ") +
+                    std::strerror(error));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        struct transfer_operation : operation
+        {
+            transfer_operation(std::uint8_t opcode, std::uint8_t fixed_opcode,
+                    int fd, std::uint64_t offset, std::vector<iovec> && iovecs,
+                    int buffer_index, char const* function)
+              : opcode_(opcode), fixed_opcode_(fixed_opcode)
+              , fd_(fd), offset_(offset), iovecs_(std::move(iovecs))
+              , buffer_index_(buffer_index), function_(function)
+            {}
+
+            void prepare(io_uring_sqe& sqe) override
+            {
+                sqe.fd = fd_;
+                sqe.off = offset_;
+                sqe.user_data = reinterpret_cast<std::uint64_t>(this);
+
+                if (buffer_index_ >= 0)
+                {
+                    // the buffer lies in a registered memory region
+                    sqe.opcode = fixed_opcode_;
+                    sqe.addr = reinterpret_cast<std::uint64_t>(
+                        iovecs_[0].iov_base);
+                    sqe.len = static_cast<std::uint32_t>(iovecs_[0].iov_len);
+                    sqe.buf_index = static_cast<std::uint16_t>(buffer_index_);
+                }
+                else
+                {
+                    sqe.opcode = opcode_;
+                    sqe.addr = reinterpret_cast<std::uint64_t>(iovecs_.data());
+                    sqe.len = static_cast<std::uint32_t>(iovecs_.size());
+                }
+            }
+
+            void complete(int result) override
+            {
+                if (result < 0)
+                    promise_.set_exception(make_exception(-result, function_));
+                else
+                    promise_.set_value(static_cast<std::size_t>(result));
+                delete this;
+            }
+
+            std::uint8_t opcode_;
+            std::uint8_t fixed_opcode_;
+            int fd_;
+            std::uint64_t offset_;
+            std::vector<iovec> iovecs_;
+            int buffer_index_;
+            char const* function_;
+            lcos::local::promise<std::size_t> promise_;
+        };
+
+        struct fsync_operation : operation
+        {
+            explicit fsync_operation(int fd)
+              : fd_(fd)
+            {}
+
+            void prepare(io_uring_sqe& sqe) override
+            {
+                sqe.opcode = IORING_OP_FSYNC;
+                sqe.fd = fd_;
+                sqe.user_data = reinterpret_cast<std::uint64_t>(this);
+            }
+
+            void complete(int result) override
+            {
+                if (result < 0)
+                {
+                    promise_.set_exception(make_exception(
+                        -result, "hpx::io::async_file::fsync"));
+                }
+                else
+                {
+                    promise_.set_value();
+                }
+                delete this;
+            }
+
+            int fd_;
+            lcos::local::promise<void> promise_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Hands all operations to the kernel using a single io_uring instance.
+    // Completions are handled by a dedicated OS thread waiting on the ring,
+    // and additionally by the worker threads as part of their background
+    // work, which avoids waking up the dedicated thread while the workers
+    // are busy.
+    class io_uring_backend : public io_backend
+    {
+        typedef lcos::local::spinlock mutex_type;
+
+    public:
+        io_uring_backend()
+          : in_flight_(0), draining_(false), resubmit_(false)
+          , stopping_(false), reaper_running_(false)
+        {}
+
+        ~io_uring_backend()
+        {
+            if (!reaper_.joinable())
+                return;
+
+            // wake up the reaper thread until it has noticed the request to
+            // exit (the wakeup might be consumed by the background work)
+            stopping_.store(true);
+            while (reaper_running_.load())
+            {
+                {
+                    std::lock_guard<mutex_type> l(submit_mtx_);
+                    if (io_uring_sqe* sqe = queue_.get_sqe())
+                    {
+                        sqe->opcode = IORING_OP_NOP;
+                        sqe->user_data = 0;
+                        queue_.submit();
+                    }
+                }
+                compat::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            reaper_.join();
+        }
+
+        int start(std::size_t queue_depth)
+        {
+            int result = queue_.open(static_cast<unsigned>(queue_depth));
+            if (result != 0)
+                return result;
+
+            reaper_running_.store(true);
+            reaper_ = compat::thread(&io_uring_backend::reap, this);
+            return 0;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        hpx::future<std::size_t> read(int fd, std::uint64_t offset,
+            void* data, std::size_t size) override
+        {
+            return submit_transfer(IORING_OP_READV, IORING_OP_READ_FIXED, fd,
+                offset, make_iovecs(mutable_buffer(data, size)), true,
+                "hpx::io::async_file::read");
+        }
+
+        hpx::future<std::size_t> write(int fd, std::uint64_t offset,
+            void const* data, std::size_t size) override
+        {
+            return submit_transfer(IORING_OP_WRITEV, IORING_OP_WRITE_FIXED, fd,
+                offset, make_iovecs(const_buffer(data, size)), true,
+                "hpx::io::async_file::write");
+        }
+
+        hpx::future<std::size_t> readv(int fd, std::uint64_t offset,
+            std::vector<mutable_buffer> && buffers) override
+        {
+            return submit_transfer(IORING_OP_READV, IORING_OP_READ_FIXED, fd,
+                offset, make_iovecs(buffers), buffers.size() == 1,
+                "hpx::io::async_file::readv");
+        }
+
+        hpx::future<std::size_t> writev(int fd, std::uint64_t offset,
+            std::vector<const_buffer> && buffers) override
+        {
+            return submit_transfer(IORING_OP_WRITEV, IORING_OP_WRITE_FIXED, fd,
+                offset, make_iovecs(buffers), buffers.size() == 1,
+                "hpx::io::async_file::writev");
+        }
+
+        hpx::future<void> fsync(int fd) override
+        {
+            fsync_operation* op = new fsync_operation(fd);
+            hpx::future<void> f = op->promise_.get_future();
+
+            operation_results failed;
+            {
+                std::lock_guard<mutex_type> l(submit_mtx_);
+                submit_locked(op, failed);
+            }
+            complete(failed);
+            return f;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void register_buffers(std::vector<mutable_buffer> const& buffers,
+            error_code& ec) override
+        {
+            std::vector<iovec> iovecs = make_iovecs(buffers);
+
+            std::lock_guard<mutex_type> l(submit_mtx_);
+            if (!registered_.empty())
+            {
+                queue_.unregister_buffers();
+                registered_.clear();
+            }
+
+            int result = queue_.register_buffers(
+                iovecs.data(), static_cast<unsigned>(iovecs.size()));
+            if (result != 0)
+            {
+                HPX_THROWS_IF(ec, filesystem_error,
+                    "hpx::io::register_buffers",
+                    std::string("registering the buffers failed: ") +
+                        std::strerror(result));
+                return;
+            }
+            registered_ = buffers;
+
+            if (&ec != &throws)
+                ec = make_success_code();
+        }
+
+        void unregister_buffers(error_code& ec) override
+        {
+            std::lock_guard<mutex_type> l(submit_mtx_);
+            if (!registered_.empty())
+            {
+                queue_.unregister_buffers();
+                registered_.clear();
+            }
+
+            if (&ec != &throws)
+                ec = make_success_code();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void drain() override
+        {
+            // fail all operations waiting for a submission queue entry
+            operation_results failed;
+            {
+                std::lock_guard<mutex_type> l(submit_mtx_);
+                draining_ = true;
+                for (operation* op : backlog_)
+                    failed.emplace_back(op, -ECANCELED);
+                backlog_.clear();
+            }
+            complete(failed);
+
+            // wait for the operations handed to the kernel
+            while (true)
+            {
+                failed.clear();
+                {
+                    std::lock_guard<mutex_type> l(submit_mtx_);
+                    if (queue_.unsubmitted() != 0)
+                        submit_entries_locked(failed);
+                    if (in_flight_ == 0 && failed.empty())
+                        break;
+                }
+                complete(failed);
+
+                poll();
+                hpx::this_thread::yield();
+            }
+        }
+
+        bool poll() override
+        {
+            // hand over entries the kernel could not accept before
+            if (resubmit_.load(boost::memory_order_relaxed))
+            {
+                operation_results failed;
+                {
+                    std::unique_lock<mutex_type> sl(
+                        submit_mtx_, std::try_to_lock);
+                    if (sl.owns_lock() && queue_.unsubmitted() != 0)
+                        submit_entries_locked(failed);
+                }
+                complete(failed);
+            }
+
+            // don't wait for another thread handling the completions
+            std::unique_lock<mutex_type> l(completion_mtx_, std::try_to_lock);
+            if (!l.owns_lock())
+                return false;
+
+            return handle_completions(l) != 0;
+        }
+
+        char const* name() const override
+        {
+            return "io_uring";
+        }
+
+    private:
+        template <typename Buffer>
+        static std::vector<iovec> make_iovecs(Buffer const& b)
+        {
+            std::vector<iovec> iovecs(1);
+            iovecs[0].iov_base = const_cast<void*>(
+                static_cast<void const*>(b.data_));
+            iovecs[0].iov_len = b.size_;
+            return iovecs;
+        }
+
+        template <typename Buffer>
+        static std::vector<iovec> make_iovecs(std::vector<Buffer> const& buffers)
+        {
+            std::vector<iovec> iovecs;
+            iovecs.reserve(buffers.size());
+            for (Buffer const& b : buffers)
+            {
+                iovec v;
+                v.iov_base = const_cast<void*>(
+                    static_cast<void const*>(b.data_));
+                v.iov_len = b.size_;
+                iovecs.push_back(v);
+            }
+            return iovecs;
+        }
+
+        // return the index of the registered region containing the given
+        // memory, or -1
+        int find_registered_buffer(iovec const& v) const
+        {
+            char const* begin = static_cast<char const*>(v.iov_base);
+            for (std::size_t i = 0; i != registered_.size(); ++i)
+            {
+                char const* region =
+                    static_cast<char const*>(registered_[i].data_);
+                if (begin >= region &&
+                    begin + v.iov_len <= region + registered_[i].size_)
+                {
+                    return static_cast<int>(i);
+                }
+            }
+            return -1;
+        }
+
+        hpx::future<std::size_t> submit_transfer(std::uint8_t opcode,
+            std::uint8_t fixed_opcode, int fd, std::uint64_t offset,
+            std::vector<iovec> && iovecs, bool may_use_fixed,
+            char const* function)
+        {
+            transfer_operation* op = new transfer_operation(opcode,
+                fixed_opcode, fd, offset, std::move(iovecs), -1, function);
+            hpx::future<std::size_t> f = op->promise_.get_future();
+
+            operation_results failed;
+            {
+                std::lock_guard<mutex_type> l(submit_mtx_);
+                if (may_use_fixed && !registered_.empty())
+                    op->buffer_index_ = find_registered_buffer(op->iovecs_[0]);
+                submit_locked(op, failed);
+            }
+            complete(failed);
+            return f;
+        }
+
+        void submit_locked(operation* op, operation_results& failed)
+        {
+            if (draining_)
+            {
+                failed.emplace_back(op, -ECANCELED);
+                return;
+            }
+
+            // Limit the number of operations in flight to the size of the
+            // submission queue, which guarantees that the completion queue
+            // (twice as large) never overflows.
+            io_uring_sqe* sqe = nullptr;
+            if (in_flight_ == queue_.capacity() ||
+                (sqe = queue_.get_sqe()) == nullptr)
+            {
+                backlog_.push_back(op);
+                return;
+            }
+
+            op->prepare(*sqe);
+            ++in_flight_;
+
+            submit_entries_locked(failed);
+        }
+
+        // Hand all prepared entries to the kernel. Entries the kernel could
+        // not accept for now are handed over again by the next submission or
+        // by the background work, all entries fail on any other error.
+        void submit_entries_locked(operation_results& failed)
+        {
+            int result = queue_.submit();
+            if (result >= 0 || result == -EAGAIN || result == -EBUSY)
+            {
+                resubmit_.store(queue_.unsubmitted() != 0,
+                    boost::memory_order_relaxed);
+                return;
+            }
+
+            LERR_(warning) << "io_uring_backend: submitting operations "
+                              "failed: " << std::strerror(-result);
+
+            queue_.discard(
+                [&](std::uint64_t user_data)
+                {
+                    // user_data is zero for wakeup requests
+                    if (user_data != 0)
+                    {
+                        --in_flight_;
+                        failed.emplace_back(
+                            reinterpret_cast<operation*>(user_data), result);
+                    }
+                });
+            resubmit_.store(false, boost::memory_order_relaxed);
+        }
+
+        // returns the number of completed operations
+        std::size_t handle_completions(std::unique_lock<mutex_type>& l)
+        {
+            operation_results done;
+            queue_.drain(
+                [&done](std::uint64_t user_data, int result)
+                {
+                    // user_data is zero for wakeup requests
+                    if (user_data != 0)
+                    {
+                        done.emplace_back(
+                            reinterpret_cast<operation*>(user_data), result);
+                    }
+                });
+            l.unlock();
+
+            if (done.empty())
+                return 0;
+
+            // submit waiting operations into the freed slots
+            operation_results failed;
+            {
+                std::lock_guard<mutex_type> sl(submit_mtx_);
+                in_flight_ -= static_cast<unsigned>(done.size());
+                while (!backlog_.empty() && in_flight_ != queue_.capacity())
+                {
+                    operation* op = backlog_.front();
+                    backlog_.pop_front();
+                    submit_locked(op, failed);
+                }
+            }
+
+            // make the futures ready outside of any lock, continuations
+            // might submit new operations
+            complete(done);
+            complete(failed);
+
+            return done.size();
+        }
+
+        void reap()
+        {
+            while (!stopping_.load())
+            {
+                int result = queue_.wait();
+                if (result < 0)
+                {
+                    LERR_(error) << "io_uring_backend: waiting for "
+                                    "completions failed: "
+                                 << std::strerror(-result);
+                    break;
+                }
+
+                std::unique_lock<mutex_type> l(completion_mtx_);
+                handle_completions(l);
+            }
+            reaper_running_.store(false);
+        }
+
+    private:
+        io_uring_queue queue_;
+
+        mutex_type submit_mtx_;         // protects the submission side
+        unsigned in_flight_;
+        std::deque<operation*> backlog_;
+        std::vector<mutable_buffer> registered_;
+        bool draining_;                 // no new operations are accepted
+        boost::atomic<bool> resubmit_;  // entries still have to be submitted
+
+        mutex_type completion_mtx_;     // protects the completion side
+
+        boost::atomic<bool> stopping_;
+        boost::atomic<bool> reaper_running_;
+        compat::thread reaper_;
+    };
+
+    std::unique_ptr<io_backend> create_io_uring_backend(
+        std::size_t queue_depth)
+    {
+        std::unique_ptr<io_uring_backend> backend(new io_uring_backend);
+
+        int result = backend->start(queue_depth);
+        if (result != 0)
+        {
+            LRT_(warning) << "io_uring_backend: io_uring is not available ("
+                          << std::strerror(result)
+                          << "), falling back to the thread pool backend";
+            return std::unique_ptr<io_backend>();
+        }
+        return backend;
+    }
+}}}
+
+#else
+
+namespace hpx { namespace io { namespace detail
+{
+    std::unique_ptr<io_backend> create_io_uring_backend(std::size_t)
+    {
+        return std::unique_ptr<io_backend>();
+    }
+}}}
+
+#endif
+#endif
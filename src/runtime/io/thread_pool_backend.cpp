@@ -0,0 +1,241 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if !defined(HPX_WINDOWS)
+#include <hpx/error_code.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/parallel/executors/execution.hpp>
+#include <hpx/parallel/executors/service_executors.hpp>
+#include <hpx/runtime/io/async_file.hpp>
+#include <hpx/runtime/io/detail/io_backend.hpp>
+#include <hpx/runtime/threads/thread.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace io { namespace detail
+{
+    namespace
+    {
+        std::size_t check_result(ssize_t result, char const* function)
+        {
+            if (result < 0)
+            {
+                HPX_THROW_EXCEPTION(filesystem_error, function,
+                    std::string("system call failed: ") +
+                        std::strerror(errno));
+            }
+            return static_cast<std::size_t>(result);
+        }
+
+        template <typename Buffers>
+        std::vector<iovec> make_iovecs(Buffers const& buffers)
+        {
+            std::vector<iovec> iovecs;
+            iovecs.reserve(buffers.size());
+            for (auto const& b : buffers)
+            {
+                iovec v;
+                v.iov_base = const_cast<void*>(
+                    static_cast<void const*>(b.data_));
+                v.iov_len = b.size_;
+                iovecs.push_back(v);
+            }
+            return iovecs;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Runs the blocking system calls on the IO pool, keeping the worker
+    // threads free to run HPX threads.
+    class thread_pool_backend : public io_backend
+    {
+    public:
+        thread_pool_backend()
+          : outstanding_(0), draining_(false)
+        {}
+
+        hpx::future<std::size_t> read(int fd, std::uint64_t offset,
+            void* data, std::size_t size) override
+        {
+            if (!start_operation())
+                return make_cancelled_future<std::size_t>();
+
+            return parallel::execution::async_execute(exec_,
+                [=]() -> std::size_t
+                {
+                    operation_scope scope(outstanding_);
+                    ssize_t result;
+                    do {
+                        result = ::pread(fd, data, size, offset);
+                    } while (result < 0 && errno == EINTR);
+                    return check_result(result, "hpx::io::async_file::read");
+                });
+        }
+
+        hpx::future<std::size_t> write(int fd, std::uint64_t offset,
+            void const* data, std::size_t size) override
+        {
+            if (!start_operation())
+                return make_cancelled_future<std::size_t>();
+
+            return parallel::execution::async_execute(exec_,
+                [=]() -> std::size_t
+                {
+                    operation_scope scope(outstanding_);
+                    ssize_t result;
+                    do {
+                        result = ::pwrite(fd, data, size, offset);
+                    } while (result < 0 && errno == EINTR);
+                    return check_result(result, "hpx::io::async_file::write");
+                });
+        }
+
+        hpx::future<std::size_t> readv(int fd, std::uint64_t offset,
+            std::vector<mutable_buffer> && buffers) override
+        {
+            if (!start_operation())
+                return make_cancelled_future<std::size_t>();
+
+            return parallel::execution::async_execute(exec_,
+                [this, fd, offset](std::vector<iovec> const& iovecs)
+                ->  std::size_t
+                {
+                    operation_scope scope(outstanding_);
+                    ssize_t result;
+                    do {
+                        result = ::preadv(fd, iovecs.data(),
+                            static_cast<int>(iovecs.size()), offset);
+                    } while (result < 0 && errno == EINTR);
+                    return check_result(result, "hpx::io::async_file::readv");
+                },
+                make_iovecs(buffers));
+        }
+
+        hpx::future<std::size_t> writev(int fd, std::uint64_t offset,
+            std::vector<const_buffer> && buffers) override
+        {
+            if (!start_operation())
+                return make_cancelled_future<std::size_t>();
+
+            return parallel::execution::async_execute(exec_,
+                [this, fd, offset](std::vector<iovec> const& iovecs)
+                ->  std::size_t
+                {
+                    operation_scope scope(outstanding_);
+                    ssize_t result;
+                    do {
+                        result = ::pwritev(fd, iovecs.data(),
+                            static_cast<int>(iovecs.size()), offset);
+                    } while (result < 0 && errno == EINTR);
+                    return check_result(result, "hpx::io::async_file::writev");
+                },
+                make_iovecs(buffers));
+        }
+
+        hpx::future<void> fsync(int fd) override
+        {
+            if (!start_operation())
+                return make_cancelled_future<void>();
+
+            return parallel::execution::async_execute(exec_,
+                [this, fd]()
+                {
+                    operation_scope scope(outstanding_);
+                    check_result(::fsync(fd), "hpx::io::async_file::fsync");
+                });
+        }
+
+        // the system calls operate on the user buffers directly
+        void register_buffers(std::vector<mutable_buffer> const&,
+            error_code& ec) override
+        {
+            if (&ec != &throws)
+                ec = make_success_code();
+        }
+
+        void unregister_buffers(error_code& ec) override
+        {
+            if (&ec != &throws)
+                ec = make_success_code();
+        }
+
+        void drain() override
+        {
+            draining_.store(true);
+            while (outstanding_.load() != 0)
+                hpx::this_thread::yield();
+        }
+
+        char const* name() const override
+        {
+            return "thread_pool";
+        }
+
+    private:
+        // marks the end of an operation once it has been executed
+        struct operation_scope
+        {
+            explicit operation_scope(boost::atomic<std::size_t>& outstanding)
+              : outstanding_(outstanding)
+            {}
+
+            ~operation_scope()
+            {
+                --outstanding_;
+            }
+
+            boost::atomic<std::size_t>& outstanding_;
+        };
+
+        // returns false if no new operations are accepted anymore
+        bool start_operation()
+        {
+            ++outstanding_;
+            if (draining_.load())
+            {
+                --outstanding_;
+                return false;
+            }
+            return true;
+        }
+
+        template <typename T>
+        static hpx::future<T> make_cancelled_future()
+        {
+            return hpx::make_exceptional_future<T>(
+                HPX_GET_EXCEPTION(filesystem_error,
+                    "hpx::io::async_file",
+                    "asynchronous file I/O has been shut down"));
+        }
+
+    private:
+        parallel::execution::io_pool_executor exec_;
+        boost::atomic<std::size_t> outstanding_;
+        boost::atomic<bool> draining_;
+    };
+
+    std::unique_ptr<io_backend> create_thread_pool_backend()
+    {
+        return std::unique_ptr<io_backend>(new thread_pool_backend);
+    }
+}}}
+
+#endif
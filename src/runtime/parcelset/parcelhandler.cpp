@@ -14,6 +14,7 @@
 #include <hpx/performance_counters/counter_creators.hpp>
 #include <hpx/performance_counters/counters.hpp>
 #include <hpx/performance_counters/manage_counter_type.hpp>
+#include <hpx/runtime/actions/base_action.hpp>
 #include <hpx/runtime/actions/continuation.hpp>
 #include <hpx/runtime/applier/applier.hpp>
 #include <hpx/runtime/config_entry.hpp>
@@ -34,6 +35,7 @@
 #include <hpx/util/logging.hpp>
 #include <hpx/util/runtime_configuration.hpp>
 #include <hpx/util/safe_lexical_cast.hpp>
+#include <hpx/util/tracing.hpp>
 #include <hpx/util/unlock_guard.hpp>
 
 #include <hpx/plugins/parcelport_factory_base.hpp>
@@ -470,6 +472,13 @@ namespace hpx { namespace parcelset
         // properly initialize parcel
         init_parcel(p);
 
+        if (HPX_UNLIKELY(util::tracing::enabled()))
+        {
+            util::tracing::record_parcel_send(
+                p.get_action()->get_action_name(),
+                p.destination_locality_id());
+        }
+
         bool resolved_locally = true;
 
         if (!addr)
@@ -1588,6 +1597,10 @@ namespace hpx { namespace parcelset
                 "$[hpx.parcel.array_optimization]}",
             "enable_security = ${HPX_PARCEL_ENABLE_SECURITY:0}",
             "async_serialization = ${HPX_PARCEL_ASYNC_SERIALIZATION:1}",
+            "adaptive_direct_execution = "
+                "${HPX_PARCEL_ADAPTIVE_DIRECT_EXECUTION:0}",
+            "direct_execution_threshold = "
+                "${HPX_PARCEL_DIRECT_EXECUTION_THRESHOLD:5000}",
 #if defined(HPX_HAVE_PARCEL_COALESCING)
             "message_handlers = ${HPX_PARCEL_MESSAGE_HANDLERS:1}"
 #else
@@ -15,6 +15,7 @@
 
 #include <boost/atomic.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <iosfwd>
 #include <stdexcept>
@@ -59,6 +60,9 @@ namespace hpx { namespace resource { namespace detail
         : pool_name_(name)
         , scheduling_policy_(sched)
         , num_threads_(0)
+        , elastic_(false)
+        , min_threads_(0)
+        , max_threads_(std::size_t(-1))
     {
         if (name.empty())
         {
@@ -73,6 +77,9 @@ namespace hpx { namespace resource { namespace detail
         , scheduling_policy_(user_defined)
         , num_threads_(0)
         , create_function_(std::move(create_func))
+        , elastic_(false)
+        , min_threads_(0)
+        , max_threads_(std::size_t(-1))
     {
         if (name.empty())
         {
@@ -156,6 +163,9 @@ namespace hpx { namespace resource { namespace detail
         case resource::throttle:
             sched = "throttle";
             break;
+        case resource::deadline:
+            sched = "deadline";
+            break;
         }
 
         os << "\"" << sched << "\" is running on PUs : \n";
@@ -198,6 +208,17 @@ namespace hpx { namespace resource { namespace detail
         return util::get<2>(assigned_pu_nums_[virt_core]);
     }
 
+    std::size_t init_pool_data::num_assigned_pus() const
+    {
+        std::size_t count = 0;
+        for (auto const& pu_num : assigned_pu_nums_)
+        {
+            if (util::get<2>(pu_num))
+                ++count;
+        }
+        return count;
+    }
+
     // 'shift' all thread assignments up by the first_core offset
     void init_pool_data::assign_first_core(std::size_t first_core)
     {
@@ -433,6 +454,10 @@ namespace hpx { namespace resource { namespace detail
         {
             default_scheduler = scheduling_policy::throttle;
         }
+        else if (0 == std::string("deadline").find(cfg_.queuing_))
+        {
+            default_scheduler = scheduling_policy::deadline;
+        }
         else
         {
             throw hpx::detail::command_line_error(
@@ -1029,6 +1054,166 @@ namespace hpx { namespace resource { namespace detail
         return pu_nums_to_add.size();
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    void partitioner::set_elastic_bounds(std::string const& pool_name,
+        std::size_t min_threads, std::size_t max_threads)
+    {
+        if (get_runtime_ptr() != nullptr)
+        {
+            HPX_THROW_EXCEPTION(invalid_status,
+                "partitioner::set_elastic_bounds",
+                "this function must be called before the runtime system has "
+                "been started");
+        }
+
+        if (!(mode_ & mode_allow_dynamic_pools))
+        {
+            throw std::invalid_argument(
+                "partitioner::set_elastic_bounds: dynamic pools have not been "
+                "enabled for this partitioner");
+        }
+
+        if (min_threads == 0 || min_threads > max_threads)
+        {
+            throw std::invalid_argument(
+                "partitioner::set_elastic_bounds: the minimal number of "
+                "threads of pool '" + pool_name + "' must be non-zero and "
+                "must not exceed the maximal number of threads");
+        }
+
+        std::lock_guard<mutex_type> l(mtx_);
+        detail::init_pool_data& data = get_pool_data(pool_name);
+
+        data.elastic_ = true;
+        data.min_threads_ = min_threads;
+        data.max_threads_ = max_threads;
+    }
+
+    bool partitioner::is_elastic(std::string const& pool_name) const
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        return get_pool_data(pool_name).elastic_;
+    }
+
+    std::size_t partitioner::get_num_assigned_pus(
+        std::string const& pool_name) const
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        return get_pool_data(pool_name).num_assigned_pus();
+    }
+
+    // Move one processing unit which is shared between the two given pools
+    // from the first to the second one, returns false if no such processing
+    // unit exists or if moving it would violate the bounds of either pool.
+    bool partitioner::move_pu(
+        std::string const& from_pool, std::string const& to_pool,
+        util::function_nonser<void(std::size_t)> const& remove_pu,
+        util::function_nonser<void(std::size_t)> const& add_pu)
+    {
+        std::size_t from_core = std::size_t(-1);
+        std::size_t to_core = std::size_t(-1);
+
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            detail::init_pool_data const& from = get_pool_data(from_pool);
+            detail::init_pool_data const& to = get_pool_data(to_pool);
+
+            std::size_t from_count = from.num_assigned_pus();
+            std::size_t to_count = to.num_assigned_pus();
+            if (from_count <= from.min_threads_ || from_count <= 1 ||
+                to_count >= to.max_threads_)
+            {
+                return false;
+            }
+
+            for (std::size_t i = 0;
+                 i != from.num_threads_ && from_core == std::size_t(-1); ++i)
+            {
+                auto const& f = from.assigned_pu_nums_[i];
+                if (util::get<1>(f) || !util::get<2>(f))
+                    continue;
+
+                for (std::size_t j = 0; j != to.num_threads_; ++j)
+                {
+                    auto const& t = to.assigned_pu_nums_[j];
+                    if (!util::get<1>(t) && !util::get<2>(t) &&
+                        util::get<0>(t) == util::get<0>(f))
+                    {
+                        from_core = i;
+                        to_core = j;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (from_core == std::size_t(-1))
+            return false;
+
+        remove_pu(from_core);
+        add_pu(to_core);
+
+        return true;
+    }
+
+    // Stop all threads of the given pool running on processing units which
+    // are currently used by any other pool, as long as the pool keeps its
+    // minimal number of threads.
+    std::size_t partitioner::release_shared_pus(std::string const& pool_name,
+        util::function_nonser<void(std::size_t)> const& remove_pu)
+    {
+        std::vector<std::size_t> pu_nums_to_remove;
+
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            detail::init_pool_data const& data = get_pool_data(pool_name);
+
+            std::size_t count = data.num_assigned_pus();
+            std::size_t min_threads = (std::max)(data.min_threads_,
+                std::size_t(1));
+
+            for (std::size_t i = 0;
+                 i != data.num_threads_ && count > min_threads; ++i)
+            {
+                auto const& p = data.assigned_pu_nums_[i];
+                if (util::get<1>(p) || !util::get<2>(p))
+                    continue;
+
+                for (detail::init_pool_data const& other :
+                     initial_thread_pools_)
+                {
+                    if (&other == &data)
+                        continue;
+
+                    bool shared = false;
+                    for (auto const& o : other.assigned_pu_nums_)
+                    {
+                        if (util::get<2>(o) &&
+                            util::get<0>(o) == util::get<0>(p))
+                        {
+                            shared = true;
+                            break;
+                        }
+                    }
+
+                    if (shared)
+                    {
+                        pu_nums_to_remove.push_back(i);
+                        --count;
+                        break;
+                    }
+                }
+            }
+        }
+
+        for (std::size_t pu_num : pu_nums_to_remove)
+        {
+            remove_pu(pu_num);
+        }
+
+        return pu_nums_to_remove.size();
+    }
+
     ////////////////////////////////////////////////////////////////////////
     std::size_t partitioner::get_pool_index(
         std::string const& pool_name) const
@@ -236,6 +236,12 @@ namespace hpx { namespace resource
         partitioner_.add_resource(ndv, pool_name, exclusive);
     }
 
+    void partitioner::set_elastic_bounds(std::string const& pool_name,
+        std::size_t min_threads, std::size_t max_threads)
+    {
+        partitioner_.set_elastic_bounds(pool_name, min_threads, max_threads);
+    }
+
     std::vector<numa_domain> const& partitioner::numa_domains() const
     {
         return partitioner_.numa_domains();
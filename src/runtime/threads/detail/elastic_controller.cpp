@@ -0,0 +1,179 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/compat/thread.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/resource/detail/partitioner.hpp>
+#include <hpx/runtime/threads/detail/elastic_controller.hpp>
+#include <hpx/runtime/threads/detail/thread_pool_base.hpp>
+#include <hpx/runtime/threads/run_as_os_thread.hpp>
+#include <hpx/runtime/threads/threadmanager.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/logging.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <string>
+
+namespace hpx { namespace threads { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    elastic_controller::elastic_controller(threadmanager& tm)
+      : tm_(tm),
+        hysteresis_(util::safe_lexical_cast<std::size_t>(
+            get_config_entry("hpx.elastic_pools.hysteresis", 3), 3)),
+        utilization_threshold_(util::safe_lexical_cast<std::int64_t>(
+            get_config_entry("hpx.elastic_pools.utilization", 50), 50)),
+        queue_threshold_(util::safe_lexical_cast<std::int64_t>(
+            get_config_entry("hpx.elastic_pools.queue_length", 2), 2)),
+        released_(false),
+        evaluating_(false),
+        timer_(util::bind(&elastic_controller::on_timer, this),
+            std::int64_t(1000) * util::safe_lexical_cast<std::int64_t>(
+                get_config_entry("hpx.elastic_pools.interval", 100), 100),
+            "elastic_controller", true)
+    {
+        auto& rp = resource::get_partitioner();
+        for (std::size_t i = 0; i != rp.get_num_pools(); ++i)
+        {
+            std::string const& name = rp.get_pool_name(i);
+            if (rp.is_elastic(name))
+                pools_.push_back(pool_state{name, 0, 0, 0});
+        }
+    }
+
+    elastic_controller::~elastic_controller()
+    {
+        stop();
+    }
+
+    void elastic_controller::start()
+    {
+        if (pools_.size() >= 2)
+            timer_.start(false);
+    }
+
+    void elastic_controller::stop()
+    {
+        timer_.stop();
+
+        // wait for a running evaluation to finish
+        while (evaluating_.load())
+            compat::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    bool elastic_controller::on_timer()
+    {
+        // Moving processing units joins the OS thread running on it, which
+        // must not be the one executing this HPX thread.
+        bool expected = false;
+        if (evaluating_.compare_exchange_strong(expected, true))
+        {
+            threads::run_as_os_thread(
+                [this]()
+                {
+                    try
+                    {
+                        evaluate();
+                    }
+                    catch (std::exception const& e)
+                    {
+                        LTM_(error)
+                            << "elastic_controller: failed to rebalance "
+                               "thread pools: " << e.what();
+                    }
+                    evaluating_.store(false);
+                });
+        }
+        return true;    // keep the timer running
+    }
+
+    bool elastic_controller::evaluate()
+    {
+        auto& rp = resource::get_partitioner();
+
+        if (!released_)
+        {
+            // All pools start out running on all of their processing units.
+            // Let the pools defined first keep the processing units they
+            // share with pools defined later.
+            for (auto it = pools_.rbegin(); it != pools_.rend(); ++it)
+            {
+                std::string const& name = it->name_;
+                rp.release_shared_pus(name,
+                    [this, &name](std::size_t virt_core)
+                    {
+                        tm_.get_pool(name).remove_processing_unit(virt_core);
+                    });
+            }
+            released_ = true;
+        }
+
+        pool_state* donor = nullptr;
+        pool_state* receiver = nullptr;
+        std::int64_t receiver_queue_length = 0;
+
+        for (pool_state& p : pools_)
+        {
+            thread_pool_base& pool = tm_.get_pool(p.name_);
+
+            std::int64_t active = static_cast<std::int64_t>(
+                rp.get_num_assigned_pus(p.name_));
+            std::int64_t queue_length =
+                pool.get_queue_length(std::size_t(-1), false);
+
+            // exponential moving average over the instantaneous utilization
+            p.utilization_ =
+                (p.utilization_ + pool.get_scheduler_utilization()) / 2;
+
+            if (p.utilization_ >= utilization_threshold_ &&
+                queue_length > queue_threshold_ * active)
+            {
+                ++p.overloaded_;
+                p.underutilized_ = 0;
+            }
+            else if (p.utilization_ < utilization_threshold_ &&
+                queue_length <= active)
+            {
+                ++p.underutilized_;
+                p.overloaded_ = 0;
+            }
+            else
+            {
+                p.overloaded_ = 0;
+                p.underutilized_ = 0;
+            }
+
+            if (p.overloaded_ >= hysteresis_ &&
+                (receiver == nullptr || queue_length > receiver_queue_length))
+            {
+                receiver = &p;
+                receiver_queue_length = queue_length;
+            }
+            else if (p.underutilized_ >= hysteresis_ &&
+                (donor == nullptr || p.utilization_ < donor->utilization_))
+            {
+                donor = &p;
+            }
+        }
+
+        if (donor == nullptr || receiver == nullptr ||
+            !tm_.move_processing_unit(donor->name_, receiver->name_))
+        {
+            return false;
+        }
+
+        LTM_(info) << "elastic_controller: moved a processing unit from pool '"
+                   << donor->name_ << "' to pool '" << receiver->name_ << "'";
+
+        donor->underutilized_ = 0;
+        receiver->overloaded_ = 0;
+        return true;
+    }
+}}}
@@ -0,0 +1,157 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/runtime/threads/executors/deadline_executor.hpp>
+
+#include <hpx/error_code.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
+#include <hpx/runtime/threads/thread_enums.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/runtime/threads/thread_init_data.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/register_locks.hpp>
+#include <hpx/util/steady_clock.hpp>
+#include <hpx/util/thread_description.hpp>
+#include <hpx/util/unique_function.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace hpx { namespace threads { namespace executors { namespace detail
+{
+    namespace
+    {
+        threads::thread_result_type thread_function_nullary(
+            util::unique_function_nonser<void()> func)
+        {
+            func();
+
+            // Verify that there are no more registered locks for this
+            // OS-thread. This will throw if there are still any locks
+            // held.
+            util::force_error_on_lock();
+
+            return threads::thread_result_type(threads::terminated, nullptr);
+        }
+    }
+
+    deadline_executor::deadline_executor(
+            util::steady_clock::duration const& budget,
+            thread_priority priority, thread_stacksize stacksize,
+            std::size_t os_thread)
+      : budget_(std::uint64_t(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                budget).count())),
+        stacksize_(stacksize),
+        priority_(priority),
+        os_thread_(os_thread)
+    {}
+
+    threads::thread_id_type deadline_executor::register_thread(
+        closure_type&& f, util::thread_description const& desc,
+        threads::thread_state_enum initial_state, bool run_now,
+        threads::thread_stacksize stacksize, std::uint64_t deadline,
+        error_code& ec)
+    {
+        if (stacksize == threads::thread_stacksize_default)
+            stacksize = stacksize_;
+
+        util::thread_description d =
+            desc ? desc : util::thread_description(f, "deadline_executor");
+
+        threads::thread_init_data data(
+            util::bind(util::one_shot(&thread_function_nullary), std::move(f)),
+            d, 0, priority_, os_thread_, threads::get_stack_size(stacksize));
+        data.deadline = deadline;
+
+        return register_thread_plain(data, initial_state, run_now, ec);
+    }
+
+    // Schedule the specified function for execution in this executor.
+    // Depending on the subclass implementation, this may block in some
+    // situations.
+    void deadline_executor::add(closure_type&& f,
+        util::thread_description const& desc,
+        threads::thread_state_enum initial_state,
+        bool run_now, threads::thread_stacksize stacksize, error_code& ec)
+    {
+        register_thread(std::move(f), desc, initial_state, run_now, stacksize,
+            util::high_resolution_clock::now() + budget_, ec);
+    }
+
+    // Schedule given function for execution in this executor no sooner
+    // than time abs_time. This call never blocks, and may violate
+    // bounds on the executor's queue size.
+    void deadline_executor::add_at(
+        util::steady_clock::time_point const& abs_time,
+        closure_type&& f, util::thread_description const& description,
+        threads::thread_stacksize stacksize, error_code& ec)
+    {
+        // the budget starts running once the thread is due
+        std::int64_t delay =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                abs_time - util::steady_clock::now()).count();
+        std::uint64_t deadline = util::high_resolution_clock::now() + budget_;
+        if (delay > 0)
+            deadline += std::uint64_t(delay);
+
+        // create new thread
+        thread_id_type id = register_thread(std::move(f), description,
+            suspended, false, stacksize, deadline, ec);
+        if (ec) return;
+
+        HPX_ASSERT(invalid_thread_id != id);    // would throw otherwise
+
+        // now schedule new thread for execution
+        set_thread_state(id, abs_time);
+    }
+
+    // Return an estimate of the number of waiting tasks.
+    std::uint64_t deadline_executor::num_pending_closures(error_code& ec) const
+    {
+        if (&ec != &throws)
+            ec = make_success_code();
+
+        return get_thread_count() - get_thread_count(terminated);
+    }
+
+    // Reset internal (round robin) thread distribution scheme
+    void deadline_executor::reset_thread_distribution()
+    {
+        threads::reset_thread_distribution();
+    }
+
+    // Set the new scheduler mode
+    void deadline_executor::set_scheduler_mode(
+        threads::policies::scheduler_mode mode)
+    {
+        threads::set_scheduler_mode(mode);
+    }
+
+    // Return the requested policy element
+    std::size_t deadline_executor::get_policy_element(
+        threads::detail::executor_parameter p, error_code& ec) const
+    {
+        switch(p) {
+        case threads::detail::min_concurrency:
+        case threads::detail::max_concurrency:
+        case threads::detail::current_concurrency:
+            return hpx::get_os_thread_count();
+
+        default:
+            break;
+        }
+
+        HPX_THROWS_IF(ec, bad_parameter,
+            "deadline_executor::get_policy_element",
+            "requested value of invalid policy element");
+        return std::size_t(-1);
+    }
+}}}}
@@ -0,0 +1,193 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/error_code.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/performance_counters/counters.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/runtime/threads/policies/deadline_statistics.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/function.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/atomic.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hpx { namespace threads { namespace policies
+{
+    namespace
+    {
+        typedef lcos::local::spinlock mutex_type;
+
+        boost::atomic<std::int64_t> deadlines_met(0);
+        boost::atomic<std::int64_t> deadlines_missed(0);
+
+        ///////////////////////////////////////////////////////////////////////
+        // Collects the lateness of the threads which missed their deadline,
+        // one instance per histogram counter.
+        struct lateness_histogram
+        {
+            lateness_histogram(std::int64_t min_boundary,
+                    std::int64_t max_boundary, std::int64_t num_buckets)
+              : min_boundary_(min_boundary), max_boundary_(max_boundary),
+                counts_(std::size_t(num_buckets), 0)
+            {}
+
+            void add(std::int64_t lateness)
+            {
+                std::size_t bucket = 0;
+                if (lateness >= max_boundary_)
+                {
+                    bucket = counts_.size() - 1;
+                }
+                else if (lateness > min_boundary_)
+                {
+                    bucket = std::size_t(
+                        (lateness - min_boundary_) * std::int64_t(counts_.size()) /
+                            (max_boundary_ - min_boundary_));
+                }
+                ++counts_[bucket];
+            }
+
+            // Return the histogram parameters followed by the relative
+            // frequencies of all buckets (in 1/1000).
+            std::vector<std::int64_t> get(bool reset)
+            {
+                std::vector<std::int64_t> result;
+                result.reserve(counts_.size() + 3);
+
+                result.push_back(min_boundary_);
+                result.push_back(max_boundary_);
+                result.push_back(std::int64_t(counts_.size()));
+
+                std::int64_t total = 0;
+                for (std::int64_t count : counts_)
+                    total += count;
+
+                for (std::int64_t& count : counts_)
+                {
+                    result.push_back(total == 0 ? 0 : count * 1000 / total);
+                    if (reset)
+                        count = 0;
+                }
+                return result;
+            }
+
+            std::int64_t const min_boundary_;
+            std::int64_t const max_boundary_;
+            std::vector<std::int64_t> counts_;
+        };
+
+        mutex_type histograms_mtx;
+        std::vector<std::shared_ptr<lateness_histogram> > histograms;
+        boost::atomic<bool> have_histograms(false);
+
+        std::vector<std::int64_t> get_lateness_histogram(
+            std::shared_ptr<lateness_histogram> const& h, bool reset)
+        {
+            std::lock_guard<mutex_type> l(histograms_mtx);
+            return h->get(reset);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void record_deadline(std::int64_t lateness)
+    {
+        if (lateness <= 0)
+        {
+            deadlines_met.fetch_add(1, boost::memory_order_relaxed);
+            return;
+        }
+
+        deadlines_missed.fetch_add(1, boost::memory_order_relaxed);
+
+        if (have_histograms.load(boost::memory_order_relaxed))
+        {
+            std::lock_guard<mutex_type> l(histograms_mtx);
+            for (auto const& h : histograms)
+                h->add(lateness);
+        }
+    }
+
+    std::int64_t get_deadline_count(bool missed, bool reset)
+    {
+        boost::atomic<std::int64_t>& count =
+            missed ? deadlines_missed : deadlines_met;
+        return reset ? count.exchange(0) : count.load();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    naming::gid_type deadline_lateness_histogram_counter_creator(
+        performance_counters::counter_info const& info, error_code& ec)
+    {
+        if (info.type_ != performance_counters::counter_histogram)
+        {
+            HPX_THROWS_IF(ec, bad_parameter,
+                "deadline_lateness_histogram_counter_creator",
+                "invalid counter type requested");
+            return naming::invalid_gid;
+        }
+
+        performance_counters::counter_path_elements paths;
+        performance_counters::get_counter_path_elements(
+            info.fullname_, paths, ec);
+        if (ec) return naming::invalid_gid;
+
+        std::int64_t min_boundary = 0;
+        std::int64_t max_boundary = 1000000;  // 1ms
+        std::int64_t num_buckets = 20;
+
+        if (!paths.parameters_.empty())
+        {
+            std::vector<std::string> params;
+            boost::algorithm::split(params, paths.parameters_,
+                boost::algorithm::is_any_of(","),
+                boost::algorithm::token_compress_off);
+
+            if (params.size() > 0 && !params[0].empty())
+                min_boundary = util::safe_lexical_cast<std::int64_t>(params[0]);
+            if (params.size() > 1 && !params[1].empty())
+                max_boundary = util::safe_lexical_cast<std::int64_t>(params[1]);
+            if (params.size() > 2 && !params[2].empty())
+                num_buckets = util::safe_lexical_cast<std::int64_t>(params[2]);
+        }
+
+        if (max_boundary <= min_boundary || num_buckets <= 0)
+        {
+            HPX_THROWS_IF(ec, bad_parameter,
+                "deadline_lateness_histogram_counter_creator",
+                "invalid counter parameter for deadline-lateness-histogram: "
+                "expected <min>,<max>,<buckets> with min < max and "
+                "buckets > 0");
+            return naming::invalid_gid;
+        }
+
+        std::shared_ptr<lateness_histogram> h =
+            std::make_shared<lateness_histogram>(
+                min_boundary, max_boundary, num_buckets);
+        {
+            std::lock_guard<mutex_type> l(histograms_mtx);
+            histograms.push_back(h);
+            have_histograms.store(true);
+        }
+
+        using util::placeholders::_1;
+        return performance_counters::detail::create_raw_counter(info,
+            util::function_nonser<std::vector<std::int64_t>(bool)>(
+                util::bind(&get_lateness_histogram, h, _1)),
+            ec);
+    }
+}}}
@@ -10,6 +10,7 @@
 #include <hpx/config.hpp>
 #include <hpx/compat/mutex.hpp>
 #include <hpx/exception.hpp>
+#include <hpx/lcos/detail/continuation_placement.hpp>
 #include <hpx/performance_counters/counter_creators.hpp>
 #include <hpx/performance_counters/counters.hpp>
 #include <hpx/performance_counters/manage_counter_type.hpp>
@@ -19,6 +20,7 @@
 #include <hpx/runtime/threads/detail/scheduled_thread_pool.hpp>
 #include <hpx/runtime/threads/detail/set_thread_state.hpp>
 #include <hpx/runtime/threads/executors/current_executor.hpp>
+#include <hpx/runtime/threads/policies/deadline_statistics.hpp>
 #include <hpx/runtime/threads/policies/schedulers.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
 #include <hpx/runtime/threads/thread_helpers.hpp>
@@ -709,6 +711,50 @@ namespace hpx { namespace threads
                 break;
             }
 
+            case resource::deadline:
+            {
+#if defined(HPX_HAVE_DEADLINE_SCHEDULER)
+                // set parameters for scheduler and pool instantiation and
+                // perform compatibility checks
+                hpx::detail::ensure_hierarchy_arity_compatibility(cfg_.vm_);
+                std::size_t num_high_priority_queues =
+                    hpx::detail::get_num_high_priority_queues(
+                        cfg_, rp.get_num_threads(name));
+                std::string affinity_desc;
+                std::size_t numa_sensitive =
+                    hpx::detail::get_affinity_description(cfg_, affinity_desc);
+
+                // instantiate the scheduler
+                typedef hpx::threads::policies::deadline_queue_scheduler<>
+                    local_sched_type;
+                local_sched_type::init_parameter_type init(num_threads_in_pool,
+                    num_high_priority_queues, 1000, numa_sensitive,
+                    "core-deadline_queue_scheduler");
+                std::unique_ptr<local_sched_type> sched(
+                    new local_sched_type(init));
+
+                // instantiate the pool
+                std::unique_ptr<detail::thread_pool_base> pool(
+                    new hpx::threads::detail::scheduled_thread_pool<
+                            local_sched_type
+                        >(std::move(sched),
+                        notifier_, i, name.c_str(),
+                        policies::scheduler_mode(policies::do_background_work |
+                            policies::reduce_thread_priority |
+                            policies::delay_exit),
+                        thread_offset));
+                pools_.push_back(std::move(pool));
+
+#else
+                throw detail::command_line_error(
+                    "Command line option "
+                    "--hpx:queuing=deadline "
+                    "is not configured in this build. Please rebuild with "
+                    "'cmake -DHPX_WITH_THREAD_SCHEDULERS=deadline'.");
+#endif
+                break;
+            }
+
             case resource::throttle:
             {
 #if !defined(HPX_HAVE_THROTTLING_SCHEDULER)
@@ -1456,6 +1502,29 @@ namespace hpx { namespace threads
                 util::bind(&coroutine_type::impl_type::get_allocation_count,
                     static_cast<std::size_t>(paths.instanceindex_), _1),
                 "allocator", HPX_COROUTINE_NUM_ALL_HEAPS},
+            // /threads{locality#%d/total}/count/continuations/inline
+            {"count/continuations/inline",
+                util::bind(&lcos::detail::get_continuation_count,
+                    lcos::detail::continuation_inline, _1),
+                util::function_nonser<std::uint64_t(bool)>(), "", 0},
+            // /threads{locality#%d/total}/count/continuations/local
+            {"count/continuations/local",
+                util::bind(&lcos::detail::get_continuation_count,
+                    lcos::detail::continuation_local, _1),
+                util::function_nonser<std::uint64_t(bool)>(), "", 0},
+            // /threads{locality#%d/total}/count/continuations/remote
+            {"count/continuations/remote",
+                util::bind(&lcos::detail::get_continuation_count,
+                    lcos::detail::continuation_remote, _1),
+                util::function_nonser<std::uint64_t(bool)>(), "", 0},
+            // /threads{locality#%d/total}/count/deadlines/met
+            {"count/deadlines/met",
+                util::bind(&policies::get_deadline_count, false, _1),
+                util::function_nonser<std::uint64_t(bool)>(), "", 0},
+            // /threads{locality#%d/total}/count/deadlines/missed
+            {"count/deadlines/missed",
+                util::bind(&policies::get_deadline_count, true, _1),
+                util::function_nonser<std::uint64_t(bool)>(), "", 0},
         };
         std::size_t const data_size = sizeof(data)/sizeof(data[0]);
 
@@ -1709,6 +1778,49 @@ namespace hpx { namespace threads
                 "the referenced locality",
                 HPX_PERFORMANCE_COUNTER_V1, counts_creator,
                 &locality_allocator_counter_discoverer, ""},
+            {"/threads/count/continuations/inline",
+                performance_counters::counter_raw,
+                "returns the number of future continuations which were run "
+                "directly by the thread making the future ready for the "
+                "referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+                &performance_counters::locality_counter_discoverer, ""},
+            {"/threads/count/continuations/local",
+                performance_counters::counter_raw,
+                "returns the number of future continuations which were "
+                "scheduled on the worker-thread making the future ready for "
+                "the referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+                &performance_counters::locality_counter_discoverer, ""},
+            {"/threads/count/continuations/remote",
+                performance_counters::counter_raw,
+                "returns the number of future continuations which were "
+                "scheduled on an arbitrary worker-thread for the referenced "
+                "locality",
+                HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+                &performance_counters::locality_counter_discoverer, ""},
+            {"/threads/count/deadlines/met",
+                performance_counters::counter_raw,
+                "returns the number of HPX-threads with a deadline which "
+                "finished executing in time for the referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+                &performance_counters::locality_counter_discoverer, ""},
+            {"/threads/count/deadlines/missed",
+                performance_counters::counter_raw,
+                "returns the number of HPX-threads with a deadline which "
+                "finished executing after their deadline for the referenced "
+                "locality",
+                HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+                &performance_counters::locality_counter_discoverer, ""},
+            {"/threads/time/deadline-lateness-histogram",
+                performance_counters::counter_histogram,
+                "returns the histogram of the time by which HPX-threads "
+                "missed their deadline for the referenced locality, the "
+                "counter parameters are the lower and upper boundaries [ns] "
+                "and the number of buckets (default: 0,1000000,20)",
+                HPX_PERFORMANCE_COUNTER_V1,
+                &policies::deadline_lateness_histogram_counter_creator,
+                &performance_counters::locality_counter_discoverer, "ns/0.1%"},
 #ifdef HPX_HAVE_THREAD_STEALING_COUNTS
             {"/threads/count/pending-misses", performance_counters::counter_raw,
                 "returns the number of times that the referenced worker-thread "
@@ -1835,6 +1947,28 @@ namespace hpx { namespace threads
             });
     }
 
+    bool threadmanager::move_processing_unit(
+        std::string const& from_pool, std::string const& to_pool)
+    {
+        return resource::get_partitioner().move_pu(from_pool, to_pool,
+            [this, &from_pool](std::size_t virt_core)
+            {
+                get_pool(from_pool).remove_processing_unit(virt_core);
+            },
+            [this, &to_pool](std::size_t virt_core)
+            {
+                detail::thread_pool_base& pool = get_pool(to_pool);
+                pool.add_processing_unit(virt_core,
+                    pool.get_thread_offset() + virt_core);
+            });
+    }
+
+    void threadmanager::start_elastic_controller()
+    {
+        elastic_controller_.reset(new detail::elastic_controller(*this));
+        elastic_controller_->start();
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     bool threadmanager::run()
     {
@@ -1882,6 +2016,9 @@ namespace hpx { namespace threads
     {
         LTM_(info) << "stop: blocking(" << std::boolalpha << blocking << ")";
 
+        if (elastic_controller_)
+            elastic_controller_->stop();
+
         std::unique_lock<mutex_type> lk(mtx_);
         for (auto& pool_iter : pools_)
         {
@@ -25,9 +25,12 @@
 #include <hpx/util/apex.hpp>
 #include <hpx/util/bind.hpp>
 #include <hpx/util/logging.hpp>
+#include <hpx/util/perf_events.hpp>
 #include <hpx/util/safe_lexical_cast.hpp>
+#include <hpx/util/sampling_profiler.hpp>
 #include <hpx/util/set_thread_name.hpp>
 #include <hpx/util/thread_mapper.hpp>
+#include <hpx/util/tracing.hpp>
 
 #include <cstddef>
 #include <cstdint>
@@ -252,6 +255,8 @@ namespace hpx {
         lbt_ << "(4th stage) runtime_impl::run_helper: bootstrap complete";
         set_state(state_running);
 
+        thread_manager_->start_elastic_controller();
+
         parcel_handler_.enable_alternative_parcelports();
 
         // reset all counters right before running main, if requested
@@ -300,6 +305,12 @@ namespace hpx {
         // initialize instrumentation system
         util::apex_init();
 
+        // enable the built-in tracing, if requested
+        util::tracing::start(get_config());
+
+        // enable the sampling profiler, if requested
+        util::sampling_profiler::start(get_config());
+
         LRT_(info) << "cmd_line: " << get_config().get_cmd_line();
 
         lbt_ << "(1st stage) runtime_impl::start: booting locality " << here();
@@ -486,6 +497,19 @@ namespace hpx {
 #ifdef HPX_HAVE_IO_POOL
         io_pool_.stop();                    // stops io_pool_ as well
 #endif
+
+        // write the trace and the profile of this locality, all threads have
+        // stopped by now
+        util::tracing::stop(naming::get_locality_id_from_gid(
+            agas_client_.get_local_locality()));
+        util::sampling_profiler::stop(naming::get_locality_id_from_gid(
+            agas_client_.get_local_locality()));
+
+#if defined(HPX_HAVE_PERF_EVENT_COUNTERS)
+        // release the hardware event counters of all worker threads
+        util::perf_events::stop();
+#endif
+
         deinit_tss();
     }
 
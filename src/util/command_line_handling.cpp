@@ -890,6 +890,27 @@ namespace hpx { namespace util
         }
 #endif
 
+        if (vm.count("hpx:trace")) {
+            ini_config += "hpx.trace.enable=1";
+            std::string destination = vm["hpx:trace"].as<std::string>();
+            if (!destination.empty())
+                ini_config += "hpx.trace.destination=" + destination;
+        }
+        if (vm.count("hpx:trace-format")) {
+            ini_config += "hpx.trace.format=" +
+                vm["hpx:trace-format"].as<std::string>();
+        }
+        if (vm.count("hpx:profile")) {
+            ini_config += "hpx.profiler.enable=1";
+            std::string destination = vm["hpx:profile"].as<std::string>();
+            if (!destination.empty())
+                ini_config += "hpx.profiler.destination=" + destination;
+        }
+        if (vm.count("hpx:profile-interval")) {
+            ini_config += "hpx.profiler.interval=" + std::to_string(
+                vm["hpx:profile-interval"].as<std::size_t>());
+        }
+
         // Set number of cores and OS threads in configuration.
         ini_config += "hpx.os_threads=" +
             std::to_string(num_threads_);
@@ -451,8 +451,9 @@ namespace hpx { namespace util
                   "the queue scheduling policy to use, options are "
                   "'local', 'local-priority-fifo','local-priority-lifo', "
                   "'abp-priority', "
-                  "'hierarchy', 'static', 'static-priority', and "
-                  "'periodic-priority' (default: 'local-priority'; "
+                  "'hierarchy', 'static', 'static-priority', "
+                  "'periodic-priority', and 'deadline' "
+                  "(default: 'local-priority'; "
                   "all option values can be abbreviated)")
                 ("hpx:hierarchy-arity", value<std::size_t>(),
                   "the arity of the of the thread queue tree, valid for "
@@ -510,6 +511,21 @@ namespace hpx { namespace util
                   "startup or exception (default: startup)")
 #endif
                 ("hpx:list-parcel-ports", "list all available parcel-ports")
+                ("hpx:trace", value<std::string>()->implicit_value(""),
+                  "record task begin and end, suspension, stealing, and parcel "
+                  "send and receive events and write them to the given file "
+                  "at shutdown (default: hpx-trace.json)")
+                ("hpx:trace-format", value<std::string>(),
+                  "the format of the trace written by --hpx:trace, possible "
+                  "values: 'chrome' (Chrome trace JSON, default) or "
+                  "'perfetto' (Perfetto protobuf)")
+                ("hpx:profile", value<std::string>()->implicit_value(""),
+                  "periodically sample the call stacks of the running HPX "
+                  "threads and write them as folded stacks to the given file "
+                  "at shutdown (default: hpx-profile.folded, Linux only)")
+                ("hpx:profile-interval", value<std::size_t>(),
+                  "the CPU time between two samples taken by --hpx:profile, "
+                  "in microseconds (default: 1000)")
             ;
 
             options_description counter_options(
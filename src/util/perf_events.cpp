@@ -0,0 +1,325 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PERF_EVENT_COUNTERS)
+#include <hpx/compat/mutex.hpp>
+#include <hpx/util/logging.hpp>
+#include <hpx/util/perf_events.hpp>
+#include <hpx/util/spinlock.hpp>
+#include <hpx/util/thread_description.hpp>
+#include <hpx/util/thread_specific_ptr.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hpx { namespace util { namespace perf_events
+{
+    namespace detail
+    {
+        boost::atomic<bool> enabled(false);
+    }
+
+    namespace
+    {
+        struct event_info
+        {
+            char const* name_;
+            std::uint32_t type_;
+            std::uint64_t config_;
+        };
+
+        event_info const events[num_events] =
+        {
+            { "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+            { "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+            // the generic cache miss event usually counts last level misses
+            { "llc-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+            { "branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES }
+        };
+
+        // Count the given event for the calling thread in user space only,
+        // which is permitted for unprivileged processes by default.
+        int open_event(event_info const& info, int group_fd)
+        {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = info.type_;
+            attr.config = info.config_;
+            attr.read_format = PERF_FORMAT_GROUP;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+
+            return static_cast<int>(
+                syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0));
+        }
+
+        typedef std::array<std::uint64_t, num_events> values_type;
+
+        struct totals
+        {
+            totals()
+            {
+                values_.fill(0);
+            }
+
+            util::thread_description desc_;
+            values_type values_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        struct worker_context
+        {
+            worker_context()
+              : leader_(-1), num_open_(0), initialized_(false),
+                running_(false), key_(0)
+            {
+                fds_.fill(-1);
+                positions_.fill(-1);
+            }
+
+            ~worker_context()
+            {
+                close();
+            }
+
+            // Open the events as one group (read with a single system call).
+            // Events not supported by the hardware are reported as zero.
+            void open()
+            {
+                for (std::size_t i = 0; i != num_events; ++i)
+                {
+                    int fd = open_event(events[i], leader_);
+                    if (fd < 0)
+                        continue;
+
+                    if (leader_ < 0)
+                        leader_ = fd;
+
+                    fds_[i] = fd;
+                    positions_[i] = static_cast<int>(num_open_++);
+                }
+
+                if (leader_ < 0)
+                {
+                    LRT_(warning) << "perf_events: could not open any "
+                        "hardware event counter, errno: " << errno;
+                }
+            }
+
+            void close()
+            {
+                for (int& fd : fds_)
+                {
+                    if (fd >= 0)
+                        ::close(fd);
+                    fd = -1;
+                }
+                positions_.fill(-1);
+                leader_ = -1;
+                num_open_ = 0;
+            }
+
+            bool read(values_type& values) const
+            {
+                // PERF_FORMAT_GROUP: the number of events followed by their
+                // values in the order the events were opened
+                std::uint64_t buffer[num_events + 1];
+                std::size_t size = (num_open_ + 1) * sizeof(std::uint64_t);
+                if (::read(leader_, buffer, size) !=
+                        static_cast<ssize_t>(size))
+                {
+                    return false;
+                }
+
+                for (std::size_t i = 0; i != num_events; ++i)
+                {
+                    values[i] = positions_[i] >= 0 ?
+                        buffer[positions_[i] + 1] : 0;
+                }
+                return true;
+            }
+
+            std::array<int, num_events> fds_;
+            std::array<int, num_events> positions_;
+            int leader_;
+            std::size_t num_open_;
+            bool initialized_;
+
+            // values read when the running HPX thread was started or resumed
+            bool running_;
+            std::uint64_t key_;
+            util::thread_description desc_;
+            values_type start_;
+
+            // accumulated values per thread description, the key is the
+            // address of the description string (or the function address)
+            util::spinlock mtx_;
+            std::unordered_map<std::uint64_t, totals> totals_;
+        };
+
+        struct tls_tag {};
+        util::thread_specific_ptr<worker_context, tls_tag> context_;
+
+        std::uint64_t get_key(util::thread_description const& desc)
+        {
+            if (desc.kind() == util::thread_description::data_type_description)
+                return reinterpret_cast<std::uint64_t>(desc.get_description());
+            return desc.get_address();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Contexts are never released as worker threads may keep referring
+        // to them, their counters are closed when the runtime stops.
+        struct perf_event_data
+        {
+            worker_context* register_worker(worker_context* ctx)
+            {
+                std::lock_guard<compat::mutex> l(mtx_);
+
+                if (ctx == nullptr)
+                {
+                    contexts_.emplace_back(new worker_context);
+                    ctx = contexts_.back().get();
+                    context_.reset(ctx);
+                }
+
+                // don't try again if the events could not be opened
+                ctx->open();
+                ctx->initialized_ = true;
+                return ctx;
+            }
+
+            compat::mutex mtx_;
+            std::vector<std::unique_ptr<worker_context> > contexts_;
+        };
+
+        perf_event_data& get_perf_event_data()
+        {
+            static perf_event_data data;
+            return data;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void record_task_begin(util::thread_description const& desc)
+    {
+        worker_context* ctx = context_.get();
+        if (HPX_UNLIKELY(ctx == nullptr || !ctx->initialized_))
+            ctx = get_perf_event_data().register_worker(ctx);
+
+        if (ctx->leader_ < 0 || !ctx->read(ctx->start_))
+            return;
+
+        ctx->running_ = true;
+        ctx->key_ = get_key(desc);
+        ctx->desc_ = desc;
+    }
+
+    void record_task_end()
+    {
+        worker_context* ctx = context_.get();
+        if (ctx == nullptr || !ctx->running_)
+            return;
+
+        ctx->running_ = false;
+
+        values_type values;
+        if (!ctx->read(values))
+            return;
+
+        std::lock_guard<util::spinlock> l(ctx->mtx_);
+
+        totals& t = ctx->totals_[ctx->key_];
+        t.desc_ = ctx->desc_;
+        for (std::size_t i = 0; i != num_events; ++i)
+            t.values_[i] += values[i] - ctx->start_[i];
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool available()
+    {
+        int fd = open_event(events[cycles], -1);
+        if (fd < 0)
+            return false;
+
+        ::close(fd);
+        return true;
+    }
+
+    void enable()
+    {
+        detail::enabled.store(true);
+    }
+
+    void stop()
+    {
+        perf_event_data& data = get_perf_event_data();
+        std::lock_guard<compat::mutex> l(data.mtx_);
+
+        detail::enabled.store(false);
+
+        for (auto& ctx : data.contexts_)
+        {
+            ctx->close();
+            ctx->initialized_ = false;
+            ctx->running_ = false;
+
+            std::lock_guard<util::spinlock> lk(ctx->mtx_);
+            ctx->totals_.clear();
+        }
+    }
+
+    std::int64_t get_value(event_type type, std::string const& description,
+        bool reset)
+    {
+        perf_event_data& data = get_perf_event_data();
+        std::lock_guard<compat::mutex> l(data.mtx_);
+
+        std::uint64_t result = 0;
+        for (auto& ctx : data.contexts_)
+        {
+            std::lock_guard<util::spinlock> lk(ctx->mtx_);
+            for (auto& t : ctx->totals_)
+            {
+                if (util::as_string(t.second.desc_) != description)
+                    continue;
+
+                result += t.second.values_[type];
+                if (reset)
+                    t.second.values_[type] = 0;
+            }
+        }
+        return static_cast<std::int64_t>(result);
+    }
+
+    event_type get_event_type(std::string const& name)
+    {
+        for (std::size_t i = 0; i != num_events; ++i)
+        {
+            if (name == events[i].name_)
+                return static_cast<event_type>(i);
+        }
+        return num_events;
+    }
+}}}
+
+#endif
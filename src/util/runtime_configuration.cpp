@@ -194,11 +194,14 @@ namespace hpx { namespace util
                 HPX_PP_STRINGIZE(HPX_PP_EXPAND(HPX_IDLE_LOOP_COUNT_MAX)) "}",
             "max_busy_loop_count = ${HPX_MAX_BUSY_LOOP_COUNT:"
                 HPX_PP_STRINGIZE(HPX_PP_EXPAND(HPX_BUSY_LOOP_COUNT_MAX)) "}",
+            "idle_park_delay = ${HPX_IDLE_PARK_DELAY:0}",
+            "max_idle_backoff_time = ${HPX_MAX_IDLE_BACKOFF_TIME:100}",
 
             // arity for collective operations implemented in a tree fashion
             "[hpx.lcos.collectives]",
             "arity = ${HPX_LCOS_COLLECTIVES_ARITY:32}",
             "cut_off = ${HPX_LCOS_COLLECTIVES_CUT_OFF:-1}",
+            "fanout = ${HPX_LCOS_COLLECTIVES_FANOUT}",
 
             // connect back to the given latch if specified
             "[hpx.on_startup]",
@@ -231,6 +234,39 @@ namespace hpx { namespace util
             "timer_pool_size = ${HPX_NUM_TIMER_POOL_SIZE:"
                 HPX_PP_STRINGIZE(HPX_PP_EXPAND(HPX_NUM_TIMER_POOL_SIZE)) "}",
 
+            "[hpx.elastic_pools]",
+            "interval = ${HPX_ELASTIC_POOLS_INTERVAL:100}",
+            "hysteresis = ${HPX_ELASTIC_POOLS_HYSTERESIS:3}",
+            "utilization = ${HPX_ELASTIC_POOLS_UTILIZATION:50}",
+            "queue_length = ${HPX_ELASTIC_POOLS_QUEUE_LENGTH:2}",
+
+            "[hpx.continuations]",
+            "max_inline_depth = ${HPX_CONTINUATIONS_MAX_INLINE_DEPTH:"
+                HPX_PP_STRINGIZE(HPX_PP_EXPAND(
+                    HPX_CONTINUATION_MAX_RECURSION_DEPTH)) "}",
+            "placement = ${HPX_CONTINUATIONS_PLACEMENT:local}",
+
+            "[hpx.io]",
+            "backend = ${HPX_IO_BACKEND:auto}",
+            "queue_depth = ${HPX_IO_QUEUE_DEPTH:256}",
+
+            "[hpx.iostreams]",
+            "ordering = ${HPX_IOSTREAMS_ORDERING:strict}",
+            "batch_size = ${HPX_IOSTREAMS_BATCH_SIZE:4096}",
+            "flush_interval = ${HPX_IOSTREAMS_FLUSH_INTERVAL:10}",
+
+            "[hpx.trace]",
+            "enable = ${HPX_TRACE_ENABLE:0}",
+            "destination = ${HPX_TRACE_DESTINATION:hpx-trace.json}",
+            "format = ${HPX_TRACE_FORMAT:chrome}",
+            "buffer_size = ${HPX_TRACE_BUFFER_SIZE:65536}",
+
+            "[hpx.profiler]",
+            "enable = ${HPX_PROFILER_ENABLE:0}",
+            "destination = ${HPX_PROFILER_DESTINATION:hpx-profile.folded}",
+            "interval = ${HPX_PROFILER_INTERVAL:1000}",
+            "table_size = ${HPX_PROFILER_TABLE_SIZE:4096}",
+
             "[hpx.thread_queue]",
             "min_tasks_to_steal_pending = "
                 "${HPX_THREAD_QUEUE_MIN_TASKS_TO_STEAL_PENDING:0}",
@@ -285,6 +321,9 @@ namespace hpx { namespace util
                 HPX_PP_STRINGIZE(HPX_PP_EXPAND(
                     HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS))
                 "}",
+            "max_pending_worker_refcnt_requests = "
+                "${HPX_AGAS_MAX_PENDING_WORKER_REFCNT_REQUESTS:64}",
+            "refcnt_flush_interval = ${HPX_AGAS_REFCNT_FLUSH_INTERVAL:10}",
             "service_mode = hosted",
             "local_cache_size = ${HPX_AGAS_LOCAL_CACHE_SIZE:"
                 HPX_PP_STRINGIZE(HPX_PP_EXPAND(HPX_AGAS_LOCAL_CACHE_SIZE)) "}",
@@ -728,6 +767,31 @@ namespace hpx { namespace util
         return HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS;
     }
 
+    std::size_t
+    runtime_configuration::get_agas_max_pending_worker_refcnt_requests() const
+    {
+        if (has_section("hpx.agas")) {
+            util::section const* sec = get_section("hpx.agas");
+            if (nullptr != sec) {
+                return hpx::util::get_entry_as<std::size_t>(
+                    *sec, "max_pending_worker_refcnt_requests", 64);
+            }
+        }
+        return 64;
+    }
+
+    std::int64_t runtime_configuration::get_agas_refcnt_flush_interval() const
+    {
+        if (has_section("hpx.agas")) {
+            util::section const* sec = get_section("hpx.agas");
+            if (nullptr != sec) {
+                return hpx::util::get_entry_as<std::int64_t>(
+                    *sec, "refcnt_flush_interval", 10);
+            }
+        }
+        return 10;
+    }
+
     bool runtime_configuration::get_itt_notify_mode() const
     {
 #if HPX_HAVE_ITTNOTIFY != 0
@@ -0,0 +1,587 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/compat/mutex.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/backtrace.hpp>
+#include <hpx/util/ini.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+#include <hpx/util/sampling_profiler.hpp>
+#include <hpx/util/thread_description.hpp>
+#include <hpx/util/thread_specific_ptr.hpp>
+
+#if defined(__linux__)
+#include <dlfcn.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#endif
+#endif
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__) && !defined(sigev_notify_thread_id)
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+namespace hpx { namespace util { namespace sampling_profiler
+{
+    namespace detail
+    {
+        bool enabled = false;
+    }
+
+#if defined(__linux__)
+    namespace
+    {
+        // maximal number of stack frames recorded for each sample
+        std::size_t const max_frames = 32;
+
+        // number of stack frames belonging to the signal handler, used if
+        // the interrupted instruction can't be found on the stack
+        std::size_t const signal_frames = 2;
+
+        // number of table entries probed before a sample is dropped
+        std::size_t const max_probes = 16;
+
+        ///////////////////////////////////////////////////////////////////////
+        // A thread description, either a string or a function address
+        struct frame_name
+        {
+            bool operator==(frame_name const& rhs) const
+            {
+                return value_ == rhs.value_ && is_address_ == rhs.is_address_;
+            }
+
+            std::uint64_t value_;
+            bool is_address_;
+        };
+
+        frame_name make_frame_name(util::thread_description const& desc)
+        {
+            frame_name name;
+            if (desc.kind() == util::thread_description::data_type_description)
+            {
+                name.value_ =
+                    reinterpret_cast<std::uint64_t>(desc.get_description());
+                name.is_address_ = false;
+            }
+            else
+            {
+                name.value_ = desc.get_address();
+                name.is_address_ = true;
+            }
+            return name;
+        }
+
+        struct sample
+        {
+            std::uint64_t hash_;            // zero marks an unused entry
+            std::uint64_t count_;
+            frame_name task_;
+            frame_name parent_;
+            std::size_t num_frames_;
+            void* frames_[max_frames];      // innermost frame first
+        };
+
+        // Open addressing hash table of samples. It is written only by the
+        // signal handler interrupting the owning worker thread (so no locking
+        // is needed) and is read only after the worker thread has stopped.
+        class sample_table
+        {
+        public:
+            explicit sample_table(std::size_t capacity)
+              : samples_(capacity), mask_(capacity - 1), idle_(0), dropped_(0)
+            {}
+
+            void reset()
+            {
+                for (sample& s : samples_)
+                    s.hash_ = 0;
+                idle_ = 0;
+                dropped_ = 0;
+            }
+
+            void add(frame_name const& task, frame_name const& parent,
+                void* const* frames, std::size_t num_frames)
+            {
+                std::uint64_t hash = hash_sample(task, parent, frames,
+                    num_frames);
+
+                for (std::size_t i = 0; i != max_probes; ++i)
+                {
+                    sample& s = samples_[(hash + i) & mask_];
+                    if (s.hash_ == 0)
+                    {
+                        s.hash_ = hash;
+                        s.count_ = 1;
+                        s.task_ = task;
+                        s.parent_ = parent;
+                        s.num_frames_ = num_frames;
+                        std::memcpy(s.frames_, frames,
+                            num_frames * sizeof(void*));
+                        return;
+                    }
+
+                    if (s.hash_ == hash && s.task_ == task &&
+                        s.parent_ == parent && s.num_frames_ == num_frames &&
+                        std::memcmp(s.frames_, frames,
+                            num_frames * sizeof(void*)) == 0)
+                    {
+                        ++s.count_;
+                        return;
+                    }
+                }
+
+                ++dropped_;
+            }
+
+            // FNV-1a
+            static std::uint64_t hash_sample(frame_name const& task,
+                frame_name const& parent, void* const* frames,
+                std::size_t num_frames)
+            {
+                std::uint64_t hash = 14695981039346656037ull;
+                auto combine = [&hash](std::uint64_t value)
+                {
+                    hash ^= value;
+                    hash *= 1099511628211ull;
+                };
+
+                combine(task.value_);
+                combine(parent.value_);
+                for (std::size_t i = 0; i != num_frames; ++i)
+                    combine(reinterpret_cast<std::uint64_t>(frames[i]));
+
+                return hash != 0 ? hash : 1;
+            }
+
+            std::vector<sample> samples_;
+            std::uint64_t mask_;
+            std::uint64_t idle_;        // samples outside of any HPX thread
+            std::uint64_t dropped_;     // samples not fitting into the table
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        struct worker_context
+        {
+            explicit worker_context(std::size_t capacity)
+              : running_(false), table_(capacity), armed_(false),
+                has_timer_(false)
+            {}
+
+            // written by the worker thread, read by the signal handler
+            // interrupting the same thread
+            frame_name task_;
+            frame_name parent_;
+            volatile bool running_;
+
+            sample_table table_;
+
+            bool armed_;
+            bool has_timer_;
+            timer_t timer_;
+        };
+
+        // the contexts are owned by profiler_data, the pointer is never reset
+        struct tls_tag {};
+        util::thread_specific_ptr<worker_context, tls_tag> context_;
+
+        // Return the address of the instruction interrupted by the signal
+        void* get_interrupted_address(void* ucontext)
+        {
+            ucontext_t const* ctx = static_cast<ucontext_t const*>(ucontext);
+#if defined(__x86_64__) && defined(REG_RIP)
+            return reinterpret_cast<void*>(ctx->uc_mcontext.gregs[REG_RIP]);
+#elif defined(__i386__) && defined(REG_EIP)
+            return reinterpret_cast<void*>(ctx->uc_mcontext.gregs[REG_EIP]);
+#elif defined(__aarch64__)
+            return reinterpret_cast<void*>(ctx->uc_mcontext.pc);
+#else
+            (void) ctx;
+            return nullptr;
+#endif
+        }
+
+        void handle_sample(int, siginfo_t*, void* ucontext)
+        {
+            worker_context* ctx = context_.get();
+            if (ctx == nullptr)
+                return;
+
+            if (!ctx->running_)
+            {
+                ++ctx->table_.idle_;
+                return;
+            }
+
+            int saved_errno = errno;
+
+            void* frames[max_frames + signal_frames];
+            std::size_t num_frames = 0;
+#if defined(HPX_HAVE_STACKTRACES)
+            num_frames = util::stack_trace::trace(frames,
+                max_frames + signal_frames);
+#endif
+
+            // skip the frames of the signal handler
+            std::size_t first = 0;
+            void* address = get_interrupted_address(ucontext);
+            while (first != num_frames && frames[first] != address)
+                ++first;
+            if (first == num_frames)
+                first = (std::min)(num_frames, signal_frames);
+
+            num_frames = (std::min)(num_frames - first, max_frames);
+            while (num_frames != 0 && frames[first + num_frames - 1] == nullptr)
+                --num_frames;
+
+            ctx->table_.add(ctx->task_, ctx->parent_, frames + first,
+                num_frames);
+
+            errno = saved_errno;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Contexts are never released as worker threads may keep referring
+        // to them, they are reset whenever the profiler is started again.
+        struct profiler_data
+        {
+            profiler_data()
+              : capacity_(4096), interval_(1000000),
+                multiple_localities_(false)
+            {
+                std::memset(&old_action_, 0, sizeof(old_action_));
+            }
+
+            worker_context* register_worker(worker_context* ctx)
+            {
+                std::lock_guard<compat::mutex> l(mtx_);
+
+                if (ctx == nullptr)
+                {
+                    contexts_.emplace_back(new worker_context(capacity_));
+                    ctx = contexts_.back().get();
+
+#if defined(HPX_HAVE_STACKTRACES)
+                    // make sure the unwinder has been loaded before it is
+                    // invoked from the signal handler for the first time
+                    void* frames[1];
+                    util::stack_trace::trace(frames, 1);
+#endif
+                    context_.reset(ctx);
+                }
+
+                // the timer measures the CPU time consumed by this thread
+                sigevent sev;
+                std::memset(&sev, 0, sizeof(sev));
+                sev.sigev_notify = SIGEV_THREAD_ID;
+                sev.sigev_signo = SIGPROF;
+                sev.sigev_notify_thread_id =
+                    static_cast<pid_t>(syscall(SYS_gettid));
+
+                if (timer_create(CLOCK_THREAD_CPUTIME_ID, &sev,
+                        &ctx->timer_) == 0)
+                {
+                    itimerspec spec;
+                    spec.it_interval.tv_sec = interval_ / 1000000000;
+                    spec.it_interval.tv_nsec = interval_ % 1000000000;
+                    spec.it_value = spec.it_interval;
+
+                    timer_settime(ctx->timer_, 0, &spec, nullptr);
+                    ctx->has_timer_ = true;
+                }
+
+                // don't try again if the timer could not be created
+                ctx->armed_ = true;
+                return ctx;
+            }
+
+            compat::mutex mtx_;
+            std::vector<std::unique_ptr<worker_context> > contexts_;
+
+            std::size_t capacity_;
+            std::int64_t interval_;         // nanoseconds
+            std::string destination_;
+            bool multiple_localities_;
+
+            struct sigaction old_action_;
+        };
+
+        profiler_data& get_profiler_data()
+        {
+            static profiler_data data;
+            return data;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        std::string demangle(char const* name)
+        {
+#if defined(__GNUC__)
+            int status = 0;
+            char* demangled = abi::__cxa_demangle(name, nullptr, nullptr,
+                &status);
+            if (demangled != nullptr)
+            {
+                std::string result(demangled);
+                std::free(demangled);
+                return result;
+            }
+#endif
+            return name;
+        }
+
+        std::string get_function_name(void const* address)
+        {
+            Dl_info info;
+            if (dladdr(address, &info) == 0)
+            {
+                std::ostringstream strm;
+                strm << address;
+                return strm.str();
+            }
+
+            if (info.dli_sname != nullptr)
+                return demangle(info.dli_sname);
+
+            // local symbols are not available, print the module offset
+            char const* module = std::strrchr(info.dli_fname, '/');
+            std::ostringstream strm;
+            strm << (module != nullptr ? module + 1 : info.dli_fname) << "+0x"
+                 << std::hex << (static_cast<char const*>(address) -
+                        static_cast<char const*>(info.dli_fbase));
+            return strm.str();
+        }
+
+        // Names of the folded stack format may not contain ';' and newlines
+        std::string get_frame_name(frame_name const& name)
+        {
+            std::string result = name.is_address_ ?
+                get_function_name(reinterpret_cast<void const*>(name.value_)) :
+                std::string(reinterpret_cast<char const*>(name.value_));
+
+            for (char& c : result)
+            {
+                if (c == ';' || c == '\n')
+                    c = ' ';
+            }
+            return result;
+        }
+
+        class symbol_cache
+        {
+        public:
+            // return addresses point behind the call instruction, all frames
+            // but the innermost are looked up at the preceding byte
+            std::string const& get(void* address, bool innermost)
+            {
+                char const* p = static_cast<char const*>(address);
+                if (!innermost)
+                    --p;
+
+                auto it = symbols_.find(p);
+                if (it == symbols_.end())
+                {
+                    frame_name name;
+                    name.value_ = reinterpret_cast<std::uint64_t>(p);
+                    name.is_address_ = true;
+                    it = symbols_.emplace(p, get_frame_name(name)).first;
+                }
+                return it->second;
+            }
+
+        private:
+            std::map<void const*, std::string> symbols_;
+        };
+
+        void write_folded_stacks(std::ostream& os, profiler_data const& data)
+        {
+            symbol_cache symbols;
+            std::map<std::string, std::uint64_t> stacks;
+            std::uint64_t idle = 0, dropped = 0;
+
+            for (auto const& ctx : data.contexts_)
+            {
+                for (sample const& s : ctx->table_.samples_)
+                {
+                    if (s.hash_ == 0)
+                        continue;
+
+                    std::string stack;
+                    std::string parent = get_frame_name(s.parent_);
+                    if (parent != "<unknown>")
+                    {
+                        stack += parent;
+                        stack += ';';
+                    }
+                    stack += get_frame_name(s.task_);
+
+                    for (std::size_t i = s.num_frames_; i != 0; --i)
+                    {
+                        stack += ';';
+                        stack += symbols.get(s.frames_[i - 1], i == 1);
+                    }
+
+                    stacks[stack] += s.count_;
+                }
+
+                idle += ctx->table_.idle_;
+                dropped += ctx->table_.dropped_;
+            }
+
+            if (idle != 0)
+                stacks["<scheduler>"] += idle;
+            if (dropped != 0)
+                stacks["<dropped>"] += dropped;
+
+            for (auto const& stack : stacks)
+                os << stack.first << ' ' << stack.second << '\n';
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void record_task_begin(util::thread_description const& desc,
+        util::thread_description const& parent)
+    {
+        worker_context* ctx = context_.get();
+        if (HPX_UNLIKELY(ctx == nullptr || !ctx->armed_))
+            ctx = get_profiler_data().register_worker(ctx);
+
+        ctx->task_ = make_frame_name(desc);
+        ctx->parent_ = make_frame_name(parent);
+
+        // the signal handler must not see the flag before the descriptions
+        std::atomic_signal_fence(std::memory_order_release);
+        ctx->running_ = true;
+    }
+
+    void record_task_end()
+    {
+        worker_context* ctx = context_.get();
+        if (ctx != nullptr)
+            ctx->running_ = false;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void start(util::section const& cfg)
+    {
+        profiler_data& data = get_profiler_data();
+        std::lock_guard<compat::mutex> l(data.mtx_);
+
+        detail::enabled = false;
+        if (cfg.get_entry("hpx.profiler.enable", "0") != "1")
+            return;
+
+        data.destination_ = cfg.get_entry("hpx.profiler.destination",
+            "hpx-profile.folded");
+        data.multiple_localities_ = util::safe_lexical_cast<std::size_t>(
+            cfg.get_entry("hpx.localities", "1"), 1) > 1;
+
+        // the sampling interval is given in microseconds
+        std::int64_t interval = util::safe_lexical_cast<std::int64_t>(
+            cfg.get_entry("hpx.profiler.interval", "1000"), 1000);
+        if (interval <= 0)
+        {
+            HPX_THROW_EXCEPTION(bad_parameter, "sampling_profiler::start",
+                "the sampling interval has to be positive: " +
+                std::to_string(interval));
+        }
+        data.interval_ = interval * 1000;
+
+        // the table capacity has to be a power of two
+        std::size_t size = util::safe_lexical_cast<std::size_t>(
+            cfg.get_entry("hpx.profiler.table_size", "4096"), 4096);
+        data.capacity_ = 16;
+        while (data.capacity_ < size)
+            data.capacity_ *= 2;
+
+        // contexts registered before keep their capacity
+        for (auto& ctx : data.contexts_)
+        {
+            ctx->table_.reset();
+            ctx->armed_ = false;
+        }
+
+        struct sigaction action;
+        std::memset(&action, 0, sizeof(action));
+        action.sa_sigaction = &handle_sample;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGPROF, &action, &data.old_action_);
+
+        detail::enabled = true;
+    }
+
+    void stop(std::uint32_t locality_id)
+    {
+        profiler_data& data = get_profiler_data();
+        std::lock_guard<compat::mutex> l(data.mtx_);
+
+        if (!detail::enabled)
+            return;
+        detail::enabled = false;
+
+        for (auto& ctx : data.contexts_)
+        {
+            if (ctx->has_timer_)
+            {
+                timer_delete(ctx->timer_);
+                ctx->has_timer_ = false;
+            }
+            ctx->armed_ = false;
+            ctx->running_ = false;
+        }
+        sigaction(SIGPROF, &data.old_action_, nullptr);
+
+        std::string destination = data.destination_;
+        if (data.multiple_localities_)
+            destination += "." + std::to_string(locality_id);
+
+        std::ofstream out(destination.c_str());
+        write_folded_stacks(out, data);
+    }
+
+#else
+    ///////////////////////////////////////////////////////////////////////////
+    void record_task_begin(util::thread_description const&,
+        util::thread_description const&)
+    {
+    }
+
+    void record_task_end()
+    {
+    }
+
+    void start(util::section const& cfg)
+    {
+        if (cfg.get_entry("hpx.profiler.enable", "0") == "1")
+        {
+            HPX_THROW_EXCEPTION(not_implemented, "sampling_profiler::start",
+                "the sampling profiler is available on Linux only");
+        }
+    }
+
+    void stop(std::uint32_t)
+    {
+    }
+#endif
+}}}
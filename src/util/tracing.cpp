@@ -0,0 +1,567 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/compat/mutex.hpp>
+#include <hpx/runtime/get_thread_name.hpp>
+#include <hpx/runtime/threads/thread_enums.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/hardware/timestamp.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/ini.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+#include <hpx/util/thread_specific_ptr.hpp>
+#include <hpx/util/tracing.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace util { namespace tracing
+{
+    namespace detail
+    {
+        bool enabled = false;
+    }
+
+    namespace
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Compact binary representation of one traced event
+        struct event
+        {
+            std::uint64_t timestamp_;   // see get_ticks()
+            std::uint64_t id_;          // address of the HPX thread, if any
+            std::uint64_t name_;        // description or function address
+            std::uint32_t data_;        // thread state, victim, or locality
+            std::uint8_t type_;         // event_type
+            std::uint8_t is_address_;   // name_ is a function address
+        };
+
+        // Ring buffer of events written by exactly one OS-thread. Once full,
+        // the oldest events are overwritten.
+        struct event_buffer
+        {
+            event_buffer(std::size_t capacity, std::string && name)
+              : events_(capacity), mask_(capacity - 1), head_(0),
+                name_(std::move(name))
+            {}
+
+            void push(event const& e)
+            {
+                std::uint64_t head = head_.load(boost::memory_order_relaxed);
+                events_[head & mask_] = e;
+                head_.store(head + 1, boost::memory_order_release);
+            }
+
+            std::vector<event> events_;
+            std::uint64_t mask_;
+            boost::atomic<std::uint64_t> head_;
+            std::string name_;
+        };
+
+        enum trace_format
+        {
+            chrome_trace,
+            perfetto_trace
+        };
+
+        // Buffers are never released as OS-threads may keep referring to
+        // them, they are reset whenever tracing is started again.
+        struct tracing_data
+        {
+            tracing_data()
+              : capacity_(65536), format_(chrome_trace),
+                multiple_localities_(false),
+                start_ticks_(0), start_time_(0), ns_per_tick_(1.0)
+            {}
+
+            event_buffer* register_buffer()
+            {
+                std::lock_guard<compat::mutex> l(mtx_);
+                buffers_.emplace_back(
+                    new event_buffer(capacity_, hpx::get_thread_name()));
+                return buffers_.back().get();
+            }
+
+            std::uint64_t get_time(std::uint64_t ticks) const
+            {
+                if (ticks <= start_ticks_)
+                    return 0;
+                return static_cast<std::uint64_t>(
+                    (ticks - start_ticks_) * ns_per_tick_);
+            }
+
+            compat::mutex mtx_;
+            std::vector<std::unique_ptr<event_buffer> > buffers_;
+
+            std::size_t capacity_;
+            trace_format format_;
+            std::string destination_;
+            bool multiple_localities_;
+
+            std::uint64_t start_ticks_;
+            std::uint64_t start_time_;
+            double ns_per_tick_;
+        };
+
+        tracing_data& get_tracing_data()
+        {
+            static tracing_data data;
+            return data;
+        }
+
+        // the buffers are owned by tracing_data, the pointer is never reset
+        struct tls_tag {};
+        util::thread_specific_ptr<event_buffer, tls_tag> buffer_;
+
+        event_buffer& get_buffer()
+        {
+            event_buffer* buffer = buffer_.get();
+            if (HPX_UNLIKELY(buffer == nullptr))
+            {
+                buffer = get_tracing_data().register_buffer();
+                buffer_.reset(buffer);
+            }
+            return *buffer;
+        }
+
+        // The time stamp counter is considerably cheaper to read than the
+        // system clock, the generic fallback has a resolution of milliseconds
+        // only, though.
+        std::uint64_t get_ticks()
+        {
+#if defined(HPX_HAVE_RDTSC) || defined(HPX_HAVE_RDTSCP) || defined(HPX_MSVC)
+            return util::hardware::timestamp();
+#else
+            return util::high_resolution_clock::now();
+#endif
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        std::string get_event_name(event const& e)
+        {
+            if (e.is_address_)
+            {
+                std::ostringstream strm;
+                strm << "0x" << std::hex << e.name_;
+                return strm.str();
+            }
+
+            if (e.name_ != 0)
+                return reinterpret_cast<char const*>(e.name_);
+
+            return e.type_ == task_steal ? "steal" : "<unknown>";
+        }
+
+        char const* get_event_category(event const& e)
+        {
+            switch (e.type_)
+            {
+            case task_steal:
+                return "scheduler";
+            case parcel_send: HPX_FALLTHROUGH;
+            case parcel_receive:
+                return "parcel";
+            default:
+                break;
+            }
+            return "task";
+        }
+
+        // Invoke f for all events still held by the given buffer, skipping
+        // the end of a task whose beginning has been overwritten already
+        template <typename F>
+        void for_each_event(event_buffer const& buffer, F && f)
+        {
+            std::uint64_t head = buffer.head_.load(boost::memory_order_acquire);
+            std::uint64_t size = buffer.events_.size();
+            std::uint64_t first = head > size ? head - size : 0;
+
+            bool in_task = false;
+            for (std::uint64_t i = first; i != head; ++i)
+            {
+                event const& e = buffer.events_[i & buffer.mask_];
+                if (e.type_ == task_begin)
+                {
+                    in_task = true;
+                }
+                else if (e.type_ == task_end || e.type_ == task_suspend)
+                {
+                    if (!in_task)
+                        continue;
+                    in_task = false;
+                }
+                f(e);
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Chrome trace event format (JSON) as understood by chrome://tracing
+        // and https://ui.perfetto.dev
+        void write_json_string(std::ostream& os, std::string const& s)
+        {
+            os << '"';
+            for (char c : s)
+            {
+                switch (c)
+                {
+                case '"':  os << "\\\""; break;
+                case '\\': os << "\\\\"; break;
+                case '\n': os << "\\n"; break;
+                case '\t': os << "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        os << "\\u" << std::hex << std::setw(4)
+                           << std::setfill('0') << int(c) << std::dec;
+                    }
+                    else
+                    {
+                        os << c;
+                    }
+                    break;
+                }
+            }
+            os << '"';
+        }
+
+        // time stamps are given in microseconds
+        void write_json_time(std::ostream& os, std::uint64_t time)
+        {
+            os << time / 1000 << '.' << std::setw(3) << std::setfill('0')
+               << time % 1000;
+        }
+
+        void write_chrome_trace(std::ostream& os, tracing_data const& data,
+            std::uint32_t locality_id)
+        {
+            os << "{\"traceEvents\":[\n"
+               << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":"
+               << locality_id << ",\"args\":{\"name\":\"locality#"
+               << locality_id << "\"}}";
+
+            std::size_t tid = 0;
+            for (auto const& buffer : data.buffers_)
+            {
+                os << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":"
+                   << locality_id << ",\"tid\":" << tid
+                   << ",\"args\":{\"name\":";
+                write_json_string(os, buffer->name_);
+                os << "}}";
+
+                for_each_event(*buffer,
+                    [&](event const& e)
+                    {
+                        os << ",\n{";
+                        if (e.type_ != task_end && e.type_ != task_suspend)
+                        {
+                            os << "\"name\":";
+                            write_json_string(os, get_event_name(e));
+                            os << ",\"cat\":\"" << get_event_category(e)
+                               << "\",";
+                        }
+
+                        switch (e.type_)
+                        {
+                        case task_begin:
+                            os << "\"ph\":\"B\"";
+                            break;
+                        case task_end: HPX_FALLTHROUGH;
+                        case task_suspend:
+                            os << "\"ph\":\"E\"";
+                            break;
+                        default:
+                            os << "\"ph\":\"i\",\"s\":\"t\"";
+                            break;
+                        }
+
+                        os << ",\"ts\":";
+                        write_json_time(os, data.get_time(e.timestamp_));
+                        os << ",\"pid\":" << locality_id << ",\"tid\":" << tid
+                           << ",\"args\":{";
+
+                        switch (e.type_)
+                        {
+                        case task_begin:
+                            os << "\"thread\":\"0x" << std::hex << e.id_
+                               << std::dec << '"';
+                            break;
+                        case task_end: HPX_FALLTHROUGH;
+                        case task_suspend:
+                            os << "\"state\":\""
+                               << threads::get_thread_state_name(
+                                      threads::thread_state_enum(e.data_))
+                               << '"';
+                            break;
+                        case task_steal:
+                            os << "\"thread\":\"0x" << std::hex << e.id_
+                               << std::dec << "\",\"victim\":" << e.data_;
+                            break;
+                        case parcel_send:
+                            os << "\"destination\":" << e.data_;
+                            break;
+                        default:
+                            break;
+                        }
+                        os << "}}";
+                    });
+
+                ++tid;
+            }
+
+            os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Perfetto trace format (protobuf), see
+        // https://perfetto.dev/docs/reference/trace-packet-proto
+        void write_varint(std::string& out, std::uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<char>(value));
+        }
+
+        void write_field(std::string& out, std::uint32_t field,
+            std::uint64_t value)
+        {
+            write_varint(out, field << 3);
+            write_varint(out, value);
+        }
+
+        void write_field(std::string& out, std::uint32_t field,
+            std::string const& value)
+        {
+            write_varint(out, (field << 3) | 2);
+            write_varint(out, value.size());
+            out += value;
+        }
+
+        // field numbers as defined by protos/perfetto/trace/trace_packet.proto
+        // and protos/perfetto/trace/track_event/*.proto
+        enum perfetto_field
+        {
+            trace_packet_field = 1,             // Trace
+            packet_timestamp = 8,               // TracePacket
+            packet_sequence_id = 10,
+            packet_track_event = 11,
+            packet_sequence_flags = 13,
+            packet_track_descriptor = 60,
+            track_event_type = 9,               // TrackEvent
+            track_event_track_uuid = 11,
+            track_event_category = 22,
+            track_event_name = 23,
+            track_descriptor_uuid = 1,          // TrackDescriptor
+            track_descriptor_name = 2,
+            track_descriptor_thread = 4,
+            thread_descriptor_pid = 1,          // ThreadDescriptor
+            thread_descriptor_tid = 2,
+            thread_descriptor_name = 5
+        };
+
+        enum perfetto_event_type
+        {
+            slice_begin = 1,
+            slice_end = 2,
+            instant = 3
+        };
+
+        void write_perfetto_trace(std::ostream& os, tracing_data const& data,
+            std::uint32_t locality_id)
+        {
+            std::uint32_t const sequence_id = 1;
+
+            std::string packet, message, nested;
+            auto write_packet =
+                [&]()
+                {
+                    nested.clear();
+                    write_field(nested, trace_packet_field, packet);
+                    os.write(nested.data(), nested.size());
+                };
+
+            std::uint64_t tid = 0;
+            for (auto const& buffer : data.buffers_)
+            {
+                std::uint64_t const uuid =
+                    (std::uint64_t(locality_id) << 32) | (tid + 1);
+
+                // describe the track of this OS-thread, Perfetto reserves
+                // the process and thread id zero
+                nested.clear();
+                write_field(nested, thread_descriptor_pid,
+                    std::uint64_t(locality_id) + 1);
+                write_field(nested, thread_descriptor_tid, tid + 1);
+                write_field(nested, thread_descriptor_name, buffer->name_);
+
+                message.clear();
+                write_field(message, track_descriptor_uuid, uuid);
+                write_field(message, track_descriptor_name, buffer->name_);
+                write_field(message, track_descriptor_thread, nested);
+
+                packet.clear();
+                write_field(packet, packet_sequence_id,
+                    std::uint64_t(sequence_id));
+                if (tid == 0)
+                {
+                    // SEQ_INCREMENTAL_STATE_CLEARED
+                    write_field(packet, packet_sequence_flags,
+                        std::uint64_t(1));
+                }
+                write_field(packet, packet_track_descriptor, message);
+                write_packet();
+
+                for_each_event(*buffer,
+                    [&](event const& e)
+                    {
+                        message.clear();
+                        switch (e.type_)
+                        {
+                        case task_begin:
+                            write_field(message, track_event_type,
+                                std::uint64_t(slice_begin));
+                            break;
+                        case task_end: HPX_FALLTHROUGH;
+                        case task_suspend:
+                            write_field(message, track_event_type,
+                                std::uint64_t(slice_end));
+                            break;
+                        default:
+                            write_field(message, track_event_type,
+                                std::uint64_t(instant));
+                            break;
+                        }
+                        write_field(message, track_event_track_uuid, uuid);
+                        if (e.type_ != task_end && e.type_ != task_suspend)
+                        {
+                            write_field(message, track_event_category,
+                                std::string(get_event_category(e)));
+                            write_field(message, track_event_name,
+                                get_event_name(e));
+                        }
+
+                        packet.clear();
+                        write_field(packet, packet_timestamp,
+                            data.get_time(e.timestamp_));
+                        write_field(packet, packet_sequence_id,
+                            std::uint64_t(sequence_id));
+                        write_field(packet, packet_track_event, message);
+                        write_packet();
+                    });
+
+                ++tid;
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        void record(event_type type, void const* id, char const* name,
+            std::size_t address, std::uint32_t data)
+        {
+            event e;
+            e.timestamp_ = get_ticks();
+            e.id_ = reinterpret_cast<std::uint64_t>(id);
+            e.name_ = name != nullptr ?
+                reinterpret_cast<std::uint64_t>(name) : address;
+            e.data_ = data;
+            e.type_ = static_cast<std::uint8_t>(type);
+            e.is_address_ = name == nullptr && address != 0;
+
+            get_buffer().push(e);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void start(util::section const& cfg)
+    {
+        tracing_data& data = get_tracing_data();
+        std::lock_guard<compat::mutex> l(data.mtx_);
+
+        detail::enabled = false;
+        if (cfg.get_entry("hpx.trace.enable", "0") != "1")
+            return;
+
+        std::string format = cfg.get_entry("hpx.trace.format", "chrome");
+        if (format == "chrome")
+        {
+            data.format_ = chrome_trace;
+        }
+        else if (format == "perfetto")
+        {
+            data.format_ = perfetto_trace;
+        }
+        else
+        {
+            HPX_THROW_EXCEPTION(bad_parameter, "tracing::start",
+                "unknown trace format: " + format +
+                " (possible values: chrome, perfetto)");
+        }
+
+        data.destination_ = cfg.get_entry("hpx.trace.destination",
+            "hpx-trace.json");
+        data.multiple_localities_ = util::safe_lexical_cast<std::size_t>(
+            cfg.get_entry("hpx.localities", "1"), 1) > 1;
+
+        // the buffer capacity has to be a power of two
+        std::size_t size = util::safe_lexical_cast<std::size_t>(
+            cfg.get_entry("hpx.trace.buffer_size", "65536"), 65536);
+        data.capacity_ = 16;
+        while (data.capacity_ < size)
+            data.capacity_ *= 2;
+
+        // buffers registered before keep their capacity
+        for (auto& buffer : data.buffers_)
+            buffer->head_.store(0);
+
+        data.start_time_ = util::high_resolution_clock::now();
+        data.start_ticks_ = get_ticks();
+
+        detail::enabled = true;
+    }
+
+    void stop(std::uint32_t locality_id)
+    {
+        tracing_data& data = get_tracing_data();
+        std::lock_guard<compat::mutex> l(data.mtx_);
+
+        if (!detail::enabled)
+            return;
+        detail::enabled = false;
+
+        // calibrate the hardware time stamps
+        std::uint64_t ticks = get_ticks() - data.start_ticks_;
+        std::uint64_t time = util::high_resolution_clock::now() -
+            data.start_time_;
+        if (ticks != 0 && time != 0)
+            data.ns_per_tick_ = double(time) / double(ticks);
+
+        std::string destination = data.destination_;
+        if (data.multiple_localities_)
+            destination += "." + std::to_string(locality_id);
+
+        std::ofstream out(destination.c_str(),
+            std::ofstream::out | std::ofstream::binary);
+        if (data.format_ == perfetto_trace)
+            write_perfetto_trace(out, data, locality_id);
+        else
+            write_chrome_trace(out, data, locality_id);
+    }
+}}}
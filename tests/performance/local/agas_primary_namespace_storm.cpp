@@ -0,0 +1,156 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Stress the tables of the AGAS primary namespace the way the AGAS root
+// locality sees them in a large run: many localities concurrently resolving
+// gids and sending credit decrements. The requests of the localities are
+// simulated by concurrent tasks running against a local instance of the
+// primary namespace service. The gids are taken from the allocator of that
+// instance and bound in blocks, the same way component heaps do.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/runtime/agas/gva.hpp>
+#include <hpx/runtime/agas/server/primary_namespace.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/tuple.hpp>
+
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+using hpx::naming::gid_type;
+
+// Run the storm from a single task: mostly resolves, every 'decref_ratio'th
+// operation is a credit increment followed by the matching decrement (which
+// never frees the object).
+void storm(hpx::agas::server::primary_namespace& ns,
+    std::vector<gid_type> const& blocks, std::size_t block_size,
+    std::size_t num_ops, std::size_t decref_ratio, unsigned int seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<std::size_t> block_dist(
+        0, blocks.size() - 1);
+    std::uniform_int_distribution<std::uint64_t> offset_dist(
+        0, block_size - 1);
+
+    for (std::size_t i = 0; i != num_ops; ++i)
+    {
+        gid_type id = blocks[block_dist(gen)] + offset_dist(gen);
+
+        if (decref_ratio != 0 && i % decref_ratio == 0)
+        {
+            ns.increment_credit(2, id, id);
+
+            std::vector<hpx::util::tuple<std::int64_t, gid_type, gid_type> >
+                requests;
+            requests.push_back(hpx::util::make_tuple(std::int64_t(-2), id, id));
+            ns.decrement_credit(std::move(requests));
+        }
+        else
+        {
+            ns.resolve_gid(id);
+        }
+    }
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::size_t const num_blocks = vm["blocks"].as<std::size_t>();
+    std::size_t const block_size = vm["block_size"].as<std::size_t>();
+    std::size_t const num_tasks = vm["tasks"].as<std::size_t>();
+    std::size_t const num_ops = vm["operations"].as<std::size_t>();
+    std::size_t const decref_ratio = vm["decref_ratio"].as<std::size_t>();
+
+    // the primary namespace is too large to be placed on the stack
+    std::unique_ptr<hpx::agas::server::primary_namespace> ns(
+        new hpx::agas::server::primary_namespace);
+
+    gid_type locality = hpx::naming::get_gid_from_locality_id(0);
+    ns->set_local_locality(locality);
+
+    // allocate and bind the gid blocks
+    std::vector<gid_type> blocks;
+    blocks.reserve(num_blocks);
+
+    int dummy = 0;
+    for (std::size_t b = 0; b != num_blocks; ++b)
+    {
+        gid_type lower = ns->allocate(block_size).first;
+        hpx::naming::detail::strip_internal_bits_from_gid(lower);
+
+        hpx::agas::gva g(locality,
+            hpx::components::component_runtime_support, block_size, &dummy);
+        ns->bind_gid(g, lower, locality);
+
+        blocks.push_back(lower);
+    }
+
+    std::uint64_t start = hpx::util::high_resolution_clock::now();
+
+    std::vector<hpx::future<void> > tasks;
+    tasks.reserve(num_tasks);
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        tasks.push_back(hpx::async(&storm, std::ref(*ns), std::cref(blocks),
+            block_size, num_ops, decref_ratio, static_cast<unsigned int>(i)));
+    }
+    hpx::wait_all(tasks);
+
+    double elapsed = (hpx::util::high_resolution_clock::now() - start) / 1e9;
+
+    if (vm.count("no-header") == 0)
+    {
+        hpx::cout << "num_cores,blocks,tasks,operations,time[s],"
+                     "throughput[ops/s]\n";
+    }
+
+    hpx::cout
+        << (boost::format("%d,%d,%d,%d,%f,%f\n") %
+                hpx::get_os_thread_count() % num_blocks % num_tasks %
+                (num_tasks * num_ops) % elapsed %
+                ((num_tasks * num_ops) / elapsed))
+        << hpx::flush;
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    namespace po = boost::program_options;
+    po::options_description cmdline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ("blocks",
+            po::value<std::size_t>()->default_value(1024),
+            "number of gid blocks allocated and bound (default: 1024)")
+        ("block_size",
+            po::value<std::size_t>()->default_value(4096),
+            "number of gids per bulk allocated block (default: 4096)")
+        ("tasks",
+            po::value<std::size_t>()->default_value(256),
+            "number of concurrent tasks sending requests (default: 256)")
+        ("operations",
+            po::value<std::size_t>()->default_value(10000),
+            "number of operations per task (default: 10000)")
+        ("decref_ratio",
+            po::value<std::size_t>()->default_value(4),
+            "every n-th operation is a credit increment/decrement pair, "
+            "no credit operations if zero (default: 4)")
+        ("no-header", "do not print out the csv header row")
+        ;
+
+    return hpx::init(cmdline, argc, argv);
+}
@@ -0,0 +1,130 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measure the throughput of writing and reading a file using asynchronous
+// file operations with a given number of operations in flight.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/runtime/io/async_file.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Issue all blocks of the file, keeping at most 'depth' operations in flight,
+// returns the elapsed time in seconds.
+template <typename F>
+double transfer(std::size_t num_blocks, std::size_t depth, F && op)
+{
+    std::vector<hpx::future<std::size_t> > in_flight(depth);
+
+    std::uint64_t start = hpx::util::high_resolution_clock::now();
+    for (std::size_t i = 0; i != num_blocks; ++i)
+    {
+        hpx::future<std::size_t>& slot = in_flight[i % depth];
+        if (slot.valid())
+            slot.get();
+        slot = op(i, i % depth);
+    }
+    for (hpx::future<std::size_t>& f : in_flight)
+    {
+        if (f.valid())
+            f.get();
+    }
+    return (hpx::util::high_resolution_clock::now() - start) / 1e9;
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::string const path = vm["file"].as<std::string>();
+    std::size_t const block_size = vm["block-size"].as<std::size_t>() * 1024;
+    std::size_t const depth = vm["depth"].as<std::size_t>();
+    std::size_t const num_blocks =
+        (vm["size"].as<std::size_t>() * 1024 * 1024) / block_size;
+    bool const registered = vm.count("registered") != 0;
+
+    // one buffer per operation in flight
+    std::vector<char> memory(depth * block_size, 'x');
+    if (registered)
+    {
+        hpx::io::register_buffers(std::vector<hpx::io::mutable_buffer>(1,
+            hpx::io::mutable_buffer(memory.data(), memory.size())));
+    }
+
+    double write_time = 0, read_time = 0;
+    {
+        hpx::io::async_file file(path, hpx::io::mode_read_write |
+            hpx::io::mode_create | hpx::io::mode_truncate);
+
+        write_time = transfer(num_blocks, depth,
+            [&](std::size_t block, std::size_t slot)
+            {
+                return file.write(block * block_size,
+                    &memory[slot * block_size], block_size);
+            });
+
+        std::uint64_t start = hpx::util::high_resolution_clock::now();
+        file.fsync().get();
+        write_time += (hpx::util::high_resolution_clock::now() - start) / 1e9;
+
+        read_time = transfer(num_blocks, depth,
+            [&](std::size_t block, std::size_t slot)
+            {
+                return file.read(block * block_size,
+                    &memory[slot * block_size], block_size);
+            });
+    }
+
+    if (registered)
+        hpx::io::unregister_buffers();
+    std::remove(path.c_str());
+
+    double const total = double(num_blocks * block_size) / (1024 * 1024);
+    hpx::cout
+        << (boost::format(
+               "backend, block size [kB], depth, size [MB], "
+               "write [MB/s], read [MB/s]\n"
+               "%s, %d, %d, %d, %.1f, %.1f\n") %
+            hpx::io::get_backend_name() % (block_size / 1024) % depth %
+            total % (total / write_time) % (total / read_time))
+        << hpx::flush;
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description cmdline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ("file",
+         boost::program_options::value<std::string>()->default_value(
+             "async_file_throughput.dat"),
+         "file to write and read (removed afterwards)")
+        ("size",
+         boost::program_options::value<std::size_t>()->default_value(1024),
+         "amount of data to transfer [MB]")
+        ("block-size",
+         boost::program_options::value<std::size_t>()->default_value(1024),
+         "size of a single operation [kB]")
+        ("depth",
+         boost::program_options::value<std::size_t>()->default_value(16),
+         "number of operations in flight")
+        ("registered",
+         "register the buffers with the kernel")
+        ;
+
+    return hpx::init(cmdline, argc, argv);
+}
@@ -0,0 +1,119 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measure the throughput of creating and destroying many small (managed)
+// components concurrently from all worker threads, the way a graph
+// application creates its vertices. The vertices are created either one by
+// one or in bulk (--bulk).
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct vertex_server
+  : hpx::components::managed_component_base<vertex_server>
+{
+    vertex_server() : value_(0) {}
+
+    std::uint64_t value_;
+};
+
+typedef hpx::components::managed_component<vertex_server> server_type;
+HPX_REGISTER_COMPONENT(server_type, vertex_server);
+
+///////////////////////////////////////////////////////////////////////////////
+// Create the given number of vertices, and release them again.
+void create_vertices(std::size_t num_vertices)
+{
+    std::vector<hpx::id_type> vertices;
+    vertices.reserve(num_vertices);
+
+    for (std::size_t i = 0; i != num_vertices; ++i)
+        vertices.push_back(hpx::local_new<vertex_server>().get());
+}
+
+// Create the given number of vertices at once, and release them again.
+void bulk_create_vertices(std::size_t num_vertices)
+{
+    std::vector<hpx::id_type> vertices =
+        hpx::new_<vertex_server[]>(hpx::find_here(), num_vertices).get();
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::size_t const num_tasks = vm["tasks"].as<std::size_t>();
+    std::size_t const num_vertices = vm["vertices"].as<std::size_t>();
+    std::size_t const num_iterations = vm["iterations"].as<std::size_t>();
+    bool const bulk = vm.count("bulk") != 0;
+
+    std::uint64_t start = hpx::util::high_resolution_clock::now();
+
+    for (std::size_t iter = 0; iter != num_iterations; ++iter)
+    {
+        std::vector<hpx::future<void> > tasks;
+        tasks.reserve(num_tasks);
+        for (std::size_t i = 0; i != num_tasks; ++i)
+        {
+            tasks.push_back(hpx::async(
+                bulk ? &bulk_create_vertices : &create_vertices,
+                num_vertices));
+        }
+        hpx::wait_all(tasks);
+    }
+
+    // make sure all vertices have been destroyed
+    hpx::agas::garbage_collect();
+
+    double elapsed = (hpx::util::high_resolution_clock::now() - start) / 1e9;
+    std::size_t const total = num_iterations * num_tasks * num_vertices;
+
+    if (vm.count("no-header") == 0)
+    {
+        hpx::cout
+            << "num_cores,bulk,tasks,vertices,time[s],throughput[1/s]\n";
+    }
+
+    hpx::cout
+        << (boost::format("%d,%d,%d,%d,%f,%f\n") %
+                hpx::get_os_thread_count() % bulk % num_tasks % total %
+                elapsed % (total / elapsed))
+        << hpx::flush;
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    namespace po = boost::program_options;
+    po::options_description cmdline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ("tasks",
+            po::value<std::size_t>()->default_value(256),
+            "number of concurrent tasks creating vertices (default: 256)")
+        ("vertices",
+            po::value<std::size_t>()->default_value(10000),
+            "number of vertices created by each task (default: 10000)")
+        ("iterations",
+            po::value<std::size_t>()->default_value(4),
+            "number of times all vertices are created (default: 4)")
+        ("bulk", "create the vertices of each task at once")
+        ("no-header", "do not print out the csv header row")
+        ;
+
+    return hpx::init(cmdline, argc, argv);
+}
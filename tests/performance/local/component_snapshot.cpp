@@ -0,0 +1,151 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measure the bandwidth of taking full and incremental snapshots of all
+// (migratable) components living on a locality.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/component_storage.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/serialization.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/unwrap.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct payload_server
+  : hpx::components::migration_support<
+        hpx::components::simple_component_base<payload_server>
+    >
+{
+    payload_server() {}
+    explicit payload_server(std::size_t size) : data_(size, 'x') {}
+
+    payload_server(payload_server const& rhs) : data_(rhs.data_) {}
+    payload_server(payload_server && rhs) : data_(std::move(rhs.data_)) {}
+
+    void touch() { if (!data_.empty()) ++data_[0]; }
+    HPX_DEFINE_COMPONENT_ACTION(payload_server, touch, touch_action);
+
+    template <typename Archive>
+    void serialize(Archive& ar, unsigned)
+    {
+        ar & data_;
+    }
+
+    std::vector<char> data_;
+};
+
+typedef hpx::components::simple_component<payload_server> server_type;
+HPX_REGISTER_COMPONENT(server_type, payload_server);
+
+typedef payload_server::touch_action touch_action;
+HPX_REGISTER_ACTION_DECLARATION(touch_action);
+HPX_REGISTER_ACTION(touch_action);
+
+///////////////////////////////////////////////////////////////////////////////
+// Take a snapshot, returns the elapsed time in seconds and the number of
+// bytes written.
+double take_snapshot(hpx::components::component_storage const& storage,
+    bool incremental, std::uint64_t& bytes)
+{
+    std::uint64_t start = hpx::util::high_resolution_clock::now();
+    bytes = hpx::components::snapshot(storage, incremental).get();
+    return (hpx::util::high_resolution_clock::now() - start) / 1e9;
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::size_t const num_components = vm["components"].as<std::size_t>();
+    std::size_t const payload = vm["payload"].as<std::size_t>();
+    std::size_t const dirty = vm["dirty"].as<std::size_t>();
+    std::string const path = vm["path"].as<std::string>();
+
+    std::uint64_t full_bytes = 0, incremental_bytes = 0;
+    double full_time = 0, incremental_time = 0;
+    {
+        hpx::components::component_storage storage = path.empty() ?
+            hpx::components::component_storage(hpx::find_here()) :
+            hpx::components::component_storage(hpx::find_here(), path);
+
+        std::vector<hpx::future<hpx::id_type> > create;
+        create.reserve(num_components);
+        for (std::size_t i = 0; i != num_components; ++i)
+        {
+            create.push_back(
+                hpx::new_<payload_server>(hpx::find_here(), payload));
+        }
+        std::vector<hpx::id_type> ids = hpx::util::unwrap(create);
+
+        full_time = take_snapshot(storage, false, full_bytes);
+
+        // modify the given percentage of the components
+        std::vector<hpx::future<void> > touched;
+        if (dirty != 0)
+        {
+            std::size_t const stride = (std::max)(std::size_t(1), 100 / dirty);
+            for (std::size_t i = 0; i < num_components; i += stride)
+                touched.push_back(hpx::async<touch_action>(ids[i]));
+        }
+        hpx::wait_all(touched);
+
+        incremental_time = take_snapshot(storage, true, incremental_bytes);
+    }
+
+    if (!path.empty())
+        boost::filesystem::remove_all(path);
+
+    double const mb = 1024. * 1024.;
+    hpx::cout
+        << (boost::format(
+               "storage, components, payload [B], dirty [%%], "
+               "full [MB], full [MB/s], incremental [MB], incremental [MB/s]\n"
+               "%s, %d, %d, %d, %.1f, %.1f, %.1f, %.1f\n") %
+            (path.empty() ? "memory" : "segments") % num_components %
+            payload % dirty %
+            (full_bytes / mb) % (full_bytes / mb / full_time) %
+            (incremental_bytes / mb) %
+            (incremental_bytes / mb / incremental_time))
+        << hpx::flush;
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description cmdline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ("components",
+         boost::program_options::value<std::size_t>()->default_value(10000),
+         "number of components to snapshot")
+        ("payload",
+         boost::program_options::value<std::size_t>()->default_value(4096),
+         "size of the state of a single component [bytes]")
+        ("dirty",
+         boost::program_options::value<std::size_t>()->default_value(10),
+         "percentage of components modified before the incremental snapshot")
+        ("path",
+         boost::program_options::value<std::string>()->default_value(
+             "component_snapshot.segments"),
+         "directory to store the snapshots in (removed afterwards), keep "
+         "the snapshots in memory if empty")
+        ;
+
+    return hpx::init(cmdline, argc, argv);
+}
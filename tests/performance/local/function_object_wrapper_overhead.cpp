@@ -13,9 +13,11 @@
 #include <boost/function.hpp>
 #include <boost/program_options.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <iostream>
+#include <memory>
 
 #include "worker_timed.hpp"
 
@@ -39,6 +41,20 @@ struct foo
     template <typename Archive> void serialize(Archive&, unsigned int) {}
 };
 
+// captures a few shared pointers and an id, which exceeds the default
+// function storage
+struct bar
+{
+    void operator()() const
+    {
+        worker_timed(delay * 1000);
+    }
+
+    std::shared_ptr<int> p1;
+    std::shared_ptr<int> p2;
+    std::uint64_t id;
+};
+
 template <typename F>
 void run(F const & f, std::uint64_t local_iterations)
 {
@@ -53,6 +69,24 @@ void run(F const & f, std::uint64_t local_iterations)
               << ((elapsed/i)*1e9) << " ns\n";
 }
 
+// construct the function object wrapper for every invocation
+template <typename Function, typename F>
+void run_construct(F const & f, std::uint64_t local_iterations)
+{
+    std::uint64_t i = 0;
+    hpx::util::high_resolution_timer t;
+
+    for (; i < local_iterations; ++i)
+    {
+        Function func = f;
+        func();
+    }
+
+    double elapsed = t.elapsed();
+    std::cout << " walltime/iteration: "
+              << ((elapsed/i)*1e9) << " ns\n";
+}
+
 int app_main(
     variables_map& vm
     )
@@ -83,6 +117,23 @@ int app_main(
         run(f, iterations);
     }
 
+    bar b = { std::make_shared<int>(0), std::make_shared<int>(1), 2 };
+    {
+        std::cout << "hpx::util::function (non-serializable, construct)";
+        run_construct<hpx::util::function<void(), false> >(b, iterations);
+    }
+    {
+        std::cout << "hpx::util::function (non-serializable, construct, "
+            "inline storage)";
+        run_construct<
+            hpx::util::function<void(), false, 8 * sizeof(void*)>
+        >(b, iterations);
+    }
+    {
+        std::cout << "std::function (construct)";
+        run_construct<std::function<void()> >(b, iterations);
+    }
+
     return 0;
 }
 
@@ -121,6 +121,42 @@ void measure_function_futures(std::uint64_t count, bool csv)
               << flush;
 }
 
+double null_continuation(future<double> r)
+{
+    return r.get();
+}
+
+// the placement of the continuations can be controlled using
+// --hpx:ini=hpx.continuations.placement=local|any
+void measure_continuation_futures(std::uint64_t count, bool csv)
+{
+    std::vector<future<double> > futures;
+
+    futures.reserve(count);
+
+    // start the clock
+    high_resolution_timer walltime;
+
+    for (std::uint64_t i = 0; i < count; ++i)
+        futures.push_back(async(&null_function).then(&null_continuation));
+
+    wait_each(scratcher(), futures);
+
+    // stop the clock
+    const double duration = walltime.elapsed();
+
+    if (csv)
+        cout << ( boost::format("%1%,%2%\n")
+                % count
+                % duration)
+              << flush;
+    else
+        cout << ( boost::format("invoked %1% futures (continuations) in %2% seconds\n")
+                % count
+                % duration)
+              << flush;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(
     variables_map& vm
@@ -136,6 +172,7 @@ int hpx_main(
 
         measure_action_futures(count, vm.count("csv") != 0);
         measure_function_futures(count, vm.count("csv") != 0);
+        measure_continuation_futures(count, vm.count("csv") != 0);
     }
 
     finalize();
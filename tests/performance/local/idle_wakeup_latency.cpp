@@ -0,0 +1,86 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measure the latency of a request/response exchange issued after all worker
+// threads went idle, as well as the CPU time consumed while idling (which is
+// a rough indicator of the power drawn by idle workers).
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::uint64_t respond(std::uint64_t request)
+{
+    return request + 1;
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::size_t const iterations = vm["iterations"].as<std::size_t>();
+    std::uint64_t const pause = vm["pause"].as<std::uint64_t>();
+
+    std::vector<std::uint64_t> latencies;
+    latencies.reserve(iterations);
+
+    std::clock_t cpu_start = std::clock();
+    std::uint64_t wall_start = hpx::util::high_resolution_clock::now();
+
+    for (std::size_t i = 0; i != iterations; ++i)
+    {
+        // give the workers time to go idle
+        hpx::this_thread::sleep_for(std::chrono::microseconds(pause));
+
+        std::uint64_t start = hpx::util::high_resolution_clock::now();
+        hpx::async(&respond, i).get();
+        latencies.push_back(hpx::util::high_resolution_clock::now() - start);
+    }
+
+    double wall = (hpx::util::high_resolution_clock::now() - wall_start) / 1e9;
+    double cpu = double(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+    std::sort(latencies.begin(), latencies.end());
+
+    hpx::cout
+        << (boost::format(
+               "OS-threads, iterations, pause [us], latency median [us], "
+               "latency 99th percentile [us], CPU time/wall time\n"
+               "%d, %d, %d, %.3f, %.3f, %.3f\n") %
+            hpx::get_os_thread_count() % iterations % pause %
+            (latencies[iterations / 2] / 1e3) %
+            (latencies[(iterations * 99) / 100] / 1e3) % (cpu / wall))
+        << hpx::flush;
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description cmdline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ("iterations",
+         boost::program_options::value<std::size_t>()->default_value(1000),
+         "number of request/response exchanges to perform")
+        ("pause",
+         boost::program_options::value<std::uint64_t>()->default_value(5000),
+         "time between two requests [us]")
+        ;
+
+    return hpx::init(cmdline, argc, argv);
+}
@@ -0,0 +1,183 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/parallel_copy.hpp>
+#include <hpx/include/parallel_remove_copy.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+
+///////////////////////////////////////////////////////////////////////////////
+int test_count = 100;
+
+struct is_even
+{
+    template <typename T>
+    bool operator()(T const& val) const
+    {
+        return std::int64_t(val) % 2 == 0;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Policy, typename Vector>
+std::uint64_t copy_if_vector(Policy && policy, Vector const& v, Vector& dest)
+{
+    std::uint64_t start = hpx::util::high_resolution_clock::now();
+
+    for (int i = 0; i != test_count; ++i)
+    {
+        hpx::parallel::copy_if(std::forward<Policy>(policy),
+            std::begin(v), std::end(v), std::begin(dest), ::is_even());
+    }
+
+    return (hpx::util::high_resolution_clock::now() - start) / test_count;
+}
+
+template <typename Policy, typename Vector>
+std::uint64_t remove_copy_if_vector(Policy && policy, Vector const& v,
+    Vector& dest)
+{
+    std::uint64_t start = hpx::util::high_resolution_clock::now();
+
+    for (int i = 0; i != test_count; ++i)
+    {
+        hpx::parallel::remove_copy_if(std::forward<Policy>(policy),
+            std::begin(v), std::end(v), std::begin(dest), ::is_even());
+    }
+
+    return (hpx::util::high_resolution_clock::now() - start) / test_count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Vector>
+void print_timings(std::string const& name, Vector const& v, Vector& dest,
+    std::uint64_t const* seq_ref, std::uint64_t const* par_ref)
+{
+    hpx::cout << "copy_if " << name << "(execution::seq): "
+        << copy_if_vector(hpx::parallel::execution::seq, v, dest) /
+                double(seq_ref[0])
+        << "\n";
+    hpx::cout << "copy_if " << name << "(execution::par): "
+        << copy_if_vector(hpx::parallel::execution::par, v, dest) /
+                double(par_ref[0]) //-V106
+        << "\n";
+    hpx::cout << "remove_copy_if " << name << "(execution::seq): "
+        << remove_copy_if_vector(hpx::parallel::execution::seq, v, dest) /
+                double(seq_ref[1])
+        << "\n";
+    hpx::cout << "remove_copy_if " << name << "(execution::par): "
+        << remove_copy_if_vector(hpx::parallel::execution::par, v, dest) /
+                double(par_ref[1]) //-V106
+        << "\n";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::size_t vector_size = vm["vector_size"].as<std::size_t>();
+    test_count = vm["test_count"].as<int>();
+
+    // verify that input is within domain of program
+    if (test_count == 0 || test_count < 0) {
+        hpx::cout << "test_count cannot be zero or negative...\n" << hpx::flush;
+    }
+    else {
+        std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+        // retrieve reference time, every other element is selected
+        std::vector<double> ref(vector_size);
+        std::vector<double> ref_dest(vector_size);
+        std::vector<std::size_t> positions(vector_size);
+        for (std::size_t i = 0; i != vector_size; ++i)
+        {
+            ref[i] = double(i);
+            positions[i] = i;
+        }
+
+        std::uint64_t seq_ref[] = {
+            copy_if_vector(hpx::parallel::execution::seq, ref, ref_dest),
+            remove_copy_if_vector(hpx::parallel::execution::seq, ref, ref_dest)
+        };
+        std::uint64_t par_ref[] = {
+            copy_if_vector(hpx::parallel::execution::par, ref,
+                ref_dest), //-V106
+            remove_copy_if_vector(hpx::parallel::execution::par, ref,
+                ref_dest) //-V106
+        };
+
+        {
+            hpx::partitioned_vector<double> v(vector_size);
+            hpx::partitioned_vector<double> dest(vector_size);
+            v.set_values(hpx::launch::sync, positions, ref);
+
+            print_timings("hpx::partitioned_vector<double>", v, dest,
+                seq_ref, par_ref);
+        }
+
+        {
+            hpx::partitioned_vector<double> v(vector_size,
+                hpx::container_layout(localities));
+            hpx::partitioned_vector<double> dest(vector_size,
+                hpx::container_layout(localities));
+            v.set_values(hpx::launch::sync, positions, ref);
+
+            print_timings("hpx::partitioned_vector<double>"
+                    "[container_layout(localities)]", v, dest,
+                seq_ref, par_ref);
+        }
+
+        {
+            hpx::partitioned_vector<double> v(vector_size,
+                hpx::container_layout(10, localities));
+            hpx::partitioned_vector<double> dest(vector_size,
+                hpx::container_layout(10, localities));
+            v.set_values(hpx::launch::sync, positions, ref);
+
+            print_timings("hpx::partitioned_vector<double>"
+                    "[container_layout(10, localities)]", v, dest,
+                seq_ref, par_ref);
+        }
+    }
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    //initialize program
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    boost::program_options::options_description cmdline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ("vector_size"
+        , boost::program_options::value<std::size_t>()->default_value(100000)
+        , "size of vectors (default: 100000)")
+
+        ("test_count"
+        , boost::program_options::value<int>()->default_value(100)
+        , "number of tests to be averaged (default: 100)")
+        ;
+
+    return hpx::init(cmdline, argc, argv, cfg);
+}
@@ -0,0 +1,165 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/parallel_equal.hpp>
+#include <hpx/include/parallel_mismatch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+
+///////////////////////////////////////////////////////////////////////////////
+int test_count = 100;
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Policy, typename Vector>
+std::uint64_t equal_vector(Policy && policy, Vector const& v1,
+    Vector const& v2)
+{
+    std::uint64_t start = hpx::util::high_resolution_clock::now();
+
+    for (int i = 0; i != test_count; ++i)
+    {
+        hpx::parallel::equal(std::forward<Policy>(policy),
+            std::begin(v1), std::end(v1), std::begin(v2));
+    }
+
+    return (hpx::util::high_resolution_clock::now() - start) / test_count;
+}
+
+template <typename Policy, typename Vector>
+std::uint64_t mismatch_vector(Policy && policy, Vector const& v1,
+    Vector const& v2)
+{
+    std::uint64_t start = hpx::util::high_resolution_clock::now();
+
+    for (int i = 0; i != test_count; ++i)
+    {
+        hpx::parallel::mismatch(std::forward<Policy>(policy),
+            std::begin(v1), std::end(v1), std::begin(v2));
+    }
+
+    return (hpx::util::high_resolution_clock::now() - start) / test_count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Vector>
+void print_timings(std::string const& name, Vector const& v1,
+    Vector const& v2, std::uint64_t const* seq_ref,
+    std::uint64_t const* par_ref)
+{
+    hpx::cout << "equal " << name << "(execution::seq): "
+        << equal_vector(hpx::parallel::execution::seq, v1, v2) /
+                double(seq_ref[0])
+        << "\n";
+    hpx::cout << "equal " << name << "(execution::par): "
+        << equal_vector(hpx::parallel::execution::par, v1, v2) /
+                double(par_ref[0]) //-V106
+        << "\n";
+    hpx::cout << "mismatch " << name << "(execution::seq): "
+        << mismatch_vector(hpx::parallel::execution::seq, v1, v2) /
+                double(seq_ref[1])
+        << "\n";
+    hpx::cout << "mismatch " << name << "(execution::par): "
+        << mismatch_vector(hpx::parallel::execution::par, v1, v2) /
+                double(par_ref[1]) //-V106
+        << "\n";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::size_t vector_size = vm["vector_size"].as<std::size_t>();
+    test_count = vm["test_count"].as<int>();
+
+    // verify that input is within domain of program
+    if (test_count == 0 || test_count < 0) {
+        hpx::cout << "test_count cannot be zero or negative...\n" << hpx::flush;
+    }
+    else {
+        std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+        // retrieve reference time, both sequences compare equal, which
+        // forces the algorithms to look at all elements
+        std::vector<double> ref1(vector_size, 1.0);
+        std::vector<double> ref2(vector_size, 1.0);
+        std::uint64_t seq_ref[] = {
+            equal_vector(hpx::parallel::execution::seq, ref1, ref2),
+            mismatch_vector(hpx::parallel::execution::seq, ref1, ref2)
+        };
+        std::uint64_t par_ref[] = {
+            equal_vector(hpx::parallel::execution::par, ref1, ref2), //-V106
+            mismatch_vector(hpx::parallel::execution::par, ref1, ref2) //-V106
+        };
+
+        {
+            hpx::partitioned_vector<double> v1(vector_size, 1.0);
+            hpx::partitioned_vector<double> v2(vector_size, 1.0);
+
+            print_timings("hpx::partitioned_vector<double>", v1, v2,
+                seq_ref, par_ref);
+        }
+
+        {
+            hpx::partitioned_vector<double> v1(vector_size, 1.0,
+                hpx::container_layout(localities));
+            hpx::partitioned_vector<double> v2(vector_size, 1.0,
+                hpx::container_layout(localities));
+
+            print_timings("hpx::partitioned_vector<double>"
+                    "[container_layout(localities)]", v1, v2,
+                seq_ref, par_ref);
+        }
+
+        {
+            hpx::partitioned_vector<double> v1(vector_size, 1.0,
+                hpx::container_layout(10, localities));
+            hpx::partitioned_vector<double> v2(vector_size, 1.0,
+                hpx::container_layout(10, localities));
+
+            print_timings("hpx::partitioned_vector<double>"
+                    "[container_layout(10, localities)]", v1, v2,
+                seq_ref, par_ref);
+        }
+    }
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    //initialize program
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    boost::program_options::options_description cmdline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ("vector_size"
+        , boost::program_options::value<std::size_t>()->default_value(100000)
+        , "size of vectors (default: 100000)")
+
+        ("test_count"
+        , boost::program_options::value<int>()->default_value(100)
+        , "number of tests to be averaged (default: 100)")
+        ;
+
+    return hpx::init(cmdline, argc, argv, cfg);
+}
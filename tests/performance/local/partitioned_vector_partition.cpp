@@ -0,0 +1,165 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/parallel_partition.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+
+///////////////////////////////////////////////////////////////////////////////
+int test_count = 100;
+
+struct is_even
+{
+    bool operator()(double val) const
+    {
+        return std::int64_t(val) % 2 == 0;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+void reset_values(std::vector<double>& v, std::vector<double> const& values,
+    std::vector<std::size_t> const&)
+{
+    v = values;
+}
+
+void reset_values(hpx::partitioned_vector<double>& v,
+    std::vector<double> const& values,
+    std::vector<std::size_t> const& positions)
+{
+    v.set_values(hpx::launch::sync, positions, values);
+}
+
+// the values are reset before each of the runs, only the partitioning itself
+// is measured
+template <typename Policy, typename Vector>
+std::uint64_t partition_vector(Policy && policy, Vector& v,
+    std::vector<double> const& values,
+    std::vector<std::size_t> const& positions)
+{
+    std::uint64_t time = 0;
+
+    for (int i = 0; i != test_count; ++i)
+    {
+        reset_values(v, values, positions);
+
+        std::uint64_t start = hpx::util::high_resolution_clock::now();
+        hpx::parallel::partition(std::forward<Policy>(policy),
+            std::begin(v), std::end(v), is_even());
+        time += hpx::util::high_resolution_clock::now() - start;
+    }
+
+    return time / test_count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Vector>
+void print_timings(std::string const& name, Vector& v,
+    std::vector<double> const& values,
+    std::vector<std::size_t> const& positions,
+    std::uint64_t seq_ref, std::uint64_t par_ref)
+{
+    hpx::cout << "partition " << name << "(execution::seq): "
+        << partition_vector(hpx::parallel::execution::seq, v, values,
+                positions) / double(seq_ref)
+        << "\n";
+    hpx::cout << "partition " << name << "(execution::par): "
+        << partition_vector(hpx::parallel::execution::par, v, values,
+                positions) / double(par_ref) //-V106
+        << "\n";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::size_t vector_size = vm["vector_size"].as<std::size_t>();
+    test_count = vm["test_count"].as<int>();
+
+    // verify that input is within domain of program
+    if (test_count == 0 || test_count < 0) {
+        hpx::cout << "test_count cannot be zero or negative...\n" << hpx::flush;
+    }
+    else {
+        std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+        // retrieve reference time, the elements satisfying the predicate are
+        // all located in the second half of the vector
+        std::vector<double> values(vector_size);
+        std::vector<std::size_t> positions(vector_size);
+        for (std::size_t i = 0; i != vector_size; ++i)
+        {
+            values[i] = double(i < vector_size / 2 ? 2 * i + 1 : 2 * i);
+            positions[i] = i;
+        }
+
+        std::vector<double> ref;
+        std::uint64_t seq_ref = partition_vector(
+            hpx::parallel::execution::seq, ref, values, positions);
+        std::uint64_t par_ref = partition_vector(
+            hpx::parallel::execution::par, ref, values, positions); //-V106
+
+        {
+            hpx::partitioned_vector<double> v(vector_size);
+            print_timings("hpx::partitioned_vector<double>", v, values,
+                positions, seq_ref, par_ref);
+        }
+
+        {
+            hpx::partitioned_vector<double> v(vector_size,
+                hpx::container_layout(localities));
+            print_timings("hpx::partitioned_vector<double>"
+                    "[container_layout(localities)]", v, values,
+                positions, seq_ref, par_ref);
+        }
+
+        {
+            hpx::partitioned_vector<double> v(vector_size,
+                hpx::container_layout(10, localities));
+            print_timings("hpx::partitioned_vector<double>"
+                    "[container_layout(10, localities)]", v, values,
+                positions, seq_ref, par_ref);
+        }
+    }
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    //initialize program
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    boost::program_options::options_description cmdline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ("vector_size"
+        , boost::program_options::value<std::size_t>()->default_value(100000)
+        , "size of vectors (default: 100000)")
+
+        ("test_count"
+        , boost::program_options::value<int>()->default_value(100)
+        , "number of tests to be averaged (default: 100)")
+        ;
+
+    return hpx::init(cmdline, argc, argv, cfg);
+}
@@ -14,7 +14,8 @@
 // until reaching the root actor. (The answer should be 499999500000).
 
 // This code implements two versions of the skynet micro benchmark: a 'normal'
-// and a futurized one.
+// and a futurized one. Both are run using help-first (launch::async) and
+// work-first (launch::fork) spawning of the actors.
 
 #include <hpx/hpx_main.hpp>
 #include <hpx/hpx.hpp>
@@ -24,7 +25,8 @@
 #include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
-std::int64_t skynet(std::int64_t num, std::int64_t size, std::int64_t div)
+std::int64_t skynet(hpx::launch policy, std::int64_t num, std::int64_t size,
+    std::int64_t div)
 {
     if (size != 1)
     {
@@ -36,7 +38,8 @@ std::int64_t skynet(std::int64_t num, std::int64_t size, std::int64_t div)
         for (std::int64_t i = 0; i != div; ++i)
         {
             std::int64_t sub_num = num + i * size;
-            results.push_back(hpx::async(skynet, sub_num, size, div));
+            results.push_back(
+                hpx::async(policy, skynet, policy, sub_num, size, div));
         }
 
         hpx::wait_all(results);
@@ -51,7 +54,8 @@ std::int64_t skynet(std::int64_t num, std::int64_t size, std::int64_t div)
 
 ///////////////////////////////////////////////////////////////////////////////
 hpx::future<std::int64_t>
-skynet_f(std::int64_t num, std::int64_t size, std::int64_t div)
+skynet_f(hpx::launch policy, std::int64_t num, std::int64_t size,
+    std::int64_t div)
 {
     if (size != 1)
     {
@@ -63,7 +67,8 @@ skynet_f(std::int64_t num, std::int64_t size, std::int64_t div)
         for (std::int64_t i = 0; i != div; ++i)
         {
             std::int64_t sub_num = num + i * size;
-            results.push_back(hpx::async(skynet_f, sub_num, size, div));
+            results.push_back(
+                hpx::async(policy, skynet_f, policy, sub_num, size, div));
         }
 
         return hpx::dataflow(
@@ -80,33 +85,40 @@ skynet_f(std::int64_t num, std::int64_t size, std::int64_t div)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-int main()
+void run(hpx::launch policy, char const* name)
 {
     {
         std::uint64_t t = hpx::util::high_resolution_clock::now();
 
-        hpx::future<std::int64_t> result = hpx::async(skynet, 0, 1000000, 10);
+        hpx::future<std::int64_t> result =
+            hpx::async(skynet, policy, 0, 1000000, 10);
         result.wait();
 
         t = hpx::util::high_resolution_clock::now() - t;
 
         hpx::cout
-            << "Result 1: " << result.get() << " in "
+            << "Result 1 (" << name << "): " << result.get() << " in "
             << (t / 1e6) << " ms.\n";
     }
 
     {
         std::uint64_t t = hpx::util::high_resolution_clock::now();
 
-        hpx::future<std::int64_t> result = hpx::async(skynet_f, 0, 1000000, 10);
+        hpx::future<std::int64_t> result =
+            hpx::async(skynet_f, policy, 0, 1000000, 10);
         result.wait();
 
         t = hpx::util::high_resolution_clock::now() - t;
 
         hpx::cout
-            << "Result 2: " << result.get() << " in "
+            << "Result 2 (" << name << "): " << result.get() << " in "
             << (t / 1e6) << " ms.\n";
     }
-    return 0;
 }
 
+int main()
+{
+    run(hpx::launch::async, "async");
+    run(hpx::launch::fork, "fork");
+    return 0;
+}
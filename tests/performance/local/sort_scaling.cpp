@@ -0,0 +1,91 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compare the parallel sort algorithm when its recursive tasks are spawned
+// help-first (launch::async) and work-first (launch::fork).
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/parallel_executors.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+double measure(std::vector<std::uint64_t> const& data, hpx::launch policy,
+    int test_count)
+{
+    hpx::parallel::execution::parallel_executor exec(policy);
+
+    double elapsed = 0;
+    for (int i = 0; i != test_count; ++i)
+    {
+        std::vector<std::uint64_t> v(data);
+
+        std::uint64_t start = hpx::util::high_resolution_clock::now();
+        hpx::parallel::sort(hpx::parallel::execution::par.on(exec),
+            v.begin(), v.end());
+        elapsed += (hpx::util::high_resolution_clock::now() - start) / 1e9;
+    }
+    return elapsed / test_count;
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::size_t const size = vm["vector_size"].as<std::size_t>();
+    int const test_count = vm["test_count"].as<int>();
+
+    std::vector<std::uint64_t> data(size);
+    {
+        std::mt19937_64 gen(vm["seed"].as<unsigned int>());
+        for (std::uint64_t& v : data)
+            v = gen();
+    }
+
+    double const async_time = measure(data, hpx::launch::async, test_count);
+    double const fork_time = measure(data, hpx::launch::fork, test_count);
+
+    if (vm.count("no-header") == 0)
+    {
+        hpx::cout
+            << "num_cores,vector_size,async_time[s],fork_time[s]\n";
+    }
+
+    hpx::cout
+        << (boost::format("%d,%d,%f,%f\n") %
+                hpx::get_os_thread_count() % size % async_time % fork_time)
+        << hpx::flush;
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    namespace po = boost::program_options;
+    po::options_description cmdline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ("vector_size",
+            po::value<std::size_t>()->default_value(10000000),
+            "number of elements to sort (default: 10000000)")
+        ("test_count",
+            po::value<int>()->default_value(10),
+            "number of tests to average over (default: 10)")
+        ("seed",
+            po::value<unsigned int>()->default_value(0),
+            "the random number generator seed to use")
+        ("no-header", "do not print out the csv header row")
+        ;
+
+    return hpx::init(cmdline, argc, argv);
+}
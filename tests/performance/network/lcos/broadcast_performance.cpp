@@ -0,0 +1,94 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Latency of hpx::lcos::broadcast in the style of osu_bcast. The shape of the
+// broadcast tree is controlled by hpx.lcos.collectives.fanout, e.g.:
+//
+//      broadcast_performance --hpx:ini=hpx.lcos.collectives.fanout=2
+//
+// Running many localities on a single node (--hpx:localities=64) simulates a
+// large machine for comparing different fanouts.
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/lcos/broadcast.hpp>
+#include <hpx/runtime/serialization/serialize_buffer.hpp>
+
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+typedef hpx::serialization::serialize_buffer<char> buffer_type;
+
+void receive(buffer_type const&)
+{
+}
+HPX_PLAIN_ACTION(receive);
+
+HPX_REGISTER_BROADCAST_ACTION_DECLARATION(receive_action)
+HPX_REGISTER_BROADCAST_ACTION(receive_action)
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::size_t const max_msg_size = vm["max-msg-size"].as<std::size_t>();
+    std::size_t const iterations = vm["iter"].as<std::size_t>();
+    std::size_t const skip = vm["skip"].as<std::size_t>();
+
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    std::vector<char> send_buffer(max_msg_size);
+
+    std::cout << "# Broadcast latency, " << localities.size()
+              << " localities, fanout: "
+              << hpx::get_config_entry("hpx.lcos.collectives.fanout",
+                    std::string("default"))
+              << "\n# Size    Latency (microsec)\n";
+
+    for (std::size_t size = 1; size <= max_msg_size; size *= 2)
+    {
+        buffer_type buffer(send_buffer.data(), size, buffer_type::reference);
+
+        double elapsed = 0.0;
+        for (std::size_t i = 0; i != iterations + skip; ++i)
+        {
+            hpx::util::high_resolution_timer t;
+
+            hpx::lcos::broadcast<receive_action>(localities, buffer).get();
+
+            if (i >= skip)
+                elapsed += t.elapsed();
+        }
+
+        std::cout << std::left << std::setw(10) << size
+                  << (elapsed * 1e6) / iterations << std::endl;
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description
+        desc("Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc.add_options()
+        ("max-msg-size",
+         boost::program_options::value<std::size_t>()->default_value(65536),
+         "set maximum message size in bytes")
+        ("iter",
+         boost::program_options::value<std::size_t>()->default_value(1000),
+         "set number of iterations per message size")
+        ("skip",
+         boost::program_options::value<std::size_t>()->default_value(100),
+         "set number of warm up iterations per message size")
+        ;
+
+    std::vector<std::string> cfg = {
+        "hpx.os_threads!=all"
+    };
+    return hpx::init(desc, argc, argv, cfg);
+}
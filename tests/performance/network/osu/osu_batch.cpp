@@ -0,0 +1,167 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Batched action invocation test: invoke an action on many objects living on
+// the same remote locality, once with one parcel per invocation and once
+// with hpx::lcos::batch_async, and compare the time per invocation and the
+// number of parcels and messages sent.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/lcos/batch_async.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <boost/format.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct vertex_server
+  : hpx::components::component_base<vertex_server>
+{
+    vertex_server() : value_(0) {}
+
+    std::uint64_t add(std::uint64_t value)
+    {
+        value_ += value;
+        return value_;
+    }
+    HPX_DEFINE_COMPONENT_ACTION(vertex_server, add);
+
+    std::uint64_t value_;
+};
+
+typedef hpx::components::component<vertex_server> server_type;
+HPX_REGISTER_COMPONENT(server_type, vertex_server);
+
+typedef vertex_server::add_action add_action;
+HPX_REGISTER_ACTION(add_action);
+
+HPX_REGISTER_BATCH_ASYNC_ACTION_DECLARATION(add_action)
+HPX_REGISTER_BATCH_ASYNC_ACTION(add_action)
+
+///////////////////////////////////////////////////////////////////////////////
+std::int64_t query_counter(std::string const& name)
+{
+    using namespace hpx::performance_counters;
+
+    performance_counter c(name);
+    return c.get_counter_value(hpx::launch::sync, true)
+        .get_value<std::int64_t>();
+}
+
+double run_individual(std::vector<hpx::id_type> const& ids,
+    std::vector<std::uint64_t> const& args, std::size_t loop)
+{
+    hpx::util::high_resolution_timer t;
+
+    for (std::size_t i = 0; i != loop; ++i)
+    {
+        std::vector<hpx::future<std::uint64_t> > results;
+        results.reserve(ids.size());
+        for (std::size_t j = 0; j != ids.size(); ++j)
+            results.push_back(hpx::async<add_action>(ids[j], args[j]));
+        hpx::wait_all(results);
+    }
+
+    return (t.elapsed() * 1e6) / (loop * ids.size());
+}
+
+double run_batched(std::vector<hpx::id_type> const& ids,
+    std::vector<std::uint64_t> const& args, std::size_t loop)
+{
+    hpx::util::high_resolution_timer t;
+
+    for (std::size_t i = 0; i != loop; ++i)
+    {
+        hpx::lcos::batch_async<add_action>(ids, args).get();
+    }
+
+    return (t.elapsed() * 1e6) / (loop * ids.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::size_t const loop = vm["loop"].as<std::size_t>();
+    std::size_t const min_objects = vm["min-objects"].as<std::size_t>();
+    std::size_t const max_objects = vm["max-objects"].as<std::size_t>();
+    std::string const parcelport = vm["parcelport"].as<std::string>();
+
+    // use the first remote locality to host all objects, if possible
+    hpx::id_type there = hpx::find_here();
+    std::vector<hpx::id_type> localities = hpx::find_remote_localities();
+    if (!localities.empty())
+        there = localities[0];
+
+    std::vector<hpx::id_type> all_ids =
+        hpx::new_<vertex_server[]>(there, max_objects).get();
+
+    std::string const here = std::to_string(hpx::get_locality_id());
+    std::string const parcels_name = "/parcels{locality#" + here +
+        "/total}/count/" + parcelport + "/sent";
+    std::string const messages_name = "/messages{locality#" + here +
+        "/total}/count/" + parcelport + "/sent";
+
+    hpx::cout << "# OSU HPX Batched Invocation Test\n"
+              << "# Objects  Individual (microsec)  Batched (microsec)  "
+                 "Parcels (individual/batched)  "
+                 "Messages (individual/batched)\n"
+              << hpx::flush;
+
+    for (std::size_t n = min_objects; n <= max_objects; n *= 2)
+    {
+        std::vector<hpx::id_type> ids(all_ids.begin(), all_ids.begin() + n);
+        std::vector<std::uint64_t> args(n, 1);
+
+        query_counter(parcels_name);
+        query_counter(messages_name);
+
+        double individual = run_individual(ids, args, loop);
+        std::int64_t individual_parcels = query_counter(parcels_name);
+        std::int64_t individual_messages = query_counter(messages_name);
+
+        double batched = run_batched(ids, args, loop);
+        std::int64_t batched_parcels = query_counter(parcels_name);
+        std::int64_t batched_messages = query_counter(messages_name);
+
+        hpx::cout
+            << (boost::format("%-10d %-22f %-19f %d/%d %d/%d\n") %
+                    n % individual % batched %
+                    individual_parcels % batched_parcels %
+                    individual_messages % batched_messages)
+            << hpx::flush;
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description
+        desc("Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc.add_options()
+        ("loop",
+         boost::program_options::value<std::size_t>()->default_value(100),
+         "Number of loops")
+        ("min-objects",
+         boost::program_options::value<std::size_t>()->default_value(1),
+         "Minimum number of objects to invoke the action on")
+        ("max-objects",
+         boost::program_options::value<std::size_t>()->default_value(4096),
+         "Maximum number of objects to invoke the action on")
+        ("parcelport",
+         boost::program_options::value<std::string>()->default_value("tcp"),
+         "Name of the parcelport whose counters are queried");
+
+    return hpx::init(desc, argc, argv);
+}
@@ -0,0 +1,188 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Invoke a short and a long running action remotely and verify that every
+// invocation is accounted for by the adaptive execution counters, that the
+// short action is executed directly, and that the long running action is
+// never executed directly. A short action which suspends must never be
+// executed directly on an OS-thread.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Scheduled actions always run on a new HPX thread. An invocation which is
+// observed outside of any HPX thread was executed directly on the thread
+// decoding the parcel (the io threads of the TCP parcelport).
+boost::atomic<std::int64_t> short_work_outside_hpx_thread(0);
+
+std::int64_t short_work(std::int64_t value)
+{
+    if (hpx::threads::get_self_ptr() == nullptr)
+        ++short_work_outside_hpx_thread;
+    return value + 1;
+}
+HPX_PLAIN_ACTION(short_work, short_work_action);
+
+boost::atomic<std::int64_t> yielding_work_outside_hpx_thread(0);
+
+std::int64_t yielding_work(std::int64_t value)
+{
+    // an OS-thread can't suspend
+    if (hpx::threads::get_self_ptr() == nullptr)
+        ++yielding_work_outside_hpx_thread;
+    else
+        hpx::this_thread::yield();
+    return value + 1;
+}
+HPX_PLAIN_ACTION(yielding_work, yielding_work_action);
+
+std::int64_t get_short_work_outside_hpx_thread()
+{
+    return short_work_outside_hpx_thread.load();
+}
+HPX_PLAIN_ACTION(get_short_work_outside_hpx_thread,
+    get_short_work_outside_hpx_thread_action);
+
+std::int64_t get_yielding_work_outside_hpx_thread()
+{
+    return yielding_work_outside_hpx_thread.load();
+}
+HPX_PLAIN_ACTION(get_yielding_work_outside_hpx_thread,
+    get_yielding_work_outside_hpx_thread_action);
+
+std::int64_t long_work(std::int64_t value)
+{
+    hpx::this_thread::sleep_for(std::chrono::milliseconds(10));
+    return value + 1;
+}
+HPX_PLAIN_ACTION(long_work, long_work_action);
+
+///////////////////////////////////////////////////////////////////////////////
+std::int64_t query_counter(hpx::id_type const& locality,
+    std::string const& counter, std::string const& action)
+{
+    using namespace hpx::performance_counters;
+
+    std::string name = "/runtime{locality#" +
+        std::to_string(hpx::naming::get_locality_id_from_id(locality)) +
+        "/total}/count/" + counter + "@" + action;
+
+    performance_counter c(name);
+    return c.get_counter_value(hpx::launch::sync)
+        .get_value<std::int64_t>();
+}
+
+template <typename Action>
+std::int64_t test_adaptive_execution(hpx::id_type const& locality,
+    std::string const& action, std::size_t iterations)
+{
+    for (std::size_t i = 0; i != iterations; ++i)
+    {
+        HPX_TEST_EQ(hpx::async<Action>(locality, std::int64_t(i)).get(),
+            std::int64_t(i + 1));
+    }
+
+    std::int64_t direct =
+        query_counter(locality, "direct-action-execution", action);
+    std::int64_t scheduled =
+        query_counter(locality, "scheduled-action-execution", action);
+
+    HPX_TEST_EQ(direct + scheduled, std::int64_t(iterations));
+
+    // the first invocation is always scheduled as its execution time is
+    // not known yet
+    HPX_TEST_LTE(std::int64_t(1), scheduled);
+
+    return direct;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::size_t const iterations = vm["iterations"].as<std::size_t>();
+
+    // the TCP parcelport decodes each (single parcel) message on one of its
+    // io threads, those are not HPX threads
+    bool const decoded_on_os_threads =
+        hpx::get_config_entry("hpx.parcel.tcp.enable", "0") != "0" &&
+        hpx::get_config_entry("hpx.parcel.mpi.enable", "0") == "0";
+
+    for (hpx::id_type const& locality : hpx::find_remote_localities())
+    {
+        std::int64_t direct = test_adaptive_execution<short_work_action>(
+            locality, "short_work_action", iterations);
+
+        // all but the first few invocations of the short action are found
+        // to be short, this includes those decoded on OS-threads
+        HPX_TEST_LT(std::int64_t(0), direct);
+
+        // every invocation observed outside of an HPX thread was executed
+        // directly
+        std::int64_t outside_hpx_thread =
+            hpx::async<get_short_work_outside_hpx_thread_action>(locality)
+                .get();
+        HPX_TEST_LTE(outside_hpx_thread, direct);
+
+        // every direct execution on an OS-thread is observable
+        if (decoded_on_os_threads)
+            HPX_TEST_EQ(outside_hpx_thread, direct);
+
+        // the yielding action is short, but it is seen suspending the first
+        // time it is executed (which is always scheduled)
+        direct = test_adaptive_execution<yielding_work_action>(
+            locality, "yielding_work_action", iterations);
+        HPX_TEST_EQ(
+            hpx::async<get_yielding_work_outside_hpx_thread_action>(locality)
+                .get(),
+            std::int64_t(0));
+        if (decoded_on_os_threads)
+            HPX_TEST_EQ(direct, std::int64_t(0));
+
+        test_adaptive_execution<long_work_action>(
+            locality, "long_work_action", iterations);
+
+        // the long running action is never found to be short
+        HPX_TEST_EQ(query_counter(locality, "direct-action-execution",
+            "long_work_action"), std::int64_t(0));
+    }
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description cmdline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ("iterations",
+            boost::program_options::value<std::size_t>()->default_value(100),
+            "number of invocations of each action (default: 100)")
+        ;
+
+    // the threshold is well below the execution time of long_work but
+    // leaves room for sending the result of short_work
+    std::vector<std::string> const cfg = {
+        "hpx.parcel.adaptive_direct_execution = 1",
+        "hpx.parcel.direct_execution_threshold = 1000000"
+    };
+
+    return hpx::init(cmdline, argc, argv, cfg);
+}
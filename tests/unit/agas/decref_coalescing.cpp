@@ -0,0 +1,138 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Release the references to many local objects and verify that the buffered
+// credit decrements are combined into a single message, and that all objects
+// are eventually destroyed. Verify as well that a buffered decrement is
+// cancelled by a matching increment.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <tests/unit/agas/components/managed_refcnt_checker.hpp>
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+
+using hpx::naming::id_type;
+using hpx::test::managed_refcnt_monitor;
+
+///////////////////////////////////////////////////////////////////////////////
+std::int64_t query_counter(
+    hpx::performance_counters::performance_counter& c, bool reset = false)
+{
+    return c.get_counter_value(hpx::launch::sync, reset)
+        .get_value<std::int64_t>();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(variables_map& vm)
+{
+    std::uint64_t const delay = vm["delay"].as<std::uint64_t>();
+    std::size_t const num_objects = vm["objects"].as<std::size_t>();
+
+    // the counters are created up front, releasing their references inside
+    // the measured section would add decrements of its own
+    using hpx::performance_counters::performance_counter;
+    performance_counter messages_counter(
+        "/agas{locality#0/total}/count/decref/messages");
+    performance_counter avoided_counter(
+        "/agas{locality#0/total}/count/decref/messages-avoided");
+
+    {
+        std::vector<std::unique_ptr<managed_refcnt_monitor> > monitors;
+        std::vector<id_type> ids;
+
+        for (std::size_t i = 0; i != num_objects; ++i)
+        {
+            monitors.emplace_back(new managed_refcnt_monitor(hpx::find_here()));
+            ids.push_back(monitors.back()->detach().get());
+        }
+
+        // flush anything which is pending right now, and reset the counters
+        hpx::agas::garbage_collect();
+        query_counter(messages_counter, true);
+        query_counter(avoided_counter, true);
+
+        // release all references, the decrements are buffered
+        ids.clear();
+
+        // send all buffered decrements at once
+        hpx::agas::garbage_collect();
+
+        // all objects live on this locality, thus the decrements for all of
+        // them go to the same destination
+        HPX_TEST_EQ(query_counter(messages_counter), std::int64_t(1));
+        HPX_TEST_EQ(query_counter(avoided_counter),
+            std::int64_t(num_objects) - 1);
+
+        HPX_TEST(monitors.front()->is_ready(std::chrono::milliseconds(delay)));
+        for (auto& monitor : monitors)
+            HPX_TEST(monitor->is_ready());
+    }
+
+    {
+        managed_refcnt_monitor monitor(hpx::find_here());
+        id_type id = monitor.detach().get();
+        hpx::naming::gid_type const gid = id.get_gid();
+
+        hpx::agas::garbage_collect();
+        query_counter(messages_counter, true);
+
+        // buffer a decrement from some worker thread, the increment below
+        // cancels it regardless of the worker it was issued on
+        hpx::async([gid]() { hpx::agas::decref(gid, 1); }).get();
+        HPX_TEST_EQ(hpx::agas::incref(hpx::launch::sync, gid, 1),
+            std::int64_t(-1));
+
+        // nothing is left to be sent, the object is still alive
+        hpx::agas::garbage_collect();
+        HPX_TEST_EQ(query_counter(messages_counter), std::int64_t(0));
+        HPX_TEST(!monitor.is_ready(std::chrono::milliseconds(delay)));
+
+        id = id_type();
+        hpx::agas::garbage_collect();
+        HPX_TEST(monitor.is_ready(std::chrono::milliseconds(delay)));
+    }
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // Configure application-specific options.
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "delay"
+        , value<std::uint64_t>()->default_value(500)
+        , "number of milliseconds to wait for object destruction")
+        ( "objects"
+        , value<std::size_t>()->default_value(100)
+        , "number of objects to create")
+        ;
+
+    // We need to explicitly enable the test components used by this test.
+    // The decrements are sent only when requested explicitly.
+    std::vector<std::string> const cfg = {
+        "hpx.components.managed_refcnt_checker.enabled! = 1",
+        "hpx.agas.refcnt_flush_interval = 0"
+    };
+
+    // Initialize and run HPX.
+    return hpx::init(cmdline, argc, argv, cfg);
+}
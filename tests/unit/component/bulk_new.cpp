@@ -0,0 +1,152 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Create more managed components at once than fit into one wrapper heap and
+// verify the compact ranges of their ids. Verify as well that the instances
+// in a range which is dropped without taking their ids are released.
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+boost::atomic<std::int64_t> alive(0);
+
+struct test_server
+  : hpx::components::managed_component_base<test_server>
+{
+    test_server() : value_(0) { ++alive; }
+    explicit test_server(std::int64_t value) : value_(value) { ++alive; }
+    ~test_server() { --alive; }
+
+    std::int64_t call() const { return value_; }
+    HPX_DEFINE_COMPONENT_ACTION(test_server, call);
+
+    hpx::id_type where() const { return hpx::find_here(); }
+    HPX_DEFINE_COMPONENT_ACTION(test_server, where);
+
+    std::int64_t value_;
+};
+
+typedef hpx::components::managed_component<test_server> server_type;
+HPX_REGISTER_COMPONENT(server_type, test_server);
+
+typedef test_server::call_action call_action;
+HPX_REGISTER_ACTION(call_action);
+
+typedef test_server::where_action where_action;
+HPX_REGISTER_ACTION(where_action);
+
+std::int64_t get_alive()
+{
+    return alive.load();
+}
+HPX_PLAIN_ACTION(get_alive, get_alive_action);
+
+// one more than fits into a single wrapper heap
+std::size_t const num_instances = 0xFFFF + 1;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_dropped_range(hpx::id_type const& locality)
+{
+    typedef hpx::components::stub_base<test_server> stub_type;
+
+    std::int64_t const before = hpx::async<get_alive_action>(locality).get();
+    {
+        hpx::components::id_range range =
+            stub_type::bulk_create_range_async(locality, 16).get();
+
+        HPX_TEST_EQ(range.size(), std::size_t(16));
+        HPX_TEST_EQ(hpx::async<get_alive_action>(locality).get(),
+            before + 16);
+    }
+
+    // the credits given back by the range release the instances, those
+    // are destroyed asynchronously
+    hpx::agas::garbage_collect();
+
+    std::int64_t after = hpx::async<get_alive_action>(locality).get();
+    for (int i = 0; i != 100 && after != before; ++i)
+    {
+        hpx::this_thread::sleep_for(std::chrono::milliseconds(10));
+        after = hpx::async<get_alive_action>(locality).get();
+    }
+    HPX_TEST_EQ(after, before);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_bulk_create_range(hpx::id_type const& locality)
+{
+    typedef hpx::components::stub_base<test_server> stub_type;
+
+    hpx::components::id_range range =
+        stub_type::bulk_create_range_async(locality, num_instances).get();
+
+    HPX_TEST_EQ(range.size(), num_instances);
+
+    // the instances are allocated in blocks of consecutive objects
+    HPX_TEST_LTE(range.runs().size(), std::size_t(3));
+
+    std::size_t count = 0;
+    for (auto const& r : range.runs())
+        count += r.count_;
+    HPX_TEST_EQ(count, num_instances);
+
+    HPX_TEST(range.get_gid(1) == range.get_gid(0) + 1);
+
+    std::vector<hpx::id_type> ids = range.release_ids();
+    HPX_TEST(range.empty());
+    HPX_TEST_EQ(ids.size(), num_instances);
+
+    for (std::size_t i : { std::size_t(0), num_instances / 2,
+            num_instances - 1 })
+    {
+        HPX_TEST(hpx::async<where_action>(ids[i]).get() == locality);
+        HPX_TEST_EQ(hpx::async<call_action>(ids[i]).get(), std::int64_t(0));
+    }
+}
+
+void test_bulk_new(hpx::id_type const& locality)
+{
+    std::vector<hpx::id_type> ids =
+        hpx::new_<test_server[]>(locality, num_instances, std::int64_t(42))
+            .get();
+
+    HPX_TEST_EQ(ids.size(), num_instances);
+
+    for (std::size_t i : { std::size_t(0), num_instances / 2,
+            num_instances - 1 })
+    {
+        HPX_TEST(hpx::async<where_action>(ids[i]).get() == locality);
+        HPX_TEST_EQ(hpx::async<call_action>(ids[i]).get(), std::int64_t(42));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    // run first, before any other instances are being released
+    for (hpx::id_type const& loc : hpx::find_all_localities())
+        test_dropped_range(loc);
+
+    for (hpx::id_type const& loc : hpx::find_all_localities())
+    {
+        test_bulk_create_range(loc);
+        test_bulk_new(loc);
+    }
+
+    return hpx::util::report_errors();
+}
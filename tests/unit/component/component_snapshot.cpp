@@ -0,0 +1,177 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/component_storage.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/serialization.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+boost::atomic<int> alive(0);
+
+struct test_server
+  : hpx::components::migration_support<
+        hpx::components::simple_component_base<test_server>
+    >
+{
+    test_server(int value = 0) : value_(value) { ++alive; }
+    ~test_server() { --alive; }
+
+    test_server(test_server const& rhs) : value_(rhs.value_) { ++alive; }
+    test_server(test_server && rhs) : value_(rhs.value_) { ++alive; }
+
+    test_server& operator=(test_server const&) = delete;
+    test_server& operator=(test_server &&) = delete;
+
+    int get() const { return value_; }
+    void set(int value) { value_ = value; }
+
+    HPX_DEFINE_COMPONENT_ACTION(test_server, get, get_action);
+    HPX_DEFINE_COMPONENT_ACTION(test_server, set, set_action);
+
+    template <typename Archive>
+    void serialize(Archive& ar, unsigned version)
+    {
+        ar & value_;
+    }
+
+    int value_;
+};
+
+typedef hpx::components::simple_component<test_server> server_type;
+HPX_REGISTER_COMPONENT(server_type, test_server);
+
+typedef test_server::get_action get_action;
+HPX_REGISTER_ACTION_DECLARATION(get_action);
+HPX_REGISTER_ACTION(get_action);
+
+typedef test_server::set_action set_action;
+HPX_REGISTER_ACTION_DECLARATION(set_action);
+HPX_REGISTER_ACTION(set_action);
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t const num_components = 100;
+
+std::vector<hpx::id_type> make_unmanaged(std::vector<hpx::id_type> const& ids)
+{
+    std::vector<hpx::id_type> unmanaged;
+    for (hpx::id_type const& id : ids)
+    {
+        unmanaged.push_back(
+            hpx::id_type(hpx::naming::detail::get_stripped_gid(id.get_gid()),
+                hpx::id_type::unmanaged));
+    }
+    return unmanaged;
+}
+
+void test_snapshot()
+{
+    hpx::components::component_storage storage(hpx::find_here());
+
+    std::vector<hpx::id_type> ids;
+    for (std::size_t i = 0; i != num_components; ++i)
+    {
+        ids.push_back(hpx::new_<test_server>(hpx::find_here(), int(i)).get());
+    }
+
+    // the first snapshot writes all components
+    std::uint64_t full = hpx::components::snapshot(storage).get();
+    HPX_TEST_NEQ(full, std::uint64_t(0));
+    HPX_TEST_EQ(storage.size(hpx::launch::sync), num_components);
+
+    // nothing has changed since
+    HPX_TEST_EQ(hpx::components::snapshot(storage).get(), std::uint64_t(0));
+
+    // only the modified component is written
+    set_action()(ids[0], 42);
+
+    std::uint64_t incremental = hpx::components::snapshot(storage).get();
+    HPX_TEST_NEQ(incremental, std::uint64_t(0));
+    HPX_TEST_LT(incremental, full);
+
+    HPX_TEST_EQ(hpx::components::snapshot(storage, false).get(), full);
+
+    // destroy all components and recreate them from the snapshot
+    std::vector<hpx::id_type> unmanaged = make_unmanaged(ids);
+    ids.clear();
+
+    while (alive.load() != 0)
+        hpx::this_thread::yield();
+
+    HPX_TEST_EQ(hpx::components::restore_snapshot(storage).get(),
+        num_components);
+    HPX_TEST_EQ(alive.load(), int(num_components));
+
+    HPX_TEST_EQ(get_action()(unmanaged[0]), 42);
+    for (std::size_t i = 1; i != num_components; ++i)
+    {
+        HPX_TEST_EQ(get_action()(unmanaged[i]), int(i));
+    }
+}
+
+// components parked in a persistent storage using migrate_to_storage are not
+// part of the snapshots written to it
+void test_persistent_snapshot()
+{
+    std::string const path = "component_snapshot.segments";
+    int const alive_before = alive.load();
+
+    {
+        hpx::components::component_storage storage(hpx::find_here(), path);
+
+        std::vector<hpx::id_type> ids;
+        for (std::size_t i = 0; i != num_components; ++i)
+        {
+            ids.push_back(
+                hpx::new_<test_server>(hpx::find_here(), int(i)).get());
+        }
+
+        HPX_TEST_NEQ(hpx::components::snapshot(storage).get(),
+            std::uint64_t(0));
+
+        hpx::id_type parked =
+            hpx::new_<test_server>(hpx::find_here(), -1).get();
+        hpx::components::migrate_to_storage<test_server>(
+            parked, storage.get_id()).get();
+        HPX_TEST_EQ(storage.size(hpx::launch::sync), num_components + 1);
+
+        std::vector<hpx::id_type> unmanaged = make_unmanaged(ids);
+        ids.clear();
+
+        while (alive.load() != alive_before)
+            hpx::this_thread::yield();
+
+        HPX_TEST_EQ(hpx::components::restore_snapshot(storage).get(),
+            num_components);
+        HPX_TEST_EQ(alive.load(), alive_before + int(num_components));
+
+        for (std::size_t i = 0; i != num_components; ++i)
+        {
+            HPX_TEST_EQ(get_action()(unmanaged[i]), int(i));
+        }
+    }
+
+    boost::filesystem::remove_all(path);
+}
+
+int main()
+{
+    test_snapshot();
+    test_persistent_snapshot();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,119 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that no output is lost or garbled if hpx::consolestream collects the
+// output in per-worker buffers (hpx.iostreams.ordering=worker), even if the
+// writing threads are suspended in the middle of a line, or if the output is
+// written from inside a streaming operation.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+std::size_t const num_tasks = 64;
+std::size_t const num_lines = 100;
+
+///////////////////////////////////////////////////////////////////////////////
+std::string make_line(std::size_t task, std::size_t line)
+{
+    std::ostringstream strm;
+    strm << "task " << task << " line " << line;
+    return strm.str();
+}
+
+// writes a line to hpx::consolestream while being formatted itself
+struct nested_line
+{
+    std::size_t line_;
+};
+
+std::ostream& operator<<(std::ostream& os, nested_line const& n)
+{
+    hpx::consolestream << make_line(num_tasks + 1, n.line_) << '\n';
+    return os << make_line(num_tasks + 2, n.line_);
+}
+
+void write_lines(std::size_t task)
+{
+    for (std::size_t i = 0; i != num_lines; ++i)
+    {
+        // suspend in the middle of the line, other threads write to the
+        // same worker buffer meanwhile (and flush it)
+        hpx::consolestream << "task " << task;
+        hpx::this_thread::yield();
+
+        if (i % 10 == 0)
+            hpx::consolestream << " line " << i << hpx::endl;
+        else
+            hpx::consolestream << " line " << i << hpx::async_endl;
+    }
+}
+
+int hpx_main()
+{
+    std::vector<hpx::future<void> > tasks;
+    tasks.reserve(num_tasks);
+    for (std::size_t i = 0; i != num_tasks; ++i)
+        tasks.push_back(hpx::async(&write_lines, i));
+    hpx::wait_all(tasks);
+
+    // output written by a single thread without suspending in between stays
+    // in order
+    for (std::size_t i = 0; i != num_lines; ++i)
+        hpx::consolestream << make_line(num_tasks, i) << '\n';
+    hpx::consolestream << hpx::flush;
+
+    // nested output must not wait for the buffer of its own worker
+    for (std::size_t i = 0; i != num_lines; ++i)
+        hpx::consolestream << nested_line{i} << hpx::endl;
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {
+        "hpx.iostreams.ordering=worker"
+    };
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+
+    std::vector<std::string> lines;
+    {
+        std::istringstream strm(hpx::get_consolestream().str());
+        std::string line;
+        while (std::getline(strm, line))
+            lines.push_back(line);
+    }
+
+    std::vector<std::string> expected;
+    for (std::size_t task = 0; task <= num_tasks + 2; ++task)
+    {
+        for (std::size_t i = 0; i != num_lines; ++i)
+            expected.push_back(make_line(task, i));
+    }
+
+    // the lines written by the last task appear in sequence
+    std::vector<std::string>::iterator it =
+        std::find(lines.begin(), lines.end(), make_line(num_tasks, 0));
+    HPX_TEST(it != lines.end());
+    for (std::size_t i = 0; i != num_lines && it != lines.end(); ++i, ++it)
+        HPX_TEST_EQ(*it, make_line(num_tasks, i));
+
+    // no line was lost or garbled
+    std::sort(lines.begin(), lines.end());
+    std::sort(expected.begin(), expected.end());
+    HPX_TEST(lines == expected);
+
+    return hpx::util::report_errors();
+}
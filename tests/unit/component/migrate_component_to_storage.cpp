@@ -11,7 +11,12 @@
 #include <hpx/include/serialization.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
+#include <boost/filesystem/operations.hpp>
+
 #include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 struct test_server
@@ -230,9 +235,151 @@ void test_storage(hpx::id_type const& here, hpx::id_type const& there)
 //     HPX_TEST(test_migrate_component_from_storage(here, storage));
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void test_bulk_migrate_to_storage(hpx::id_type const& source,
+    hpx::components::component_storage storage)
+{
+    std::size_t const num_components = 16;
+
+    std::vector<test_client> clients;
+    std::vector<hpx::id_type> oldids;
+    for (std::size_t i = 0; i != num_components; ++i)
+    {
+        clients.push_back(test_client(source));
+        oldids.push_back(hpx::id_type(clients.back().get_id().get_gid(),
+            hpx::id_type::unmanaged));
+    }
+
+    // migrate all components concurrently
+    std::vector<test_client> migrated =
+        hpx::components::migrate_to_storage(clients, storage);
+    HPX_TEST_EQ(migrated.size(), num_components);
+    for (test_client const& c : migrated)
+        HPX_TEST_EQ(hpx::naming::invalid_id, c.get_id());
+
+    clients.clear();
+    HPX_TEST_EQ(storage.size(hpx::launch::sync), num_components);
+
+    // the data is loaded when the components are resurrected
+    for (hpx::id_type const& id : oldids)
+    {
+        test_client t(hpx::components::migrate_from_storage<test_server>(id));
+        HPX_TEST_EQ(id, t.get_id());
+        HPX_TEST_EQ(t.call(), source);
+    }
+    HPX_TEST_EQ(storage.size(hpx::launch::sync), std::size_t(0));
+
+    // nothing is left to be kept, compaction must not lose anything
+    storage.compact(hpx::launch::sync);
+    HPX_TEST_EQ(storage.size(hpx::launch::sync), std::size_t(0));
+}
+
+std::size_t count_segments(std::string const& path)
+{
+    std::size_t count = 0;
+    for (boost::filesystem::directory_iterator it(path), end; it != end; ++it)
+    {
+        if (it->path().extension() == ".log")
+            ++count;
+    }
+    return count;
+}
+
+// Snapshot records are not bound to the storage in AGAS, which allows to
+// check the stored data after the storage has been reopened.
+void test_compact_and_recover(hpx::id_type const& here,
+    std::string const& path)
+{
+    std::size_t const num_records = 16;
+    std::size_t const segment_size = 4096;
+
+    std::vector<hpx::naming::gid_type> ids;
+    std::vector<std::vector<char> > data;
+    for (std::size_t i = 0; i != num_records; ++i)
+    {
+        ids.push_back(hpx::naming::gid_type(0x1234, i + 1));
+
+        // two records fit into each segment
+        data.push_back(std::vector<char>(1500, static_cast<char>('a' + i)));
+    }
+
+    std::vector<hpx::naming::gid_type> kept;
+    std::vector<std::vector<char> > kept_data;
+    {
+        hpx::components::component_storage storage(here, path, segment_size);
+        storage.store_snapshot(hpx::launch::sync, ids, data);
+        HPX_TEST_EQ(storage.size(hpx::launch::sync), num_records);
+
+        // erase every other record, leaving all full segments half empty
+        std::vector<hpx::naming::gid_type> erased;
+        for (std::size_t i = 0; i != num_records; ++i)
+        {
+            if (i % 2)
+            {
+                erased.push_back(ids[i]);
+            }
+            else
+            {
+                kept.push_back(ids[i]);
+                kept_data.push_back(data[i]);
+            }
+        }
+        storage.commit_snapshot(hpx::launch::sync, erased);
+        HPX_TEST_EQ(storage.size(hpx::launch::sync), kept.size());
+
+        std::size_t const segments = count_segments(path);
+        HPX_TEST_LTE(num_records / 2, segments);
+
+        // the live records are moved into fewer segments
+        HPX_TEST_LT(std::uint64_t(0), storage.compact(hpx::launch::sync, 0.75));
+        HPX_TEST_EQ(storage.size(hpx::launch::sync), kept.size());
+        HPX_TEST_LT(count_segments(path), segments);
+
+        // write everything back before the storage is reopened
+        storage.commit_snapshot(hpx::launch::sync,
+            std::vector<hpx::naming::gid_type>());
+    }
+
+    // reopening the directory restores all records which were kept
+    {
+        hpx::components::component_storage storage(here, path, segment_size);
+        HPX_TEST_EQ(storage.size(hpx::launch::sync), kept.size());
+        HPX_TEST_EQ(storage.snapshot_keys(hpx::launch::sync).size(),
+            kept.size());
+
+        std::vector<std::vector<char> > loaded =
+            storage.load_snapshot(hpx::launch::sync, kept);
+        HPX_TEST(loaded == kept_data);
+    }
+}
+
+void test_persistent_storage(hpx::id_type const& here,
+    hpx::id_type const& there)
+{
+    std::string const path = "migrate_component_to_storage.segments";
+
+    {
+        // use small segments to spread the data over several files
+        hpx::components::component_storage storage(here, path, 4096);
+        HPX_TEST_NEQ(hpx::naming::invalid_id, storage.get_id());
+
+        HPX_TEST(test_migrate_component_to_storage(here, storage,
+            hpx::id_type::unmanaged));
+        HPX_TEST(test_migrate_component_to_storage(here, there, storage,
+            hpx::id_type::managed));
+
+        test_bulk_migrate_to_storage(here, storage);
+    }
+    boost::filesystem::remove_all(path);
+
+    test_compact_and_recover(here, path);
+    boost::filesystem::remove_all(path);
+}
+
 int main()
 {
     test_storage(hpx::find_here(), hpx::find_here());
+    test_persistent_storage(hpx::find_here(), hpx::find_here());
 
     for (hpx::id_type const& id: hpx::find_remote_localities())
     {
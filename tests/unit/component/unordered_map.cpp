@@ -75,6 +75,66 @@ void fill_unordered_map(hpx::unordered_map<Key, Value, Hash, KeyEqual>& m,
     HPX_TEST(m.size() == count);
 }
 
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+void test_bulk_access(hpx::unordered_map<Key, Value, Hash, KeyEqual>& m,
+    std::size_t count)
+{
+    std::vector<Key> keys;
+    std::vector<Value> values;
+    keys.reserve(count);
+    values.reserve(count);
+
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        keys.push_back(std::to_string(i));
+        values.push_back(Value(i + 1));
+    }
+
+    m.set_values(hpx::launch::sync, keys, values);
+    HPX_TEST_EQ(m.size(), count);
+
+    // retrieve the values in an order which is different from the one used
+    // to store them
+    std::reverse(keys.begin(), keys.end());
+    std::reverse(values.begin(), values.end());
+
+    std::vector<Value> result = m.get_values(keys).get();
+    HPX_TEST_EQ(result.size(), count);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        HPX_TEST_EQ(result[i], values[i]);
+        HPX_TEST_EQ(m[keys[i]], values[i]);
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+void test_concurrent_access(hpx::unordered_map<Key, Value, Hash, KeyEqual>& m,
+    std::size_t count)
+{
+    // insert elements from many threads concurrently
+    std::vector<hpx::future<void> > futures;
+    futures.reserve(count);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        futures.push_back(m.set_value(std::to_string(i), Value(i)));
+    }
+    hpx::wait_all(futures);
+    HPX_TEST_EQ(m.size(), count);
+
+    // erase every other element while reading the remaining ones
+    std::vector<hpx::future<Value> > values;
+    values.reserve(count);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        values.push_back(m.get_value(std::to_string(i), (i % 2) != 0));
+    }
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        HPX_TEST_EQ(values[i].get(), Value(i));
+    }
+    HPX_TEST_EQ(m.size(), (count + 1) / 2);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 template <typename Key, typename Value, typename DistPolicy>
 void trivial_tests(DistPolicy const& policy)
@@ -106,6 +166,18 @@ void trivial_tests(DistPolicy const& policy)
         fill_unordered_map(m, 107, Value(42));
         test_global_iteration(m, Value(42));
     }
+
+    // bulk access
+    {
+        hpx::unordered_map<Key, Value> m(17, policy);
+        test_bulk_access(m, 107);
+    }
+
+    // concurrent access
+    {
+        hpx::unordered_map<Key, Value> m(17, policy);
+        test_concurrent_access(m, 1007);
+    }
 }
 
 template <typename Key, typename Value>
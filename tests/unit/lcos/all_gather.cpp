@@ -0,0 +1,80 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/lcos/all_gather.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+HPX_REGISTER_ALL_GATHER(std::uint32_t, test_all_gather);
+
+///////////////////////////////////////////////////////////////////////////////
+void test_all_gather_localities()
+{
+    std::uint32_t num_localities = hpx::get_num_localities(hpx::launch::sync);
+    std::uint32_t here = hpx::get_locality_id();
+
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        std::vector<std::uint32_t> result = hpx::lcos::all_gather(
+            "/test/all_gather/", here, num_localities, i).get();
+
+        HPX_TEST_EQ(result.size(), std::size_t(num_localities));
+        for (std::size_t j = 0; j != result.size(); ++j)
+        {
+            HPX_TEST_EQ(result[j], std::uint32_t(j));
+        }
+    }
+}
+
+// run all sites on this locality to cover site counts which are not a power
+// of two
+void test_all_gather_sites(std::size_t num_sites)
+{
+    std::string basename = "/test/all_gather_sites/" +
+        std::to_string(hpx::get_locality_id()) + "/" +
+        std::to_string(num_sites) + "/";
+
+    std::vector<hpx::future<std::vector<std::uint32_t> > > results;
+    for (std::size_t site = 0; site != num_sites; ++site)
+    {
+        results.push_back(hpx::lcos::all_gather(basename.c_str(),
+            std::uint32_t(2 * site), num_sites, std::size_t(-1), site));
+    }
+
+    for (hpx::future<std::vector<std::uint32_t> >& f : results)
+    {
+        std::vector<std::uint32_t> result = f.get();
+
+        HPX_TEST_EQ(result.size(), num_sites);
+        for (std::size_t j = 0; j != result.size(); ++j)
+        {
+            HPX_TEST_EQ(result[j], std::uint32_t(2 * j));
+        }
+    }
+}
+
+int hpx_main()
+{
+    test_all_gather_localities();
+
+    for (std::size_t num_sites : { 1, 2, 3, 5, 8, 13 })
+        test_all_gather_sites(num_sites);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
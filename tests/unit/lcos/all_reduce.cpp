@@ -0,0 +1,77 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/lcos/all_reduce.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+HPX_REGISTER_ALL_REDUCE(std::uint32_t, test_all_reduce);
+HPX_REGISTER_ALL_REDUCE(std::string, test_all_reduce_string);
+
+///////////////////////////////////////////////////////////////////////////////
+void test_all_reduce_localities()
+{
+    std::uint32_t num_localities = hpx::get_num_localities(hpx::launch::sync);
+    std::uint32_t here = hpx::get_locality_id();
+
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        std::uint32_t result = hpx::lcos::all_reduce("/test/all_reduce/",
+            here, std::plus<std::uint32_t>(), num_localities, i).get();
+
+        HPX_TEST_EQ(result, num_localities * (num_localities - 1) / 2);
+    }
+}
+
+// run all sites on this locality to cover site counts which are not a power
+// of two and to verify that values are combined in site order
+void test_all_reduce_sites(std::size_t num_sites)
+{
+    std::string basename = "/test/all_reduce_sites/" +
+        std::to_string(hpx::get_locality_id()) + "/" +
+        std::to_string(num_sites) + "/";
+
+    std::vector<hpx::future<std::string> > results;
+    for (std::size_t site = 0; site != num_sites; ++site)
+    {
+        results.push_back(hpx::lcos::all_reduce(basename.c_str(),
+            std::to_string(site), std::plus<std::string>(), num_sites,
+            std::size_t(-1), site));
+    }
+
+    std::string expected;
+    for (std::size_t site = 0; site != num_sites; ++site)
+        expected += std::to_string(site);
+
+    for (hpx::future<std::string>& f : results)
+    {
+        HPX_TEST_EQ(f.get(), expected);
+    }
+}
+
+int hpx_main()
+{
+    test_all_reduce_localities();
+
+    for (std::size_t num_sites : { 1, 2, 3, 5, 8, 13 })
+        test_all_reduce_sites(num_sites);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
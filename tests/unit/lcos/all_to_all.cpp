@@ -0,0 +1,95 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/lcos/all_to_all.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+HPX_REGISTER_ALL_TO_ALL(std::uint32_t, test_all_to_all);
+
+///////////////////////////////////////////////////////////////////////////////
+// the value sent from site i to site j
+std::uint32_t value(std::size_t i, std::size_t j)
+{
+    return std::uint32_t(100 * i + j);
+}
+
+void check_result(std::size_t num_sites, std::size_t this_site,
+    std::vector<std::uint32_t> const& result)
+{
+    HPX_TEST_EQ(result.size(), num_sites);
+    for (std::size_t j = 0; j != result.size(); ++j)
+    {
+        HPX_TEST_EQ(result[j], value(j, this_site));
+    }
+}
+
+std::vector<std::uint32_t> make_values(std::size_t num_sites,
+    std::size_t this_site)
+{
+    std::vector<std::uint32_t> values(num_sites);
+    for (std::size_t j = 0; j != num_sites; ++j)
+        values[j] = value(this_site, j);
+    return values;
+}
+
+void test_all_to_all_localities()
+{
+    std::size_t num_localities = hpx::get_num_localities(hpx::launch::sync);
+    std::size_t here = hpx::get_locality_id();
+
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        std::vector<std::uint32_t> result = hpx::lcos::all_to_all(
+            "/test/all_to_all/", make_values(num_localities, here),
+            num_localities, i).get();
+
+        check_result(num_localities, here, result);
+    }
+}
+
+// run all sites on this locality to exercise larger numbers of sites
+void test_all_to_all_sites(std::size_t num_sites)
+{
+    std::string basename = "/test/all_to_all_sites/" +
+        std::to_string(hpx::get_locality_id()) + "/" +
+        std::to_string(num_sites) + "/";
+
+    std::vector<hpx::future<std::vector<std::uint32_t> > > results;
+    for (std::size_t site = 0; site != num_sites; ++site)
+    {
+        results.push_back(hpx::lcos::all_to_all(basename.c_str(),
+            make_values(num_sites, site), num_sites, std::size_t(-1), site));
+    }
+
+    for (std::size_t site = 0; site != num_sites; ++site)
+    {
+        check_result(num_sites, site, results[site].get());
+    }
+}
+
+int hpx_main()
+{
+    test_all_to_all_localities();
+
+    for (std::size_t num_sites : { 1, 2, 3, 5, 8, 13 })
+        test_all_to_all_sites(num_sites);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
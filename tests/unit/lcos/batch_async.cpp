@@ -0,0 +1,130 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/lcos/batch_async.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::atomic<std::int64_t> num_touched(0);
+
+struct test_server
+  : hpx::components::component_base<test_server>
+{
+    test_server() : value_(0) {}
+    explicit test_server(std::int64_t value) : value_(value) {}
+
+    std::int64_t add(std::int64_t value) const
+    {
+        return value_ + value;
+    }
+    HPX_DEFINE_COMPONENT_ACTION(test_server, add);
+
+    void touch()
+    {
+        ++num_touched;
+    }
+    HPX_DEFINE_COMPONENT_ACTION(test_server, touch);
+
+    std::int64_t value_;
+};
+
+typedef hpx::components::component<test_server> server_type;
+HPX_REGISTER_COMPONENT(server_type, test_server);
+
+typedef test_server::add_action add_action;
+HPX_REGISTER_ACTION(add_action);
+
+HPX_REGISTER_BATCH_ASYNC_ACTION_DECLARATION(add_action)
+HPX_REGISTER_BATCH_ASYNC_ACTION(add_action)
+
+typedef test_server::touch_action touch_action;
+HPX_REGISTER_ACTION(touch_action);
+
+HPX_REGISTER_BATCH_ASYNC_ACTION_DECLARATION(touch_action)
+HPX_REGISTER_BATCH_ASYNC_ACTION(touch_action)
+
+std::int64_t get_num_touched()
+{
+    return num_touched.load();
+}
+HPX_PLAIN_ACTION(get_num_touched);
+
+HPX_REGISTER_BATCH_ASYNC_ACTION_DECLARATION(get_num_touched_action)
+HPX_REGISTER_BATCH_ASYNC_ACTION(get_num_touched_action)
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    std::size_t const num_objects = 100;
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    // distribute the objects round-robin over all localities
+    std::vector<hpx::id_type> ids;
+    std::vector<std::int64_t> args;
+    for (std::size_t i = 0; i != num_objects; ++i)
+    {
+        ids.push_back(hpx::new_<test_server>(
+            localities[i % localities.size()], std::int64_t(i)).get());
+        args.push_back(std::int64_t(2 * i));
+    }
+
+    {
+        std::vector<std::int64_t> results =
+            hpx::lcos::batch_async<add_action>(ids, args).get();
+
+        HPX_TEST_EQ(results.size(), num_objects);
+        for (std::size_t i = 0; i != num_objects; ++i)
+        {
+            HPX_TEST_EQ(results[i], std::int64_t(3 * i));
+        }
+    }
+
+    {
+        hpx::lcos::batch_async<touch_action>(ids).get();
+
+        std::vector<std::int64_t> touched =
+            hpx::lcos::batch_async(get_num_touched_action(), localities).get();
+
+        std::int64_t total = 0;
+        for (std::int64_t t : touched)
+            total += t;
+        HPX_TEST_EQ(total, std::int64_t(num_objects));
+    }
+
+    {
+        std::vector<std::int64_t> results = hpx::lcos::batch_async<add_action>(
+            std::vector<hpx::id_type>(), std::vector<std::int64_t>()).get();
+        HPX_TEST(results.empty());
+    }
+
+    {
+        bool caught_exception = false;
+        try {
+            args.pop_back();
+            hpx::lcos::batch_async<add_action>(ids, args).get();
+        }
+        catch (hpx::exception const& e) {
+            HPX_TEST_EQ(e.get_error(), hpx::bad_parameter);
+            caught_exception = true;
+        }
+        HPX_TEST(caught_exception);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
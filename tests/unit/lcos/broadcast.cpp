@@ -5,11 +5,16 @@
 
 #include <hpx/hpx_init.hpp>
 #include <hpx/include/lcos.hpp>
+#include <hpx/include/performance_counters.hpp>
 #include <hpx/lcos/broadcast.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/util/calculate_fanout.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <string>
 #include <vector>
 
 std::uint32_t f1()
@@ -81,6 +86,110 @@ HPX_PLAIN_ACTION(f4_idx);
 HPX_REGISTER_BROADCAST_WITH_INDEX_ACTION_DECLARATION(f4_idx_action)
 HPX_REGISTER_BROADCAST_WITH_INDEX_ACTION(f4_idx_action)
 
+std::size_t f5_idx(std::size_t i)
+{
+    return i;
+}
+HPX_PLAIN_ACTION(f5_idx);
+
+HPX_REGISTER_BROADCAST_WITH_INDEX_ACTION_DECLARATION(f5_idx_action)
+HPX_REGISTER_BROADCAST_WITH_INDEX_ACTION(f5_idx_action)
+
+///////////////////////////////////////////////////////////////////////////////
+// every locality forwarding a part of the broadcast reads the fanout from its
+// own configuration
+void set_fanout(std::size_t fanout)
+{
+    hpx::set_config_entry("hpx.lcos.collectives.fanout", fanout);
+}
+HPX_PLAIN_ACTION(set_fanout);
+
+// number of parts of the broadcast forwarded to other localities (including
+// those forwarded again from there)
+std::int64_t count_forwarded(std::vector<hpx::id_type> const& localities)
+{
+    using namespace hpx::performance_counters;
+
+    std::int64_t result = 0;
+    for (hpx::id_type const& locality : localities)
+    {
+        performance_counter c("/runtime{locality#" +
+            std::to_string(hpx::naming::get_locality_id_from_id(locality)) +
+            "/total}/count/action-invocation@"
+            "broadcast_with_index_f5_idx_action");
+        result += c.get_counter_value(hpx::launch::sync)
+            .get_value<std::int64_t>();
+    }
+    return result;
+}
+
+// the number of forwarded parts expected for the given number of targets
+std::int64_t expected_forwarded(std::size_t size, std::size_t fanout)
+{
+    std::size_t local_fanout = fanout;
+    if (local_fanout == 0)
+    {
+        local_fanout = 2;
+        while (local_fanout * (local_fanout + 1) < size)
+            ++local_fanout;
+    }
+    if (size <= local_fanout)
+        return 0;
+
+    std::size_t next_fanout =
+        hpx::util::calculate_fanout(size, local_fanout);
+
+    std::int64_t result = 0;
+    for (std::size_t applied = local_fanout; applied != size; /**/)
+    {
+        std::size_t next = (std::min)(next_fanout, size - applied);
+        result += 1 + expected_forwarded(next, fanout);
+        applied += next;
+    }
+    return result;
+}
+
+void test_broadcast_tree(std::vector<hpx::id_type> const& localities,
+    std::size_t fanout)
+{
+    std::vector<hpx::future<void> > configured;
+    for (hpx::id_type const& locality : localities)
+        configured.push_back(hpx::async<set_fanout_action>(locality, fanout));
+    hpx::wait_all(configured);
+
+    // spread a large number of targets over the available localities to
+    // exercise the tree-shaped distribution of the broadcast
+    std::vector<hpx::id_type> ids;
+    for (std::size_t i = 0; i != 257; ++i)
+        ids.push_back(localities[i % localities.size()]);
+
+    std::int64_t forwarded = count_forwarded(localities);
+
+    std::vector<std::size_t> f5_res =
+        hpx::lcos::broadcast_with_index<f5_idx_action>(ids).get();
+
+    HPX_TEST_EQ(f5_res.size(), ids.size());
+    for (std::size_t i = 0; i < f5_res.size(); ++i)
+    {
+        HPX_TEST_EQ(f5_res[i], i);
+    }
+
+    // the shape of the tree depends on the fanout used on every level
+    HPX_TEST_EQ(count_forwarded(localities) - forwarded,
+        expected_forwarded(ids.size(), fanout));
+
+    std::vector<std::uint32_t> f1_res =
+        hpx::lcos::broadcast<f1_action>(ids).get();
+
+    HPX_TEST_EQ(f1_res.size(), ids.size());
+    for (std::size_t i = 0; i < f1_res.size(); ++i)
+    {
+        HPX_TEST_EQ(f1_res[i], hpx::naming::get_locality_id_from_id(ids[i]));
+    }
+
+    hpx::lcos::broadcast<f2_action>(ids).get();
+}
+
 
 int hpx_main()
 {
@@ -135,6 +244,12 @@ int hpx_main()
 
         hpx::lcos::broadcast_with_index<f4_idx_action>(localities, 0).get();
     }
+
+    // 0: derive the fanout from the number of targets (16 for 257 targets)
+    test_broadcast_tree(localities, 0);
+    test_broadcast_tree(localities, 2);
+    test_broadcast_tree(localities, 8);
+
     return hpx::finalize();
 }
 
@@ -0,0 +1,91 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that future continuations are accounted for according to where they
+// have been placed.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/lcos/detail/continuation_placement.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+using hpx::lcos::detail::continuation_placement;
+using hpx::lcos::detail::continuation_inline;
+using hpx::lcos::detail::continuation_local;
+using hpx::lcos::detail::continuation_remote;
+
+std::int64_t count(continuation_placement placement)
+{
+    return hpx::lcos::detail::get_continuation_count(placement, false);
+}
+
+int continuation(hpx::future<int> f)
+{
+    return f.get() + 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_inline()
+{
+    std::int64_t inline_count = count(continuation_inline);
+
+    hpx::lcos::local::promise<int> p;
+    hpx::future<int> f = p.get_future().then(hpx::launch::sync, &continuation);
+
+    p.set_value(41);
+    HPX_TEST_EQ(f.get(), 42);
+
+    HPX_TEST_LT(inline_count, count(continuation_inline));
+}
+
+void test_local()
+{
+    std::int64_t local_count = count(continuation_local);
+
+    hpx::lcos::local::promise<int> p;
+    hpx::future<int> f = p.get_future().then(hpx::launch::async, &continuation);
+
+    // the continuation is spawned by this worker thread
+    p.set_value(41);
+    HPX_TEST_EQ(f.get(), 42);
+
+    HPX_TEST_LT(local_count, count(continuation_local));
+}
+
+void test_remote()
+{
+    std::int64_t remote_count = count(continuation_remote);
+
+    hpx::lcos::local::promise<int> p;
+    hpx::future<int> f = p.get_future().then(hpx::launch::async, &continuation);
+
+    // continuations of futures made ready on a non-HPX thread can be run
+    // anywhere
+    std::thread t([&p]() { p.set_value(41); });
+    t.join();
+    HPX_TEST_EQ(f.get(), 42);
+
+    HPX_TEST_LT(remote_count, count(continuation_remote));
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    test_inline();
+    test_local();
+    test_remote();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
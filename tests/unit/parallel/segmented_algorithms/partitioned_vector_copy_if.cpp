@@ -0,0 +1,203 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/parallel_copy.hpp>
+#include <hpx/include/parallel_remove_copy.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+struct is_even
+{
+    template <typename T>
+    bool operator()(T const& val) const
+    {
+        return int(val) % 2 == 0;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+void iota_vector(hpx::partitioned_vector<T>& v)
+{
+    typename hpx::partitioned_vector<T>::iterator it = v.begin(), end = v.end();
+    for (int i = 0; it != end; ++it, ++i)
+        *it = T(i);
+}
+
+template <typename Values, typename T>
+void verify_values(Values const& dest, std::size_t offset,
+    std::vector<T> const& expected)
+{
+    std::size_t count = 0;
+    for (T const& val : dest)
+    {
+        if (count >= offset && count - offset < expected.size())
+        {
+            HPX_TEST_EQ(val, expected[count - offset]);
+        }
+        else
+        {
+            HPX_TEST_EQ(val, T(-1));
+        }
+        ++count;
+    }
+}
+
+template <typename ExPolicy, typename T, typename Values>
+void test_copy_if(ExPolicy && policy, hpx::partitioned_vector<T> const& v,
+    Values& dest, std::size_t offset, std::vector<T> const& expected)
+{
+    std::fill(std::begin(dest), std::end(dest), T(-1));
+
+    auto out = std::begin(dest);
+    std::advance(out, offset);
+
+    auto r = hpx::parallel::copy_if(policy, v.begin(), v.end(), out,
+        is_even());
+    HPX_TEST(r.in() == v.end());
+    HPX_TEST_EQ(std::size_t(std::distance(out, r.out())), expected.size());
+    verify_values(dest, offset, expected);
+}
+
+template <typename ExPolicy, typename T, typename Values>
+void test_copy_if_async(ExPolicy && policy,
+    hpx::partitioned_vector<T> const& v, Values& dest, std::size_t offset,
+    std::vector<T> const& expected)
+{
+    std::fill(std::begin(dest), std::end(dest), T(-1));
+
+    auto out = std::begin(dest);
+    std::advance(out, offset);
+
+    auto r = hpx::parallel::copy_if(policy, v.begin(), v.end(), out,
+        is_even()).get();
+    HPX_TEST(r.in() == v.end());
+    HPX_TEST_EQ(std::size_t(std::distance(out, r.out())), expected.size());
+    verify_values(dest, offset, expected);
+}
+
+template <typename ExPolicy, typename T, typename Values>
+void test_remove_copy_if(ExPolicy && policy,
+    hpx::partitioned_vector<T> const& v, Values& dest, std::size_t offset,
+    std::vector<T> const& expected)
+{
+    std::fill(std::begin(dest), std::end(dest), T(-1));
+
+    auto out = std::begin(dest);
+    std::advance(out, offset);
+
+    auto r = hpx::parallel::remove_copy_if(policy, v.begin(), v.end(), out,
+        is_even());
+    HPX_TEST(r.in() == v.end());
+    HPX_TEST_EQ(std::size_t(std::distance(out, r.out())), expected.size());
+    verify_values(dest, offset, expected);
+}
+
+template <typename ExPolicy, typename T, typename Values>
+void test_remove_copy_if_async(ExPolicy && policy,
+    hpx::partitioned_vector<T> const& v, Values& dest, std::size_t offset,
+    std::vector<T> const& expected)
+{
+    std::fill(std::begin(dest), std::end(dest), T(-1));
+
+    auto out = std::begin(dest);
+    std::advance(out, offset);
+
+    auto r = hpx::parallel::remove_copy_if(policy, v.begin(), v.end(), out,
+        is_even()).get();
+    HPX_TEST(r.in() == v.end());
+    HPX_TEST_EQ(std::size_t(std::distance(out, r.out())), expected.size());
+    verify_values(dest, offset, expected);
+}
+
+template <typename T, typename Values>
+void copy_if_tests(hpx::partitioned_vector<T> const& v, Values& dest,
+    std::size_t offset)
+{
+    using namespace hpx::parallel::execution;
+
+    std::vector<T> values(v.size());
+    std::copy(v.begin(), v.end(), values.begin());
+
+    std::vector<T> selected, removed;
+    std::copy_if(values.begin(), values.end(), std::back_inserter(selected),
+        is_even());
+    std::remove_copy_if(values.begin(), values.end(),
+        std::back_inserter(removed), is_even());
+
+    test_copy_if(seq, v, dest, offset, selected);
+    test_copy_if(par, v, dest, offset, selected);
+    test_copy_if_async(seq(task), v, dest, offset, selected);
+    test_copy_if_async(par(task), v, dest, offset, selected);
+
+    test_remove_copy_if(seq, v, dest, offset, removed);
+    test_remove_copy_if(par, v, dest, offset, removed);
+    test_remove_copy_if_async(seq(task), v, dest, offset, removed);
+    test_remove_copy_if_async(par(task), v, dest, offset, removed);
+}
+
+template <typename T>
+void copy_if_tests(std::vector<hpx::id_type>& localities)
+{
+    std::size_t const num = 1007;
+    {
+        hpx::partitioned_vector<T> v(num);
+        iota_vector(v);
+
+        hpx::partitioned_vector<T> dest(num);
+        copy_if_tests(v, dest, 0);
+    }
+
+    {
+        hpx::partitioned_vector<T> v(num, hpx::container_layout(localities));
+        iota_vector(v);
+
+        hpx::partitioned_vector<T> dest(num,
+            hpx::container_layout(localities));
+        copy_if_tests(v, dest, 0);
+        copy_if_tests(v, dest, 3);
+    }
+
+    // the partitions of the destination don't line up with the source
+    {
+        hpx::partitioned_vector<T> v(num, hpx::container_layout(localities));
+        iota_vector(v);
+
+        hpx::partitioned_vector<T> dest(num + 10,
+            hpx::container_layout(2 * localities.size() + 1, localities));
+        copy_if_tests(v, dest, 0);
+        copy_if_tests(v, dest, 10);
+    }
+
+    // the destination is not segmented
+    {
+        hpx::partitioned_vector<T> v(num, hpx::container_layout(localities));
+        iota_vector(v);
+
+        std::vector<T> dest(num);
+        copy_if_tests(v, dest, 0);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    copy_if_tests<int>(localities);
+    copy_if_tests<double>(localities);
+    return hpx::util::report_errors();
+}
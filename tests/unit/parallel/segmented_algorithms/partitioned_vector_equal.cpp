@@ -0,0 +1,143 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/parallel_equal.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+struct equal_to
+{
+    template <typename T>
+    bool operator()(T const& x, T const& y) const
+    {
+        return x == y;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename T, typename Values>
+void test_equal(ExPolicy && policy, hpx::partitioned_vector<T> const& xvalues,
+    Values const& yvalues, bool expected)
+{
+    HPX_TEST_EQ(
+        hpx::parallel::equal(policy, std::begin(xvalues), std::end(xvalues),
+            std::begin(yvalues)),
+        expected);
+    HPX_TEST_EQ(
+        hpx::parallel::equal(policy, std::begin(xvalues), std::end(xvalues),
+            std::begin(yvalues), std::end(yvalues), equal_to()),
+        expected);
+
+    // sequences of different length are never equal
+    HPX_TEST(
+        !hpx::parallel::equal(policy, std::begin(xvalues), std::end(xvalues),
+            std::begin(yvalues), std::prev(std::end(yvalues))));
+}
+
+template <typename ExPolicy, typename T, typename Values>
+void test_equal_async(ExPolicy && policy,
+    hpx::partitioned_vector<T> const& xvalues, Values const& yvalues,
+    bool expected)
+{
+    HPX_TEST_EQ(
+        hpx::parallel::equal(policy, std::begin(xvalues), std::end(xvalues),
+            std::begin(yvalues)).get(),
+        expected);
+    HPX_TEST_EQ(
+        hpx::parallel::equal(policy, std::begin(xvalues), std::end(xvalues),
+            std::begin(yvalues), std::end(yvalues), equal_to()).get(),
+        expected);
+}
+
+template <typename T, typename Values>
+void equal_tests(hpx::partitioned_vector<T> const& xvalues,
+    Values const& yvalues, bool expected)
+{
+    test_equal(hpx::parallel::execution::seq, xvalues, yvalues, expected);
+    test_equal(hpx::parallel::execution::par, xvalues, yvalues, expected);
+
+    test_equal_async(
+        hpx::parallel::execution::seq(hpx::parallel::execution::task),
+        xvalues, yvalues, expected);
+    test_equal_async(
+        hpx::parallel::execution::par(hpx::parallel::execution::task),
+        xvalues, yvalues, expected);
+}
+
+template <typename T>
+void equal_tests(hpx::partitioned_vector<T> const& xvalues,
+    hpx::partitioned_vector<T>& yvalues)
+{
+    std::size_t const size = yvalues.size();
+
+    equal_tests(xvalues, yvalues, true);
+
+    // differ in the first, the last, and an element in the middle
+    for (std::size_t pos : { std::size_t(0), size / 2, size - 1 })
+    {
+        yvalues.set_value(hpx::launch::sync, pos, T(2));
+        equal_tests(xvalues, yvalues, false);
+        yvalues.set_value(hpx::launch::sync, pos, T(1));
+    }
+}
+
+template <typename T>
+void equal_tests(std::vector<hpx::id_type>& localities)
+{
+    std::size_t const num = 10007;
+    {
+        hpx::partitioned_vector<T> xvalues(num, T(1));
+        hpx::partitioned_vector<T> yvalues(num, T(1));
+        equal_tests(xvalues, yvalues);
+    }
+
+    {
+        hpx::partitioned_vector<T> xvalues(num, T(1),
+            hpx::container_layout(localities));
+        hpx::partitioned_vector<T> yvalues(num, T(1),
+            hpx::container_layout(localities));
+        equal_tests(xvalues, yvalues);
+    }
+
+    // the partitions of the sequences don't line up
+    {
+        hpx::partitioned_vector<T> xvalues(num, T(1),
+            hpx::container_layout(localities));
+        hpx::partitioned_vector<T> yvalues(num, T(1),
+            hpx::container_layout(2 * localities.size() + 1, localities));
+        equal_tests(xvalues, yvalues);
+    }
+
+    // the second sequence is not segmented
+    {
+        hpx::partitioned_vector<T> xvalues(num, T(1),
+            hpx::container_layout(localities));
+        std::vector<T> yvalues(num, T(1));
+        equal_tests(xvalues, yvalues, true);
+
+        yvalues[num / 2] = T(2);
+        equal_tests(xvalues, yvalues, false);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    equal_tests<int>(localities);
+    equal_tests<double>(localities);
+    return hpx::util::report_errors();
+}
@@ -103,6 +103,30 @@ void handle_values_tests_distributed_access(hpx::partitioned_vector<T>& v)
     compare_vectors(values2, result2);
 }
 
+template <typename T>
+void handle_values_tests_interleaved_access(hpx::partitioned_vector<T>& v)
+{
+    fill_vector(v, T(42));
+
+    // access the elements in reverse order, this touches all partitions
+    // in an order which is different from their layout
+    std::vector<std::size_t> positions(v.size());
+    fill_vector(positions, v.size() - 1, std::size_t(-1));
+
+    std::vector<T> values(positions.size());
+    fill_vector(values, T(48), T(3));
+
+    v.set_values(hpx::launch::sync, positions, values);
+    std::vector<T> result = v.get_values(hpx::launch::sync, positions);
+
+    compare_vectors(values, result);
+
+    for (std::size_t i = 0; i != positions.size(); ++i)
+    {
+        HPX_TEST_EQ(v.get_value(hpx::launch::sync, positions[i]), values[i]);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 template <typename T, typename DistPolicy>
@@ -118,6 +142,11 @@ void handle_values_tests_with_policy(std::size_t size, std::size_t localities,
         hpx::partitioned_vector<T> v(size, policy);
         handle_values_tests_distributed_access(v);
     }
+
+    {
+        hpx::partitioned_vector<T> v(size, policy);
+        handle_values_tests_interleaved_access(v);
+    }
 }
 
 template <typename T>
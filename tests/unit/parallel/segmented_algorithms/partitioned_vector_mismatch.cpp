@@ -0,0 +1,149 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/parallel_mismatch.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+struct equal_to
+{
+    template <typename T>
+    bool operator()(T const& x, T const& y) const
+    {
+        return x == y;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Result, typename Iter1, typename Iter2>
+void verify_mismatch(Result const& r, Iter1 first1, Iter2 first2,
+    std::size_t pos)
+{
+    HPX_TEST_EQ(std::size_t(std::distance(first1, r.first)), pos);
+    HPX_TEST_EQ(std::size_t(std::distance(first2, r.second)), pos);
+}
+
+template <typename ExPolicy, typename T, typename Values>
+void test_mismatch(ExPolicy && policy,
+    hpx::partitioned_vector<T> const& xvalues, Values const& yvalues,
+    std::size_t pos)
+{
+    verify_mismatch(
+        hpx::parallel::mismatch(policy, std::begin(xvalues), std::end(xvalues),
+            std::begin(yvalues)),
+        std::begin(xvalues), std::begin(yvalues), pos);
+    verify_mismatch(
+        hpx::parallel::mismatch(policy, std::begin(xvalues), std::end(xvalues),
+            std::begin(yvalues), std::end(yvalues), equal_to()),
+        std::begin(xvalues), std::begin(yvalues), pos);
+}
+
+template <typename ExPolicy, typename T, typename Values>
+void test_mismatch_async(ExPolicy && policy,
+    hpx::partitioned_vector<T> const& xvalues, Values const& yvalues,
+    std::size_t pos)
+{
+    verify_mismatch(
+        hpx::parallel::mismatch(policy, std::begin(xvalues), std::end(xvalues),
+            std::begin(yvalues)).get(),
+        std::begin(xvalues), std::begin(yvalues), pos);
+    verify_mismatch(
+        hpx::parallel::mismatch(policy, std::begin(xvalues), std::end(xvalues),
+            std::begin(yvalues), std::end(yvalues), equal_to()).get(),
+        std::begin(xvalues), std::begin(yvalues), pos);
+}
+
+template <typename T, typename Values>
+void mismatch_tests(hpx::partitioned_vector<T> const& xvalues,
+    Values const& yvalues, std::size_t pos)
+{
+    test_mismatch(hpx::parallel::execution::seq, xvalues, yvalues, pos);
+    test_mismatch(hpx::parallel::execution::par, xvalues, yvalues, pos);
+
+    test_mismatch_async(
+        hpx::parallel::execution::seq(hpx::parallel::execution::task),
+        xvalues, yvalues, pos);
+    test_mismatch_async(
+        hpx::parallel::execution::par(hpx::parallel::execution::task),
+        xvalues, yvalues, pos);
+}
+
+template <typename T>
+void mismatch_tests(hpx::partitioned_vector<T> const& xvalues,
+    hpx::partitioned_vector<T>& yvalues)
+{
+    std::size_t const size = yvalues.size();
+
+    mismatch_tests(xvalues, yvalues, size);
+
+    // the first mismatch is reported, even if later elements differ as well
+    yvalues.set_value(hpx::launch::sync, size - 1, T(2));
+    for (std::size_t pos : { std::size_t(0), size / 3, size / 2, size - 1 })
+    {
+        yvalues.set_value(hpx::launch::sync, pos, T(2));
+        mismatch_tests(xvalues, yvalues, pos);
+        yvalues.set_value(hpx::launch::sync, pos, T(1));
+    }
+}
+
+template <typename T>
+void mismatch_tests(std::vector<hpx::id_type>& localities)
+{
+    std::size_t const num = 10007;
+    {
+        hpx::partitioned_vector<T> xvalues(num, T(1));
+        hpx::partitioned_vector<T> yvalues(num, T(1));
+        mismatch_tests(xvalues, yvalues);
+    }
+
+    {
+        hpx::partitioned_vector<T> xvalues(num, T(1),
+            hpx::container_layout(localities));
+        hpx::partitioned_vector<T> yvalues(num, T(1),
+            hpx::container_layout(localities));
+        mismatch_tests(xvalues, yvalues);
+    }
+
+    // the partitions of the sequences don't line up
+    {
+        hpx::partitioned_vector<T> xvalues(num, T(1),
+            hpx::container_layout(localities));
+        hpx::partitioned_vector<T> yvalues(num, T(1),
+            hpx::container_layout(2 * localities.size() + 1, localities));
+        mismatch_tests(xvalues, yvalues);
+    }
+
+    // the second sequence is not segmented
+    {
+        hpx::partitioned_vector<T> xvalues(num, T(1),
+            hpx::container_layout(localities));
+        std::vector<T> yvalues(num, T(1));
+        mismatch_tests(xvalues, yvalues, num);
+
+        yvalues[num / 2] = T(2);
+        mismatch_tests(xvalues, yvalues, num / 2);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    mismatch_tests<int>(localities);
+    mismatch_tests<double>(localities);
+    return hpx::util::report_errors();
+}
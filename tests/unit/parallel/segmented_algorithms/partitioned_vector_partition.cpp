@@ -0,0 +1,143 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/parallel_partition.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+struct is_even
+{
+    template <typename T>
+    bool operator()(T const& val) const
+    {
+        return int(val) % 2 == 0;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+void fill_vector(hpx::partitioned_vector<T>& v, std::vector<T> const& values)
+{
+    std::copy(values.begin(), values.end(), v.begin());
+}
+
+template <typename T>
+void verify_partition(hpx::partitioned_vector<T>& v,
+    typename hpx::partitioned_vector<T>::iterator boundary,
+    std::vector<T> const& values)
+{
+    std::vector<T> result(v.size());
+    std::copy(v.begin(), v.end(), result.begin());
+
+    std::size_t count = std::count_if(values.begin(), values.end(), is_even());
+    HPX_TEST_EQ(std::size_t(std::distance(v.begin(), boundary)), count);
+    HPX_TEST(std::is_partitioned(result.begin(), result.end(), is_even()));
+
+    // the elements were only reordered
+    std::vector<T> expected(values);
+    std::sort(expected.begin(), expected.end());
+    std::sort(result.begin(), result.end());
+    HPX_TEST(expected == result);
+}
+
+template <typename ExPolicy, typename T>
+void test_partition(ExPolicy && policy, hpx::partitioned_vector<T>& v,
+    std::vector<T> const& values)
+{
+    fill_vector(v, values);
+
+    auto boundary = hpx::parallel::partition(policy, v.begin(), v.end(),
+        is_even());
+    verify_partition<T>(v, boundary, values);
+}
+
+template <typename ExPolicy, typename T>
+void test_partition_async(ExPolicy && policy, hpx::partitioned_vector<T>& v,
+    std::vector<T> const& values)
+{
+    fill_vector(v, values);
+
+    auto boundary = hpx::parallel::partition(policy, v.begin(), v.end(),
+        is_even()).get();
+    verify_partition<T>(v, boundary, values);
+}
+
+template <typename T>
+void partition_tests(hpx::partitioned_vector<T>& v,
+    std::vector<T> const& values)
+{
+    using namespace hpx::parallel::execution;
+
+    test_partition(seq, v, values);
+    test_partition(par, v, values);
+    test_partition_async(seq(task), v, values);
+    test_partition_async(par(task), v, values);
+}
+
+template <typename T>
+void partition_tests(hpx::partitioned_vector<T>& v)
+{
+    std::size_t const num = v.size();
+
+    // alternating elements
+    std::vector<T> values(num);
+    for (std::size_t i = 0; i != num; ++i)
+        values[i] = T(i);
+    partition_tests(v, values);
+
+    // all elements satisfying the predicate are at the end, they are all
+    // exchanged with elements of other partitions
+    for (std::size_t i = 0; i != num; ++i)
+        values[i] = T(i < num / 2 ? 2 * i + 1 : 2 * i);
+    partition_tests(v, values);
+
+    // none and all elements satisfy the predicate
+    std::fill(values.begin(), values.end(), T(1));
+    partition_tests(v, values);
+    std::fill(values.begin(), values.end(), T(2));
+    partition_tests(v, values);
+}
+
+template <typename T>
+void partition_tests(std::vector<hpx::id_type>& localities)
+{
+    std::size_t const num = 1007;
+    {
+        hpx::partitioned_vector<T> v(num);
+        partition_tests(v);
+    }
+
+    {
+        hpx::partitioned_vector<T> v(num, hpx::container_layout(localities));
+        partition_tests(v);
+    }
+
+    {
+        hpx::partitioned_vector<T> v(num,
+            hpx::container_layout(2 * localities.size() + 1, localities));
+        partition_tests(v);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    partition_tests<int>(localities);
+    partition_tests<double>(localities);
+    return hpx::util::report_errors();
+}
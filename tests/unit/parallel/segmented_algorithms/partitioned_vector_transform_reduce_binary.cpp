@@ -0,0 +1,132 @@
+//  Copyright (c) 2014-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/parallel_transform_reduce.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+struct multiply
+{
+    template <typename T>
+    T operator()(T const& x, T const& y) const
+    {
+        return x * y;
+    }
+};
+
+struct plus
+{
+    template <typename T>
+    T operator()(T const& x, T const& y) const
+    {
+        return x + y;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy, typename T, typename Values>
+T test_transform_reduce_binary(ExPolicy && policy,
+    hpx::partitioned_vector<T> const& xvalues, Values const& yvalues)
+{
+    return
+        hpx::parallel::transform_reduce(policy,
+            std::begin(xvalues), std::end(xvalues), std::begin(yvalues),
+            T(1), plus(), multiply()
+        );
+}
+
+template <typename ExPolicy, typename T, typename Values>
+hpx::future<T>
+test_transform_reduce_binary_async(ExPolicy && policy,
+    hpx::partitioned_vector<T> const& xvalues, Values const& yvalues)
+{
+    return
+        hpx::parallel::transform_reduce(policy,
+            std::begin(xvalues), std::end(xvalues), std::begin(yvalues),
+            T(1), plus(), multiply()
+        );
+}
+
+template <typename T, typename Values>
+void transform_reduce_binary_tests(std::size_t num,
+    hpx::partitioned_vector<T> const& xvalues, Values const& yvalues)
+{
+    HPX_TEST_EQ(
+        test_transform_reduce_binary(
+            hpx::parallel::execution::seq, xvalues, yvalues),
+        T(2 * num + 1));
+    HPX_TEST_EQ(
+        test_transform_reduce_binary(
+            hpx::parallel::execution::par, xvalues, yvalues),
+        T(2 * num + 1));
+
+    HPX_TEST_EQ(
+        test_transform_reduce_binary_async(
+            hpx::parallel::execution::seq(hpx::parallel::execution::task),
+            xvalues, yvalues).get(),
+        T(2 * num + 1));
+    HPX_TEST_EQ(
+        test_transform_reduce_binary_async(
+            hpx::parallel::execution::par(hpx::parallel::execution::task),
+            xvalues, yvalues).get(),
+        T(2 * num + 1));
+}
+
+template <typename T>
+void transform_reduce_binary_tests(std::vector<hpx::id_type> &localities)
+{
+    std::size_t const num = 10007;
+    {
+        hpx::partitioned_vector<T> xvalues(num, T(1));
+        hpx::partitioned_vector<T> yvalues(num, T(2));
+        transform_reduce_binary_tests(num, xvalues, yvalues);
+    }
+
+    {
+        hpx::partitioned_vector<T> xvalues(num, T(1),
+            hpx::container_layout(localities));
+        hpx::partitioned_vector<T> yvalues(num, T(2),
+            hpx::container_layout(localities));
+        transform_reduce_binary_tests(num, xvalues, yvalues);
+    }
+
+    // the partitions of the sequences don't line up
+    {
+        hpx::partitioned_vector<T> xvalues(num, T(1),
+            hpx::container_layout(localities));
+        hpx::partitioned_vector<T> yvalues(num, T(2),
+            hpx::container_layout(2 * localities.size() + 1, localities));
+        transform_reduce_binary_tests(num, xvalues, yvalues);
+    }
+
+    // the second sequence is not segmented
+    {
+        hpx::partitioned_vector<T> xvalues(num, T(1),
+            hpx::container_layout(localities));
+        std::vector<T> yvalues(num, T(2));
+        transform_reduce_binary_tests(num, xvalues, yvalues);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    transform_reduce_binary_tests<int>(localities);
+    transform_reduce_binary_tests<double>(localities);
+    return hpx::util::report_errors();
+}
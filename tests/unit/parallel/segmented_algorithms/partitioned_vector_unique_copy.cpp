@@ -0,0 +1,156 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/parallel_unique.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+// runs of equal elements, some of them spanning partition boundaries
+template <typename T>
+void fill_runs(hpx::partitioned_vector<T>& v, std::size_t run_length)
+{
+    typename hpx::partitioned_vector<T>::iterator it = v.begin(), end = v.end();
+    for (std::size_t i = 0; it != end; ++it, ++i)
+        *it = T(int(i / run_length));
+}
+
+template <typename Values, typename T>
+void verify_values(Values const& dest, std::size_t offset,
+    std::vector<T> const& expected)
+{
+    std::size_t count = 0;
+    for (T const& val : dest)
+    {
+        if (count >= offset && count - offset < expected.size())
+        {
+            HPX_TEST_EQ(val, expected[count - offset]);
+        }
+        else
+        {
+            HPX_TEST_EQ(val, T(-1));
+        }
+        ++count;
+    }
+}
+
+template <typename ExPolicy, typename T, typename Values>
+void test_unique_copy(ExPolicy && policy, hpx::partitioned_vector<T> const& v,
+    Values& dest, std::size_t offset, std::vector<T> const& expected)
+{
+    std::fill(std::begin(dest), std::end(dest), T(-1));
+
+    auto out = std::begin(dest);
+    std::advance(out, offset);
+
+    auto r = hpx::parallel::unique_copy(policy, v.begin(), v.end(), out);
+    HPX_TEST(r.in() == v.end());
+    HPX_TEST_EQ(std::size_t(std::distance(out, r.out())), expected.size());
+    verify_values(dest, offset, expected);
+}
+
+template <typename ExPolicy, typename T, typename Values>
+void test_unique_copy_async(ExPolicy && policy,
+    hpx::partitioned_vector<T> const& v, Values& dest, std::size_t offset,
+    std::vector<T> const& expected)
+{
+    std::fill(std::begin(dest), std::end(dest), T(-1));
+
+    auto out = std::begin(dest);
+    std::advance(out, offset);
+
+    auto r = hpx::parallel::unique_copy(policy, v.begin(), v.end(), out).get();
+    HPX_TEST(r.in() == v.end());
+    HPX_TEST_EQ(std::size_t(std::distance(out, r.out())), expected.size());
+    verify_values(dest, offset, expected);
+}
+
+template <typename T, typename Values>
+void unique_copy_tests(hpx::partitioned_vector<T> const& v, Values& dest,
+    std::size_t offset)
+{
+    using namespace hpx::parallel::execution;
+
+    std::vector<T> values(v.size());
+    std::copy(v.begin(), v.end(), values.begin());
+
+    std::vector<T> expected;
+    std::unique_copy(values.begin(), values.end(),
+        std::back_inserter(expected));
+
+    test_unique_copy(seq, v, dest, offset, expected);
+    test_unique_copy(par, v, dest, offset, expected);
+    test_unique_copy_async(seq(task), v, dest, offset, expected);
+    test_unique_copy_async(par(task), v, dest, offset, expected);
+}
+
+template <typename T>
+void unique_copy_tests(std::vector<hpx::id_type>& localities)
+{
+    std::size_t const num = 1007;
+    for (std::size_t run_length : { std::size_t(1), std::size_t(3),
+             std::size_t(100), num })
+    {
+        {
+            hpx::partitioned_vector<T> v(num);
+            fill_runs(v, run_length);
+
+            hpx::partitioned_vector<T> dest(num);
+            unique_copy_tests(v, dest, 0);
+        }
+
+        {
+            hpx::partitioned_vector<T> v(num,
+                hpx::container_layout(localities));
+            fill_runs(v, run_length);
+
+            hpx::partitioned_vector<T> dest(num,
+                hpx::container_layout(localities));
+            unique_copy_tests(v, dest, 0);
+        }
+
+        // the partitions of the destination don't line up with the source
+        {
+            hpx::partitioned_vector<T> v(num,
+                hpx::container_layout(2 * localities.size() + 1, localities));
+            fill_runs(v, run_length);
+
+            hpx::partitioned_vector<T> dest(num + 10,
+                hpx::container_layout(localities));
+            unique_copy_tests(v, dest, 10);
+        }
+
+        // the destination is not segmented
+        {
+            hpx::partitioned_vector<T> v(num,
+                hpx::container_layout(localities));
+            fill_runs(v, run_length);
+
+            std::vector<T> dest(num);
+            unique_copy_tests(v, dest, 0);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+    unique_copy_tests<int>(localities);
+    unique_copy_tests<double>(localities);
+    return hpx::util::report_errors();
+}
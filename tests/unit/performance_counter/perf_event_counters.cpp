@@ -0,0 +1,95 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/util/annotated_function.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/perf_events.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+char const* const counter_names[] =
+{
+    "/threads{locality#0/total}/perf/cycles@perf_event_test_task",
+    "/threads{locality#0/total}/perf/instructions@perf_event_test_task",
+    "/threads{locality#0/total}/perf/llc-misses@perf_event_test_task",
+    "/threads{locality#0/total}/perf/branch-misses@perf_event_test_task",
+    nullptr
+};
+
+///////////////////////////////////////////////////////////////////////////////
+std::uint64_t sum(std::vector<std::uint64_t> const& data)
+{
+    std::uint64_t result = 0;
+    for (std::uint64_t value : data)
+        result += value;
+    return result;
+}
+
+void run_tasks()
+{
+    std::vector<hpx::future<std::uint64_t> > tasks;
+    for (std::size_t i = 0; i != 16; ++i)
+    {
+        tasks.push_back(hpx::async(hpx::util::annotated_function(
+            []()
+            {
+                std::vector<std::uint64_t> data(1 << 20, 1);
+                return sum(data);
+            },
+            "perf_event_test_task")));
+    }
+
+    for (hpx::future<std::uint64_t>& f : tasks)
+        HPX_TEST_EQ(f.get(), std::uint64_t(1 << 20));
+}
+
+int main()
+{
+    using hpx::performance_counters::performance_counter;
+
+    // counting starts when the first counter is created
+    std::vector<performance_counter> counters;
+    for (char const* const* p = counter_names; *p != nullptr; ++p)
+        counters.push_back(performance_counter(*p));
+
+    HPX_TEST(hpx::util::perf_events::enabled());
+
+    run_tasks();
+
+    std::int64_t instructions =
+        counters[1].get_value<std::int64_t>(hpx::launch::sync);
+
+    // the hardware events are not available on every system (for instance
+    // inside virtual machines), the counters report zero in this case
+    if (hpx::util::perf_events::available())
+    {
+        HPX_TEST_LT(std::int64_t(0),
+            counters[0].get_value<std::int64_t>(hpx::launch::sync));
+        HPX_TEST_LT(std::int64_t(1 << 20), instructions);
+    }
+    else
+    {
+        HPX_TEST_EQ(instructions, std::int64_t(0));
+    }
+
+    // the counters can be reset
+    counters[1].get_value<std::int64_t>(hpx::launch::sync, true);
+    HPX_TEST_EQ(counters[1].get_value<std::int64_t>(hpx::launch::sync),
+        std::int64_t(0));
+
+    // counters for unknown descriptions are zero
+    performance_counter unknown(
+        "/threads{locality#0/total}/perf/cycles@perf_event_unknown_task");
+    HPX_TEST_EQ(unknown.get_value<std::int64_t>(hpx::launch::sync),
+        std::int64_t(0));
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,114 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that processing units are moved from an idle elastic pool to an
+// overloaded one.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/resource_partitioner.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/runtime/resource/detail/partitioner.hpp>
+#include <hpx/runtime/threads/executors/customized_pool_executors.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+void busy_wait()
+{
+    hpx::util::high_resolution_timer t;
+    while (t.elapsed() < 0.001)
+        ;
+}
+
+std::size_t num_active(std::string const& pool_name)
+{
+    return hpx::resource::get_partitioner().get_num_assigned_pus(pool_name);
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    std::size_t const num_pus = hpx::resource::get_num_threads("pool-a");
+    HPX_TEST_EQ(num_pus, hpx::resource::get_num_threads("pool-b"));
+
+    // the shared processing units are released by the first sample
+    hpx::util::high_resolution_timer t;
+    while (num_active("pool-a") + num_active("pool-b") != num_pus &&
+        t.elapsed() < 10.0)
+    {
+        hpx::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    HPX_TEST_EQ(num_active("pool-a") + num_active("pool-b"), num_pus);
+    HPX_TEST_EQ(num_active("pool-b"), std::size_t(1));
+
+    // keep pool-b busy until it has grabbed processing units from pool-a
+    hpx::threads::executors::customized_pool_executor exec("pool-b");
+
+    t.restart();
+    while (num_active("pool-b") == 1 && t.elapsed() < 10.0)
+    {
+        std::vector<hpx::future<void> > work;
+        for (std::size_t i = 0; i != 100 * num_pus; ++i)
+            work.push_back(hpx::async(exec, &busy_wait));
+        hpx::wait_all(work);
+    }
+
+    HPX_TEST_LT(std::size_t(1), num_active("pool-b"));
+    HPX_TEST_LTE(std::size_t(1), num_active("pool-a"));
+    HPX_TEST_EQ(num_active("pool-a") + num_active("pool-b"), num_pus);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {
+        "hpx.os_threads=4",
+        "hpx.elastic_pools.interval=10",
+        "hpx.elastic_pools.hysteresis=1"
+    };
+
+    // set up the resource partitioner
+    hpx::resource::partitioner rp(argc, argv, std::move(cfg),
+        hpx::resource::partitioner_mode(
+            hpx::resource::mode_allow_oversubscription |
+            hpx::resource::mode_allow_dynamic_pools));
+
+    rp.create_thread_pool("pool-a");
+    rp.create_thread_pool("pool-b");
+
+    // share all but the first processing unit between both pools
+    bool first = true;
+    for (hpx::resource::numa_domain const& d : rp.numa_domains())
+    {
+        for (hpx::resource::core const& c : d.cores())
+        {
+            for (hpx::resource::pu const& p : c.pus())
+            {
+                if (first)
+                {
+                    first = false;
+                    continue;
+                }
+
+                rp.add_resource(p, "pool-a", false);
+                rp.add_resource(p, "pool-b", false);
+            }
+        }
+    }
+
+    rp.set_elastic_bounds("pool-a", 1);
+    rp.set_elastic_bounds("pool-b", 1);
+
+    // now run the test
+    HPX_TEST_EQ(hpx::init(), 0);
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,81 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/thread_executors.hpp>
+#include <hpx/runtime/threads/policies/deadline_statistics.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t const num_tasks = 10;
+
+hpx::lcos::local::spinlock mtx;
+std::vector<int> order;
+
+void record(int value)
+{
+    std::lock_guard<hpx::lcos::local::spinlock> l(mtx);
+    order.push_back(value);
+}
+
+int hpx_main()
+{
+    std::int64_t const met = hpx::threads::policies::get_deadline_count(false, true);
+    std::int64_t const missed = hpx::threads::policies::get_deadline_count(true, true);
+    HPX_TEST_EQ(met + missed, std::int64_t(0));
+
+    // the only worker thread is busy running this thread, none of the new
+    // threads will run before it suspends
+    std::vector<hpx::future<void> > tasks;
+
+    // threads without a deadline
+    for (std::size_t i = 0; i != num_tasks; ++i)
+        tasks.push_back(hpx::async(&record, -1));
+
+    // threads with a deadline, created latest deadline first
+    for (std::size_t i = num_tasks; i != 0; --i)
+    {
+        hpx::threads::executors::deadline_executor exec(
+            std::chrono::milliseconds(100 * i));
+        tasks.push_back(hpx::async(exec, &record, int(i)));
+    }
+
+    hpx::wait_all(tasks);
+
+    // the threads with a deadline run first, earliest deadline first
+    HPX_TEST_EQ(order.size(), 2 * num_tasks);
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        HPX_TEST_EQ(order[i], int(i + 1));
+        HPX_TEST_EQ(order[num_tasks + i], -1);
+    }
+
+    HPX_TEST_EQ(
+        hpx::threads::policies::get_deadline_count(false, false) +
+            hpx::threads::policies::get_deadline_count(true, false),
+        std::int64_t(num_tasks));
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=1",
+        "hpx.scheduler=deadline"
+    };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}
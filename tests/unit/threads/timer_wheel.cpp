@@ -0,0 +1,143 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/runtime/threads/detail/timer_wheel.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/steady_clock.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+using hpx::threads::detail::timer_wheel;
+using hpx::util::steady_clock;
+
+///////////////////////////////////////////////////////////////////////////////
+struct timer_data
+{
+    steady_clock::time_point due_;
+    steady_clock::time_point fired_at_;
+    bool fired_ = false;
+    bool canceled_ = false;
+    timer_wheel::handle_type handle_;
+};
+
+// drive the wheel with a simulated clock, covering all levels of the wheel
+void test_timer_wheel()
+{
+    std::mt19937 gen(42);
+
+    timer_wheel wheel;
+    steady_clock::time_point now = steady_clock::now();
+
+    std::vector<timer_data> timers(10000);
+    for (timer_data& t : timers)
+    {
+        switch (gen() % 4)
+        {
+        case 0:
+            t.due_ = now + std::chrono::nanoseconds(gen() % 100000);
+            break;
+        case 1:
+            t.due_ = now + std::chrono::microseconds(gen() % 20000);
+            break;
+        case 2:
+            t.due_ = now + std::chrono::milliseconds(gen() % 5000);
+            break;
+        default:
+            t.due_ = now + std::chrono::seconds(gen() % 1000);
+            break;
+        }
+
+        timer_data* p = &t;
+        t.handle_ = wheel.add(t.due_,
+            [p, &now]()
+            {
+                HPX_TEST(!p->fired_);
+                p->fired_ = true;
+                p->fired_at_ = now;
+            });
+
+        if (gen() % 8 == 0)
+        {
+            t.canceled_ = timer_wheel::cancel(t.handle_);
+            HPX_TEST(t.canceled_);
+        }
+    }
+
+    steady_clock::time_point end = now + std::chrono::seconds(1001);
+    while (now < end)
+    {
+        switch (gen() % 3)
+        {
+        case 0:
+            now += std::chrono::microseconds(gen() % 200);
+            break;
+        case 1:
+            now += std::chrono::milliseconds(gen() % 50);
+            break;
+        default:
+            now += std::chrono::seconds(gen() % 3);
+            break;
+        }
+        wheel.expire(now);
+    }
+
+    HPX_TEST(wheel.empty());
+    for (timer_data const& t : timers)
+    {
+        HPX_TEST_NEQ(t.fired_, t.canceled_);
+        if (t.fired_)
+        {
+            HPX_TEST(t.fired_at_ >= t.due_);
+        }
+        HPX_TEST(!timer_wheel::cancel(t.handle_));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// many threads sleeping concurrently
+void sleep_for(std::chrono::microseconds d)
+{
+    steady_clock::time_point start = steady_clock::now();
+    hpx::this_thread::sleep_for(d);
+    HPX_TEST(steady_clock::now() - start >= d);
+}
+
+void test_sleep()
+{
+    std::mt19937 gen(42);
+
+    std::vector<hpx::future<void> > sleeping;
+    for (std::size_t i = 0; i != 10000; ++i)
+    {
+        sleeping.push_back(hpx::async(&sleep_for,
+            std::chrono::microseconds(gen() % 100000)));
+    }
+    hpx::wait_all(sleeping);
+}
+
+int hpx_main()
+{
+    test_timer_wheel();
+    test_sleep();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}
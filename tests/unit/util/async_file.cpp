@@ -0,0 +1,139 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/runtime/io/async_file.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+std::string const filename = "async_file_test.dat";
+
+///////////////////////////////////////////////////////////////////////////////
+void test_read_write()
+{
+    hpx::io::async_file file(filename, hpx::io::mode_read_write |
+        hpx::io::mode_create | hpx::io::mode_truncate);
+    HPX_TEST(file.is_open());
+
+    std::vector<char> data(4096);
+    for (std::size_t i = 0; i != data.size(); ++i)
+        data[i] = static_cast<char>(i);
+
+    // write the data in two halves, the second one first
+    hpx::future<std::size_t> f2 = file.write(2048, &data[2048], 2048);
+    hpx::future<std::size_t> f1 = file.write(0, &data[0], 2048);
+    HPX_TEST_EQ(f1.get(), std::size_t(2048));
+    HPX_TEST_EQ(f2.get(), std::size_t(2048));
+
+    file.fsync().get();
+    HPX_TEST_EQ(file.size(), std::uint64_t(4096));
+
+    std::vector<char> result(4096);
+    HPX_TEST_EQ(file.read(0, result.data(), result.size()).get(),
+        std::size_t(4096));
+    HPX_TEST(result == data);
+
+    // reading past the end of the file yields nothing
+    HPX_TEST_EQ(file.read(4096, result.data(), result.size()).get(),
+        std::size_t(0));
+}
+
+void test_vectored()
+{
+    hpx::io::async_file file(filename, hpx::io::mode_read_write |
+        hpx::io::mode_create | hpx::io::mode_truncate);
+
+    std::string const header = "header:";
+    std::string const body = "body";
+
+    std::vector<hpx::io::const_buffer> out = {
+        hpx::io::const_buffer(header.data(), header.size()),
+        hpx::io::const_buffer(body.data(), body.size())
+    };
+    HPX_TEST_EQ(file.writev(0, out).get(), header.size() + body.size());
+
+    std::vector<char> first(header.size()), second(body.size());
+    std::vector<hpx::io::mutable_buffer> in = {
+        hpx::io::mutable_buffer(first.data(), first.size()),
+        hpx::io::mutable_buffer(second.data(), second.size())
+    };
+    HPX_TEST_EQ(file.readv(0, in).get(), header.size() + body.size());
+    HPX_TEST(std::string(first.begin(), first.end()) == header);
+    HPX_TEST(std::string(second.begin(), second.end()) == body);
+}
+
+void test_registered_buffers()
+{
+    std::vector<char> memory(8192, 'r');
+    hpx::io::register_buffers(std::vector<hpx::io::mutable_buffer>(1,
+        hpx::io::mutable_buffer(memory.data(), memory.size())));
+
+    {
+        hpx::io::async_file file(filename, hpx::io::mode_read_write |
+            hpx::io::mode_create | hpx::io::mode_truncate);
+
+        HPX_TEST_EQ(file.write(0, memory.data(), 4096).get(),
+            std::size_t(4096));
+        HPX_TEST_EQ(file.read(0, &memory[4096], 4096).get(),
+            std::size_t(4096));
+    }
+
+    hpx::io::unregister_buffers();
+    HPX_TEST(std::vector<char>(8192, 'r') == memory);
+}
+
+void test_errors()
+{
+    // opening a file which doesn't exist fails
+    hpx::error_code ec;
+    hpx::io::async_file file;
+    file.open("does/not/exist", hpx::io::mode_read, ec);
+    HPX_TEST(ec);
+    HPX_TEST(!file.is_open());
+
+    // writing to a file opened for reading only is reported by the future
+    {
+        hpx::io::async_file out(filename,
+            hpx::io::mode_write | hpx::io::mode_create);
+    }
+    hpx::io::async_file in(filename, hpx::io::mode_read);
+
+    char c = 'c';
+    bool caught_exception = false;
+    try
+    {
+        in.write(0, &c, 1).get();
+    }
+    catch (hpx::exception const& e)
+    {
+        caught_exception = true;
+        HPX_TEST_EQ(e.get_error(), hpx::filesystem_error);
+    }
+    HPX_TEST(caught_exception);
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    test_read_write();
+    test_vectored();
+    test_registered_buffers();
+    test_errors();
+
+    std::remove(filename.c_str());
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // the backend can be selected using --hpx:ini=hpx.io.backend=...
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
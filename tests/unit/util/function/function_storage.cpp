@@ -0,0 +1,153 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx.hpp>
+#include <hpx/util/function.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/unique_function.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+int instances = 0;
+
+// exceeds the default function storage, but fits into eight pointers
+struct medium_object
+{
+    explicit medium_object(int value)
+      : value_(value), str_("a string")
+    {
+        ++instances;
+    }
+
+    medium_object(medium_object const& other)
+      : value_(other.value_), str_(other.str_)
+    {
+        ++instances;
+    }
+
+    medium_object(medium_object&& other) noexcept
+      : value_(other.value_), str_(std::move(other.str_))
+    {
+        ++instances;
+    }
+
+    ~medium_object()
+    {
+        --instances;
+    }
+
+    int operator()() const
+    {
+        return value_ + static_cast<int>(str_.size());
+    }
+
+    int value_;
+    std::string str_;
+};
+
+// trivially copyable, exceeds the default function storage
+struct trivial_object
+{
+    int operator()() const
+    {
+        return values_[0];
+    }
+
+    int values_[10];
+};
+
+template <typename F, typename T>
+bool is_stored_inline(F const& f, T const* target)
+{
+    char const* begin = reinterpret_cast<char const*>(&f);
+    char const* p = reinterpret_cast<char const*>(target);
+    return p >= begin && p < begin + sizeof(f);
+}
+
+std::size_t const storage_size = 8 * sizeof(void*);
+
+///////////////////////////////////////////////////////////////////////////////
+void test_function_storage()
+{
+    typedef hpx::util::function_nonser<int(), storage_size> function_type;
+
+    {
+        function_type f = medium_object(1);
+        HPX_TEST(is_stored_inline(f, f.target<medium_object>()));
+        HPX_TEST(f.target_type() == typeid(medium_object));
+        HPX_TEST_EQ(f(), 9);
+
+        // copies and moves preserve the stored object
+        function_type g(f);
+        HPX_TEST(is_stored_inline(g, g.target<medium_object>()));
+        HPX_TEST_EQ(g(), 9);
+
+        function_type h(std::move(f));
+        HPX_TEST(f.empty());
+        HPX_TEST_EQ(h(), 9);
+
+        function_type k = trivial_object{{5}};
+        HPX_TEST(is_stored_inline(k, k.target<trivial_object>()));
+        HPX_TEST_EQ(k(), 5);
+
+        k.swap(h);
+        HPX_TEST_EQ(k(), 9);
+        HPX_TEST_EQ(h(), 5);
+
+        function_type m(h);
+        HPX_TEST_EQ(m(), 5);
+
+        h = std::move(k);
+        HPX_TEST(k.empty());
+        HPX_TEST_EQ(h(), 9);
+
+        h.reset();
+        HPX_TEST(h.empty());
+    }
+    HPX_TEST_EQ(instances, 0);
+
+    // the default storage is too small to hold the object inline
+    {
+        hpx::util::function_nonser<int()> f = medium_object(2);
+        HPX_TEST(!is_stored_inline(f, f.target<medium_object>()));
+        HPX_TEST_EQ(f(), 10);
+    }
+    HPX_TEST_EQ(instances, 0);
+}
+
+void test_unique_function_storage()
+{
+    typedef hpx::util::unique_function_nonser<int(), storage_size>
+        function_type;
+
+    {
+        std::unique_ptr<medium_object> p(new medium_object(3));
+        function_type f = hpx::util::bind(
+            [](std::unique_ptr<medium_object>& p, medium_object const& o)
+            {
+                return (*p)() + o();
+            },
+            std::move(p), medium_object(4));
+        HPX_TEST_EQ(f(), 11 + 12);
+
+        function_type g(std::move(f));
+        HPX_TEST(f.empty());
+        HPX_TEST_EQ(g(), 11 + 12);
+    }
+    HPX_TEST_EQ(instances, 0);
+}
+
+int main()
+{
+    test_function_storage();
+    test_unique_function_storage();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,93 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/util/annotated_function.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/sampling_profiler.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+char const* const destination = "sampling_profiler_test.folded";
+
+///////////////////////////////////////////////////////////////////////////////
+void spin(std::uint64_t duration)
+{
+    std::uint64_t start = hpx::util::high_resolution_clock::now();
+    while (hpx::util::high_resolution_clock::now() - start < duration)
+        /**/;
+}
+
+int hpx_main()
+{
+    HPX_TEST(hpx::util::sampling_profiler::enabled());
+
+    // keep both worker threads busy for 200ms each
+    std::vector<hpx::future<void> > tasks;
+    for (std::size_t i = 0; i != 2; ++i)
+    {
+        tasks.push_back(hpx::async(hpx::util::annotated_function(
+            []()
+            {
+                spin(200000000);
+            },
+            "sampling_profiler_test_task")));
+    }
+    hpx::wait_all(tasks);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {
+        "hpx.profiler.enable=1",
+        "hpx.profiler.interval=1000",
+        std::string("hpx.profiler.destination=") + destination
+    };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    HPX_TEST(!hpx::util::sampling_profiler::enabled());
+
+    // the profile is written while the runtime shuts down
+    std::ifstream in(destination);
+    HPX_TEST(in.is_open());
+
+    std::uint64_t samples = 0, task_samples = 0;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        // every line is a list of frames followed by a sample count
+        std::string::size_type pos = line.rfind(' ');
+        HPX_TEST_NEQ(pos, std::string::npos);
+
+        std::uint64_t count = 0;
+        std::istringstream(line.substr(pos + 1)) >> count;
+        HPX_TEST_LT(std::uint64_t(0), count);
+
+        samples += count;
+        if (line.find("sampling_profiler_test_task") != std::string::npos)
+            task_samples += count;
+    }
+    in.close();
+    std::remove(destination);
+
+    // 400ms of CPU time are sampled every millisecond
+    HPX_TEST_LTE(std::uint64_t(100), samples);
+
+#if defined(HPX_HAVE_THREAD_DESCRIPTION)
+    HPX_TEST_LTE(std::uint64_t(100), task_samples);
+#endif
+
+    return hpx::util::report_errors();
+}
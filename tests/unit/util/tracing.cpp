@@ -0,0 +1,87 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/util/annotated_function.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/tracing.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+char const* const destination = "tracing_test.json";
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t count(std::string const& str, std::string const& pattern)
+{
+    std::size_t result = 0;
+    for (std::size_t pos = str.find(pattern); pos != std::string::npos;
+         pos = str.find(pattern, pos + pattern.size()))
+    {
+        ++result;
+    }
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    HPX_TEST(hpx::util::tracing::enabled());
+
+    std::vector<hpx::future<void> > tasks;
+    for (std::size_t i = 0; i != 100; ++i)
+    {
+        tasks.push_back(hpx::async(hpx::util::annotated_function(
+            []()
+            {
+                // suspend the task once
+                hpx::this_thread::yield();
+            },
+            "tracing_test_task")));
+    }
+    hpx::wait_all(tasks);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {
+        "hpx.trace.enable=1",
+        std::string("hpx.trace.destination=") + destination
+    };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    HPX_TEST(!hpx::util::tracing::enabled());
+
+    // the trace is written while the runtime shuts down
+    std::ifstream in(destination);
+    HPX_TEST(in.is_open());
+
+    std::string trace((std::istreambuf_iterator<char>(in)),
+        std::istreambuf_iterator<char>());
+    in.close();
+    std::remove(destination);
+
+    HPX_TEST_EQ(trace.find("{\"traceEvents\":["), std::size_t(0));
+    HPX_TEST_NEQ(trace.find("\"name\":\"thread_name\""), std::string::npos);
+
+    // every task has been started and suspended or terminated at least once
+    std::size_t begin_events = count(trace, "\"ph\":\"B\"");
+    HPX_TEST_LTE(std::size_t(200), begin_events);
+    HPX_TEST_EQ(begin_events, count(trace, "\"ph\":\"E\""));
+    HPX_TEST_LTE(std::size_t(100), count(trace, "\"state\":\"terminated\""));
+
+#if defined(HPX_HAVE_THREAD_DESCRIPTION)
+    HPX_TEST_LTE(std::size_t(200), count(trace, "\"tracing_test_task\""));
+#endif
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,230 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify the framing of the Perfetto (protobuf) trace written by
+// hpx::util::tracing and the number of events it holds.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/util/annotated_function.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/tracing.hpp>
+#include <hpx/util/unused.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+char const* const destination = "tracing_perfetto_test.pftrace";
+
+///////////////////////////////////////////////////////////////////////////////
+// A minimal protobuf decoder, only varint (0) and length delimited (2) fields
+// are written by the tracing support.
+struct field
+{
+    std::uint32_t number_;
+    std::uint32_t wire_type_;
+    std::uint64_t value_;
+    std::string data_;
+};
+
+bool read_varint(std::string const& msg, std::size_t& pos,
+    std::uint64_t& value)
+{
+    value = 0;
+    for (std::size_t shift = 0; pos != msg.size() && shift < 64; shift += 7)
+    {
+        std::uint8_t byte = static_cast<std::uint8_t>(msg[pos++]);
+        value |= std::uint64_t(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+// returns false if the message is not framed correctly
+bool decode(std::string const& msg, std::vector<field>& fields)
+{
+    fields.clear();
+
+    std::size_t pos = 0;
+    while (pos != msg.size())
+    {
+        std::uint64_t tag = 0;
+        if (!read_varint(msg, pos, tag))
+            return false;
+
+        field f = { std::uint32_t(tag >> 3), std::uint32_t(tag & 0x7), 0,
+            std::string() };
+        if (f.number_ == 0 || !read_varint(msg, pos, f.value_))
+            return false;
+
+        if (f.wire_type_ == 2)
+        {
+            if (f.value_ > msg.size() - pos)
+                return false;
+            f.data_ = msg.substr(pos, std::size_t(f.value_));
+            pos += std::size_t(f.value_);
+        }
+        else if (f.wire_type_ != 0)
+        {
+            return false;
+        }
+        fields.push_back(f);
+    }
+    return true;
+}
+
+field const* find(std::vector<field> const& fields, std::uint32_t number)
+{
+    for (field const& f : fields)
+    {
+        if (f.number_ == number)
+            return &f;
+    }
+    return nullptr;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    HPX_TEST(hpx::util::tracing::enabled());
+
+    std::vector<hpx::future<void> > tasks;
+    for (std::size_t i = 0; i != 100; ++i)
+    {
+        tasks.push_back(hpx::async(hpx::util::annotated_function(
+            []()
+            {
+                // suspend the task once
+                hpx::this_thread::yield();
+            },
+            "tracing_test_task")));
+    }
+    hpx::wait_all(tasks);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> const cfg = {
+        "hpx.trace.enable=1",
+        "hpx.trace.format=perfetto",
+        std::string("hpx.trace.destination=") + destination
+    };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    HPX_TEST(!hpx::util::tracing::enabled());
+
+    // the trace is written while the runtime shuts down
+    std::ifstream in(destination, std::ifstream::in | std::ifstream::binary);
+    HPX_TEST(in.is_open());
+
+    std::string trace((std::istreambuf_iterator<char>(in)),
+        std::istreambuf_iterator<char>());
+    in.close();
+    std::remove(destination);
+
+    // the trace is a sequence of TracePacket messages (Trace.packet = 1)
+    std::vector<field> packets;
+    HPX_TEST(decode(trace, packets));
+    HPX_TEST(!packets.empty());
+
+    std::map<std::uint64_t, std::uint64_t> tracks;  // uuid -> last timestamp
+    std::size_t begin_events = 0, end_events = 0, named_tasks = 0;
+
+    std::vector<field> packet, message;
+    for (std::size_t i = 0; i != packets.size(); ++i)
+    {
+        HPX_TEST_EQ(packets[i].number_, 1u);
+        HPX_TEST_EQ(packets[i].wire_type_, 2u);
+        HPX_TEST(decode(packets[i].data_, packet));
+
+        // all packets are written on one sequence, which is reset first
+        field const* sequence_id = find(packet, 10);
+        HPX_TEST(sequence_id != nullptr && sequence_id->value_ == 1);
+        if (i == 0)
+        {
+            field const* flags = find(packet, 13);
+            HPX_TEST(flags != nullptr && flags->value_ == 1);
+        }
+
+        if (field const* descriptor = find(packet, 60))
+        {
+            // TrackDescriptor, each track is described once before its
+            // events are written
+            HPX_TEST(decode(descriptor->data_, message));
+            field const* uuid = find(message, 1);
+            HPX_TEST(uuid != nullptr && find(message, 4) != nullptr);
+            if (uuid != nullptr)
+                HPX_TEST(tracks.insert(std::make_pair(uuid->value_, 0)).second);
+            continue;
+        }
+
+        // TrackEvent
+        field const* timestamp = find(packet, 8);
+        field const* event = find(packet, 11);
+        HPX_TEST(timestamp != nullptr && event != nullptr);
+        if (timestamp == nullptr || event == nullptr)
+            continue;
+
+        HPX_TEST(decode(event->data_, message));
+        field const* type = find(message, 9);
+        field const* uuid = find(message, 11);
+        HPX_TEST(type != nullptr && uuid != nullptr);
+        if (type == nullptr || uuid == nullptr)
+            continue;
+
+        // events are written in the order they were recorded on their track
+        auto it = tracks.find(uuid->value_);
+        HPX_TEST(it != tracks.end());
+        if (it != tracks.end())
+        {
+            HPX_TEST_LTE(it->second, timestamp->value_);
+            it->second = timestamp->value_;
+        }
+
+        field const* name = find(message, 23);
+        switch (type->value_)
+        {
+        case 1:     // TYPE_SLICE_BEGIN
+            ++begin_events;
+            HPX_TEST(name != nullptr);
+            if (name != nullptr && name->data_ == "tracing_test_task")
+                ++named_tasks;
+            break;
+
+        case 2:     // TYPE_SLICE_END
+            ++end_events;
+            HPX_TEST(name == nullptr);
+            break;
+
+        default:
+            HPX_TEST_EQ(type->value_, 3u);  // TYPE_INSTANT
+            break;
+        }
+    }
+
+    HPX_TEST(!tracks.empty());
+
+    // every task has been started and suspended or terminated at least once
+    HPX_TEST_LTE(std::size_t(200), begin_events);
+    HPX_TEST_EQ(begin_events, end_events);
+
+#if defined(HPX_HAVE_THREAD_DESCRIPTION)
+    HPX_TEST_LTE(std::size_t(200), named_tasks);
+#else
+    HPX_UNUSED(named_tasks);
+#endif
+
+    return hpx::util::report_errors();
+}